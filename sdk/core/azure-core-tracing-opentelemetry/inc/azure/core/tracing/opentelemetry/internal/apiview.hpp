@@ -19,4 +19,11 @@ namespace trace {
     static nostd::shared_ptr<TracerProvider> GetTracerProvider();
   };
 } // namespace trace
+namespace metrics {
+  struct MeterProvider;
+  struct Provider
+  {
+    static nostd::shared_ptr<MeterProvider> GetMeterProvider();
+  };
+} // namespace metrics
 } // namespace opentelemetry
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <azure/core/metrics/metrics.hpp>
 #include <azure/core/tracing/tracing.hpp>
 
 #if defined(_azure_APIVIEW)
@@ -17,6 +18,8 @@
 #pragma warning(disable : 6323) // Disable "Use of arithmetic operator on Boolean type" warning.
 #endif
 
+#include <opentelemetry/metrics/meter_provider.h>
+#include <opentelemetry/metrics/provider.h>
 #include <opentelemetry/trace/provider.h>
 #include <opentelemetry/trace/tracer_provider.h>
 
@@ -66,4 +69,43 @@ namespace Azure { namespace Core { namespace Tracing { namespace OpenTelemetry {
     virtual ~OpenTelemetryProvider() = default;
   };
 
+  /**
+   * @brief Meter Provider - factory for creating Meter objects.
+   *
+   * An OpenTelemetryMeterProvider object wraps an opentelemetry-cpp MeterProvider object and
+   * provides an abstraction of the opentelemetry metrics APIs which can be consumed by Azure Core
+   * and other Azure services.
+   *
+   */
+  class OpenTelemetryMeterProvider final : public Azure::Core::Metrics::MeterProvider {
+  private:
+    std::shared_ptr<Azure::Core::Metrics::_internal::Meter> CreateMeter(
+        std::string const& name,
+        std::string const& version) const override;
+
+    opentelemetry::nostd::shared_ptr<opentelemetry::metrics::MeterProvider> m_meterProvider;
+
+    explicit OpenTelemetryMeterProvider(
+        opentelemetry::nostd::shared_ptr<opentelemetry::metrics::MeterProvider> meterProvider
+        = opentelemetry::metrics::Provider::GetMeterProvider());
+
+    // Schema URL for OpenTelemetry. Azure SDKs currently support version 1.17.0 only.
+    const char* OpenTelemetrySchemaUrl117 = "https://opentelemetry.io/schemas/1.17.0";
+    const char* OpenTelemetrySchemaUrlCurrent = OpenTelemetrySchemaUrl117;
+
+  public:
+    /**
+     * @brief Create a new instance of an OpenTelemetryMeterProvider.
+     *
+     * @param meterProvider opentelemetry-cpp MeterProvider object.
+     *
+     * @returns a new OpenTelemetryMeterProvider object
+     */
+    static std::shared_ptr<OpenTelemetryMeterProvider> Create(
+        opentelemetry::nostd::shared_ptr<opentelemetry::metrics::MeterProvider> meterProvider
+        = opentelemetry::metrics::Provider::GetMeterProvider());
+
+    virtual ~OpenTelemetryMeterProvider() = default;
+  };
+
 }}}} // namespace Azure::Core::Tracing::OpenTelemetry
@@ -19,6 +19,7 @@
 #pragma warning(disable : 6323)
 #endif
 
+#include <opentelemetry/metrics/provider.h>
 #include <opentelemetry/trace/propagation/http_trace_context.h>
 #include <opentelemetry/trace/provider.h>
 #include <opentelemetry/trace/tracer_provider.h>
@@ -51,6 +52,30 @@ namespace Azure { namespace Core { namespace Tracing { namespace OpenTelemetry {
     return std::make_shared<Azure::Core::Tracing::OpenTelemetry::_detail::OpenTelemetryTracer>(
         returnTracer);
   }
+
+  OpenTelemetryMeterProvider::OpenTelemetryMeterProvider(
+      opentelemetry::nostd::shared_ptr<opentelemetry::metrics::MeterProvider> meterProvider)
+      : m_meterProvider(meterProvider)
+  {
+  }
+
+  std::shared_ptr<OpenTelemetryMeterProvider> OpenTelemetryMeterProvider::Create(
+      opentelemetry::nostd::shared_ptr<opentelemetry::metrics::MeterProvider> meterProvider)
+  {
+    auto rv = std::shared_ptr<OpenTelemetryMeterProvider>(
+        new OpenTelemetryMeterProvider(meterProvider));
+    return {rv, rv.get()};
+  }
+
+  std::shared_ptr<Azure::Core::Metrics::_internal::Meter> OpenTelemetryMeterProvider::CreateMeter(
+      std::string const& name,
+      std::string const& version) const
+  {
+    opentelemetry::nostd::shared_ptr<opentelemetry::metrics::Meter> returnMeter(
+        m_meterProvider->GetMeter(name, version, OpenTelemetrySchemaUrlCurrent));
+    return std::make_shared<Azure::Core::Tracing::OpenTelemetry::_detail::OpenTelemetryMeter>(
+        returnMeter);
+  }
   namespace _detail {
 
     std::unique_ptr<Azure::Core::Tracing::_internal::AttributeSet>
@@ -262,6 +287,31 @@ namespace Azure { namespace Core { namespace Tracing { namespace OpenTelemetry {
         opentelemetry::trace::propagation::HttpTraceContext().Inject(propagator, currentContext);
       }
     }
+
+    OpenTelemetryMeter::OpenTelemetryMeter(
+        opentelemetry::nostd::shared_ptr<opentelemetry::metrics::Meter> meter)
+        : m_meter(meter)
+    {
+    }
+
+    std::shared_ptr<Azure::Core::Metrics::_internal::Counter> OpenTelemetryMeter::CreateCounter(
+        std::string const& name,
+        std::string const& description,
+        std::string const& unit) const
+    {
+      return std::make_shared<OpenTelemetryCounter>(
+          m_meter->CreateUInt64Counter(name, description, unit));
+    }
+
+    std::shared_ptr<Azure::Core::Metrics::_internal::Histogram>
+    OpenTelemetryMeter::CreateHistogram(
+        std::string const& name,
+        std::string const& description,
+        std::string const& unit) const
+    {
+      return std::make_shared<OpenTelemetryHistogram>(
+          m_meter->CreateDoubleHistogram(name, description, unit));
+    }
   } // namespace _detail
 
 }}}} // namespace Azure::Core::Tracing::OpenTelemetry
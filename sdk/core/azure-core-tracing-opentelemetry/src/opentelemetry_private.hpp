@@ -5,6 +5,7 @@
 
 #include "azure/core/tracing/opentelemetry/opentelemetry.hpp"
 
+#include <azure/core/internal/metrics/metrics_impl.hpp>
 #include <azure/core/internal/tracing/tracing_impl.hpp>
 #if defined(_MSC_VER)
 // The OpenTelemetry headers generate a couple of warnings on MSVC in the OTel 1.2 package, suppress
@@ -15,7 +16,11 @@
 #pragma warning(disable : 6323) // Disable "Use of arithmetic operator on Boolean type" warning.
 #endif
 
+#include <opentelemetry/common/key_value_iterable.h>
 #include <opentelemetry/common/kv_properties.h>
+#include <opentelemetry/context/context.h>
+#include <opentelemetry/metrics/meter.h>
+#include <opentelemetry/metrics/sync_instruments.h>
 #include <opentelemetry/trace/provider.h>
 #include <opentelemetry/trace/span.h>
 #include <opentelemetry/trace/tracer.h>
@@ -143,6 +148,11 @@ namespace Azure { namespace Core { namespace Tracing { namespace OpenTelemetry {
      */
     virtual void PropagateToHttpHeaders(Azure::Core::Http::Request& request) override;
 
+    /**
+     * @brief Returns whether the span is recording, i.e. whether it was sampled.
+     */
+    virtual bool IsRecording() const override { return m_span->IsRecording(); }
+
     opentelemetry::trace::SpanContext GetContext() { return m_span->GetContext(); }
   };
 
@@ -159,4 +169,91 @@ namespace Azure { namespace Core { namespace Tracing { namespace OpenTelemetry {
         const override;
   };
 
+  /**
+   * @brief Presents the attributes of a measurement to OpenTelemetry without copying them.
+   */
+  class OpenTelemetryMetricAttributes final : public opentelemetry::common::KeyValueIterable {
+    Azure::Core::Metrics::_internal::MetricAttributes m_attributes;
+
+  public:
+    explicit OpenTelemetryMetricAttributes(
+        Azure::Core::Metrics::_internal::MetricAttributes attributes)
+        : m_attributes(attributes)
+    {
+    }
+
+    bool ForEachKeyValue(
+        opentelemetry::nostd::function_ref<
+            bool(opentelemetry::nostd::string_view, opentelemetry::common::AttributeValue)>
+            callback) const noexcept override
+    {
+      for (auto const& attribute : m_attributes)
+      {
+        if (!callback(
+                attribute.Name,
+                opentelemetry::common::AttributeValue(
+                    opentelemetry::nostd::string_view(attribute.Value))))
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    size_t size() const noexcept override { return m_attributes.size(); }
+  };
+
+  class OpenTelemetryCounter final : public Azure::Core::Metrics::_internal::Counter {
+    opentelemetry::nostd::unique_ptr<opentelemetry::metrics::Counter<uint64_t>> m_counter;
+
+  public:
+    OpenTelemetryCounter(
+        opentelemetry::nostd::unique_ptr<opentelemetry::metrics::Counter<uint64_t>> counter)
+        : m_counter(std::move(counter))
+    {
+    }
+
+    void Add(uint64_t value, Azure::Core::Metrics::_internal::MetricAttributes attributes)
+        override
+    {
+      m_counter->Add(
+          value, OpenTelemetryMetricAttributes(attributes), opentelemetry::context::Context{});
+    }
+  };
+
+  class OpenTelemetryHistogram final : public Azure::Core::Metrics::_internal::Histogram {
+    opentelemetry::nostd::unique_ptr<opentelemetry::metrics::Histogram<double>> m_histogram;
+
+  public:
+    OpenTelemetryHistogram(
+        opentelemetry::nostd::unique_ptr<opentelemetry::metrics::Histogram<double>> histogram)
+        : m_histogram(std::move(histogram))
+    {
+    }
+
+    void Record(double value, Azure::Core::Metrics::_internal::MetricAttributes attributes)
+        override
+    {
+      m_histogram->Record(
+          value, OpenTelemetryMetricAttributes(attributes), opentelemetry::context::Context{});
+    }
+  };
+
+  class OpenTelemetryMeter final : public Azure::Core::Metrics::_internal::Meter {
+    opentelemetry::nostd::shared_ptr<opentelemetry::metrics::Meter> m_meter;
+
+  public:
+    OpenTelemetryMeter(opentelemetry::nostd::shared_ptr<opentelemetry::metrics::Meter> meter);
+
+    std::shared_ptr<Azure::Core::Metrics::_internal::Counter> CreateCounter(
+        std::string const& name,
+        std::string const& description,
+        std::string const& unit) const override;
+
+    std::shared_ptr<Azure::Core::Metrics::_internal::Histogram> CreateHistogram(
+        std::string const& name,
+        std::string const& description,
+        std::string const& unit) const override;
+  };
+
 }}}}} // namespace Azure::Core::Tracing::OpenTelemetry::_detail
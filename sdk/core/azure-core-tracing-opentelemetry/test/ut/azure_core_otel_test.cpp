@@ -189,6 +189,52 @@ TEST_F(OpenTelemetryTests, Basic)
   }
 }
 
+TEST_F(OpenTelemetryTests, Metrics)
+{
+  // Create a provider using the OpenTelemetry default provider (this will be a "noop" provider).
+  auto meterProvider = Azure::Core::Tracing::OpenTelemetry::OpenTelemetryMeterProvider::Create();
+
+  auto meter
+      = Azure::Core::Metrics::_internal::MeterProviderImplGetter::MeterImplFromMeter(meterProvider)
+            ->CreateMeter("MeterName", "1.0");
+  ASSERT_TRUE(meter);
+
+  auto counter = meter->CreateCounter("test.counter", "A test counter.", "{test}");
+  ASSERT_TRUE(counter);
+  counter->Add(1, {});
+  counter->Add(2, {{"attribute", "value"}});
+
+  auto histogram = meter->CreateHistogram("test.histogram", "A test histogram.", "s");
+  ASSERT_TRUE(histogram);
+  histogram->Record(0.5, {{"attribute", "value"}, {"other.attribute", "other value"}});
+}
+
+TEST_F(OpenTelemetryTests, SpanIsRecording)
+{
+  // The spans of the OpenTelemetry default provider (a "noop" provider) aren't recorded.
+  {
+    auto provider(Azure::Core::Tracing::OpenTelemetry::OpenTelemetryProvider::Create());
+    auto tracer
+        = Azure::Core::Tracing::_internal::TracerProviderImplGetter::TracerImplFromTracer(provider)
+              ->CreateTracer("TracerName", "1.0");
+    auto span = tracer->CreateSpan("My Span", {});
+    EXPECT_FALSE(span->IsRecording());
+    span->End({});
+  }
+
+  // The spans of the reference provider are always sampled.
+  {
+    auto provider = Azure::Core::Tracing::OpenTelemetry::OpenTelemetryProvider::Create(
+        CreateOpenTelemetryProvider());
+    auto tracer
+        = Azure::Core::Tracing::_internal::TracerProviderImplGetter::TracerImplFromTracer(provider)
+              ->CreateTracer("TracerName", {});
+    auto span = tracer->CreateSpan("My Span", {});
+    EXPECT_TRUE(span->IsRecording());
+    span->End({});
+  }
+}
+
 TEST_F(OpenTelemetryTests, CreateSpanSimple)
 {
   // Simple create an OTel telemetry provider as a static member variable.
@@ -43,6 +43,7 @@
 #include "azure/core/http/http.hpp"
 #include "azure/core/http/http_status_code.hpp"
 #include "azure/core/http/raw_response.hpp"
+#include "azure/core/http/response_buffer_pool.hpp"
 #include "azure/core/http/transport.hpp"
 
 // azure/core/http/policies
@@ -51,5 +52,8 @@
 // azure/core/io
 #include "azure/core/io/body_stream.hpp"
 
+// azure/core/metrics
+#include "azure/core/metrics/metrics.hpp"
+
 // azure/core/tracing
 #include "azure/core/tracing/tracing.hpp"
@@ -86,42 +86,51 @@ namespace Azure { namespace Core {
     class Base64Url final {
 
     public:
-      static std::string Base64UrlEncode(const std::vector<uint8_t>& data)
-      {
-        auto base64 = Azure::Core::Convert::Base64Encode(data);
-        // update to base64url
-        auto trail = base64.find('=');
-        if (trail != std::string::npos)
-        {
-          base64 = base64.substr(0, trail);
-        }
-        std::replace(base64.begin(), base64.end(), '+', '-');
-        std::replace(base64.begin(), base64.end(), '/', '_');
-        return base64;
-      }
+      /**
+       * @brief Encodes a vector of binary data using Base64URL, without padding.
+       *
+       * @param data The input vector that contains binary data to be encoded.
+       * @return The Base64URL encoded contents of the vector.
+       */
+      static std::string Base64UrlEncode(const std::vector<uint8_t>& data);
 
-      static std::vector<uint8_t> Base64UrlDecode(const std::string& text)
-      {
-        std::string base64url(text);
-        // base64url to base64
-        std::replace(base64url.begin(), base64url.end(), '-', '+');
-        std::replace(base64url.begin(), base64url.end(), '_', '/');
-        switch (base64url.size() % 4)
-        {
-          case 0:
-            break;
-          case 2:
-            base64url.append("==");
-            break;
-          case 3:
-            base64url.append("=");
-            break;
-          default:
-            throw std::invalid_argument("Unexpected Base64URL encoding in the HTTP response.");
-        }
-        return Azure::Core::Convert::Base64Decode(base64url);
-      }
+      /**
+       * @brief Decodes a Base64URL encoded data into a vector of binary data.
+       *
+       * @remark The padding is optional, and the `+` and `/` characters of Base64 are accepted as
+       * well.
+       *
+       * @param text Base64URL encoded data to be decoded.
+       * @return The decoded binary data.
+       */
+      static std::vector<uint8_t> Base64UrlDecode(const std::string& text);
     };
   } // namespace _internal
 
+  namespace _detail {
+    /**
+     * @brief Selects between the vectorized and the scalar implementations of the Base64
+     * conversions, so that the tests can compare them.
+     *
+     */
+    class Base64Vectorization final {
+    public:
+      /**
+       * @brief Checks whether the CPU supports the vectorized implementation, which uses AVX2 on
+       * x86 and NEON on AArch64.
+       *
+       */
+      static bool IsSupported();
+
+      /**
+       * @brief Enables or disables the vectorized implementation. It is enabled by default, and
+       * only used when the CPU supports it.
+       *
+       * @param enabled `true` to use the vectorized implementation, `false` for the scalar one.
+       * @return Whether the vectorized implementation was enabled before the call.
+       */
+      static bool SetEnabled(bool enabled);
+    };
+  } // namespace _detail
+
 }} // namespace Azure::Core
@@ -8,10 +8,27 @@
 
 #pragma once
 
+#include <cstddef>
 #include <functional>
 #include <string>
 
 namespace Azure { namespace Core { namespace Diagnostics {
+  /**
+   * @brief Options for delivering the log messages to a listener from a background thread.
+   *
+   */
+  struct AsyncLogListenerOptions final
+  {
+    /**
+     * @brief The number of log messages which can wait to be delivered to the listener, rounded
+     * up to a power of 2.
+     *
+     * @remark When the queue is full, new messages are dropped and the listener is later reported
+     * how many were, with a warning.
+     */
+    size_t Capacity = 4096;
+  };
+
   /**
    * @brief Log message handler.
    */
@@ -45,6 +62,34 @@ namespace Azure { namespace Core { namespace Diagnostics {
      */
     static void SetListener(std::function<void(Level level, std::string const& message)> listener);
 
+    /**
+     * @brief Sets the function that will be invoked, from a background thread, to report an Azure
+     * SDK log message.
+     *
+     * @details The thread reporting a message only adds it to a bounded queue, and the messages
+     * are formatted and delivered to \p listener by a single background thread, in the order in
+     * which they were queued. This keeps a slow listener, such as one writing to a file, out of
+     * the path of the requests when verbose logging is enabled.
+     *
+     * @remark The messages still in the queue when the application exits are lost. Call #Flush(),
+     * or set another listener, to deliver them first.
+     *
+     * @param listener A callback function that will be invoked when the SDK reports a log message.
+     * If `nullptr`, no function will be invoked.
+     * @param options Options for the queue of the log messages.
+     */
+    static void SetAsyncListener(
+        std::function<void(Level level, std::string const& message)> listener,
+        AsyncLogListenerOptions const& options = AsyncLogListenerOptions());
+
+    /**
+     * @brief Waits until the log messages reported so far are delivered to the listener set with
+     * #SetAsyncListener().
+     *
+     * @remark Returns immediately when the listener isn't asynchronous.
+     */
+    static void Flush();
+
     /**
      * @brief Sets the log message level an application is interested in receiving.
      *
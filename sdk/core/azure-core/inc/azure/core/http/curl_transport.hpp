@@ -15,6 +15,7 @@
 #include <chrono>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace Azure { namespace Core { namespace Http {
   class CurlNetworkConnection;
@@ -26,6 +27,22 @@ namespace Azure { namespace Core { namespace Http {
      *
      */
     constexpr std::chrono::milliseconds DefaultConnectionTimeout = std::chrono::minutes(5);
+
+    /**
+     * @brief Default time after which a connection which isn't used is closed by the connection
+     * pool.
+     *
+     */
+    constexpr std::chrono::milliseconds DefaultConnectionIdleTimeout = std::chrono::seconds(60);
+
+    /**
+     * @brief Default time between two passes of the connection pool closing the idle connections.
+     *
+     */
+    constexpr std::chrono::milliseconds DefaultConnectionPoolCleanupInterval
+        = std::chrono::seconds(90);
+
+    class CurlMultiplexer;
   } // namespace _detail
 
   /**
@@ -194,6 +211,77 @@ namespace Azure { namespace Core { namespace Http {
      * @brief If set, integrates libcurl's internal tracing with Azure logging.
      */
     bool EnableCurlTracing = false;
+
+    /**
+     * @brief Sends the requests over HTTP/2 when the server supports it, multiplexing the
+     * concurrent requests to a host over a single connection.
+     *
+     * @details The requests are performed by libcurl on a background thread of the transport.
+     * Up to 1 MiB of each response body is buffered until it is read, beyond which libcurl stops
+     * reading the stream of the response, so that a slow reader doesn't hold back the other
+     * requests sharing the connection. With libcurl older than 8.4.0, the response bodies are
+     * buffered without limit.
+     *
+     * @remark HTTP/2 is negotiated during the TLS handshake: requests to `http` URLs, and requests
+     * to servers which don't support HTTP/2, use HTTP/1.1. Requests upgrading the connection to a
+     * WebSocket don't use this option.
+     *
+     * @remark This option is ignored on Linux when
+     * #Azure::Core::Http::CurlTransportSslOptions::EnableCertificateRevocationListCheck is `true`.
+     *
+     * @warning Requires libcurl >= 7.68.0, built with HTTP/2 support.
+     *
+     */
+    bool EnableHttp2 = false;
+
+    /**
+     * @brief Shares the DNS cache and the TLS sessions between the connections created with this
+     * option, by every transport of the process.
+     *
+     * @details A connection to a host which was recently resolved reuses its address instead of
+     * resolving it again, and resumes the TLS session of a previous connection instead of
+     * performing a full handshake. This makes opening new connections cheaper, e.g. after the idle
+     * connections of the pool expire.
+     *
+     * @remark This option is ignored on Linux when
+     * #Azure::Core::Http::CurlTransportSslOptions::EnableCertificateRevocationListCheck is `true`,
+     * because the certificate of a server isn't verified again when a session is resumed.
+     *
+     */
+    bool EnableSharedCaches = false;
+
+    /**
+     * @brief The time after which a pooled connection which isn't used is closed.
+     *
+     * @remarks The default timeout is 60 seconds and using `0` would set this default value.
+     *
+     */
+    std::chrono::milliseconds ConnectionIdleTimeout = _detail::DefaultConnectionIdleTimeout;
+
+    /**
+     * @brief The time between two passes of the connection pool closing the idle connections.
+     *
+     * @details The connection pool is shared by the transports of the process, and uses the
+     * shortest interval set by any of them.
+     *
+     * @remarks The default interval is 90 seconds and using `0` would set this default value.
+     *
+     */
+    std::chrono::milliseconds ConnectionPoolCleanupInterval
+        = _detail::DefaultConnectionPoolCleanupInterval;
+
+    /**
+     * @brief The number of idle connections to a host which the connection pool keeps open after
+     * #Azure::Core::Http::CurlTransportOptions::ConnectionIdleTimeout.
+     *
+     * @details Together with #Azure::Core::Http::CurlTransport::WarmUpConnections, this keeps the
+     * connections ready for a burst of requests after a quiet period.
+     *
+     * @remark The server may still close an idle connection, in which case the request using it
+     * is sent again on a new connection.
+     *
+     */
+    size_t MinIdleConnectionsPerHost = 0;
   };
 
   /**
@@ -202,6 +290,7 @@ namespace Azure { namespace Core { namespace Http {
   class CurlTransport : public HttpTransport {
   private:
     CurlTransportOptions m_options;
+    std::shared_ptr<_detail::CurlMultiplexer> m_multiplexer;
 
     /**
      * @brief Called when an HTTP response indicates the connection should be upgraded to
@@ -215,9 +304,7 @@ namespace Azure { namespace Core { namespace Http {
      *
      * @param options Optional parameter to override the default options.
      */
-    CurlTransport(CurlTransportOptions const& options = CurlTransportOptions()) : m_options(options)
-    {
-    }
+    CurlTransport(CurlTransportOptions const& options = CurlTransportOptions());
 
     /**
      * @brief Construct a new CurlTransport object based on common Azure HTTP Transport Options
@@ -245,6 +332,43 @@ namespace Azure { namespace Core { namespace Http {
      * @return unique ptr to an HTTP RawResponse.
      */
     std::unique_ptr<RawResponse> Send(Request& request, Context const& context) override;
+
+    /**
+     * @brief Sends an HTTP Request without waiting for its response.
+     *
+     * @details With #Azure::Core::Http::CurlTransportOptions::EnableHttp2, the request is
+     * performed by the background thread of the transport, and \p callback is called from another
+     * background thread once the headers of the response are received. When the request buffers
+     * its response, \p callback is called once the whole body is received instead, so that
+     * buffering it doesn't block. Otherwise, the request is sent on the calling thread.
+     *
+     * @param request an HTTP Request to be send, kept alive until \p callback is called.
+     * @param context A context to control the request lifetime.
+     * @param callback Receives the HTTP RawResponse, or the error.
+     */
+    void SendAsync(Request& request, Context const& context, SendCallback callback) override;
+
+    /**
+     * @brief Opens connections to the hosts of a service ahead of the first requests, and adds
+     * them to the connection pool.
+     *
+     * @details The connections are opened in parallel, until the pool has \p connectionsPerHost
+     * connections to each host. The connections which fail to open are logged and skipped.
+     *
+     * @remark No connection is opened when
+     * #Azure::Core::Http::CurlTransportOptions::HttpKeepAlive is `false`, or when the requests are
+     * sent over HTTP/2.
+     *
+     * @param urls The URLs of the hosts, only their scheme, host and port are used.
+     * @param connectionsPerHost The number of connections to keep in the pool for each host.
+     * @param context A context to cancel the operation.
+     *
+     * @return The number of connections opened.
+     */
+    size_t WarmUpConnections(
+        std::vector<Azure::Core::Url> const& urls,
+        size_t connectionsPerHost,
+        Context const& context = Context{});
   };
 
 }}} // namespace Azure::Core::Http
@@ -14,6 +14,7 @@
 #include "azure/core/http/http_status_code.hpp"
 #include "azure/core/http/raw_response.hpp"
 #include "azure/core/internal/contract.hpp"
+#include "azure/core/internal/http/http_headers.hpp"
 #include "azure/core/io/body_stream.hpp"
 #include "azure/core/nullable.hpp"
 #include "azure/core/url.hpp"
@@ -35,6 +36,7 @@ namespace Azure { namespace Core { namespace Test {
   class TestHttp_getters_Test;
   class TestHttp_query_parameter_Test;
   class TestHttp_RequestStartTry_Test;
+  class TestHttp_RequestHeadersView_Test;
   class TestURL_getters_Test;
   class TestURL_query_parameter_Test;
   class TransportAdapter_headWithStream_Test;
@@ -187,6 +189,7 @@ namespace Azure { namespace Core { namespace Http {
     friend class Azure::Core::Test::TestHttp_getters_Test;
     friend class Azure::Core::Test::TestHttp_query_parameter_Test;
     friend class Azure::Core::Test::TestHttp_RequestStartTry_Test;
+    friend class Azure::Core::Test::TestHttp_RequestHeadersView_Test;
     friend class Azure::Core::Test::TestURL_getters_Test;
     friend class Azure::Core::Test::TestURL_query_parameter_Test;
     // make tests classes friends to validate private Request ctor that takes both stream and bool
@@ -203,8 +206,8 @@ namespace Azure { namespace Core { namespace Http {
   private:
     HttpMethod m_method;
     Url m_url;
-    CaseInsensitiveMap m_headers;
-    CaseInsensitiveMap m_retryHeaders;
+    _internal::HttpHeaders m_headers;
+    _internal::HttpHeaders m_retryHeaders;
 
     Azure::Core::IO::BodyStream* m_bodyStream;
 
@@ -290,6 +293,40 @@ namespace Azure { namespace Core { namespace Http {
      */
     Azure::Nullable<std::string> GetHeader(std::string const& name);
 
+    /**
+     * @brief Returns whether the #Azure::Core::Http::Request has an HTTP header.
+     *
+     * @remark Unlike #GetHeaders(), the headers are not copied.
+     *
+     * @param name The name of the header.
+     */
+    bool HasHeader(std::string const& name) const;
+
+    /**
+     * @brief Calls \p callback with the name and the value of each HTTP header.
+     *
+     * @remark Unlike #GetHeaders(), the headers are neither copied nor sorted: the headers set for
+     * the current try come first. \p callback must not modify the headers of the request.
+     *
+     * @param callback Function called with the name and the value of each header, as
+     * `std::string const&`.
+     */
+    template <typename Callback> void ForEachHeader(Callback&& callback) const
+    {
+      for (auto const& header : m_retryHeaders)
+      {
+        callback(header.first, header.second);
+      }
+      for (auto const& header : m_headers)
+      {
+        // The headers set for the current try override the ones of the request.
+        if (m_retryHeaders.IsEmpty() || m_retryHeaders.Find(header.first) == nullptr)
+        {
+          callback(header.first, header.second);
+        }
+      }
+    }
+
     /**
      * @brief Remove an HTTP header.
      *
@@ -361,6 +398,21 @@ namespace Azure { namespace Core { namespace Http {
           std::string const& headerName,
           std::string const& headerValue);
 
+      /**
+       * @brief Insert a header into \p headers checking that \p headerName does not contain invalid
+       * characters.
+       *
+       * @param headers The headers where to insert header.
+       * @param headerName The header name for the header to be inserted.
+       * @param headerValue The header value for the header to be inserted.
+       *
+       * @throw if \p headerName is invalid.
+       */
+      static void InsertHeaderWithValidation(
+          _internal::HttpHeaders& headers,
+          std::string const& headerName,
+          std::string const& headerValue);
+
       static void inline SetHeader(
           Azure::Core::Http::RawResponse& response,
           uint8_t const* const first,
@@ -13,8 +13,11 @@
 #include "azure/core/credentials/credentials.hpp"
 #include "azure/core/dll_import_export.hpp"
 #include "azure/core/http/http.hpp"
+#include "azure/core/http/response_buffer_pool.hpp"
 #include "azure/core/http/transport.hpp"
 #include "azure/core/internal/http/http_sanitizer.hpp"
+#include "azure/core/internal/metrics/service_metrics.hpp"
+#include "azure/core/metrics/metrics.hpp"
 #include "azure/core/uuid.hpp"
 
 #include <atomic>
@@ -44,6 +47,9 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
   namespace _detail {
     std::shared_ptr<HttpTransport> GetTransportAdapter(TransportOptions const& transportOptions);
 
+    struct HedgingState;
+    struct RetryState;
+
     AZ_CORE_DLLEXPORT extern std::set<std::string> const g_defaultAllowedHttpQueryParameters;
     AZ_CORE_DLLEXPORT extern CaseInsensitiveSet const g_defaultAllowedHttpHeaders;
   } // namespace _detail
@@ -73,6 +79,12 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
      */
     std::shared_ptr<Azure::Core::Tracing::TracerProvider> TracingProvider;
 
+    /**
+     * @brief Specifies the metrics provider to record the metrics of this client into, such as the
+     * duration of the requests and the number of retries. By default, no metrics are recorded.
+     */
+    std::shared_ptr<Azure::Core::Metrics::MeterProvider> MeterProvider;
+
   private:
     // The friend declaration is needed so that TelemetryPolicy could access CppStandardVersion,
     // and it is not a struct's public field like the ones above to be set non-programmatically.
@@ -139,6 +151,46 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
     };
   };
 
+  /**
+   * @brief The set of options that can be specified to influence how idempotent requests are
+   * hedged, i.e. how a duplicate request is sent when the original one is slow to complete.
+   *
+   * @remark Only `GET` and `HEAD` requests without a body are hedged. The first successful
+   * response is returned and the other request is cancelled. A response with an error status is
+   * only returned early when it comes from the original request and isn't retriable; otherwise the
+   * other request is awaited.
+   *
+   */
+  struct HedgingOptions final
+  {
+    /**
+     * @brief Whether requests should be hedged. Hedging is disabled by default.
+     *
+     */
+    bool Enabled = false;
+
+    /**
+     * @brief The time to wait for the original request before sending a hedged request.
+     * @note See https://en.cppreference.com/w/cpp/chrono/duration.
+     *
+     */
+    std::chrono::milliseconds HedgeDelay = std::chrono::milliseconds(100);
+
+    /**
+     * @brief When set, the hedge delay is the observed latency of recent requests at this
+     * percentile (e.g. `0.95`), and #HedgeDelay is used as the lower bound.
+     *
+     */
+    Azure::Nullable<double> LatencyPercentile;
+
+    /**
+     * @brief The maximum number of hedged requests, as a percentage of the requests eligible for
+     * hedging.
+     *
+     */
+    int32_t MaxHedgedRequestsPercentage = 10;
+  };
+
   /**
    * @brief Log options that parameterize the information being logged.
    * @note See https://azure.github.io/azure-sdk/general_azurecore.html#logging-policy.
@@ -246,6 +298,16 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
      *
      */
     std::shared_ptr<HttpTransport> Transport;
+
+    /**
+     * @brief The pool that the buffered responses borrow their body from.
+     *
+     * @remark When not set, the body of each buffered response is allocated for it.
+     *
+     * @remark Unlike the other options, this option is also used when the caller specifies a value
+     * for Transport.
+     */
+    std::shared_ptr<Azure::Core::Http::ResponseBufferPool> ResponseBufferPool;
   };
 
   class NextHttpPolicy;
@@ -277,6 +339,29 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
         NextHttpPolicy nextPolicy,
         Context const& context) const = 0;
 
+    /**
+     * @brief Applies this HTTP policy without waiting for the response.
+     *
+     * @details \p callback is called exactly once, with the response after this policy and all
+     * subsequent HTTP policies have been applied, or with the exception which #Send would have
+     * thrown. It may be called before this function returns, or from a thread of the transport.
+     *
+     * The default implementation calls #Send and then \p callback, so that the policies which
+     * don't override it still work in an asynchronous pipeline, by blocking the calling thread.
+     *
+     * @remark \p request must be kept alive until \p callback is called.
+     *
+     * @param request An HTTP request being sent.
+     * @param nextPolicy The next HTTP to invoke after this policy has been applied.
+     * @param context A context to control the request lifetime.
+     * @param callback Receives the response, or the error.
+     */
+    virtual void SendAsync(
+        Request& request,
+        NextHttpPolicy nextPolicy,
+        Context const& context,
+        SendCallback callback) const;
+
     /**
      * @brief Destructs `%HttpPolicy`.
      *
@@ -356,6 +441,16 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
      * sequence of policies have been applied.
      */
     std::unique_ptr<RawResponse> Send(Request& request, Context const& context);
+
+    /**
+     * @brief Applies this HTTP policy without waiting for the response.
+     *
+     * @param request An HTTP request being sent.
+     * @param context A context to control the request lifetime.
+     * @param callback Receives the response after this policy, and all subsequent HTTP policies
+     * in the stack sequence of policies have been applied, or the error.
+     */
+    void SendAsync(Request& request, Context const& context, SendCallback callback);
   };
 
   namespace _internal {
@@ -385,6 +480,18 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
           Request& request,
           NextHttpPolicy nextPolicy,
           Context const& context) const override;
+
+      void SendAsync(
+          Request& request,
+          NextHttpPolicy nextPolicy,
+          Context const& context,
+          SendCallback callback) const override;
+
+    private:
+      // Downloads the body of the response to its buffer, unless it can be returned with the
+      // BodyStream reading directly from the socket.
+      void BufferResponse(Request const& request, RawResponse& response, Context const& context)
+          const;
     };
 
     /**
@@ -416,6 +523,19 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
           NextHttpPolicy nextPolicy,
           Context const& context) const final;
 
+      /**
+       * @brief Sends the request without waiting for the response, nor blocking a thread between
+       * the tries.
+       *
+       * @details The delay before a retry is waited for by a background thread, which sends the
+       * next try once it expires.
+       */
+      void SendAsync(
+          Request& request,
+          NextHttpPolicy nextPolicy,
+          Context const& context,
+          SendCallback callback) const final;
+
       /**
        * @brief Get the Retry Count from the context.
        *
@@ -442,6 +562,69 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
           int32_t attempt,
           std::chrono::milliseconds& retryAfter,
           double jitterFactor = -1) const;
+
+    private:
+      void SendTryAsync(std::shared_ptr<_detail::RetryState> state) const;
+    };
+
+    /**
+     * @brief HTTP hedging policy.
+     *
+     * @details Sends a duplicate of an idempotent request when the original request hasn't
+     * completed within the hedge delay, and returns the first successful response. The slower
+     * request is cancelled.
+     *
+     * This policy is intended to be inserted into the HTTP pipeline *after* the retry policy, so
+     * that each try is hedged independently.
+     *
+     * @remark The original request is sent from the calling thread, and the hedged request from a
+     * thread started when the hedge delay expires. Destroying the policy waits for any cancelled
+     * request that is still in flight.
+     */
+    class HedgingPolicy final : public HttpPolicy {
+    private:
+      HedgingOptions m_hedgingOptions;
+      std::shared_ptr<_detail::HedgingState> m_state;
+
+    public:
+      /**
+       * Constructs HTTP hedging policy with the provided
+       * #Azure::Core::Http::Policies::HedgingOptions.
+       *
+       * @param options #Azure::Core::Http::Policies::HedgingOptions.
+       */
+      explicit HedgingPolicy(HedgingOptions options);
+
+      /**
+       * @brief Constructs a copy of \p other `%HedgingPolicy`, with its own load and latency
+       * statistics.
+       * @param other Other `%HedgingPolicy` to copy.
+       */
+      HedgingPolicy(HedgingPolicy const& other) : HedgingPolicy(other.m_hedgingOptions) {}
+
+      ~HedgingPolicy() override;
+
+      std::unique_ptr<HttpPolicy> Clone() const override
+      {
+        return std::make_unique<HedgingPolicy>(*this);
+      }
+
+      std::unique_ptr<RawResponse> Send(
+          Request& request,
+          NextHttpPolicy nextPolicy,
+          Context const& context) const override;
+
+      /**
+       * @brief Checks whether the request being sent with \p context is a hedged duplicate of an
+       * original request.
+       *
+       * @remark Policies placed after #HedgingPolicy can use this to send the hedged request to an
+       * alternate endpoint.
+       *
+       * @param context A context to control the request lifetime.
+       * @return `true` if the request is the hedged duplicate; otherwise, `false`.
+       */
+      static bool IsHedgedAttempt(Context const& context);
     };
 
     /**
@@ -479,6 +662,21 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
 
         return nextPolicy.Send(request, context);
       }
+
+      void SendAsync(
+          Request& request,
+          NextHttpPolicy nextPolicy,
+          Context const& context,
+          SendCallback callback) const override
+      {
+        if (!request.GetHeader(RequestIdHeader).HasValue())
+        {
+          auto const uuid = Uuid::CreateUuid().ToString();
+          request.SetHeader(RequestIdHeader, uuid);
+        }
+
+        nextPolicy.SendAsync(request, context, std::move(callback));
+      }
     };
 
     /**
@@ -518,6 +716,51 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
           Request& request,
           NextHttpPolicy nextPolicy,
           Context const& context) const override;
+
+      void SendAsync(
+          Request& request,
+          NextHttpPolicy nextPolicy,
+          Context const& context,
+          SendCallback callback) const override;
+    };
+
+    /**
+     * @brief HTTP Request Metrics policy.
+     *
+     * @details Records the duration of each try of a request, and the sizes of the bodies of the
+     * request and the response, into the metrics of the pipeline.
+     */
+    class RequestMetricsPolicy final : public HttpPolicy {
+    private:
+      std::shared_ptr<Azure::Core::Metrics::_internal::HttpClientMetrics const> m_metrics;
+
+    public:
+      /**
+       * @brief Constructs HTTP Request Metrics policy.
+       *
+       * @param metrics The instruments to record into.
+       */
+      explicit RequestMetricsPolicy(
+          std::shared_ptr<Azure::Core::Metrics::_internal::HttpClientMetrics const> metrics)
+          : m_metrics(std::move(metrics))
+      {
+      }
+
+      std::unique_ptr<HttpPolicy> Clone() const override
+      {
+        return std::make_unique<RequestMetricsPolicy>(*this);
+      }
+
+      std::unique_ptr<RawResponse> Send(
+          Request& request,
+          NextHttpPolicy nextPolicy,
+          Context const& context) const override;
+
+      void SendAsync(
+          Request& request,
+          NextHttpPolicy nextPolicy,
+          Context const& context,
+          SendCallback callback) const override;
     };
 
     /**
@@ -566,6 +809,12 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
           Request& request,
           NextHttpPolicy nextPolicy,
           Context const& context) const override;
+
+      void SendAsync(
+          Request& request,
+          NextHttpPolicy nextPolicy,
+          Context const& context,
+          SendCallback callback) const override;
     };
 
     /**
@@ -608,6 +857,18 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
           NextHttpPolicy nextPolicy,
           Context const& context) const override;
 
+      /**
+       * @brief Authorizes the request and sends it without waiting for the response.
+       *
+       * @remark The token is acquired on the calling thread, when it isn't cached. A class
+       * overriding #AuthorizeAndSendRequest sends the request with it, on the calling thread.
+       */
+      void SendAsync(
+          Request& request,
+          NextHttpPolicy nextPolicy,
+          Context const& context,
+          SendCallback callback) const override;
+
     protected:
       BearerTokenAuthenticationPolicy(BearerTokenAuthenticationPolicy const& other)
           : BearerTokenAuthenticationPolicy(other.m_credential, other.m_tokenRequestContext)
@@ -644,7 +905,8 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
      */
     class LogPolicy final : public HttpPolicy {
       LogOptions m_options;
-      Azure::Core::Http::_internal::HttpSanitizer m_httpSanitizer;
+      // Shared with the log records, which may be formatted after the policy is destroyed.
+      std::shared_ptr<Azure::Core::Http::_internal::HttpSanitizer const> m_httpSanitizer;
 
     public:
       /**
@@ -653,7 +915,9 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
        */
       explicit LogPolicy(LogOptions options)
           : m_options(std::move(options)),
-            m_httpSanitizer(m_options.AllowedHttpQueryParameters, m_options.AllowedHttpHeaders)
+            m_httpSanitizer(std::make_shared<Azure::Core::Http::_internal::HttpSanitizer>(
+                m_options.AllowedHttpQueryParameters,
+                m_options.AllowedHttpHeaders))
       {
       }
 
@@ -666,6 +930,12 @@ namespace Azure { namespace Core { namespace Http { namespace Policies {
           Request& request,
           NextHttpPolicy nextPolicy,
           Context const& context) const override;
+
+      void SendAsync(
+          Request& request,
+          NextHttpPolicy nextPolicy,
+          Context const& context,
+          SendCallback callback) const override;
     };
   } // namespace _internal
 }}}} // namespace Azure::Core::Http::Policies
@@ -17,11 +17,19 @@
 #include <vector>
 
 namespace Azure { namespace Core { namespace Http {
+  class ResponseBufferPool;
+
+  namespace Policies { namespace _internal {
+    class TransportPolicy;
+  }} // namespace Policies::_internal
+
   /**
    * @brief After receiving and interpreting a request message, a server responds with an HTTP
    * response message.
    */
   class RawResponse final {
+    // Sets a body borrowed from a ResponseBufferPool.
+    friend class Azure::Core::Http::Policies::_internal::TransportPolicy;
 
   private:
     int32_t m_majorVersion;
@@ -32,6 +40,8 @@ namespace Azure { namespace Core { namespace Http {
 
     std::unique_ptr<Azure::Core::IO::BodyStream> m_bodyStream;
     std::vector<uint8_t> m_body;
+    // The pool to give the body back to, if it was borrowed from one.
+    std::shared_ptr<ResponseBufferPool> m_bodyPool;
 
     explicit RawResponse(
         int32_t majorVersion,
@@ -104,8 +114,10 @@ namespace Azure { namespace Core { namespace Http {
     /**
      * @brief Destructs `%RawResponse`.
      *
+     * @remark A body borrowed from a #Azure::Core::Http::ResponseBufferPool is given back to it.
+     *
      */
-    ~RawResponse() = default;
+    ~RawResponse();
 
     // ===== Methods used to build HTTP response =====
 
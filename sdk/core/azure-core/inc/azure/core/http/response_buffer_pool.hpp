@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief A pool of buffers recycled between the bodies of HTTP responses.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace Azure { namespace Core { namespace Http {
+
+  /**
+   * @brief Options for a #Azure::Core::Http::ResponseBufferPool.
+   *
+   */
+  struct ResponseBufferPoolOptions final
+  {
+    /**
+     * @brief The maximum number of buffers kept by the pool when no response uses them.
+     *
+     */
+    size_t MaxBufferCount = 16;
+
+    /**
+     * @brief The maximum capacity, in bytes, of a buffer kept by the pool. Larger buffers are freed
+     * when their response is destroyed.
+     *
+     */
+    size_t MaxBufferSize = 4 * 1024 * 1024;
+  };
+
+  /**
+   * @brief A pool of buffers recycled between the bodies of HTTP responses.
+   *
+   * @details When a pool is set in #Azure::Core::Http::Policies::TransportOptions, the responses
+   * buffered by the pipeline borrow their body from the pool, and give it back when the
+   * #Azure::Core::Http::RawResponse is destroyed. A client receiving many similar responses, such
+   * as pages of a list operation, then reuses the same memory instead of allocating it for each
+   * response.
+   *
+   * @remark The pool can be shared by clients and used concurrently.
+   */
+  class ResponseBufferPool final {
+  public:
+    /**
+     * @brief Constructs a pool.
+     *
+     * @param options Options for the pool.
+     */
+    explicit ResponseBufferPool(ResponseBufferPoolOptions const& options = {})
+        : m_options(options)
+    {
+    }
+
+    /**
+     * @brief Takes an empty buffer out of the pool, or creates one when the pool is empty.
+     *
+     * @param sizeHint The expected size of the content, 0 when unknown.
+     * @return An empty buffer.
+     */
+    std::vector<uint8_t> Acquire(size_t sizeHint);
+
+    /**
+     * @brief Gives a buffer back to the pool.
+     *
+     * @remark The buffer is freed when it is larger than
+     * #Azure::Core::Http::ResponseBufferPoolOptions::MaxBufferSize or when the pool is full.
+     *
+     * @param buffer The buffer.
+     */
+    void Release(std::vector<uint8_t> buffer);
+
+  private:
+    ResponseBufferPoolOptions m_options;
+    std::mutex m_mutex;
+    std::vector<std::vector<uint8_t>> m_buffers;
+  };
+
+}}} // namespace Azure::Core::Http
@@ -12,10 +12,22 @@
 #include "azure/core/http/http.hpp"
 #include "azure/core/http/raw_response.hpp"
 
+#include <exception>
+#include <functional>
 #include <memory>
+#include <utility>
 
 namespace Azure { namespace Core { namespace Http {
 
+  /**
+   * @brief Receives the outcome of a request sent asynchronously.
+   *
+   * @details Either \p response is the response to the request, or \p error is the exception
+   * which sending the request would have thrown.
+   */
+  using SendCallback
+      = std::function<void(std::unique_ptr<RawResponse> response, std::exception_ptr error)>;
+
   /**
    * @brief Base class for all HTTP transport implementations.
    */
@@ -34,6 +46,37 @@ namespace Azure { namespace Core { namespace Http {
     // TODO - Should this be const
     virtual std::unique_ptr<RawResponse> Send(Request& request, Context const& context) = 0;
 
+    /**
+     * @brief Send an HTTP request over the wire without waiting for its response.
+     *
+     * @details \p callback is called exactly once, when the headers of the response are received
+     * or when the request fails. It may be called before this function returns, and may be called
+     * from a thread of the transport, which it must not block for long.
+     *
+     * The default implementation calls #Send and then \p callback, on the calling thread.
+     *
+     * @remark \p request must be kept alive until \p callback is called. An implementation which
+     * uses \p context after returning keeps a copy of it.
+     *
+     * @param request An #Azure::Core::Http::Request to send.
+     * @param context A context to control the request lifetime.
+     * @param callback Receives the response, or the error.
+     */
+    virtual void SendAsync(Request& request, Context const& context, SendCallback callback)
+    {
+      std::unique_ptr<RawResponse> response;
+      try
+      {
+        response = Send(request, context);
+      }
+      catch (...)
+      {
+        callback(nullptr, std::current_exception());
+        return;
+      }
+      callback(std::move(response), nullptr);
+    }
+
     /**
      * @brief Destructs `%HttpTransport`.
      *
@@ -68,6 +68,7 @@ namespace Azure { namespace Core { namespace _internal {
     ClientOptions& operator=(const ClientOptions& other)
     {
       this->Retry = other.Retry;
+      this->Hedging = other.Hedging;
       this->Transport = other.Transport;
       this->Telemetry = other.Telemetry;
       this->Log = other.Log;
@@ -90,6 +91,12 @@ namespace Azure { namespace Core { namespace _internal {
      */
     Azure::Core::Http::Policies::RetryOptions Retry;
 
+    /**
+     * @brief Specify whether and how idempotent requests are hedged.
+     *
+     */
+    Azure::Core::Http::Policies::HedgingOptions Hedging;
+
     /**
      * @brief Customized HTTP client. We're going to use the default one if this is empty.
      *
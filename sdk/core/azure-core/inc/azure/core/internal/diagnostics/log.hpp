@@ -8,12 +8,32 @@
 
 #include <atomic>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <sstream>
 #include <type_traits>
 
 namespace Azure { namespace Core { namespace Diagnostics { namespace _internal {
 
+  /** @brief A log message which is formatted only when it is delivered to the listener.
+   *
+   * Components which log large messages, such as the HTTP requests and responses, write a record
+   * holding the values of the message rather than the message itself. When the listener is
+   * asynchronous, the record is formatted on the background thread, so it must own the values
+   * it formats.
+   */
+  class LogRecord {
+  public:
+    /** @brief Destroys the record. */
+    virtual ~LogRecord() = default;
+
+    /** @brief Formats the log message.
+     *
+     * @returns The log message, nothing is logged when it is empty.
+     */
+    virtual std::string Format() const = 0;
+  };
+
   /** @brief Internal Log class used for generating diagnostic logs.
    *
    * When components within the Azure SDK wish to emit diagnostic log messages, they should use the
@@ -148,6 +168,17 @@ namespace Azure { namespace Core { namespace Diagnostics { namespace _internal {
      */
     static void Write(Logger::Level level, std::string const& message);
 
+    /** @brief Write a record to the configured logger at the specified log level.
+     *
+     * The record is formatted on the calling thread when the listener is synchronous, and on the
+     * thread of the listener when it is asynchronous.
+     *
+     * @param level - log level to use for the message.
+     * @param record - record of the message to write to the logger.
+     *
+     */
+    static void Write(Logger::Level level, std::unique_ptr<LogRecord> record);
+
     /** @brief Enable logging.
      *
      * @param isEnabled - true if logging should be enabled, false if it should be disabled.
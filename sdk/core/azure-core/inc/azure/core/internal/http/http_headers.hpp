@@ -0,0 +1,123 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief A flat store of HTTP headers with case-insensitive names.
+ */
+
+#pragma once
+
+#include "azure/core/case_insensitive_containers.hpp"
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Azure { namespace Core { namespace Http { namespace _internal {
+
+  /**
+   * @brief A flat store of HTTP headers with case-insensitive names.
+   *
+   * @details The headers are kept in insertion order in a vector, and the case-insensitive hashes
+   * of their names in a parallel vector. A lookup scans the hashes, which fit in a few cache lines
+   * for the usual dozen headers, and only compares the names whose hash matches. Unlike a
+   * `CaseInsensitiveMap`, adding a header doesn't allocate a node.
+   */
+  class HttpHeaders final {
+  public:
+    /// Iterator over the name and value of the headers, in insertion order.
+    using const_iterator = std::vector<std::pair<std::string, std::string>>::const_iterator;
+
+    /**
+     * @brief Computes the case-insensitive hash of a header name.
+     *
+     * @param name The header name.
+     * @return The FNV-1a hash of \p name in lowercase.
+     */
+    static size_t Hash(std::string const& name) noexcept;
+
+    /**
+     * @brief Sets a header, replacing the value of a header with the same name.
+     *
+     * @remark The name of a new header is stored in lowercase.
+     *
+     * @param name The header name.
+     * @param value The header value.
+     */
+    void Set(std::string const& name, std::string const& value);
+
+    /**
+     * @brief Finds the value of a header.
+     *
+     * @param name The header name.
+     * @return A pointer to the value, valid until the headers are modified, or `nullptr` when there
+     * is no such header.
+     */
+    std::string const* Find(std::string const& name) const
+    {
+      return Find(name, Hash(name));
+    }
+
+    /**
+     * @brief Finds the value of a header from the hash of its name.
+     *
+     * @param name The header name.
+     * @param hash The hash of \p name.
+     * @return A pointer to the value, valid until the headers are modified, or `nullptr` when there
+     * is no such header.
+     */
+    std::string const* Find(std::string const& name, size_t hash) const;
+
+    /**
+     * @brief Removes a header.
+     *
+     * @param name The header name.
+     */
+    void Erase(std::string const& name);
+
+    /**
+     * @brief Removes all the headers, keeping the storage for the next ones.
+     */
+    void Clear() noexcept
+    {
+      m_headers.clear();
+      m_hashes.clear();
+    }
+
+    /**
+     * @brief Returns whether there is no header.
+     */
+    bool IsEmpty() const noexcept { return m_headers.empty(); }
+
+    /**
+     * @brief Returns the number of headers.
+     */
+    size_t Size() const noexcept { return m_headers.size(); }
+
+    /**
+     * @brief Returns an iterator to the first header.
+     */
+    const_iterator begin() const noexcept { return m_headers.begin(); }
+
+    /**
+     * @brief Returns an iterator past the last header.
+     */
+    const_iterator end() const noexcept { return m_headers.end(); }
+
+    /**
+     * @brief Copies the headers to a map, for the callers which need them sorted.
+     *
+     * @remark Headers already in \p headers are not replaced.
+     */
+    void CopyTo(Azure::Core::CaseInsensitiveMap& headers) const;
+
+  private:
+    std::vector<std::pair<std::string, std::string>> m_headers;
+    std::vector<size_t> m_hashes;
+
+    size_t IndexOf(std::string const& name, size_t hash) const noexcept;
+  };
+
+}}}} // namespace Azure::Core::Http::_internal
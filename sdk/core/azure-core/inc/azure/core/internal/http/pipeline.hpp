@@ -15,8 +15,10 @@
 #include "azure/core/http/transport.hpp"
 #include "azure/core/internal/client_options.hpp"
 #include "azure/core/internal/http/http_sanitizer.hpp"
+#include "azure/core/internal/metrics/service_metrics.hpp"
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace Azure { namespace Core { namespace Http { namespace _internal {
@@ -33,6 +35,8 @@ namespace Azure { namespace Core { namespace Http { namespace _internal {
   class HttpPipeline final {
   protected:
     std::vector<std::unique_ptr<Azure::Core::Http::Policies::HttpPolicy>> m_policies;
+    // Added to the context of each request, when the client records metrics.
+    std::shared_ptr<Azure::Core::Metrics::_internal::HttpClientMetrics const> m_metrics;
 
   public:
     /**
@@ -87,15 +91,23 @@ namespace Azure { namespace Core { namespace Http { namespace _internal {
 
       auto const& perCallClientPolicies = clientOptions.PerOperationPolicies;
       auto const& perRetryClientPolicies = clientOptions.PerRetryPolicies;
-      // Adding 5/6 for:
+      // Adding 5/6/7/8 for:
       // - TelemetryPolicy (if required)
       // - RequestIdPolicy
       // - RetryPolicy
+      // - HedgingPolicy (if enabled)
       // - LogPolicy
       // - RequestActivityPolicy
+      // - RequestMetricsPolicy (if a MeterProvider is set)
       // - TransportPolicy
       auto pipelineSize = perCallClientPolicies.size() + perRetryClientPolicies.size()
-          + perRetryPolicies.size() + perCallPolicies.size() + 6;
+          + perRetryPolicies.size() + perCallPolicies.size() + 8;
+
+      if (clientOptions.Telemetry.MeterProvider)
+      {
+        m_metrics = std::make_shared<Azure::Core::Metrics::_internal::HttpClientMetrics>(
+            clientOptions.Telemetry.MeterProvider, telemetryPackageName, telemetryPackageVersion);
+      }
 
       m_policies.reserve(pipelineSize);
 
@@ -124,6 +136,14 @@ namespace Azure { namespace Core { namespace Http { namespace _internal {
       m_policies.emplace_back(std::make_unique<Azure::Core::Http::Policies::_internal::RetryPolicy>(
           clientOptions.Retry));
 
+      // Hedging policy, so that each try is hedged independently.
+      if (clientOptions.Hedging.Enabled)
+      {
+        m_policies.emplace_back(
+            std::make_unique<Azure::Core::Http::Policies::_internal::HedgingPolicy>(
+                clientOptions.Hedging));
+      }
+
       // service-specific per retry policies.
       for (auto& policy : perRetryPolicies)
       {
@@ -140,6 +160,14 @@ namespace Azure { namespace Core { namespace Http { namespace _internal {
           std::make_unique<Azure::Core::Http::Policies::_internal::RequestActivityPolicy>(
               httpSanitizer));
 
+      // Add a request metrics policy which will record the duration of each try.
+      if (m_metrics)
+      {
+        m_policies.emplace_back(
+            std::make_unique<Azure::Core::Http::Policies::_internal::RequestMetricsPolicy>(
+                m_metrics));
+      }
+
       // logging - won't update request
       m_policies.emplace_back(
           std::make_unique<Azure::Core::Http::Policies::_internal::LogPolicy>(clientOptions.Log));
@@ -204,7 +232,7 @@ namespace Azure { namespace Core { namespace Http { namespace _internal {
      * @param other Another instance of #Azure::Core::Http::_internal::HttpPipeline to create a copy
      * of.
      */
-    HttpPipeline(const HttpPipeline& other)
+    HttpPipeline(const HttpPipeline& other) : m_metrics(other.m_metrics)
     {
       m_policies.reserve(other.m_policies.size());
       for (auto& policy : other.m_policies)
@@ -227,8 +255,53 @@ namespace Azure { namespace Core { namespace Http { namespace _internal {
     {
       // Accessing position zero is fine because pipeline must be constructed with at least one
       // policy.
+      if (m_metrics)
+      {
+        return m_policies[0]->Send(
+            request,
+            Azure::Core::Http::Policies::NextHttpPolicy(0, m_policies),
+            m_metrics->ApplyToContext(context));
+      }
       return m_policies[0]->Send(
           request, Azure::Core::Http::Policies::NextHttpPolicy(0, m_policies), context);
     }
+
+    /**
+     * @brief Start the HTTP pipeline without waiting for the response.
+     *
+     * @details \p callback is called exactly once, with the response after the request has been
+     * processed, or with the exception which #Send would have thrown. It may be called before this
+     * function returns, or from a background thread.
+     *
+     * The policies which don't support it send the request synchronously, on the calling thread.
+     *
+     * @remark The pipeline and \p request must be kept alive until \p callback is called.
+     *
+     * @param request The HTTP request to be processed.
+     * @param context A context to control the request lifetime.
+     * @param callback Receives the response, or the error.
+     */
+    void SendAsync(
+        Azure::Core::Http::Request& request,
+        Context const& context,
+        Azure::Core::Http::SendCallback callback) const
+    {
+      // Accessing position zero is fine because pipeline must be constructed with at least one
+      // policy.
+      if (m_metrics)
+      {
+        m_policies[0]->SendAsync(
+            request,
+            Azure::Core::Http::Policies::NextHttpPolicy(0, m_policies),
+            m_metrics->ApplyToContext(context),
+            std::move(callback));
+        return;
+      }
+      m_policies[0]->SendAsync(
+          request,
+          Azure::Core::Http::Policies::NextHttpPolicy(0, m_policies),
+          context,
+          std::move(callback));
+    }
   };
 }}}} // namespace Azure::Core::Http::_internal
@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Internal metrics types used to record measurements from Azure SDK clients.
+ */
+
+#pragma once
+
+#include "azure/core/metrics/metrics.hpp"
+
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string>
+
+namespace Azure { namespace Core { namespace Metrics { namespace _internal {
+
+  /**
+   * @brief An attribute of a measurement.
+   *
+   * @remark The attributes are only valid during the call recording the measurement, an
+   * implementation needing them afterwards must copy them.
+   */
+  struct MetricAttribute final
+  {
+    /**
+     * @brief Name of the attribute, a string literal.
+     */
+    const char* Name;
+
+    /**
+     * @brief Value of the attribute.
+     */
+    std::string Value;
+  };
+
+  /**
+   * @brief The attributes of a measurement.
+   */
+  using MetricAttributes = std::initializer_list<MetricAttribute>;
+
+  /**
+   * @brief A monotonic counter, e.g. of the retried requests.
+   *
+   * @remark Counters are created once and shared by the threads recording into them, an
+   * implementation must be thread safe and should not block.
+   */
+  class Counter {
+  public:
+    /**
+     * @brief Adds a value to the counter.
+     *
+     * @param value The value to add.
+     * @param attributes The attributes of the measurement.
+     */
+    virtual void Add(uint64_t value, MetricAttributes attributes) = 0;
+
+    virtual ~Counter() = default;
+  };
+
+  /**
+   * @brief A histogram, e.g. of the duration of requests.
+   *
+   * @remark Histograms are created once and shared by the threads recording into them, an
+   * implementation must be thread safe and should not block.
+   */
+  class Histogram {
+  public:
+    /**
+     * @brief Records a value in the histogram.
+     *
+     * @param value The value to record.
+     * @param attributes The attributes of the measurement.
+     */
+    virtual void Record(double value, MetricAttributes attributes) = 0;
+
+    virtual ~Histogram() = default;
+  };
+
+  /**
+   * @brief Meter - factory for creating instruments.
+   */
+  class Meter {
+  public:
+    /**
+     * @brief Creates a counter.
+     *
+     * @param name Name of the counter, e.g. "azure.core.http.client.retries".
+     * @param description Description of the counter.
+     * @param unit Unit of the counted values, following UCUM, e.g. "{retry}".
+     */
+    virtual std::shared_ptr<Counter> CreateCounter(
+        std::string const& name,
+        std::string const& description,
+        std::string const& unit) const = 0;
+
+    /**
+     * @brief Creates a histogram.
+     *
+     * @param name Name of the histogram, e.g. "http.client.request.duration".
+     * @param description Description of the histogram.
+     * @param unit Unit of the recorded values, following UCUM, e.g. "s".
+     */
+    virtual std::shared_ptr<Histogram> CreateHistogram(
+        std::string const& name,
+        std::string const& description,
+        std::string const& unit) const = 0;
+
+    virtual ~Meter() = default;
+  };
+
+}}}} // namespace Azure::Core::Metrics::_internal
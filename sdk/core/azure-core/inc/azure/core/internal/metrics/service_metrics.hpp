@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief The instruments recording the metrics of the HTTP pipeline of a service client.
+ */
+
+#pragma once
+
+#include "azure/core/context.hpp"
+#include "azure/core/internal/metrics/metrics_impl.hpp"
+#include "azure/core/metrics/metrics.hpp"
+
+#include <memory>
+#include <string>
+
+namespace Azure { namespace Core { namespace Metrics { namespace _internal {
+
+  /**
+   * @brief The instruments of the HTTP pipeline of a service client.
+   *
+   * @details The instruments are created once per pipeline. The pipeline adds them to the context
+   * of each request so that the policies and the transport adapters can record into them, nothing
+   * is recorded when no MeterProvider is configured.
+   */
+  class HttpClientMetrics final {
+  public:
+    /// Attribute for the HTTP method of a request.
+    constexpr static const char* HttpRequestMethod = "http.request.method";
+    /// Attribute for the status code of a response.
+    constexpr static const char* HttpResponseStatusCode = "http.response.status_code";
+    /// Attribute for the host of the service.
+    constexpr static const char* ServerAddress = "server.address";
+    /// Attribute for the type of the error which failed a request.
+    constexpr static const char* ErrorType = "error.type";
+    /// Attribute telling whether a TLS handshake resumed a previous session.
+    constexpr static const char* TlsResumed = "tls.resumed";
+
+    /**
+     * @brief Creates the instruments from a meter provider.
+     *
+     * @param meterProvider The meter provider, must not be null.
+     * @param packageName Name of the package of the service client, e.g. "storage-blobs".
+     * @param packageVersion Version of the package of the service client.
+     */
+    explicit HttpClientMetrics(
+        std::shared_ptr<Azure::Core::Metrics::MeterProvider> const& meterProvider,
+        std::string const& packageName,
+        std::string const& packageVersion);
+
+    /**
+     * @brief Returns a new context with the instruments.
+     *
+     * @remark The instruments must outlive the returned context.
+     */
+    Azure::Core::Context ApplyToContext(Azure::Core::Context const& context) const;
+
+    /**
+     * @brief Returns the instruments of a context, or `nullptr` when the pipeline doesn't record
+     * metrics.
+     */
+    static HttpClientMetrics const* CreateFromContext(Azure::Core::Context const& context);
+
+    /// Duration of each try of a request, until the headers of the response are received.
+    std::shared_ptr<Histogram> RequestDuration;
+    /// Size of the body of each try of a request.
+    std::shared_ptr<Histogram> RequestBodySize;
+    /// Size of the body of each response, from its Content-Length.
+    std::shared_ptr<Histogram> ResponseBodySize;
+    /// Number of tries retried by the RetryPolicy.
+    std::shared_ptr<Counter> Retries;
+    /// Number of connections taken from a connection pool of a transport adapter.
+    std::shared_ptr<Counter> PooledConnectionsReused;
+    /// Number of connections opened by a transport adapter because none was pooled.
+    std::shared_ptr<Counter> ConnectionsCreated;
+    /// Number of TLS handshakes of the connections opened by a transport adapter.
+    std::shared_ptr<Counter> TlsHandshakes;
+
+  private:
+    static Azure::Core::Context::Key ContextKey;
+  };
+
+}}}} // namespace Azure::Core::Metrics::_internal
@@ -161,6 +161,12 @@ namespace Azure { namespace Core { namespace Tracing { namespace _internal {
         m_span->PropagateToHttpHeaders(request);
       }
     }
+
+    /**
+     * @brief Returns whether the span records the attributes and events added to it, false when
+     * there is no span or it isn't sampled.
+     */
+    bool IsRecording() const override { return m_span && m_span->IsRecording(); }
   };
 
   /**
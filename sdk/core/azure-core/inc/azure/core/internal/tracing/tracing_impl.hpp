@@ -232,6 +232,15 @@ namespace Azure { namespace Core { namespace Tracing { namespace _internal {
      */
     virtual void PropagateToHttpHeaders(Azure::Core::Http::Request& request) = 0;
 
+    /**
+     * @brief Returns whether the span records the attributes and events added to it.
+     *
+     * @remark A span which isn't sampled doesn't record anything, so callers can skip computing
+     * its attributes. The sampling decision is made when the span is created, the attributes
+     * which are expensive to compute should be added once the span is known to be recording.
+     */
+    virtual bool IsRecording() const { return true; }
+
     virtual ~Span() = default;
   };
 
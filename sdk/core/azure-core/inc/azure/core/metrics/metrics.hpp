@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Public MeterProvider type used to represent a meter provider.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+namespace Azure { namespace Core { namespace Metrics {
+  class MeterProvider;
+  namespace _internal {
+    class Meter;
+    /**
+     * @brief Meter Provider - factory for creating Meter objects.
+     */
+    class MeterProviderImpl {
+    public:
+      /**
+       * @brief Create a Meter object
+       *
+       * @param name Name of the meter object, typically the name of the Service client
+       * (Azure.Storage.Blobs, for example)
+       * @param version Optional version of the service client.
+       * @return std::shared_ptr<Azure::Core::Metrics::_internal::Meter>
+       */
+      virtual std::shared_ptr<Azure::Core::Metrics::_internal::Meter> CreateMeter(
+          std::string const& name,
+          std::string const& version = {}) const = 0;
+
+      virtual ~MeterProviderImpl() = default;
+    };
+
+    struct MeterProviderImplGetter
+    {
+      /**
+       * @brief Returns a MeterProviderImpl from a MeterProvider object.
+       *
+       * @param provider The MeterProvider object.
+       * @returns A MeterProviderImpl implementation.
+       */
+      static std::shared_ptr<MeterProviderImpl> MeterImplFromMeter(
+          std::shared_ptr<MeterProvider> const& provider);
+    };
+
+  } // namespace _internal
+
+  /**
+   * @brief Meter Provider - factory for creating Meter objects.
+   */
+  class MeterProvider : private _internal::MeterProviderImpl {
+    // Marked MeterImplFromMeter as friend so it can access private members in the class.
+    friend std::shared_ptr<MeterProviderImpl>
+    _internal::MeterProviderImplGetter::MeterImplFromMeter(std::shared_ptr<MeterProvider> const&);
+  };
+
+}}} // namespace Azure::Core::Metrics
@@ -0,0 +1,220 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "private/async_log_sink.hpp"
+
+#include <cstddef>
+#include <utility>
+
+using Azure::Core::Diagnostics::Logger;
+using Azure::Core::Diagnostics::_detail::AsyncLogSink;
+using Azure::Core::Diagnostics::_internal::Log;
+using Azure::Core::Diagnostics::_internal::LogRecord;
+
+AsyncLogSink::AsyncLogSink(Listener listener, size_t capacity) : m_listener(std::move(listener))
+{
+  size_t size = 2;
+  while (size < capacity)
+  {
+    size *= 2;
+  }
+
+  m_entries.reset(new Entry[size]);
+  m_mask = size - 1;
+  for (size_t i = 0; i < size; ++i)
+  {
+    m_entries[i].Sequence.store(i, std::memory_order_relaxed);
+  }
+
+  m_thread = std::thread([this]() { Drain(); });
+}
+
+AsyncLogSink::~AsyncLogSink()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wakeUp.notify_one();
+  m_thread.join();
+}
+
+AsyncLogSink::Entry* AsyncLogSink::TryClaim(size_t& position)
+{
+  position = m_enqueuePosition.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    Entry& entry = m_entries[position & m_mask];
+    auto const sequence = entry.Sequence.load(std::memory_order_acquire);
+    auto const difference
+        = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+    if (difference == 0)
+    {
+      if (m_enqueuePosition.compare_exchange_weak(
+              position, position + 1, std::memory_order_relaxed))
+      {
+        return &entry;
+      }
+    }
+    else if (difference < 0)
+    {
+      // The consumer hasn't freed the entry written a lap ago: the queue is full. The level is
+      // checked here since logging may be disabled by the time the warning is delivered.
+      if (Log::ShouldWrite(Logger::Level::Warning))
+      {
+        m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+      }
+      return nullptr;
+    }
+    else
+    {
+      position = m_enqueuePosition.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void AsyncLogSink::Publish(Entry& entry, size_t position)
+{
+  entry.Sequence.store(position + 1, std::memory_order_release);
+
+  // Pairs with the fence of Drain(): either the background thread sees the entry before going to
+  // sleep, or this thread sees it sleeping and wakes it up.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (m_isSleeping.load(std::memory_order_relaxed))
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+    }
+    m_wakeUp.notify_one();
+  }
+}
+
+void AsyncLogSink::Write(Logger::Level level, std::string const& message)
+{
+  size_t position;
+  if (auto const entry = TryClaim(position))
+  {
+    entry->Level = level;
+    entry->Message = message;
+    Publish(*entry, position);
+  }
+}
+
+void AsyncLogSink::Write(Logger::Level level, std::unique_ptr<LogRecord> record)
+{
+  size_t position;
+  if (auto const entry = TryClaim(position))
+  {
+    entry->Level = level;
+    entry->Record = std::move(record);
+    Publish(*entry, position);
+  }
+}
+
+void AsyncLogSink::Flush()
+{
+  auto const target = m_enqueuePosition.load();
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  ++m_flushWaiters;
+  m_flushed.wait(lock, [&]() { return m_dequeuePosition.load() >= target; });
+  --m_flushWaiters;
+}
+
+bool AsyncLogSink::HasEntry() const
+{
+  auto const position = m_dequeuePosition.load(std::memory_order_relaxed);
+  return m_entries[position & m_mask].Sequence.load(std::memory_order_acquire) == position + 1;
+}
+
+bool AsyncLogSink::TryDeliver()
+{
+  auto const position = m_dequeuePosition.load(std::memory_order_relaxed);
+  Entry& entry = m_entries[position & m_mask];
+  if (entry.Sequence.load(std::memory_order_acquire) != position + 1)
+  {
+    return false;
+  }
+
+  auto const level = entry.Level;
+  auto message = std::move(entry.Message);
+  auto record = std::move(entry.Record);
+  entry.Message.clear();
+  entry.Sequence.store(position + m_mask + 1, std::memory_order_release);
+
+  Deliver(level, message, record.get());
+
+  m_dequeuePosition.store(position + 1);
+  if (m_flushWaiters.load() != 0)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+    }
+    m_flushed.notify_all();
+  }
+  return true;
+}
+
+void AsyncLogSink::ReportDropped()
+{
+  auto const droppedCount = m_droppedCount.exchange(0, std::memory_order_relaxed);
+  if (droppedCount != 0)
+  {
+    Deliver(
+        Logger::Level::Warning,
+        "Dropped " + std::to_string(droppedCount)
+            + " log messages because the queue of the asynchronous log listener was full.",
+        nullptr);
+  }
+}
+
+void AsyncLogSink::Deliver(
+    Logger::Level level,
+    std::string const& message,
+    LogRecord const* record)
+{
+  try
+  {
+    if (record != nullptr)
+    {
+      auto const formattedMessage = record->Format();
+      if (!formattedMessage.empty())
+      {
+        m_listener(level, formattedMessage);
+      }
+    }
+    else if (!message.empty())
+    {
+      m_listener(level, message);
+    }
+  }
+  catch (...)
+  {
+    // There is no caller to report the failure to, and logging must not stop the application.
+  }
+}
+
+void AsyncLogSink::Drain()
+{
+  for (;;)
+  {
+    while (TryDeliver())
+    {
+    }
+    ReportDropped();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_isSleeping.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    m_wakeUp.wait(lock, [this]() { return m_stop || HasEntry(); });
+    m_isSleeping.store(false, std::memory_order_relaxed);
+
+    if (m_stop && !HasEntry())
+    {
+      // The messages dropped since the last report.
+      lock.unlock();
+      ReportDropped();
+      return;
+    }
+  }
+}
@@ -3,498 +3,495 @@
 
 #include "azure/core/base64.hpp"
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define _azure_BASE64_AVX2
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define _azure_BASE64_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(_azure_BASE64_AVX2) && (defined(__GNUC__) || defined(__clang__))
+// Compiles a function with AVX2 instructions, which it only uses once the CPU is known to support
+// them, without requiring them from the rest of the library.
+#define _azure_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define _azure_TARGET_AVX2
+#endif
+
 namespace {
 
-char const Base64EncodeArray[65]
-    = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 char const EncodingPad = '=';
-int8_t const Base64DecodeArray[256] = {
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    62,
-    -1,
-    -1,
-    -1,
-    63, // 62 is placed at index 43 (for +), 63 at index 47 (for /)
-    52,
-    53,
-    54,
-    55,
-    56,
-    57,
-    58,
-    59,
-    60,
-    61,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1, // 52-61 are placed at index 48-57 (for 0-9), 64 at index 61 (for =)
-    -1,
-    0,
-    1,
-    2,
-    3,
-    4,
-    5,
-    6,
-    7,
-    8,
-    9,
-    10,
-    11,
-    12,
-    13,
-    14,
-    15,
-    16,
-    17,
-    18,
-    19,
-    20,
-    21,
-    22,
-    23,
-    24,
-    25,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1, // 0-25 are placed at index 65-90 (for A-Z)
-    -1,
-    26,
-    27,
-    28,
-    29,
-    30,
-    31,
-    32,
-    33,
-    34,
-    35,
-    36,
-    37,
-    38,
-    39,
-    40,
-    41,
-    42,
-    43,
-    44,
-    45,
-    46,
-    47,
-    48,
-    49,
-    50,
-    51,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1, // 26-51 are placed at index 97-122 (for a-z)
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1, // Bytes over 122 ('z') are invalid and cannot be decoded. Hence, padding the map with -1,
-        // which indicates invalid input
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-    -1,
-};
 
-int32_t Base64Encode(const uint8_t* threeBytes)
+// The 64 characters of an encoding, and the value of each character when decoding.
+struct Base64Alphabet final
 {
-  int32_t i = (threeBytes[0] << 16) | (threeBytes[1] << 8) | threeBytes[2];
+  char Characters[64]{};
+  // Characters also decoded as 62 and 63, so that the URL-safe decoding accepts the standard
+  // alphabet as well.
+  char Alternatives[2]{};
+  // -1 for the characters which are not part of the alphabet.
+  int8_t Values[256]{};
+
+  constexpr Base64Alphabet(char const (&characters)[65], char alternative62, char alternative63)
+  {
+    for (int i = 0; i < 256; ++i)
+    {
+      Values[i] = -1;
+    }
+    for (int i = 0; i < 64; ++i)
+    {
+      Characters[i] = characters[i];
+      Values[static_cast<uint8_t>(characters[i])] = static_cast<int8_t>(i);
+    }
+    Alternatives[0] = alternative62;
+    Alternatives[1] = alternative63;
+    Values[static_cast<uint8_t>(alternative62)] = 62;
+    Values[static_cast<uint8_t>(alternative63)] = 63;
+  }
+};
 
-  int32_t i0 = Base64EncodeArray[i >> 18];
-  int32_t i1 = Base64EncodeArray[(i >> 12) & 0x3F];
-  int32_t i2 = Base64EncodeArray[(i >> 6) & 0x3F];
-  int32_t i3 = Base64EncodeArray[i & 0x3F];
+constexpr Base64Alphabet Base64Standard(
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/",
+    '+',
+    '/');
+constexpr Base64Alphabet Base64UrlSafe(
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_",
+    '+',
+    '/');
 
-  return i0 | (i1 << 8) | (i2 << 16) | (i3 << 24);
-}
+std::atomic<bool> VectorizationEnabled(true);
 
-int32_t Base64EncodeAndPadOne(const uint8_t* twoBytes)
+bool DetectVectorization()
 {
-  int32_t i = twoBytes[0] << 16 | (twoBytes[1] << 8);
-
-  int32_t i0 = Base64EncodeArray[i >> 18];
-  int32_t i1 = Base64EncodeArray[(i >> 12) & 0x3F];
-  int32_t i2 = Base64EncodeArray[(i >> 6) & 0x3F];
-
-  return i0 | (i1 << 8) | (i2 << 16) | (EncodingPad << 24);
+#if defined(_azure_BASE64_AVX2) && defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7)
+  {
+    return false;
+  }
+  // The CPU must support AVX, and the OS must save the AVX registers.
+  __cpuid(info, 1);
+  bool const osxsave = (info[2] & (1 << 27)) != 0;
+  bool const avx = (info[2] & (1 << 28)) != 0;
+  if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+  {
+    return false;
+  }
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#elif defined(_azure_BASE64_AVX2)
+  return __builtin_cpu_supports("avx2") != 0;
+#elif defined(_azure_BASE64_NEON)
+  // NEON is part of the base instruction set of AArch64.
+  return true;
+#else
+  return false;
+#endif
 }
 
-int32_t Base64EncodeAndPadTwo(const uint8_t* oneByte)
+bool IsVectorizationSupported()
 {
-  int32_t i = oneByte[0] << 8;
-
-  int32_t i0 = Base64EncodeArray[i >> 10];
-  int32_t i1 = Base64EncodeArray[(i >> 4) & 0x3F];
-
-  return i0 | (i1 << 8) | (EncodingPad << 16) | (EncodingPad << 24);
+  static bool const supported = DetectVectorization();
+  return supported;
 }
 
-void Base64WriteIntAsFourBytes(char* destination, int32_t value)
+bool UseVectorization()
 {
-  destination[3] = static_cast<uint8_t>((value >> 24) & 0xFF);
-  destination[2] = static_cast<uint8_t>((value >> 16) & 0xFF);
-  destination[1] = static_cast<uint8_t>((value >> 8) & 0xFF);
-  destination[0] = static_cast<uint8_t>(value & 0xFF);
+  return VectorizationEnabled.load(std::memory_order_relaxed) && IsVectorizationSupported();
 }
 
-std::string Base64Encode(uint8_t const* const data, size_t length)
+#if defined(_azure_BASE64_AVX2)
+// Encodes 24 bytes at a time with the algorithm of Wojciech Mula and Daniel Lemire, and returns the
+// number of bytes encoded, a multiple of 3.
+_azure_TARGET_AVX2 size_t EncodeVectorized(
+    uint8_t const* data,
+    size_t length,
+    char* destination,
+    Base64Alphabet const& alphabet)
 {
-  size_t sourceIndex = 0;
-  auto inputSize = length;
-  auto maxEncodedSize = ((inputSize + 2) / 3) * 4;
-  // Use a string with size to the max possible result
-  std::string encodedResult(maxEncodedSize, '0');
-  // Removing const from the string to update the placeholder string
-  auto destination = const_cast<char*>(encodedResult.data());
-
-  while (sourceIndex + 3 <= inputSize)
+  char const offset62 = static_cast<char>(alphabet.Characters[62] - 62);
+  char const offset63 = static_cast<char>(alphabet.Characters[63] - 63);
+  // clang-format off
+  // Spreads each group of 3 bytes of a lane over 4 bytes, in an order from which the
+  // multiplications below move each 6-bit index to its own byte.
+  __m256i const spread = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+      1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+  // Added to an index to get its character, looked up by the range of the index: 0 for [26, 51],
+  // 1 to 10 for [52, 61], 11 for 62, 12 for 63 and 13 for [0, 25].
+  __m256i const offsets = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, offset62, offset63, 'A', 0, 0));
+  // clang-format on
+
+  size_t encoded = 0;
+  // Each lane is loaded with 16 bytes, of which 12 are encoded.
+  for (; encoded + 28 <= length; encoded += 24)
   {
-    int32_t result = Base64Encode(&data[sourceIndex]);
-    Base64WriteIntAsFourBytes(destination, result);
-    destination += 4;
-    sourceIndex += 3;
+    __m256i input = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + encoded))),
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + encoded + 12)),
+        1);
+    input = _mm256_shuffle_epi8(input, spread);
+
+    __m256i const high = _mm256_mulhi_epu16(
+        _mm256_and_si256(input, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+    __m256i const low = _mm256_mullo_epi16(
+        _mm256_and_si256(input, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+    __m256i const indices = _mm256_or_si256(high, low);
+
+    __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    range = _mm256_or_si256(
+        range,
+        _mm256_and_si256(
+            _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices), _mm256_set1_epi8(13)));
+    __m256i const characters = _mm256_add_epi8(indices, _mm256_shuffle_epi8(offsets, range));
+
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(destination + (encoded / 3) * 4), characters);
   }
-
-  if (sourceIndex + 1 == inputSize)
-  {
-    int32_t result = Base64EncodeAndPadTwo(&data[sourceIndex]);
-    Base64WriteIntAsFourBytes(destination, result);
-  }
-  else if (sourceIndex + 2 == inputSize)
-  {
-    int32_t result = Base64EncodeAndPadOne(&data[sourceIndex]);
-    Base64WriteIntAsFourBytes(destination, result);
-  }
-
-  return encodedResult;
+  return encoded;
 }
 
-int32_t Base64Decode(const char* encodedBytes)
+// Decodes 32 characters at a time, and returns the number of characters decoded, a multiple of 4.
+// It stops before the first block holding a character which is not part of the alphabet.
+_azure_TARGET_AVX2 size_t DecodeVectorized(
+    char const* text,
+    size_t length,
+    uint8_t* destination,
+    Base64Alphabet const& alphabet)
 {
-  int32_t i0 = encodedBytes[0];
-  int32_t i1 = encodedBytes[1];
-  int32_t i2 = encodedBytes[2];
-  int32_t i3 = encodedBytes[3];
-
-  i0 = Base64DecodeArray[i0];
-  i1 = Base64DecodeArray[i1];
-  i2 = Base64DecodeArray[i2];
-  i3 = Base64DecodeArray[i3];
-
-  i0 <<= 18;
-  i1 <<= 12;
-  i2 <<= 6;
+  // clang-format off
+  __m256i const gather = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+  // clang-format on
 
-  i0 |= i3;
-  i1 |= i2;
+  size_t decoded = 0;
+  for (; decoded + 32 <= length; decoded += 32)
+  {
+    __m256i const characters
+        = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(text + decoded));
+
+    // The comparisons are signed, so that the characters over 127 are in none of the ranges.
+    __m256i const upper = _mm256_and_si256(
+        _mm256_cmpgt_epi8(characters, _mm256_set1_epi8('A' - 1)),
+        _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), characters));
+    __m256i const lower = _mm256_and_si256(
+        _mm256_cmpgt_epi8(characters, _mm256_set1_epi8('a' - 1)),
+        _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), characters));
+    __m256i const digit = _mm256_and_si256(
+        _mm256_cmpgt_epi8(characters, _mm256_set1_epi8('0' - 1)),
+        _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), characters));
+    __m256i const is62 = _mm256_or_si256(
+        _mm256_cmpeq_epi8(characters, _mm256_set1_epi8(alphabet.Characters[62])),
+        _mm256_cmpeq_epi8(characters, _mm256_set1_epi8(alphabet.Alternatives[0])));
+    __m256i const is63 = _mm256_or_si256(
+        _mm256_cmpeq_epi8(characters, _mm256_set1_epi8(alphabet.Characters[63])),
+        _mm256_cmpeq_epi8(characters, _mm256_set1_epi8(alphabet.Alternatives[1])));
+
+    __m256i const valid = _mm256_or_si256(
+        _mm256_or_si256(upper, lower), _mm256_or_si256(digit, _mm256_or_si256(is62, is63)));
+    if (_mm256_movemask_epi8(valid) != -1)
+    {
+      break;
+    }
 
-  i0 |= i1;
-  return i0;
+    __m256i const values = _mm256_or_si256(
+        _mm256_or_si256(
+            _mm256_and_si256(upper, _mm256_sub_epi8(characters, _mm256_set1_epi8('A'))),
+            _mm256_and_si256(lower, _mm256_sub_epi8(characters, _mm256_set1_epi8('a' - 26)))),
+        _mm256_or_si256(
+            _mm256_and_si256(digit, _mm256_add_epi8(characters, _mm256_set1_epi8(52 - '0'))),
+            _mm256_or_si256(
+                _mm256_and_si256(is62, _mm256_set1_epi8(62)),
+                _mm256_and_si256(is63, _mm256_set1_epi8(63)))));
+
+    // Merge the 4 values of each block into 24 bits, then gather the 3 bytes of each block.
+    __m256i const pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+    __m256i const blocks = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+    __m256i const bytes = _mm256_permutevar8x32_epi32(
+        _mm256_shuffle_epi8(blocks, gather), _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+
+    uint8_t* const output = destination + (decoded / 4) * 3;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm256_castsi256_si128(bytes));
+    _mm_storel_epi64(
+        reinterpret_cast<__m128i*>(output + 16), _mm256_extracti128_si256(bytes, 1));
+  }
+  return decoded;
 }
-
-void Base64WriteThreeLowOrderBytes(std::vector<uint8_t>::iterator destination, int64_t value)
+#elif defined(_azure_BASE64_NEON)
+// Encodes 48 bytes at a time, and returns the number of bytes encoded, a multiple of 3.
+size_t EncodeVectorized(
+    uint8_t const* data,
+    size_t length,
+    char* destination,
+    Base64Alphabet const& alphabet)
 {
-  destination[0] = static_cast<uint8_t>(value >> 16);
-  destination[1] = static_cast<uint8_t>(value >> 8);
-  destination[2] = static_cast<uint8_t>(value);
+  auto const characters = reinterpret_cast<uint8_t const*>(alphabet.Characters);
+  uint8x16x4_t const table = {
+      {vld1q_u8(characters),
+       vld1q_u8(characters + 16),
+       vld1q_u8(characters + 32),
+       vld1q_u8(characters + 48)}};
+  uint8x16_t const mask = vdupq_n_u8(0x3F);
+
+  size_t encoded = 0;
+  for (; encoded + 48 <= length; encoded += 48)
+  {
+    uint8x16x3_t const input = vld3q_u8(data + encoded);
+    uint8x16x4_t output;
+    output.val[0] = vshrq_n_u8(input.val[0], 2);
+    output.val[1]
+        = vandq_u8(vorrq_u8(vshlq_n_u8(input.val[0], 4), vshrq_n_u8(input.val[1], 4)), mask);
+    output.val[2]
+        = vandq_u8(vorrq_u8(vshlq_n_u8(input.val[1], 2), vshrq_n_u8(input.val[2], 6)), mask);
+    output.val[3] = vandq_u8(input.val[2], mask);
+    for (int i = 0; i < 4; ++i)
+    {
+      output.val[i] = vqtbl4q_u8(table, output.val[i]);
+    }
+    vst4q_u8(reinterpret_cast<uint8_t*>(destination + (encoded / 3) * 4), output);
+  }
+  return encoded;
 }
 
-std::vector<uint8_t> Base64Decode(const std::string& text)
+// Decodes 64 characters at a time, and returns the number of characters decoded, a multiple of 4.
+// It stops before the first block holding a character which is not part of the alphabet.
+size_t DecodeVectorized(
+    char const* text,
+    size_t length,
+    uint8_t* destination,
+    Base64Alphabet const& alphabet)
 {
-  auto inputSize = text.size();
-  if (inputSize % 4 != 0)
+  auto const values = reinterpret_cast<uint8_t const*>(alphabet.Values);
+  uint8x16x4_t const lowTable
+      = {{vld1q_u8(values), vld1q_u8(values + 16), vld1q_u8(values + 32), vld1q_u8(values + 48)}};
+  uint8x16x4_t const highTable
+      = {{vld1q_u8(values + 64),
+          vld1q_u8(values + 80),
+          vld1q_u8(values + 96),
+          vld1q_u8(values + 112)}};
+
+  size_t decoded = 0;
+  for (; decoded + 64 <= length; decoded += 64)
   {
-    throw std::runtime_error("Unexpected end of Base64 encoded string.");
+    uint8x16x4_t input = vld4q_u8(reinterpret_cast<uint8_t const*>(text + decoded));
+    // The values are at most 63, and the invalid characters are looked up as 0xFF.
+    uint8x16_t invalid = vdupq_n_u8(0);
+    for (int i = 0; i < 4; ++i)
+    {
+      uint8x16_t const character = input.val[i];
+      uint8x16_t value = vqtbl4q_u8(lowTable, character);
+      value = vqtbx4q_u8(value, highTable, vsubq_u8(character, vdupq_n_u8(64)));
+      invalid = vorrq_u8(invalid, vorrq_u8(value, vcgeq_u8(character, vdupq_n_u8(128))));
+      input.val[i] = value;
+    }
+    if (vmaxvq_u8(invalid) > 63)
+    {
+      break;
+    }
+
+    uint8x16x3_t output;
+    output.val[0] = vorrq_u8(vshlq_n_u8(input.val[0], 2), vshrq_n_u8(input.val[1], 4));
+    output.val[1] = vorrq_u8(vshlq_n_u8(input.val[1], 4), vshrq_n_u8(input.val[2], 2));
+    output.val[2] = vorrq_u8(vshlq_n_u8(input.val[2], 6), input.val[3]);
+    vst3q_u8(destination + (decoded / 4) * 3, output);
   }
+  return decoded;
+}
+#else
+size_t EncodeVectorized(uint8_t const*, size_t, char*, Base64Alphabet const&) { return 0; }
+
+size_t DecodeVectorized(char const*, size_t, uint8_t*, Base64Alphabet const&) { return 0; }
+#endif
 
-  // An empty input should result in an empty output.
-  if (inputSize == 0)
+void EncodeBlocks(uint8_t const* data, size_t blocks, char* destination, char const* characters)
+{
+  for (size_t i = 0; i < blocks; ++i, data += 3, destination += 4)
   {
-    return std::vector<uint8_t>();
+    uint32_t const block = (data[0] << 16) | (data[1] << 8) | data[2];
+    destination[0] = characters[block >> 18];
+    destination[1] = characters[(block >> 12) & 0x3F];
+    destination[2] = characters[(block >> 6) & 0x3F];
+    destination[3] = characters[block & 0x3F];
   }
+}
 
-  size_t sourceIndex = 0;
-  auto inputPtr = text.data();
-  auto decodedSize = (inputSize / 4) * 3;
-
-  if (inputPtr[inputSize - 2] == EncodingPad)
+std::string Base64Encode(
+    uint8_t const* const data,
+    size_t length,
+    Base64Alphabet const& alphabet,
+    bool pad)
+{
+  auto const remainder = length % 3;
+  // The padding is already in place, and the characters are written over it.
+  std::string encodedResult(
+      (length / 3) * 4 + (remainder == 0 ? 0 : (pad ? 4 : remainder + 1)), EncodingPad);
+  auto destination = &encodedResult[0];
+
+  size_t encoded = UseVectorization() ? EncodeVectorized(data, length, destination, alphabet) : 0;
+  EncodeBlocks(
+      data + encoded, (length - encoded) / 3, destination + (encoded / 3) * 4, alphabet.Characters);
+  encoded = length - remainder;
+  destination += (encoded / 3) * 4;
+
+  if (remainder == 1)
   {
-    decodedSize -= 2;
+    destination[0] = alphabet.Characters[data[encoded] >> 2];
+    destination[1] = alphabet.Characters[(data[encoded] & 0x03) << 4];
   }
-  else if (inputPtr[inputSize - 1] == EncodingPad)
+  else if (remainder == 2)
   {
-    decodedSize -= 1;
+    uint32_t const block = (data[encoded] << 8) | data[encoded + 1];
+    destination[0] = alphabet.Characters[block >> 10];
+    destination[1] = alphabet.Characters[(block >> 4) & 0x3F];
+    destination[2] = alphabet.Characters[(block << 2) & 0x3F];
   }
 
-  std::vector<uint8_t> destination(decodedSize);
-  auto destinationPtr = destination.begin();
+  return encodedResult;
+}
 
-  while (sourceIndex + 4 < inputSize)
+// Returns false when a block holds a character which is not part of the alphabet.
+bool DecodeBlocks(char const* text, size_t blocks, uint8_t* destination, int8_t const* values)
+{
+  for (size_t i = 0; i < blocks; ++i, text += 4, destination += 3)
   {
-    int64_t result = Base64Decode(inputPtr + sourceIndex);
-    if (result < 0)
+    int32_t const i0 = values[static_cast<uint8_t>(text[0])];
+    int32_t const i1 = values[static_cast<uint8_t>(text[1])];
+    int32_t const i2 = values[static_cast<uint8_t>(text[2])];
+    int32_t const i3 = values[static_cast<uint8_t>(text[3])];
+    if ((i0 | i1 | i2 | i3) < 0)
     {
-      throw std::runtime_error("Unexpected character in Base64 encoded string");
+      return false;
     }
-    Base64WriteThreeLowOrderBytes(destinationPtr, result);
-    destinationPtr += 3;
-    sourceIndex += 4;
-  }
 
-  // We are guaranteed to have an input with at least 4 bytes at this point, with a size that is a
-  // multiple of 4.
-  int64_t i0 = inputPtr[inputSize - 4];
-  int64_t i1 = inputPtr[inputSize - 3];
-  int64_t i2 = inputPtr[inputSize - 2];
-  int64_t i3 = inputPtr[inputSize - 1];
-
-  i0 = Base64DecodeArray[i0];
-  i1 = Base64DecodeArray[i1];
-
-  i0 <<= 18;
-  i1 <<= 12;
-
-  i0 |= i1;
+    int32_t const block = (i0 << 18) | (i1 << 12) | (i2 << 6) | i3;
+    destination[0] = static_cast<uint8_t>(block >> 16);
+    destination[1] = static_cast<uint8_t>(block >> 8);
+    destination[2] = static_cast<uint8_t>(block);
+  }
+  return true;
+}
 
-  if (i3 != EncodingPad)
+// Decodes text whose padding is removed.
+std::vector<uint8_t> Base64Decode(char const* text, size_t length, Base64Alphabet const& alphabet)
+{
+  auto const remainder = length % 4;
+  if (remainder == 1)
   {
-    i2 = Base64DecodeArray[i2];
-    i3 = Base64DecodeArray[i3];
-
-    i2 <<= 6;
+    throw std::runtime_error("Unexpected end of Base64 encoded string.");
+  }
 
-    i0 |= i3;
-    i0 |= i2;
+  std::vector<uint8_t> destination((length / 4) * 3 + (remainder == 0 ? 0 : remainder - 1));
+  auto destinationPtr = destination.data();
 
-    if (i0 < 0)
-    {
-      throw std::runtime_error("Unexpected character in Base64 encoded string");
-    }
-
-    Base64WriteThreeLowOrderBytes(destinationPtr, i0);
-  }
-  else if (i2 != EncodingPad)
+  size_t decoded
+      = UseVectorization() ? DecodeVectorized(text, length, destinationPtr, alphabet) : 0;
+  if (!DecodeBlocks(
+          text + decoded,
+          (length - decoded) / 4,
+          destinationPtr + (decoded / 4) * 3,
+          alphabet.Values))
   {
-    i2 = Base64DecodeArray[i2];
-
-    i2 <<= 6;
+    throw std::runtime_error("Unexpected character in Base64 encoded string");
+  }
+  decoded = length - remainder;
+  destinationPtr += (decoded / 4) * 3;
 
-    i0 |= i2;
-    if (i0 < 0)
+  if (remainder != 0)
+  {
+    int32_t const i0 = alphabet.Values[static_cast<uint8_t>(text[decoded])];
+    int32_t const i1 = alphabet.Values[static_cast<uint8_t>(text[decoded + 1])];
+    int32_t const i2
+        = remainder == 3 ? alphabet.Values[static_cast<uint8_t>(text[decoded + 2])] : 0;
+    if ((i0 | i1 | i2) < 0)
     {
       throw std::runtime_error("Unexpected character in Base64 encoded string");
     }
 
-    destinationPtr[1] = static_cast<uint8_t>(i0 >> 8);
-    destinationPtr[0] = static_cast<uint8_t>(i0 >> 16);
-  }
-  else
-  {
-    if (i0 < 0)
+    int32_t const block = (i0 << 18) | (i1 << 12) | (i2 << 6);
+    destinationPtr[0] = static_cast<uint8_t>(block >> 16);
+    if (remainder == 3)
     {
-      throw std::runtime_error("Unexpected character in Base64 encoded string");
+      destinationPtr[1] = static_cast<uint8_t>(block >> 8);
     }
-
-    destinationPtr[0] = static_cast<uint8_t>(i0 >> 16);
   }
 
   return destination;
 }
 
+// Returns the length of the text without its padding of at most two characters.
+size_t RemovePadding(std::string const& text)
+{
+  auto length = text.size();
+  for (int i = 0; i < 2 && length != 0 && text[length - 1] == EncodingPad; ++i)
+  {
+    --length;
+  }
+  return length;
+}
+
 } // namespace
 
 namespace Azure { namespace Core {
 
   std::string Convert::Base64Encode(const std::vector<uint8_t>& data)
   {
-    return ::Base64Encode(data.data(), data.size());
+    return ::Base64Encode(data.data(), data.size(), Base64Standard, true);
   }
 
   std::vector<uint8_t> Convert::Base64Decode(const std::string& text)
   {
-    return ::Base64Decode(text);
+    if (text.size() % 4 != 0)
+    {
+      throw std::runtime_error("Unexpected end of Base64 encoded string.");
+    }
+    return ::Base64Decode(text.data(), RemovePadding(text), Base64Standard);
   }
+
   namespace _internal {
 
     std::string Convert::Base64Encode(const std::string& data)
     {
-      return ::Base64Encode(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+      return ::Base64Encode(
+          reinterpret_cast<const uint8_t*>(data.data()), data.size(), Base64Standard, true);
+    }
+
+    std::string Base64Url::Base64UrlEncode(const std::vector<uint8_t>& data)
+    {
+      return ::Base64Encode(data.data(), data.size(), Base64UrlSafe, false);
+    }
+
+    std::vector<uint8_t> Base64Url::Base64UrlDecode(const std::string& text)
+    {
+      if (text.size() % 4 == 1)
+      {
+        throw std::invalid_argument("Unexpected Base64URL encoding in the HTTP response.");
+      }
+      return ::Base64Decode(text.data(), RemovePadding(text), Base64UrlSafe);
     }
   } // namespace _internal
 
+  namespace _detail {
+
+    bool Base64Vectorization::IsSupported() { return IsVectorizationSupported(); }
+
+    bool Base64Vectorization::SetEnabled(bool enabled)
+    {
+      return VectorizationEnabled.exchange(enabled);
+    }
+  } // namespace _detail
+
 }} // namespace Azure::Core
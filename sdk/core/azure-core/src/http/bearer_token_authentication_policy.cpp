@@ -6,6 +6,9 @@
 #include "azure/core/internal/credentials/authorization_challenge_parser.hpp"
 
 #include <chrono>
+#include <exception>
+#include <typeinfo>
+#include <utility>
 
 using Azure::Core::Http::Policies::_internal::BearerTokenAuthenticationPolicy;
 
@@ -15,6 +18,7 @@ using Azure::Core::Credentials::TokenRequestContext;
 using Azure::Core::Credentials::_detail::AuthorizationChallengeHelper;
 using Azure::Core::Http::RawResponse;
 using Azure::Core::Http::Request;
+using Azure::Core::Http::SendCallback;
 using Azure::Core::Http::Policies::NextHttpPolicy;
 
 std::unique_ptr<RawResponse> BearerTokenAuthenticationPolicy::Send(
@@ -42,6 +46,82 @@ std::unique_ptr<RawResponse> BearerTokenAuthenticationPolicy::Send(
   return result;
 }
 
+void BearerTokenAuthenticationPolicy::SendAsync(
+    Request& request,
+    NextHttpPolicy nextPolicy,
+    Context const& context,
+    SendCallback callback) const
+{
+  // The classes overriding AuthorizeAndSendRequest() send the request with it.
+  if (typeid(*this) != typeid(BearerTokenAuthenticationPolicy))
+  {
+    HttpPolicy::SendAsync(request, nextPolicy, context, std::move(callback));
+    return;
+  }
+
+  std::exception_ptr error;
+  try
+  {
+    if (request.GetUrl().GetScheme() != "https")
+    {
+      throw AuthenticationException(
+          "Bearer token authentication is not permitted for non TLS protected (https) "
+          "endpoints.");
+    }
+
+    AuthenticateAndAuthorizeRequest(request, m_tokenRequestContext, context);
+  }
+  catch (...)
+  {
+    error = std::current_exception();
+  }
+
+  if (error)
+  {
+    callback(nullptr, error);
+    return;
+  }
+
+  auto const requestContext = context;
+  nextPolicy.SendAsync(
+      request,
+      context,
+      [this, &request, nextPolicy, requestContext, callback = std::move(callback)](
+          std::unique_ptr<RawResponse> response, std::exception_ptr error) mutable {
+        if (!response)
+        {
+          callback(nullptr, error);
+          return;
+        }
+
+        bool resend = false;
+        try
+        {
+          m_invalidateToken = (response->GetStatusCode() == HttpStatusCode::Unauthorized);
+          auto const& challenge = AuthorizationChallengeHelper::GetChallenge(*response);
+          resend = !challenge.empty()
+              && AuthorizeRequestOnChallenge(challenge, request, requestContext);
+        }
+        catch (...)
+        {
+          error = std::current_exception();
+        }
+
+        if (error)
+        {
+          callback(nullptr, error);
+        }
+        else if (resend)
+        {
+          nextPolicy.SendAsync(request, requestContext, std::move(callback));
+        }
+        else
+        {
+          callback(std::move(response), nullptr);
+        }
+      });
+}
+
 std::unique_ptr<RawResponse> BearerTokenAuthenticationPolicy::AuthorizeAndSendRequest(
     Request& request,
     NextHttpPolicy& nextPolicy,
@@ -23,6 +23,7 @@
 // Private include
 #include "curl_connection_pool_private.hpp"
 #include "curl_connection_private.hpp"
+#include "curl_multiplexer_private.hpp"
 #include "curl_session_private.hpp"
 
 #if defined(AZ_PLATFORM_POSIX)
@@ -58,11 +59,19 @@
 #endif // AZ_PLATFORM_POSIX/AZ_PLATFORM_WINDOWS
 
 #include <algorithm>
+#include <atomic>
+#include <cerrno>
 #include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
 #include <iomanip>
+#include <limits>
+#include <map>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace {
 std::string const LogMsgPrefix = "[CURL Transport Adapter]: ";
@@ -201,16 +210,21 @@ static void CleanupThread()
     std::unique_lock<std::mutex> lockForPoolCleaning(
         CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
 
-    // Wait for the default time OR to the signal from the conditional variable.
+    // Wait for the cleaner interval OR to the signal from the conditional variable.
     // wait_for releases the mutex lock when it goes to sleep and it takes the lock again when it
     // wakes up (or it's cancelled).
+    auto const interval = CurlConnectionPool::g_curlConnectionPool.CleanerInterval;
     if (CurlConnectionPool::g_curlConnectionPool.ConditionalVariableForCleanThread.wait_for(
-            lockForPoolCleaning,
-            std::chrono::milliseconds(DefaultCleanerIntervalMilliseconds),
-            []() {
-              return CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.size() == 0;
+            lockForPoolCleaning, interval, [interval]() {
+              return CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.size() == 0
+                  || CurlConnectionPool::g_curlConnectionPool.CleanerInterval < interval;
             }))
     {
+      if (CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.size() != 0)
+      {
+        // A transport asked for a shorter interval, wait again for it.
+        continue;
+      }
       // Cancelled by another thread or no connections on wakeup
       CurlConnectionPool::g_curlConnectionPool.IsCleanThreadRunning = false;
       break;
@@ -235,7 +249,8 @@ static void CleanupThread()
       while (connectionIter != connectionList.begin())
       {
         --connectionIter;
-        if ((*connectionIter)->IsExpired())
+        if ((*connectionIter)->IsExpired()
+            && connectionList.size() > (*connectionIter)->GetMinIdleConnections())
         {
           // remove connection from the pool and update the connection to the next one
           // which is going to be list.end()
@@ -311,6 +326,18 @@ Azure::Core::Http::CurlTransportOptions CurlTransportOptionsFromTransportOptions
   return curlOptions;
 }
 
+// The revocation check of OpenSSL is set up by each CurlConnection, and relies on the
+// verification of the certificate during the TLS handshake.
+bool ChecksCrlWithOpenSsl(Azure::Core::Http::CurlTransportOptions const& options)
+{
+#if defined(AZ_PLATFORM_WINDOWS) || defined(AZ_PLATFORM_MAC)
+  (void)options;
+  return false;
+#else
+  return options.SslOptions.EnableCertificateRevocationListCheck;
+#endif
+}
+
 } // namespace
 
 using Azure::Core::Context;
@@ -324,10 +351,41 @@ using Azure::Core::Http::RawResponse;
 using Azure::Core::Http::Request;
 using Azure::Core::Http::TransportException;
 using Azure::Core::Http::_detail::CurlConnectionPool;
+using Azure::Core::Metrics::_internal::HttpClientMetrics;
 
 Azure::Core::Http::_detail::CurlConnectionPool
     Azure::Core::Http::_detail::CurlConnectionPool::g_curlConnectionPool;
 
+CurlTransport::CurlTransport(CurlTransportOptions const& options) : m_options(options)
+{
+  if (options.ConnectionPoolCleanupInterval > std::chrono::milliseconds::zero())
+  {
+    bool shortened = false;
+    {
+      std::lock_guard<std::mutex> lock(
+          CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
+      auto& cleanerInterval = CurlConnectionPool::g_curlConnectionPool.CleanerInterval;
+      if (options.ConnectionPoolCleanupInterval < cleanerInterval)
+      {
+        cleanerInterval = options.ConnectionPoolCleanupInterval;
+        shortened = true;
+      }
+    }
+    if (shortened)
+    {
+      // Wake the clean thread up, so that it waits for the shorter interval.
+      CurlConnectionPool::g_curlConnectionPool.ConditionalVariableForCleanThread.notify_one();
+    }
+  }
+
+#if LIBCURL_VERSION_NUM >= 0x074400 // 7.68.0
+  if (options.EnableHttp2 && !ChecksCrlWithOpenSsl(options))
+  {
+    m_multiplexer = std::make_shared<_detail::CurlMultiplexer>(options);
+  }
+#endif
+}
+
 CurlTransport::CurlTransport(Azure::Core::Http::Policies::TransportOptions const& options)
     : CurlTransport(CurlTransportOptionsFromTransportOptions(options))
 {
@@ -335,12 +393,21 @@ CurlTransport::CurlTransport(Azure::Core::Http::Policies::TransportOptions const
 
 std::unique_ptr<RawResponse> CurlTransport::Send(Request& request, Context const& context)
 {
+#if LIBCURL_VERSION_NUM >= 0x074400 // 7.68.0
+  if (m_multiplexer && !request.HasHeader("upgrade"))
+  {
+    return m_multiplexer->Send(request, context);
+  }
+#endif
+
   // Create CurlSession to perform request
   Log::Write(Logger::Level::Verbose, LogMsgPrefix + "Creating a new session.");
 
+  auto const metrics = HttpClientMetrics::CreateFromContext(context);
   auto session = std::make_unique<CurlSession>(
       request,
-      CurlConnectionPool::g_curlConnectionPool.ExtractOrCreateCurlConnection(request, m_options),
+      CurlConnectionPool::g_curlConnectionPool.ExtractOrCreateCurlConnection(
+          request, m_options, false, metrics),
       m_options);
 
   CURLcode performing;
@@ -369,7 +436,8 @@ std::unique_ptr<RawResponse> CurlTransport::Send(Request& request, Context const
         CurlConnectionPool::g_curlConnectionPool.ExtractOrCreateCurlConnection(
             request,
             m_options,
-            getConnectionOpenIntent + 1 >= _detail::RequestPoolResetAfterConnectionFailed),
+            getConnectionOpenIntent + 1 >= _detail::RequestPoolResetAfterConnectionFailed,
+            metrics),
         m_options);
   }
 
@@ -398,6 +466,19 @@ std::unique_ptr<RawResponse> CurlTransport::Send(Request& request, Context const
   return response;
 }
 
+void CurlTransport::SendAsync(Request& request, Context const& context, SendCallback callback)
+{
+#if LIBCURL_VERSION_NUM >= 0x074400 // 7.68.0
+  if (m_multiplexer && !request.HasHeader("upgrade"))
+  {
+    m_multiplexer->SendAsync(request, context, std::move(callback));
+    return;
+  }
+#endif
+
+  HttpTransport::SendAsync(request, context, std::move(callback));
+}
+
 CURLcode CurlSession::Perform(Context const& context)
 {
   // Set the session state
@@ -405,9 +486,7 @@ CURLcode CurlSession::Perform(Context const& context)
 
   // libcurl settings after connection is open (headers)
   {
-    auto headers = this->m_request.GetHeaders();
-    auto hostHeader = headers.find("Host");
-    if (hostHeader == headers.end())
+    if (!this->m_request.HasHeader("Host"))
     {
       Log::Write(Logger::Level::Verbose, LogMsgPrefix + "No Host in request headers. Adding it");
       std::string hostName = this->m_request.GetUrl().GetHost();
@@ -421,7 +500,7 @@ CURLcode CurlSession::Perform(Context const& context)
     if (this->m_request.GetMethod() != HttpMethod::Get
         && this->m_request.GetMethod() != HttpMethod::Head
         && this->m_request.GetMethod() != HttpMethod::Delete
-        && headers.find("content-length") == headers.end())
+        && !this->m_request.HasHeader("content-length"))
     {
       Log::Write(Logger::Level::Verbose, LogMsgPrefix + "No content-length in headers. Adding it");
       this->m_request.SetHeader(
@@ -700,13 +779,12 @@ inline std::string CurlSession::GetHeadersAsString(Azure::Core::Http::Request co
 {
   std::string requestHeaderString;
 
-  for (auto const& header : request.GetHeaders())
-  {
-    requestHeaderString += header.first; // string (key)
+  request.ForEachHeader([&](std::string const& name, std::string const& value) {
+    requestHeaderString += name;
     requestHeaderString += ": ";
-    requestHeaderString += header.second; // string's value
+    requestHeaderString += value;
     requestHeaderString += "\r\n";
-  }
+  });
   requestHeaderString += "\r\n";
 
   return requestHeaderString;
@@ -1375,6 +1453,13 @@ size_t CurlSession::ResponseBufferParser::Parse(
 }
 
 namespace {
+// Generate a display name for the host being connected to
+inline std::string GetHostDisplayName(Azure::Core::Url const& url)
+{
+  uint16_t const port = url.GetPort();
+  return url.GetScheme() + "://" + url.GetHost() + (port != 0 ? ":" + std::to_string(port) : "");
+}
+
 // Calculate the connection key.
 // The connection key is a tuple of host, proxy info, TLS info, etc. Basically any characteristics
 // of the connection that should indicate that the connection shouldn't be re-used should be listed
@@ -2167,12 +2252,10 @@ int CurlConnection::SslCtxCallback(CURL*, void* sslctx)
 std::unique_ptr<CurlNetworkConnection> CurlConnectionPool::ExtractOrCreateCurlConnection(
     Request& request,
     CurlTransportOptions const& options,
-    bool resetPool)
+    bool resetPool,
+    HttpClientMetrics const* metrics)
 {
-  uint16_t port = request.GetUrl().GetPort();
-  // Generate a display name for the host being connected to
-  std::string const& hostDisplayName = request.GetUrl().GetScheme() + "://"
-      + request.GetUrl().GetHost() + (port != 0 ? ":" + std::to_string(port) : "");
+  std::string const hostDisplayName = GetHostDisplayName(request.GetUrl());
   std::string const connectionKey = GetConnectionKey(hostDisplayName, options);
 
   {
@@ -2214,6 +2297,11 @@ std::unique_ptr<CurlNetworkConnection> CurlConnectionPool::ExtractOrCreateCurlCo
         }
 
         Log::Write(Logger::Level::Verbose, LogMsgPrefix + "Re-using connection from the pool.");
+        if (metrics)
+        {
+          metrics->PooledConnectionsReused->Add(
+              1, {{HttpClientMetrics::ServerAddress, request.GetUrl().GetHost()}});
+        }
         // return connection ref
         return connection;
       }
@@ -2223,25 +2311,153 @@ std::unique_ptr<CurlNetworkConnection> CurlConnectionPool::ExtractOrCreateCurlCo
   // Creating a new connection is thread safe. No need to lock mutex here.
   // No available connection for the pool for the required host. Create one
   Log::Write(Logger::Level::Verbose, LogMsgPrefix + "Spawn new connection.");
+  if (metrics)
+  {
+    metrics->ConnectionsCreated->Add(
+        1, {{HttpClientMetrics::ServerAddress, request.GetUrl().GetHost()}});
+  }
+
+  auto connection
+      = std::make_unique<CurlConnection>(request, options, hostDisplayName, connectionKey);
+  auto const tlsSessionResumed = connection->IsTlsSessionResumed();
+  if (tlsSessionResumed.HasValue() && tlsSessionResumed.Value())
+  {
+    Log::Write(Logger::Level::Verbose, LogMsgPrefix + "Resumed the TLS session.");
+  }
+  if (metrics && connection->HasTlsHandshake())
+  {
+    if (tlsSessionResumed.HasValue())
+    {
+      metrics->TlsHandshakes->Add(
+          1,
+          {{HttpClientMetrics::ServerAddress, request.GetUrl().GetHost()},
+           {HttpClientMetrics::TlsResumed, tlsSessionResumed.Value() ? "true" : "false"}});
+    }
+    else
+    {
+      metrics->TlsHandshakes->Add(
+          1, {{HttpClientMetrics::ServerAddress, request.GetUrl().GetHost()}});
+    }
+  }
+  return connection;
+}
+
+size_t CurlTransport::WarmUpConnections(
+    std::vector<Azure::Core::Url> const& urls,
+    size_t connectionsPerHost,
+    Context const& context)
+{
+  if (!m_options.HttpKeepAlive || m_multiplexer)
+  {
+    return 0;
+  }
+
+  // The hosts to connect to, by connection key.
+  struct Host final
+  {
+    Request Target;
+    std::string DisplayName;
+  };
+  std::map<std::string, Host> hosts;
+  for (auto const& url : urls)
+  {
+    auto const displayName = GetHostDisplayName(url);
+    auto const key = GetConnectionKey(displayName, m_options);
+    if (hosts.count(key) == 0)
+    {
+      hosts.emplace(key, Host{Request(HttpMethod::Get, url), displayName});
+    }
+  }
+  std::vector<std::pair<std::string const*, Host*>> connections;
+  {
+    std::lock_guard<std::mutex> lock(CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
+    auto const& pool = CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex;
+    for (auto& host : hosts)
+    {
+      auto const pooled = pool.find(host.first);
+      size_t const pooledConnections = pooled != pool.end() ? pooled->second.size() : 0;
+      for (size_t i = pooledConnections; i < connectionsPerHost; ++i)
+      {
+        connections.emplace_back(&host.first, &host.second);
+      }
+    }
+  }
+
+  // Each thread opens the next connection until they are all opened.
+  std::atomic<size_t> next{0};
+  std::atomic<size_t> opened{0};
+  auto const openConnections = [&]() {
+    for (size_t i = next++; i < connections.size() && !context.IsCancelled(); i = next++)
+    {
+      auto& host = *connections[i].second;
+      try
+      {
+        // A connection replacing another one in a full pool doesn't count.
+        if (CurlConnectionPool::g_curlConnectionPool.MoveConnectionBackToPool(
+                std::make_unique<CurlConnection>(
+                    host.Target, m_options, host.DisplayName, *connections[i].first),
+                true))
+        {
+          ++opened;
+        }
+      }
+      // An exception escaping a worker thread would terminate the application.
+      catch (std::exception const& e)
+      {
+        Log::Write(
+            Logger::Level::Warning,
+            LogMsgPrefix + "Failed to warm up a connection. " + std::string(e.what()));
+      }
+      catch (...)
+      {
+        Log::Write(Logger::Level::Warning, LogMsgPrefix + "Failed to warm up a connection.");
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  try
+  {
+    for (size_t i = 1; i < (std::min)(connections.size(), _detail::MaxWarmUpThreads); ++i)
+    {
+      threads.emplace_back(openConnections);
+    }
+  }
+  catch (...)
+  {
+    // Destroying a thread which hasn't been joined would terminate the application.
+    next = connections.size();
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+    throw;
+  }
+  openConnections();
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
 
-  return std::make_unique<CurlConnection>(request, options, hostDisplayName, connectionKey);
+  context.ThrowIfCancelled();
+  return opened;
 }
 
 // Move the connection back to the connection pool. Push it to the front so it becomes the
 // first connection to be picked next time some one ask for a connection to the pool (LIFO)
-void CurlConnectionPool::MoveConnectionBackToPool(
+bool CurlConnectionPool::MoveConnectionBackToPool(
     std::unique_ptr<CurlNetworkConnection> connection,
     bool httpKeepAlive)
 {
   if (!httpKeepAlive)
   {
-    return; // The server has asked us to not re-use this connection.
+    return false; // The server has asked us to not re-use this connection.
   }
 
   if (connection->IsShutdown())
   {
     // Can't re-used a shut down connection
-    return;
+    return false;
   }
 
   Log::Write(Logger::Level::Verbose, "Moving connection to pool...");
@@ -2254,7 +2470,8 @@ void CurlConnectionPool::MoveConnectionBackToPool(
   auto& poolId = connection->GetConnectionKey();
   auto& hostPool = g_curlConnectionPool.ConnectionPoolIndex[poolId];
 
-  if (hostPool.size() >= _detail::MaxConnectionsPerIndex && !hostPool.empty())
+  bool const isAdded = hostPool.size() < _detail::MaxConnectionsPerIndex;
+  if (!isAdded && !hostPool.empty())
   {
     // Remove the last connection from the pool to insert this one.
     auto lastConnection = --hostPool.end();
@@ -2285,6 +2502,43 @@ void CurlConnectionPool::MoveConnectionBackToPool(
   {
     Log::Write(Logger::Level::Verbose, "Clean thread running. Won't start a new one.");
   }
+  return isAdded;
+}
+
+CURLSH* CurlConnectionPool::GetShareHandle()
+{
+  std::lock_guard<std::mutex> lock(m_shareMutex);
+  if (m_share == nullptr)
+  {
+    CURLSH* share = curl_share_init();
+    if (share == nullptr)
+    {
+      return nullptr;
+    }
+    // The connection cache isn't shared: the pool keeps the connections itself, which libcurl
+    // doesn't cache once they are opened with CURLOPT_CONNECT_ONLY.
+    if (curl_share_setopt(share, CURLSHOPT_LOCKFUNC, LockSharedData) != CURLSHE_OK
+        || curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, UnlockSharedData) != CURLSHE_OK
+        || curl_share_setopt(share, CURLSHOPT_USERDATA, this) != CURLSHE_OK
+        || curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS) != CURLSHE_OK
+        || curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION) != CURLSHE_OK)
+    {
+      curl_share_cleanup(share);
+      return nullptr;
+    }
+    m_share = share;
+  }
+  return m_share;
+}
+
+void CurlConnectionPool::LockSharedData(CURL*, curl_lock_data data, curl_lock_access, void* pool)
+{
+  static_cast<CurlConnectionPool*>(pool)->m_shareLocks[data].lock();
+}
+
+void CurlConnectionPool::UnlockSharedData(CURL*, curl_lock_data data, void* pool)
+{
+  static_cast<CurlConnectionPool*>(pool)->m_shareLocks[data].unlock();
 }
 
 CurlConnection::CurlConnection(
@@ -2292,7 +2546,12 @@ CurlConnection::CurlConnection(
     CurlTransportOptions const& options,
     std::string const& hostDisplayName,
     std::string const& connectionPropertiesKey)
-    : m_connectionKey(connectionPropertiesKey)
+    : m_connectionKey(connectionPropertiesKey),
+      m_idleTimeout(
+          options.ConnectionIdleTimeout > std::chrono::milliseconds::zero()
+              ? options.ConnectionIdleTimeout
+              : _detail::DefaultConnectionIdleTimeout),
+      m_minIdleConnections(options.MinIdleConnectionsPerHost)
 {
   m_handle = Azure::Core::_internal::UniqueHandle<CURL>(curl_easy_init());
   if (!m_handle)
@@ -2508,6 +2767,17 @@ CurlConnection::CurlConnection(
     }
   }
 
+  if (options.EnableSharedCaches && !ChecksCrlWithOpenSsl(options))
+  {
+    CURLSH* share = CurlConnectionPool::g_curlConnectionPool.GetShareHandle();
+    if (share != nullptr && !SetLibcurlOption(m_handle, CURLOPT_SHARE, share, &result))
+    {
+      throw Azure::Core::Http::TransportException(
+          _detail::DefaultFailedToGetNewConnectionTemplate + hostDisplayName
+          + ". Failed to set the share handle. " + std::string(curl_easy_strerror(result)));
+    }
+  }
+
   // curl-transport adapter supports only HTTP/1.1
   // https://github.com/Azure/azure-sdk-for-cpp/issues/2848
   // The libcurl uses HTTP/2 by default, if it can be negotiated with a server on handshake.
@@ -2565,4 +2835,856 @@ CurlConnection::CurlConnection(
         "Broken connection. Couldn't get the active socket for it."
         + std::string(curl_easy_strerror(result)));
   }
+
+  // The time until the end of the TLS handshake, which stays 0 when there was none.
+  double tlsHandshakeEndTime = 0;
+  curl_easy_getinfo(m_handle.get(), CURLINFO_APPCONNECT_TIME, &tlsHandshakeEndTime);
+  m_hasTlsHandshake = tlsHandshakeEndTime > 0;
 }
+
+Azure::Nullable<bool> CurlConnection::IsTlsSessionResumed() const
+{
+  curl_tlssessioninfo* tlsSession = nullptr;
+  if (!m_hasTlsHandshake
+      || curl_easy_getinfo(m_handle.get(), CURLINFO_TLS_SSL_PTR, &tlsSession) != CURLE_OK
+      || tlsSession == nullptr || tlsSession->internals == nullptr)
+  {
+    return {};
+  }
+#if defined(AZ_PLATFORM_POSIX)
+  if (tlsSession->backend == CURLSSLBACKEND_OPENSSL)
+  {
+    return SSL_session_reused(static_cast<SSL*>(tlsSession->internals)) == 1;
+  }
+#endif
+  return {};
+}
+
+#if LIBCURL_VERSION_NUM >= 0x074400 // 7.68.0
+using Azure::Core::Http::_detail::CurlMultiplexer;
+
+namespace {
+struct HeaderListDeleter final
+{
+  void operator()(curl_slist* list) const { curl_slist_free_all(list); }
+};
+} // namespace
+
+// The state of a request shared by the background thread of the multiplexer, which performs it,
+// and the threads which send it and read its response.
+struct CurlMultiplexer::Stream final
+{
+  Azure::Core::_internal::UniqueHandle<CURL> Handle;
+  std::unique_ptr<curl_slist, HeaderListDeleter> Headers;
+  Azure::Core::IO::BodyStream* Upload = nullptr;
+  Context const* UploadContext = nullptr;
+  bool CanPause = false;
+  // The bytes left to upload, or -1 when the length of the request body is unknown.
+  int64_t UploadRemaining = 0;
+  bool IsHead = false;
+
+  // Set for the requests sent asynchronously, whose callback takes the response.
+  std::weak_ptr<CurlMultiplexer> Multiplexer;
+  SendCallback Callback;
+  Context CallContext;
+  std::string Host;
+  bool CompletesWhenDone = false;
+
+  std::mutex Mutex;
+  std::condition_variable Changed;
+  // Written by the background thread until HeadersReceived is set.
+  std::unique_ptr<RawResponse> Response;
+  long NewConnections = 0;
+  bool HeadersReceived = false;
+  bool UploadCompleted = true;
+  bool Paused = false;
+  bool Done = false;
+  CURLcode Result = CURLE_OK;
+  std::exception_ptr Error;
+  // The response body received and not read yet, from ReadOffset.
+  std::vector<uint8_t> Buffer;
+  size_t ReadOffset = 0;
+
+  static size_t OnHeader(char* data, size_t size, size_t count, void* userp)
+  {
+    auto& stream = *static_cast<Stream*>(userp);
+    size_t const length = size * count;
+    try
+    {
+      stream.ParseHeader(std::string(data, length));
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(stream.Mutex);
+      stream.Error = std::current_exception();
+      return 0;
+    }
+    return length;
+  }
+
+  static size_t OnBody(char* data, size_t size, size_t count, void* userp)
+  {
+    auto& stream = *static_cast<Stream*>(userp);
+    size_t const length = size * count;
+    {
+      std::lock_guard<std::mutex> lock(stream.Mutex);
+      size_t const buffered = stream.Buffer.size() - stream.ReadOffset;
+      if (stream.CanPause && buffered != 0 && buffered + length > Http2StreamBufferSize)
+      {
+        // libcurl delivers the same data again when the stream is resumed.
+        stream.Paused = true;
+        return CURL_WRITEFUNC_PAUSE;
+      }
+      if (stream.ReadOffset != 0 && stream.ReadOffset >= buffered)
+      {
+        stream.Buffer.erase(
+            stream.Buffer.begin(),
+            stream.Buffer.begin() + static_cast<std::ptrdiff_t>(stream.ReadOffset));
+        stream.ReadOffset = 0;
+      }
+      stream.Buffer.insert(stream.Buffer.end(), data, data + length);
+    }
+    stream.Changed.notify_all();
+    return length;
+  }
+
+  static size_t OnUpload(char* data, size_t size, size_t count, void* userp)
+  {
+    auto& stream = *static_cast<Stream*>(userp);
+    try
+    {
+      auto const read = stream.Upload->Read(
+          reinterpret_cast<uint8_t*>(data), size * count, *stream.UploadContext);
+      if (stream.UploadRemaining > 0)
+      {
+        stream.UploadRemaining -= static_cast<int64_t>(read);
+      }
+      // libcurl doesn't read past the length of the body.
+      if (read == 0 || stream.UploadRemaining == 0)
+      {
+        {
+          std::lock_guard<std::mutex> lock(stream.Mutex);
+          stream.UploadCompleted = true;
+        }
+        stream.Changed.notify_all();
+      }
+      return read;
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(stream.Mutex);
+      stream.Error = std::current_exception();
+      return CURL_READFUNC_ABORT;
+    }
+  }
+
+  void ParseHeader(std::string const& line)
+  {
+    if (HeadersReceived)
+    {
+      // Trailers are not part of the response.
+      return;
+    }
+
+    auto const end = line.find_last_not_of("\r\n");
+    if (end == std::string::npos)
+    {
+      // The empty line ending the headers, after which an informational response is followed by
+      // another one.
+      if (Response && static_cast<int>(Response->GetStatusCode()) >= 200)
+      {
+        curl_easy_getinfo(Handle.get(), CURLINFO_NUM_CONNECTS, &NewConnections);
+        {
+          std::lock_guard<std::mutex> lock(Mutex);
+          HeadersReceived = true;
+        }
+        Changed.notify_all();
+      }
+      else
+      {
+        Response.reset();
+      }
+      return;
+    }
+
+    if (line.compare(0, 5, "HTTP/") == 0)
+    {
+      // The status line, like "HTTP/2 200" or "HTTP/1.1 200 OK".
+      auto const versionEnd = line.find(' ');
+      auto const statusEnd = line.find(' ', versionEnd + 1);
+      auto const version = line.substr(5, versionEnd - 5);
+      auto const dot = version.find('.');
+      auto const statusCode = std::stoi(line.substr(versionEnd + 1, statusEnd - versionEnd - 1));
+      Response = std::make_unique<RawResponse>(
+          std::stoi(version.substr(0, dot)),
+          dot == std::string::npos ? 0 : std::stoi(version.substr(dot + 1)),
+          HttpStatusCode(statusCode),
+          statusEnd == std::string::npos || statusEnd >= end
+              ? std::string()
+              : line.substr(statusEnd + 1, end - statusEnd));
+      return;
+    }
+
+    auto const colon = line.find(':');
+    if (Response && colon != std::string::npos)
+    {
+      auto const valueStart = line.find_first_not_of(" \t", colon + 1);
+      auto const valueEnd = line.find_last_not_of(" \t\r\n");
+      Response->SetHeader(
+          line.substr(0, colon),
+          valueStart == std::string::npos || valueStart > valueEnd
+              ? std::string()
+              : line.substr(valueStart, valueEnd - valueStart + 1));
+    }
+  }
+};
+
+// Reads the body of a response from the buffer of its stream.
+class CurlMultiplexer::ResponseBodyStream final : public Azure::Core::IO::BodyStream {
+  std::shared_ptr<CurlMultiplexer> m_multiplexer;
+  std::shared_ptr<Stream> m_stream;
+  int64_t m_length;
+
+  size_t OnRead(uint8_t* buffer, size_t count, Context const& context) override
+  {
+    auto& stream = *m_stream;
+    std::unique_lock<std::mutex> lock(stream.Mutex);
+    while (stream.ReadOffset == stream.Buffer.size() && !stream.Done)
+    {
+      context.ThrowIfCancelled();
+      stream.Changed.wait_for(lock, std::chrono::milliseconds(100));
+    }
+
+    size_t const buffered = stream.Buffer.size() - stream.ReadOffset;
+    if (buffered == 0)
+    {
+      if (stream.Result != CURLE_OK)
+      {
+        throw TransportException(
+            "Error while reading the response body. "
+            + std::string(curl_easy_strerror(stream.Result)));
+      }
+      return 0;
+    }
+
+    auto const read = (std::min)(count, buffered);
+    std::copy_n(
+        stream.Buffer.begin() + static_cast<std::ptrdiff_t>(stream.ReadOffset), read, buffer);
+    stream.ReadOffset += read;
+
+    // Resume the stream once the buffer is half empty, rather than after each read.
+    if (stream.Paused && buffered - read <= Http2StreamBufferSize / 2)
+    {
+      stream.Paused = false;
+      lock.unlock();
+      m_multiplexer->Post(m_multiplexer->m_resumed, m_stream);
+    }
+    return read;
+  }
+
+public:
+  ResponseBodyStream(
+      std::shared_ptr<CurlMultiplexer> multiplexer,
+      std::shared_ptr<Stream> stream,
+      int64_t length)
+      : m_multiplexer(std::move(multiplexer)), m_stream(std::move(stream)), m_length(length)
+  {
+  }
+
+  ~ResponseBodyStream() override
+  {
+    bool done;
+    {
+      std::lock_guard<std::mutex> lock(m_stream->Mutex);
+      done = m_stream->Done;
+    }
+    if (!done)
+    {
+      m_multiplexer->Post(m_multiplexer->m_cancelled, std::move(m_stream));
+    }
+  }
+
+  int64_t Length() const override { return m_length; }
+};
+
+CurlMultiplexer::CurlMultiplexer(CurlTransportOptions const& options)
+    : m_options(options),
+      // Older versions may not resume a paused HTTP/2 stream whose data was already read from the
+      // connection.
+      m_canPause(curl_version_info(CURLVERSION_NOW)->version_num >= 0x080400), // 8.4.0
+      m_completions(std::make_shared<CompletionQueue>())
+{
+}
+
+CurlMultiplexer::~CurlMultiplexer()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  if (m_thread.joinable())
+  {
+    curl_multi_wakeup(m_multi.get());
+    m_thread.join();
+  }
+  for (auto& active : m_active)
+  {
+    curl_multi_remove_handle(m_multi.get(), active.first);
+  }
+
+  // The callbacks of the requests sent asynchronously report that the transport is destroyed.
+  for (auto& stream : m_added)
+  {
+    if (stream->Callback)
+    {
+      m_pending.push_back(std::move(stream));
+    }
+  }
+  for (auto& stream : m_pending)
+  {
+    Dispatch(std::move(stream));
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_completions->Mutex);
+    m_completions->Stop = true;
+  }
+  m_completions->Ready.notify_one();
+}
+
+std::shared_ptr<CurlMultiplexer::Stream> CurlMultiplexer::CreateStream(
+    Request& request,
+    Context const& context) const
+{
+  auto stream = std::make_shared<Stream>();
+  stream->Handle = Azure::Core::_internal::UniqueHandle<CURL>(curl_easy_init());
+  if (!stream->Handle)
+  {
+    throw TransportException(
+        "Error while sending request. " + std::string("curl_easy_init returned Null"));
+  }
+
+  stream->CanPause = m_canPause;
+
+  auto const& handle = stream->Handle;
+  auto const setOption = [&handle](CURLoption option, auto value, char const* description) {
+    CURLcode result;
+    if (!SetLibcurlOption(handle, option, value, &result))
+    {
+      throw TransportException(
+          "Error while sending request. Failed to set " + std::string(description) + ". "
+          + std::string(curl_easy_strerror(result)));
+    }
+  };
+
+  if (m_options.EnableCurlTracing)
+  {
+    setOption(CURLOPT_DEBUGFUNCTION, CurlConnection::CurlLoggingCallback, "logging callback");
+    setOption(CURLOPT_VERBOSE, 1L, "verbose logging");
+  }
+
+  setOption(CURLOPT_URL, request.GetUrl().GetAbsoluteUrl().c_str(), "URL");
+  if (request.GetUrl().GetPort() != 0)
+  {
+    setOption(CURLOPT_PORT, static_cast<long>(request.GetUrl().GetPort()), "port");
+  }
+  // HTTP/2 is negotiated on the TLS handshake, the other requests use HTTP/1.1.
+  setOption(CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2TLS), "HTTP version");
+  // Wait for the connection being opened to the host rather than opening another one, so that the
+  // concurrent requests are multiplexed on it.
+  setOption(CURLOPT_PIPEWAIT, 1L, "pipe wait");
+  setOption(CURLOPT_TIMEOUT, 60L * 60L * 24L, "timeout");
+  if (m_options.ConnectionTimeout != Azure::Core::Http::_detail::DefaultConnectionTimeout)
+  {
+    setOption(
+        CURLOPT_CONNECTTIMEOUT_MS,
+        static_cast<long>(m_options.ConnectionTimeout.count()),
+        "connect timeout");
+  }
+  if (!m_options.HttpKeepAlive)
+  {
+    setOption(CURLOPT_FORBID_REUSE, 1L, "connection reuse");
+  }
+  if (m_options.Proxy)
+  {
+    setOption(CURLOPT_PROXY, m_options.Proxy->c_str(), "proxy");
+  }
+  if (m_options.ProxyUsername.HasValue())
+  {
+    setOption(CURLOPT_PROXYUSERNAME, m_options.ProxyUsername.Value().c_str(), "proxy username");
+  }
+  if (m_options.ProxyPassword.HasValue())
+  {
+    setOption(CURLOPT_PROXYPASSWORD, m_options.ProxyPassword.Value().c_str(), "proxy password");
+  }
+  if (!m_options.CAInfo.empty())
+  {
+    setOption(CURLOPT_CAINFO, m_options.CAInfo.c_str(), "CA cert file");
+  }
+  if (!m_options.CAPath.empty())
+  {
+    setOption(CURLOPT_CAPATH, m_options.CAPath.c_str(), "CA path");
+  }
+#if LIBCURL_VERSION_NUM >= 0x074D00 // 7.77.0
+  if (!m_options.SslOptions.PemEncodedExpectedRootCertificates.empty())
+  {
+    curl_blob rootCertBlob
+        = {const_cast<void*>(reinterpret_cast<const void*>(
+               m_options.SslOptions.PemEncodedExpectedRootCertificates.c_str())),
+           m_options.SslOptions.PemEncodedExpectedRootCertificates.size(),
+           CURL_BLOB_COPY};
+    setOption(CURLOPT_CAINFO_BLOB, &rootCertBlob, "CA cert");
+  }
+#endif
+#if defined(AZ_PLATFORM_WINDOWS)
+  if (!m_options.SslOptions.EnableCertificateRevocationListCheck)
+  {
+    setOption(CURLOPT_SSL_OPTIONS, static_cast<long>(CURLSSLOPT_NO_REVOKE), "ssl options");
+  }
+#endif
+  if (!m_options.SslVerifyPeer)
+  {
+    setOption(CURLOPT_SSL_VERIFYPEER, 0L, "ssl verify peer");
+  }
+  if (m_options.NoSignal)
+  {
+    setOption(CURLOPT_NOSIGNAL, 1L, "NOSIGNAL option");
+  }
+  if (m_options.EnableSharedCaches)
+  {
+    CURLSH* share = CurlConnectionPool::g_curlConnectionPool.GetShareHandle();
+    if (share != nullptr)
+    {
+      setOption(CURLOPT_SHARE, share, "share handle");
+    }
+  }
+  setOption(CURLOPT_SSLVERSION, static_cast<long>(CURL_SSLVERSION_TLSv1_2), "TLS version");
+
+  auto const method = request.GetMethod();
+  auto* const upload = request.GetBodyStream();
+  bool const hasBody = method != HttpMethod::Head && upload != nullptr && upload->Length() != 0;
+  if (method == HttpMethod::Head)
+  {
+    stream->IsHead = true;
+    setOption(CURLOPT_NOBODY, 1L, "HEAD method");
+  }
+  else if (method != HttpMethod::Get || hasBody)
+  {
+    setOption(CURLOPT_CUSTOMREQUEST, method.ToString().c_str(), "method");
+  }
+
+  if (hasBody)
+  {
+    stream->Upload = upload;
+    stream->UploadContext = &context;
+    stream->UploadRemaining = upload->Length();
+    stream->UploadCompleted = false;
+    setOption(CURLOPT_POST, 1L, "request body");
+    setOption(
+        CURLOPT_POSTFIELDSIZE_LARGE,
+        static_cast<curl_off_t>(upload->Length()),
+        "request body size");
+    setOption(CURLOPT_READFUNCTION, Stream::OnUpload, "request body callback");
+    setOption(CURLOPT_READDATA, stream.get(), "request body callback data");
+  }
+  else if (method == HttpMethod::Post || method == HttpMethod::Put || method == HttpMethod::Patch)
+  {
+    setOption(CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(0), "request body size");
+    setOption(CURLOPT_POSTFIELDS, "", "request body");
+  }
+
+  curl_slist* headers = nullptr;
+  auto const appendHeader = [&headers](std::string const& header) {
+    auto const appended = curl_slist_append(headers, header.c_str());
+    if (appended == nullptr)
+    {
+      curl_slist_free_all(headers);
+      throw std::bad_alloc();
+    }
+    headers = appended;
+  };
+  request.ForEachHeader([&](std::string const& name, std::string const& value) {
+    // libcurl sends a header without value when it ends with a semicolon.
+    appendHeader(value.empty() ? name + ";" : name + ": " + value);
+  });
+  // Prevent libcurl from adding the headers of a form, or waiting for a 100-continue response.
+  if (!request.HasHeader("content-type"))
+  {
+    appendHeader("Content-Type:");
+  }
+  appendHeader("Expect:");
+  stream->Headers.reset(headers);
+  setOption(CURLOPT_HTTPHEADER, headers, "headers");
+
+  setOption(CURLOPT_HEADERFUNCTION, Stream::OnHeader, "header callback");
+  setOption(CURLOPT_HEADERDATA, stream.get(), "header callback data");
+  setOption(CURLOPT_WRITEFUNCTION, Stream::OnBody, "body callback");
+  setOption(CURLOPT_WRITEDATA, stream.get(), "body callback data");
+  return stream;
+}
+
+void CurlMultiplexer::Start()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_multi)
+  {
+    m_multi.reset(curl_multi_init());
+    if (!m_multi)
+    {
+      throw TransportException(
+          "Error while sending request. " + std::string("curl_multi_init returned Null"));
+    }
+    curl_multi_setopt(m_multi.get(), CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    m_thread = std::thread([this]() { Run(); });
+    // The thread calling the callbacks isn't joined, since a callback may destroy the multiplexer
+    // by releasing the last response.
+    std::thread([completions = m_completions]() { CallCallbacks(completions); }).detach();
+  }
+}
+
+std::unique_ptr<RawResponse> CurlMultiplexer::Send(Request& request, Context const& context)
+{
+  context.ThrowIfCancelled();
+  auto stream = CreateStream(request, context);
+  Start();
+  Log::Write(Logger::Level::Verbose, LogMsgPrefix + "Sending the request over HTTP/2.");
+  Post(m_added, stream);
+
+  {
+    std::unique_lock<std::mutex> lock(stream->Mutex);
+    while (!stream->Done && !(stream->HeadersReceived && stream->UploadCompleted))
+    {
+      if (context.IsCancelled())
+      {
+        lock.unlock();
+        Post(m_cancelled, stream);
+        // Wait for the request to be removed, since it reads the request body.
+        lock.lock();
+        stream->Changed.wait(lock, [&stream]() { return stream->Done; });
+        context.ThrowIfCancelled();
+      }
+      stream->Changed.wait_for(lock, std::chrono::milliseconds(100));
+    }
+  }
+
+  return TakeResponse(std::move(stream), request.GetUrl().GetHost(), context);
+}
+
+void CurlMultiplexer::SendAsync(Request& request, Context const& context, SendCallback callback)
+{
+  std::shared_ptr<Stream> stream;
+  std::exception_ptr error;
+  try
+  {
+    context.ThrowIfCancelled();
+    stream = CreateStream(request, context);
+    Start();
+  }
+  catch (...)
+  {
+    error = std::current_exception();
+  }
+
+  if (error)
+  {
+    callback(nullptr, error);
+    return;
+  }
+
+  stream->Multiplexer = shared_from_this();
+  stream->Callback = std::move(callback);
+  stream->CallContext = context;
+  stream->Host = request.GetUrl().GetHost();
+  if (stream->Upload != nullptr)
+  {
+    stream->UploadContext = &stream->CallContext;
+  }
+  if (request.ShouldBufferResponse())
+  {
+    // The whole body is buffered before the callback is called.
+    stream->CompletesWhenDone = true;
+    stream->CanPause = false;
+  }
+
+  Log::Write(Logger::Level::Verbose, LogMsgPrefix + "Sending the request over HTTP/2.");
+  Post(m_added, std::move(stream));
+}
+
+std::unique_ptr<RawResponse> CurlMultiplexer::TakeResponse(
+    std::shared_ptr<Stream> stream,
+    std::string const& host,
+    Context const& context)
+{
+  {
+    std::lock_guard<std::mutex> lock(stream->Mutex);
+    stream->Upload = nullptr;
+    stream->UploadContext = nullptr;
+
+    if (stream->Error)
+    {
+      std::rethrow_exception(stream->Error);
+    }
+    if (!stream->HeadersReceived)
+    {
+      throw TransportException(
+          "Error while sending request. " + std::string(curl_easy_strerror(stream->Result)));
+    }
+  }
+
+  auto response = std::move(stream->Response);
+  auto const metrics = HttpClientMetrics::CreateFromContext(context);
+  if (metrics)
+  {
+    (stream->NewConnections > 0 ? metrics->ConnectionsCreated : metrics->PooledConnectionsReused)
+        ->Add(1, {{HttpClientMetrics::ServerAddress, host}});
+  }
+
+  int64_t length = -1;
+  auto const statusCode = response->GetStatusCode();
+  if (stream->IsHead || statusCode == HttpStatusCode::NoContent
+      || statusCode == HttpStatusCode::NotModified)
+  {
+    length = 0;
+  }
+  else
+  {
+    auto const& headers = response->GetHeaders();
+    auto const contentLength = headers.find("content-length");
+    if (contentLength != headers.end())
+    {
+      // A malformed value leaves the length unknown, the body is then read until the stream ends.
+      auto const& value = contentLength->second;
+      char* end = nullptr;
+      errno = 0;
+      auto const parsed = std::strtoull(value.c_str(), &end, 10);
+      if (!value.empty() && value[0] >= '0' && value[0] <= '9' && *end == '\0' && errno == 0
+          && parsed <= static_cast<unsigned long long>((std::numeric_limits<int64_t>::max)()))
+      {
+        length = static_cast<int64_t>(parsed);
+      }
+    }
+  }
+  response->SetBodyStream(
+      std::make_unique<ResponseBodyStream>(shared_from_this(), std::move(stream), length));
+  return response;
+}
+
+void CurlMultiplexer::Post(
+    std::vector<std::shared_ptr<Stream>>& queue,
+    std::shared_ptr<Stream> stream)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    queue.push_back(std::move(stream));
+  }
+  curl_multi_wakeup(m_multi.get());
+}
+
+void CurlMultiplexer::Complete(Stream& stream, CURLcode result)
+{
+  curl_multi_remove_handle(m_multi.get(), stream.Handle.get());
+  {
+    std::lock_guard<std::mutex> lock(stream.Mutex);
+    stream.Done = true;
+    stream.Result = result;
+  }
+  stream.Changed.notify_all();
+}
+
+void CurlMultiplexer::Dispatch(std::shared_ptr<Stream> stream)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_completions->Mutex);
+    m_completions->Streams.push_back(std::move(stream));
+  }
+  m_completions->Ready.notify_one();
+}
+
+void CurlMultiplexer::CallCallbacks(std::shared_ptr<CompletionQueue> queue)
+{
+  std::vector<std::shared_ptr<Stream>> streams;
+  std::unique_lock<std::mutex> lock(queue->Mutex);
+  for (;;)
+  {
+    queue->Ready.wait(lock, [&queue]() { return queue->Stop || !queue->Streams.empty(); });
+    if (queue->Streams.empty())
+    {
+      break;
+    }
+    streams.swap(queue->Streams);
+    lock.unlock();
+    for (auto& stream : streams)
+    {
+      CallCallback(std::move(stream));
+    }
+    streams.clear();
+    lock.lock();
+  }
+}
+
+void CurlMultiplexer::CallCallback(std::shared_ptr<Stream> stream)
+{
+  auto const callback = std::move(stream->Callback);
+  std::unique_ptr<RawResponse> response;
+  std::exception_ptr error;
+  try
+  {
+    auto const multiplexer = stream->Multiplexer.lock();
+    if (!multiplexer)
+    {
+      throw TransportException(
+          "Error while sending request. The transport was destroyed before the response was "
+          "received.");
+    }
+    response = multiplexer->TakeResponse(stream, stream->Host, stream->CallContext);
+  }
+  catch (...)
+  {
+    error = std::current_exception();
+  }
+
+  try
+  {
+    callback(std::move(response), error);
+  }
+  catch (std::exception const& e)
+  {
+    Log::Write(
+        Logger::Level::Error,
+        LogMsgPrefix + "The callback of a request sent asynchronously threw: " + e.what());
+  }
+  catch (...)
+  {
+    Log::Write(
+        Logger::Level::Error,
+        LogMsgPrefix + "The callback of a request sent asynchronously threw an exception.");
+  }
+}
+
+void CurlMultiplexer::Run()
+{
+  std::vector<std::shared_ptr<Stream>> added;
+  std::vector<std::shared_ptr<Stream>> resumed;
+  std::vector<std::shared_ptr<Stream>> cancelled;
+  for (;;)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_stop)
+      {
+        break;
+      }
+      added.swap(m_added);
+      resumed.swap(m_resumed);
+      cancelled.swap(m_cancelled);
+    }
+
+    for (auto& stream : added)
+    {
+      if (stream->Callback)
+      {
+        m_pending.push_back(stream);
+      }
+      auto const result = curl_multi_add_handle(m_multi.get(), stream->Handle.get());
+      if (result != CURLM_OK)
+      {
+        Complete(*stream, CURLE_FAILED_INIT);
+        continue;
+      }
+      m_active.emplace(stream->Handle.get(), std::move(stream));
+    }
+    for (auto& stream : cancelled)
+    {
+      auto const active = m_active.find(stream->Handle.get());
+      if (active != m_active.end())
+      {
+        Complete(*stream, CURLE_ABORTED_BY_CALLBACK);
+        m_active.erase(active);
+      }
+    }
+    for (auto& stream : resumed)
+    {
+      if (m_active.count(stream->Handle.get()) != 0)
+      {
+        curl_easy_pause(stream->Handle.get(), CURLPAUSE_CONT);
+      }
+    }
+    added.clear();
+    resumed.clear();
+    cancelled.clear();
+
+    int running = 0;
+    curl_multi_perform(m_multi.get(), &running);
+    int queued = 0;
+    while (CURLMsg* message = curl_multi_info_read(m_multi.get(), &queued))
+    {
+      if (message->msg == CURLMSG_DONE)
+      {
+        auto const active = m_active.find(message->easy_handle);
+        if (active != m_active.end())
+        {
+          auto const stream = std::move(active->second);
+          m_active.erase(active);
+          Complete(*stream, message->data.result);
+        }
+      }
+    }
+
+    // Hand the requests sent asynchronously whose response is ready, or which are cancelled, to
+    // the thread calling their callback.
+    for (auto pending = m_pending.begin(); pending != m_pending.end();)
+    {
+      auto& stream = **pending;
+      bool ready;
+      bool cancelled;
+      {
+        std::lock_guard<std::mutex> lock(stream.Mutex);
+        ready = stream.Done
+            || (stream.HeadersReceived && stream.UploadCompleted && !stream.CompletesWhenDone);
+        cancelled = !ready && stream.CallContext.IsCancelled();
+        if (cancelled)
+        {
+          stream.Error = std::make_exception_ptr(
+              Azure::Core::OperationCancelledException("Request was cancelled by context."));
+        }
+      }
+      if (cancelled)
+      {
+        Complete(stream, CURLE_ABORTED_BY_CALLBACK);
+        m_active.erase(stream.Handle.get());
+        ready = true;
+      }
+
+      if (ready)
+      {
+        Dispatch(std::move(*pending));
+        pending = m_pending.erase(pending);
+      }
+      else
+      {
+        ++pending;
+      }
+    }
+
+    // Returns on the activity of a connection, on a timeout of libcurl, or when another thread
+    // posts a request. The requests sent asynchronously are checked for cancellation at least
+    // every 100ms.
+    int numfds = 0;
+    curl_multi_poll(
+        m_multi.get(), nullptr, 0, m_canPause && m_pending.empty() ? 1000 : 100, &numfds);
+    if (!m_canPause && numfds == 0)
+    {
+      // libcurl older than 8.4.0 may keep the last data of a stream in its buffers after the
+      // connection is drained, with nothing left to poll for. Pausing and resuming the streams
+      // makes it deliver that data.
+      for (auto& active : m_active)
+      {
+        if (!active.second->Paused)
+        {
+          curl_easy_pause(active.first, CURLPAUSE_RECV);
+          curl_easy_pause(active.first, CURLPAUSE_CONT);
+        }
+      }
+    }
+  }
+}
+#endif
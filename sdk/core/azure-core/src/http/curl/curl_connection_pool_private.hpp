@@ -11,11 +11,13 @@
 
 #include "azure/core/dll_import_export.hpp"
 #include "azure/core/http/http.hpp"
+#include "azure/core/internal/metrics/service_metrics.hpp"
 #include "curl_connection_private.hpp"
 
 #include <azure/core/http/curl_transport.hpp>
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <list>
 #include <memory>
@@ -67,6 +69,12 @@ namespace Azure { namespace Core { namespace Http { namespace _detail {
         // join thread
         m_cleanThread.join();
       }
+      if (m_share != nullptr)
+      {
+        // The connections stop using the share handle when they are cleaned up.
+        ConnectionPoolIndex.clear();
+        curl_share_cleanup(m_share);
+      }
       curl_global_cleanup();
     }
 
@@ -79,13 +87,16 @@ namespace Azure { namespace Core { namespace Http { namespace _detail {
      * configuration.
      * @param resetPool Request the pool to remove all current connections for the provided
      * options to force the creation of a new connection.
+     * @param metrics The metrics of the pipeline sending the request, which counts the reused and
+     * created connections, or `nullptr`.
      *
      * @return #Azure::Core::Http::CurlNetworkConnection to use.
      */
     std::unique_ptr<CurlNetworkConnection> ExtractOrCreateCurlConnection(
         Request& request,
         CurlTransportOptions const& options,
-        bool resetPool = false);
+        bool resetPool = false,
+        Azure::Core::Metrics::_internal::HttpClientMetrics const* metrics = nullptr);
 
     /**
      * @brief Moves a connection back to the pool to be re-used.
@@ -93,11 +104,24 @@ namespace Azure { namespace Core { namespace Http { namespace _detail {
      * @param connection CURL HTTP connection to add to the pool.
      * @param httpKeepAlive The status of keep-alive behavior, based on HTTP protocol version and
      * the most recent response header received through the \p connection.
+     * @return `true` if the pool holds one more connection, `false` if the connection was dropped
+     * or replaced the oldest connection of a full pool.
      */
-    void MoveConnectionBackToPool(
+    bool MoveConnectionBackToPool(
         std::unique_ptr<CurlNetworkConnection> connection,
         bool httpKeepAlive);
 
+    /**
+     * @brief Gets the libcurl share handle of the connections created with
+     * #Azure::Core::Http::CurlTransportOptions::EnableSharedCaches.
+     *
+     * @details The handle shares the DNS cache and the TLS sessions. It is created on the first
+     * call and lives as long as the pool.
+     *
+     * @return The share handle, or `nullptr` when libcurl can't create it.
+     */
+    CURLSH* GetShareHandle();
+
     /**
      * @brief Keeps a unique key for each host and creates a connection pool for each key.
      *
@@ -119,6 +143,11 @@ namespace Azure { namespace Core { namespace Http { namespace _detail {
 
     bool IsCleanThreadRunning = false;
 
+    // Time between two passes of the clean thread, the shortest
+    // CurlTransportOptions::ConnectionPoolCleanupInterval of the transports. Guarded by
+    // ConnectionPoolMutex.
+    std::chrono::milliseconds CleanerInterval{DefaultConnectionPoolCleanupInterval};
+
   private:
     // private constructor to keep this as singleton.
     CurlConnectionPool() { curl_global_init(CURL_GLOBAL_ALL); }
@@ -128,6 +157,14 @@ namespace Azure { namespace Core { namespace Http { namespace _detail {
     size_t ConnectionsOnPool(std::string const& host) { return ConnectionPoolIndex[host].size(); }
 
     std::thread m_cleanThread;
+
+    std::mutex m_shareMutex;
+    CURLSH* m_share = nullptr;
+    // Locks the data of the share handle, one mutex for each curl_lock_data.
+    std::mutex m_shareLocks[CURL_LOCK_DATA_LAST];
+
+    static void LockSharedData(CURL*, curl_lock_data data, curl_lock_access, void* pool);
+    static void UnlockSharedData(CURL*, curl_lock_data data, void* pool);
   };
 
 }}}} // namespace Azure::Core::Http::_detail
@@ -11,6 +11,7 @@
 
 #include "azure/core/http/http.hpp"
 #include "azure/core/internal/unique_handle.hpp"
+#include "azure/core/nullable.hpp"
 
 #include <chrono>
 #include <string>
@@ -57,15 +58,15 @@ namespace Azure { namespace Core {
       // After 3 connections are received from the pool and failed to send a request, the next
       // connections would ask the pool to be clean and spawn new connection.
       constexpr static int32_t RequestPoolResetAfterConnectionFailed = 3;
-      // 90 sec -> cleaner wait time before next clean routine
-      constexpr static int32_t DefaultCleanerIntervalMilliseconds = 1000 * 90;
-      // 60 sec -> expired connection is when it waits for 60 sec or more and it's not re-used
-      constexpr static int32_t DefaultConnectionExpiredMilliseconds = 1000 * 60;
       // Define the maximum allowed connections per host-index in the pool. If this number is
       // reached for the host-index, next connections trying to be added to the pool will be
       // ignored.
       constexpr static int32_t MaxConnectionsPerIndex = 1024;
+      // Maximum number of threads opening connections in parallel for
+      // CurlTransport::WarmUpConnections.
+      constexpr static size_t MaxWarmUpThreads = 16;
 
+      class CurlMultiplexer;
     } // namespace _detail
 
     /**
@@ -104,6 +105,13 @@ namespace Azure { namespace Core {
        */
       virtual bool IsExpired() = 0;
 
+      /**
+       * @brief Gets the number of idle connections to the host of this connection which the
+       * connection pool keeps open, even when they are expired.
+       *
+       */
+      virtual size_t GetMinIdleConnections() const { return 0; }
+
       /**
        * @brief This function is used when working with streams to pull more data from the wire.
        * Function will try to keep pulling data from socket until the buffer is all written or until
@@ -140,6 +148,9 @@ namespace Azure { namespace Core {
      *
      */
     class CurlConnection final : public CurlNetworkConnection {
+      // The multiplexer sets the logging callback on its own handles.
+      friend class _detail::CurlMultiplexer;
+
     private:
       Azure::Core::_internal::UniqueHandle<CURL> m_handle;
       curl_socket_t m_curlSocket;
@@ -149,6 +160,9 @@ namespace Azure { namespace Core {
       bool m_enableCrlValidation{false};
       // Allow the connection to proceed if retrieving the CRL failed.
       bool m_allowFailedCrlRetrieval{true};
+      bool m_hasTlsHandshake{false};
+      std::chrono::milliseconds m_idleTimeout;
+      size_t m_minIdleConnections;
 
       static int CurlLoggingCallback(
           CURL* handle,
@@ -185,6 +199,22 @@ namespace Azure { namespace Core {
 
       std::string const& GetConnectionKey() const override { return this->m_connectionKey; }
 
+      /**
+       * @brief Checks whether the connection performed a TLS handshake when it was opened.
+       */
+      bool HasTlsHandshake() const { return m_hasTlsHandshake; }
+
+      /**
+       * @brief Checks whether the TLS handshake of the connection resumed a previous session.
+       *
+       * @remark Some versions of libcurl only tell about the TLS session of a connection once data
+       * was sent on it.
+       *
+       * @return No value when there was no TLS handshake, or when libcurl or its TLS backend
+       * doesn't tell whether the session was resumed.
+       */
+      Azure::Nullable<bool> IsTlsSessionResumed() const;
+
       /**
        * @brief Update last usage time for the connection.
        *
@@ -202,9 +232,11 @@ namespace Azure { namespace Core {
       {
         auto connectionOnWaitingTimeMs = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::steady_clock::now() - this->m_lastUseTime);
-        return connectionOnWaitingTimeMs.count() >= _detail::DefaultConnectionExpiredMilliseconds;
+        return connectionOnWaitingTimeMs >= m_idleTimeout;
       }
 
+      size_t GetMinIdleConnections() const override { return m_minIdleConnections; }
+
       /**
        * @brief This function is used when working with streams to pull more data from the wire.
        * Function will try to keep pulling data from socket until the buffer is all written or until
@@ -0,0 +1,147 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief The HTTP/2 mode of the libcurl transport, which multiplexes the concurrent requests to a
+ * host over a single connection.
+ */
+
+#pragma once
+
+#include "azure/core/context.hpp"
+#include "azure/core/http/curl_transport.hpp"
+#include "azure/core/http/http.hpp"
+#include "azure/core/http/raw_response.hpp"
+#include "azure/core/http/transport.hpp"
+#include "curl_connection_private.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Azure { namespace Core { namespace Http { namespace _detail {
+
+  // Bytes of a response body buffered for a request before libcurl stops reading it from the
+  // connection, which then holds the server back through the HTTP/2 flow control of the stream.
+  constexpr static size_t Http2StreamBufferSize = 1024 * 1024;
+
+  /**
+   * @brief Performs the requests of a #Azure::Core::Http::CurlTransport over HTTP/2 with a libcurl
+   * multi handle.
+   *
+   * @details The multi handle keeps the connections, and multiplexes the concurrent requests to a
+   * host over one of them. It is only used by a background thread, which adds the requests to it,
+   * performs them, and fills the buffer of their response body. The threads sending the requests
+   * and reading the responses wait on the state of their request, and post to the background
+   * thread the requests to cancel or to resume.
+   *
+   * A request whose response body isn't read is paused when its buffer is full, so that libcurl
+   * stops acknowledging the data of its stream. The other streams of the connection are not held
+   * back by the slow reader. With libcurl older than 8.4.0, the requests are not paused and their
+   * buffer isn't bounded.
+   *
+   * The callbacks of the requests sent asynchronously are called by a second background thread,
+   * so that they can read the response body, which the first one fills.
+   */
+  class CurlMultiplexer final : public std::enable_shared_from_this<CurlMultiplexer> {
+  public:
+    /**
+     * @brief Constructs a multiplexer, which starts its background thread with the first request.
+     *
+     * @param options The options of the connections.
+     */
+    explicit CurlMultiplexer(CurlTransportOptions const& options);
+
+    /**
+     * @brief Stops the background thread and closes the connections.
+     *
+     * @remark The responses keep the multiplexer alive until their body is destroyed. The requests
+     * sent asynchronously which haven't completed fail with a
+     * #Azure::Core::Http::TransportException.
+     */
+    ~CurlMultiplexer();
+
+    CurlMultiplexer(CurlMultiplexer const&) = delete;
+    CurlMultiplexer& operator=(CurlMultiplexer const&) = delete;
+
+    /**
+     * @brief Sends a request and waits for the headers of its response.
+     *
+     * @remark The body of the request is uploaded before the call returns.
+     *
+     * @param request The request to send.
+     * @param context A context to control the request lifetime.
+     * @return The response, whose body stream is read from the connection.
+     */
+    std::unique_ptr<RawResponse> Send(Request& request, Context const& context);
+
+    /**
+     * @brief Sends a request without waiting for its response.
+     *
+     * @details \p callback is called once the headers of the response are received and the body
+     * of the request is uploaded. When \p request buffers its response, it is called once the
+     * whole body is received instead, so that reading it doesn't block.
+     *
+     * @param request The request to send, kept alive until \p callback is called.
+     * @param context A context to control the request lifetime.
+     * @param callback Receives the response, whose body stream is read from the connection.
+     */
+    void SendAsync(Request& request, Context const& context, SendCallback callback);
+
+  private:
+    struct Stream;
+    class ResponseBodyStream;
+
+    // The requests sent asynchronously whose callback is due. It is shared with the thread calling
+    // the callbacks, which may destroy the multiplexer.
+    struct CompletionQueue final
+    {
+      std::mutex Mutex;
+      std::condition_variable Ready;
+      std::vector<std::shared_ptr<Stream>> Streams;
+      bool Stop = false;
+    };
+
+    struct MultiHandleDeleter final
+    {
+      void operator()(CURLM* handle) const { curl_multi_cleanup(handle); }
+    };
+
+    CurlTransportOptions m_options;
+    bool const m_canPause;
+
+    std::mutex m_mutex;
+    std::unique_ptr<CURLM, MultiHandleDeleter> m_multi;
+    std::vector<std::shared_ptr<Stream>> m_added;
+    std::vector<std::shared_ptr<Stream>> m_resumed;
+    std::vector<std::shared_ptr<Stream>> m_cancelled;
+    bool m_stop = false;
+    std::thread m_thread;
+    std::shared_ptr<CompletionQueue> m_completions;
+
+    // Only used by the background thread.
+    std::map<CURL*, std::shared_ptr<Stream>> m_active;
+    // The requests sent asynchronously whose callback isn't due yet.
+    std::vector<std::shared_ptr<Stream>> m_pending;
+
+    std::shared_ptr<Stream> CreateStream(Request& request, Context const& context) const;
+    void Start();
+    std::unique_ptr<RawResponse> TakeResponse(
+        std::shared_ptr<Stream> stream,
+        std::string const& host,
+        Context const& context);
+    void Post(std::vector<std::shared_ptr<Stream>>& queue, std::shared_ptr<Stream> stream);
+    void Run();
+    void Complete(Stream& stream, CURLcode result);
+    void Dispatch(std::shared_ptr<Stream> stream);
+    static void CallCallbacks(std::shared_ptr<CompletionQueue> queue);
+    static void CallCallback(std::shared_ptr<Stream> stream);
+  };
+
+}}}} // namespace Azure::Core::Http::_detail
@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "delayed_task_queue_private.hpp"
+
+#include "azure/core/internal/diagnostics/log.hpp"
+
+#include <exception>
+#include <string>
+#include <system_error>
+
+using Azure::Core::Http::_detail::DelayedTaskQueue;
+
+namespace {
+void RunTask(std::function<void()> const& task)
+{
+  using Azure::Core::Diagnostics::Logger;
+  using Azure::Core::Diagnostics::_internal::Log;
+
+  try
+  {
+    task();
+  }
+  catch (std::exception const& e)
+  {
+    Log::Write(
+        Logger::Level::Error,
+        std::string("An exception was thrown by a delayed HTTP task: ") + e.what());
+  }
+}
+} // namespace
+
+DelayedTaskQueue& DelayedTaskQueue::Get()
+{
+  static DelayedTaskQueue queue;
+  return queue;
+}
+
+DelayedTaskQueue::~DelayedTaskQueue()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wakeUp.notify_one();
+  if (m_thread.joinable())
+  {
+    m_thread.join();
+  }
+}
+
+DelayedTaskQueue::TaskId DelayedTaskQueue::Schedule(
+    std::chrono::milliseconds delay,
+    std::function<void()> task)
+{
+  TaskId id(std::chrono::steady_clock::now() + delay, 0);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    id.second = m_sequence++;
+    m_tasks.emplace(id, std::move(task));
+    if (!m_thread.joinable())
+    {
+      m_thread = std::thread([this]() { Run(); });
+    }
+  }
+  m_wakeUp.notify_one();
+  return id;
+}
+
+bool DelayedTaskQueue::Cancel(TaskId const& id)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_tasks.erase(id) != 0;
+}
+
+void DelayedTaskQueue::Run()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (!m_stop)
+  {
+    if (m_tasks.empty())
+    {
+      m_wakeUp.wait(lock);
+      continue;
+    }
+
+    auto const first = m_tasks.begin();
+    if (std::chrono::steady_clock::now() < first->first.first)
+    {
+      m_wakeUp.wait_until(lock, first->first.first);
+      continue;
+    }
+
+    auto task = std::move(first->second);
+    m_tasks.erase(first);
+    lock.unlock();
+    try
+    {
+      std::thread([task]() { RunTask(task); }).detach();
+    }
+    catch (std::system_error const&)
+    {
+      RunTask(task);
+    }
+    lock.lock();
+  }
+}
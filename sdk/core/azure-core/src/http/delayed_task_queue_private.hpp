@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace Azure { namespace Core { namespace Http { namespace _detail {
+
+  /**
+   * @brief Runs tasks once their delay has expired, each on a thread of its own.
+   *
+   * @details A single background thread, started with the first task, waits for the deadlines of
+   * all the tasks of the process. It only starts the thread of a task when its deadline is
+   * reached, so that a task which is cancelled before costs no thread, and a task which blocks
+   * doesn't delay the others.
+   *
+   * @remark The tasks which are still scheduled when the process exits are not run.
+   */
+  class DelayedTaskQueue final {
+  public:
+    /**
+     * @brief Identifies a scheduled task.
+     */
+    using TaskId = std::pair<std::chrono::steady_clock::time_point, uint64_t>;
+
+    /**
+     * @brief Gets the queue of the process.
+     */
+    static DelayedTaskQueue& Get();
+
+    ~DelayedTaskQueue();
+
+    DelayedTaskQueue(DelayedTaskQueue const&) = delete;
+    DelayedTaskQueue& operator=(DelayedTaskQueue const&) = delete;
+
+    /**
+     * @brief Schedules \p task to run after \p delay.
+     *
+     * @remark When no thread can be started for the task, it runs on the background thread of the
+     * queue. The exceptions it throws are logged.
+     *
+     * @param delay The time to wait before running the task.
+     * @param task The task.
+     * @return The ID of the task, to cancel it.
+     */
+    TaskId Schedule(std::chrono::milliseconds delay, std::function<void()> task);
+
+    /**
+     * @brief Removes a task from the queue.
+     *
+     * @param id The ID of the task.
+     * @return `true` if the task was removed, `false` if it already started.
+     */
+    bool Cancel(TaskId const& id);
+
+  private:
+    std::mutex m_mutex;
+    std::condition_variable m_wakeUp;
+    // Ordered by deadline, then in the order the tasks were scheduled.
+    std::map<TaskId, std::function<void()>> m_tasks;
+    uint64_t m_sequence = 0;
+    bool m_stop = false;
+    std::thread m_thread;
+
+    DelayedTaskQueue() = default;
+
+    void Run();
+  };
+
+}}}} // namespace Azure::Core::Http::_detail
@@ -0,0 +1,324 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/core/http/policies/policy.hpp"
+#include "azure/core/internal/diagnostics/log.hpp"
+#include "delayed_task_queue_private.hpp"
+#include "retry_policy_private.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+using Azure::Core::Context;
+using namespace Azure::Core::Http;
+using namespace Azure::Core::Http::Policies;
+using namespace Azure::Core::Http::Policies::_internal;
+
+namespace Azure { namespace Core { namespace Http { namespace Policies { namespace _detail {
+  /**
+   * @brief State shared by a hedging policy and the attempts it has in flight.
+   */
+  struct HedgingState final
+  {
+    // Number of latency samples kept to estimate the hedge delay from a percentile.
+    static constexpr size_t MaxLatencySamples = 128;
+    // Minimum number of samples before the observed percentile is trusted.
+    static constexpr size_t MinLatencySamples = 16;
+
+    std::mutex Mutex;
+    std::condition_variable AttemptFinished;
+    int32_t InFlightAttempts = 0;
+
+    std::atomic<int64_t> EligibleRequests{0};
+    std::atomic<int64_t> HedgedRequests{0};
+
+    std::vector<std::chrono::milliseconds::rep> LatencySamples;
+    size_t NextLatencySample = 0;
+  };
+}}}}} // namespace Azure::Core::Http::Policies::_detail
+
+namespace {
+using Azure::Core::Http::Policies::_detail::HedgingState;
+
+Context::Key const HedgedAttemptKey;
+
+/**
+ * @brief The race between the original request and its hedged duplicate.
+ */
+struct HedgedCall final
+{
+  std::mutex Mutex;
+  std::condition_variable Completed;
+  // The context of the original attempt, then of the hedged one once it is sent.
+  std::vector<Context> AttemptContexts;
+  int32_t PendingAttempts = 0;
+  bool HasWinner = false;
+  // The winning response, or the failed response returned when no attempt succeeds.
+  std::unique_ptr<RawResponse> Response;
+  std::exception_ptr Error;
+  // Attempts may outlive RetryPolicy::Send(), so they must not refer to its retry counter.
+  int32_t RetryCount = -1;
+};
+
+bool IsHedgeable(Request const& request)
+{
+  auto const& method = request.GetMethod();
+  return (method == HttpMethod::Get || method == HttpMethod::Head)
+      && request.GetBodyStream()->Length() == 0;
+}
+
+// A response ends the race when it is successful, or when it is a failure of the original attempt
+// that retrying wouldn't fix. The failures of the hedged attempt, which may be sent to another
+// replica, only end the race when every attempt fails.
+bool IsWinningResponse(RawResponse const& response, bool isOriginalAttempt)
+{
+  static std::set<HttpStatusCode> const RetriableStatusCodes = RetryOptions().StatusCodes;
+
+  auto const statusCode = response.GetStatusCode();
+  if (static_cast<int32_t>(statusCode) < 400)
+  {
+    return true;
+  }
+  return isOriginalAttempt && RetriableStatusCodes.count(statusCode) == 0;
+}
+
+bool TryAcquireHedge(HedgingState& state, int32_t maxHedgedRequestsPercentage)
+{
+  auto const eligible = state.EligibleRequests.load();
+  auto hedged = state.HedgedRequests.load();
+  do
+  {
+    if (hedged * 100 >= eligible * maxHedgedRequestsPercentage)
+    {
+      return false;
+    }
+  } while (!state.HedgedRequests.compare_exchange_weak(hedged, hedged + 1));
+  return true;
+}
+
+std::chrono::milliseconds GetHedgeDelay(HedgingState& state, HedgingOptions const& options)
+{
+  if (!options.LatencyPercentile.HasValue())
+  {
+    return options.HedgeDelay;
+  }
+
+  std::vector<std::chrono::milliseconds::rep> samples;
+  {
+    std::lock_guard<std::mutex> lock(state.Mutex);
+    if (state.LatencySamples.size() < HedgingState::MinLatencySamples)
+    {
+      return options.HedgeDelay;
+    }
+    samples = state.LatencySamples;
+  }
+
+  auto const percentile = (std::min)((std::max)(options.LatencyPercentile.Value(), 0.0), 1.0);
+  auto const nth = samples.begin()
+      + static_cast<std::ptrdiff_t>(percentile * static_cast<double>(samples.size() - 1));
+  std::nth_element(samples.begin(), nth, samples.end());
+  return (std::max)(options.HedgeDelay, std::chrono::milliseconds(*nth));
+}
+
+void RecordLatency(HedgingState& state, std::chrono::milliseconds latency)
+{
+  std::lock_guard<std::mutex> lock(state.Mutex);
+  if (state.LatencySamples.size() < HedgingState::MaxLatencySamples)
+  {
+    state.LatencySamples.push_back(latency.count());
+  }
+  else
+  {
+    state.LatencySamples[state.NextLatencySample] = latency.count();
+  }
+  state.NextLatencySample = (state.NextLatencySample + 1) % HedgingState::MaxLatencySamples;
+}
+
+void RunAttempt(
+    HedgedCall& call,
+    size_t attemptIndex,
+    Request& request,
+    NextHttpPolicy& nextPolicy,
+    Context const& context)
+{
+  std::unique_ptr<RawResponse> response;
+  std::exception_ptr error;
+  try
+  {
+    response = nextPolicy.Send(request, context);
+  }
+  catch (...)
+  {
+    error = std::current_exception();
+  }
+
+  bool const isOriginalAttempt = attemptIndex == 0;
+  {
+    std::lock_guard<std::mutex> lock(call.Mutex);
+    --call.PendingAttempts;
+    if (call.HasWinner)
+    {
+      return;
+    }
+
+    if (response && IsWinningResponse(*response, isOriginalAttempt))
+    {
+      call.HasWinner = true;
+      call.Response = std::move(response);
+      for (size_t i = 0; i < call.AttemptContexts.size(); ++i)
+      {
+        if (i != attemptIndex)
+        {
+          call.AttemptContexts[i].Cancel();
+        }
+      }
+    }
+    // A failed response is preferred to an exception, and the original attempt to the hedged one.
+    else if (response)
+    {
+      if (!call.Response || isOriginalAttempt)
+      {
+        call.Response = std::move(response);
+      }
+    }
+    else if (!call.Error || isOriginalAttempt)
+    {
+      call.Error = error;
+    }
+  }
+  call.Completed.notify_all();
+}
+} // namespace
+
+HedgingPolicy::HedgingPolicy(HedgingOptions options)
+    : m_hedgingOptions(std::move(options)), m_state(std::make_shared<_detail::HedgingState>())
+{
+}
+
+HedgingPolicy::~HedgingPolicy()
+{
+  std::unique_lock<std::mutex> lock(m_state->Mutex);
+  m_state->AttemptFinished.wait(lock, [this] { return m_state->InFlightAttempts == 0; });
+}
+
+bool HedgingPolicy::IsHedgedAttempt(Context const& context)
+{
+  bool isHedged = false;
+  context.TryGetValue(HedgedAttemptKey, isHedged);
+  return isHedged;
+}
+
+std::unique_ptr<RawResponse> HedgingPolicy::Send(
+    Request& request,
+    NextHttpPolicy nextPolicy,
+    Context const& context) const
+{
+  using Azure::Core::Diagnostics::Logger;
+  using Azure::Core::Diagnostics::_internal::Log;
+  using Azure::Core::Http::_detail::DelayedTaskQueue;
+
+  if (!m_hedgingOptions.Enabled || m_hedgingOptions.MaxHedgedRequestsPercentage <= 0
+      || !IsHedgeable(request))
+  {
+    return nextPolicy.Send(request, context);
+  }
+
+  ++m_state->EligibleRequests;
+
+  auto call = std::make_shared<HedgedCall>();
+  call->RetryCount = RetryPolicy::GetRetryCount(context);
+  auto const attemptContext = _detail::WithRetryCount(context, &call->RetryCount);
+  auto const originalContext = attemptContext.WithValue(HedgedAttemptKey, false);
+  call->AttemptContexts.emplace_back(originalContext);
+  call->PendingAttempts = 1;
+
+  auto const start = std::chrono::steady_clock::now();
+
+  // The original attempt is sent from the calling thread. The hedged attempt is sent from a thread
+  // which the delayed task queue only starts once the hedge delay has expired. It sends a copy of
+  // the request, taken before the original attempt changes it.
+  auto const state = m_state;
+  auto const maxHedgedRequestsPercentage = m_hedgingOptions.MaxHedgedRequestsPercentage;
+  {
+    std::lock_guard<std::mutex> lock(state->Mutex);
+    ++state->InFlightAttempts;
+  }
+  auto const hedge = DelayedTaskQueue::Get().Schedule(
+      GetHedgeDelay(*state, m_hedgingOptions),
+      [state, call, maxHedgedRequestsPercentage, start, attemptContext, request, nextPolicy]()
+          mutable {
+        {
+          std::unique_lock<std::mutex> lock(call->Mutex);
+          if (!call->HasWinner && call->PendingAttempts != 0
+              && TryAcquireHedge(*state, maxHedgedRequestsPercentage))
+          {
+            if (Log::ShouldWrite(Logger::Level::Informational))
+            {
+              Log::Write(
+                  Logger::Level::Informational,
+                  "HTTP request did not complete within "
+                      + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                           std::chrono::steady_clock::now() - start)
+                                           .count())
+                      + "ms, sending a hedged request.");
+            }
+
+            auto const hedgedContext = attemptContext.WithValue(HedgedAttemptKey, true);
+            call->AttemptContexts.emplace_back(hedgedContext);
+            ++call->PendingAttempts;
+            lock.unlock();
+            RunAttempt(*call, 1, request, nextPolicy, hedgedContext);
+          }
+        }
+
+        // Nothing that refers to the pipeline may be used past this point, since the policy may
+        // be destroyed as soon as the in-flight count drops to zero.
+        {
+          std::lock_guard<std::mutex> lock(state->Mutex);
+          --state->InFlightAttempts;
+        }
+        state->AttemptFinished.notify_all();
+      });
+
+  RunAttempt(*call, 0, request, nextPolicy, originalContext);
+
+  // The hedged attempt is not sent once the original one has completed, unless it has already
+  // started.
+  if (DelayedTaskQueue::Get().Cancel(hedge))
+  {
+    {
+      std::lock_guard<std::mutex> lock(state->Mutex);
+      --state->InFlightAttempts;
+    }
+    state->AttemptFinished.notify_all();
+  }
+
+  std::unique_lock<std::mutex> lock(call->Mutex);
+  call->Completed.wait(lock, [&call] { return call->HasWinner || call->PendingAttempts == 0; });
+  auto response = std::move(call->Response);
+  auto const hasWinner = call->HasWinner;
+  auto const error = call->Error;
+  lock.unlock();
+
+  if (hasWinner)
+  {
+    RecordLatency(
+        *state,
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start));
+  }
+  if (response)
+  {
+    return response;
+  }
+  std::rethrow_exception(error);
+}
@@ -53,3 +53,17 @@ void Azure::Core::Http::_detail::RawResponseHelpers::InsertHeaderWithValidation(
   // insert (override if duplicated)
   headers[headerName] = headerValue;
 }
+
+void Azure::Core::Http::_detail::RawResponseHelpers::InsertHeaderWithValidation(
+    Azure::Core::Http::_internal::HttpHeaders& headers,
+    std::string const& headerName,
+    std::string const& headerValue)
+{
+  if (std::find_if(headerName.begin(), headerName.end(), IsInvalidHeaderNameChar)
+      != headerName.end())
+  {
+    throw std::invalid_argument("Invalid header name: " + headerName);
+  }
+
+  headers.Set(headerName, headerValue);
+}
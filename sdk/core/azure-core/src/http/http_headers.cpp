@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/core/internal/http/http_headers.hpp"
+
+#include "azure/core/internal/strings.hpp"
+
+using Azure::Core::_internal::StringExtensions;
+using Azure::Core::Http::_internal::HttpHeaders;
+
+namespace {
+// Most requests and responses have fewer headers, so that the storage is allocated once.
+constexpr size_t InitialCapacity = 16;
+constexpr size_t NotFound = static_cast<size_t>(-1);
+} // namespace
+
+size_t HttpHeaders::Hash(std::string const& name) noexcept
+{
+  // 32-bit FNV-1a, which is enough to tell a dozen header names apart.
+  size_t hash = 2166136261u;
+  for (auto const c : name)
+  {
+    hash ^= static_cast<unsigned char>(StringExtensions::ToLower(c));
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+size_t HttpHeaders::IndexOf(std::string const& name, size_t hash) const noexcept
+{
+  for (size_t i = 0; i < m_hashes.size(); ++i)
+  {
+    if (m_hashes[i] == hash
+        && StringExtensions::LocaleInvariantCaseInsensitiveEqual(m_headers[i].first, name))
+    {
+      return i;
+    }
+  }
+  return NotFound;
+}
+
+void HttpHeaders::Set(std::string const& name, std::string const& value)
+{
+  auto const hash = Hash(name);
+  auto const index = IndexOf(name, hash);
+  if (index != NotFound)
+  {
+    m_headers[index].second = value;
+    return;
+  }
+
+  if (m_headers.capacity() == 0)
+  {
+    m_headers.reserve(InitialCapacity);
+    m_hashes.reserve(InitialCapacity);
+  }
+  m_headers.emplace_back(name, value);
+  for (auto& c : m_headers.back().first)
+  {
+    c = StringExtensions::ToLower(c);
+  }
+  m_hashes.push_back(hash);
+}
+
+std::string const* HttpHeaders::Find(std::string const& name, size_t hash) const
+{
+  auto const index = IndexOf(name, hash);
+  return index == NotFound ? nullptr : &m_headers[index].second;
+}
+
+void HttpHeaders::Erase(std::string const& name)
+{
+  auto const index = IndexOf(name, Hash(name));
+  if (index != NotFound)
+  {
+    m_headers.erase(m_headers.begin() + static_cast<std::ptrdiff_t>(index));
+    m_hashes.erase(m_hashes.begin() + static_cast<std::ptrdiff_t>(index));
+  }
+}
+
+void HttpHeaders::CopyTo(Azure::Core::CaseInsensitiveMap& headers) const
+{
+  headers.insert(m_headers.begin(), m_headers.end());
+}
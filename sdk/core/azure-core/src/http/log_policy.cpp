@@ -5,7 +5,11 @@
 #include "azure/core/internal/diagnostics/log.hpp"
 
 #include <chrono>
+#include <exception>
+#include <memory>
 #include <sstream>
+#include <utility>
+#include <vector>
 
 using Azure::Core::Context;
 using namespace Azure::Core;
@@ -32,35 +36,75 @@ inline void AppendHeaders(
   }
 }
 
-inline std::string GetRequestLogMessage(
-    Azure::Core::Http::_internal::HttpSanitizer const& httpSanitizer,
-    Request const& request)
-{
-  std::ostringstream log;
-  log << "HTTP Request : " << request.GetMethod().ToString() << " ";
+// The values of the request are copied so that the message can be formatted by an asynchronous
+// listener, once the request is sent.
+class RequestLogRecord final : public Azure::Core::Diagnostics::_internal::LogRecord {
+  std::shared_ptr<Azure::Core::Http::_internal::HttpSanitizer const> m_httpSanitizer;
+  std::string m_method;
+  Azure::Core::Url m_url;
+  std::vector<std::pair<std::string, std::string>> m_headers;
+
+public:
+  RequestLogRecord(
+      std::shared_ptr<Azure::Core::Http::_internal::HttpSanitizer const> httpSanitizer,
+      Request const& request)
+      : m_httpSanitizer(std::move(httpSanitizer)), m_method(request.GetMethod().ToString()),
+        m_url(request.GetUrl())
+  {
+    m_headers.reserve(16);
+    request.ForEachHeader([&](std::string const& name, std::string const& value) {
+      m_headers.emplace_back(name, value);
+    });
+  }
 
-  Azure::Core::Url urlToLog(httpSanitizer.SanitizeUrl(request.GetUrl()));
-  log << urlToLog.GetAbsoluteUrl();
+  std::string Format() const override
+  {
+    std::ostringstream log;
+    log << "HTTP Request : " << m_method << " ";
 
-  AppendHeaders(log, httpSanitizer, request.GetHeaders());
-  return log.str();
-}
+    Azure::Core::Url urlToLog(m_httpSanitizer->SanitizeUrl(m_url));
+    log << urlToLog.GetAbsoluteUrl();
 
-inline std::string GetResponseLogMessage(
-    Azure::Core::Http::_internal::HttpSanitizer const& httpSanitizer,
-    RawResponse const& response,
-    std::chrono::system_clock::duration const& duration)
-{
-  std::ostringstream log;
+    // The headers are logged sorted by name.
+    AppendHeaders(
+        log, *m_httpSanitizer, Azure::Core::CaseInsensitiveMap(m_headers.begin(), m_headers.end()));
+    return log.str();
+  }
+};
+
+class ResponseLogRecord final : public Azure::Core::Diagnostics::_internal::LogRecord {
+  std::shared_ptr<Azure::Core::Http::_internal::HttpSanitizer const> m_httpSanitizer;
+  int32_t m_majorVersion;
+  int32_t m_minorVersion;
+  HttpStatusCode m_statusCode;
+  std::string m_reasonPhrase;
+  Azure::Core::CaseInsensitiveMap m_headers;
+  std::chrono::system_clock::duration m_duration;
+
+public:
+  ResponseLogRecord(
+      std::shared_ptr<Azure::Core::Http::_internal::HttpSanitizer const> httpSanitizer,
+      RawResponse const& response,
+      std::chrono::system_clock::duration const& duration)
+      : m_httpSanitizer(std::move(httpSanitizer)), m_majorVersion(response.GetMajorVersion()),
+        m_minorVersion(response.GetMinorVersion()), m_statusCode(response.GetStatusCode()),
+        m_reasonPhrase(response.GetReasonPhrase()), m_headers(response.GetHeaders()),
+        m_duration(duration)
+  {
+  }
+
+  std::string Format() const override
+  {
+    std::ostringstream log;
 
-  log << "HTTP/" << response.GetMajorVersion() << '.' << response.GetMinorVersion() << " Response ("
-      << std::chrono::duration_cast<std::chrono::milliseconds>(duration).count()
-      << "ms) : " << static_cast<int>(response.GetStatusCode()) << " "
-      << response.GetReasonPhrase();
+    log << "HTTP/" << m_majorVersion << '.' << m_minorVersion << " Response ("
+        << std::chrono::duration_cast<std::chrono::milliseconds>(m_duration).count()
+        << "ms) : " << static_cast<int>(m_statusCode) << " " << m_reasonPhrase;
 
-  AppendHeaders(log, httpSanitizer, response.GetHeaders());
-  return log.str();
-}
+    AppendHeaders(log, *m_httpSanitizer, m_headers);
+    return log.str();
+  }
+};
 } // namespace
 
 std::set<std::string> const Policies::_detail::g_defaultAllowedHttpQueryParameters = {
@@ -111,7 +155,9 @@ std::unique_ptr<RawResponse> LogPolicy::Send(
 
   if (Log::ShouldWrite(Logger::Level::Verbose))
   {
-    Log::Write(Logger::Level::Informational, GetRequestLogMessage(m_httpSanitizer, request));
+    Log::Write(
+        Logger::Level::Informational,
+        std::make_unique<RequestLogRecord>(m_httpSanitizer, request));
   }
   else
   {
@@ -123,7 +169,43 @@ std::unique_ptr<RawResponse> LogPolicy::Send(
   auto const end = std::chrono::system_clock::now();
 
   Log::Write(
-      Logger::Level::Informational, GetResponseLogMessage(m_httpSanitizer, *response, end - start));
+      Logger::Level::Informational,
+      std::make_unique<ResponseLogRecord>(m_httpSanitizer, *response, end - start));
 
   return response;
 }
+
+void LogPolicy::SendAsync(
+    Request& request,
+    NextHttpPolicy nextPolicy,
+    Context const& context,
+    SendCallback callback) const
+{
+  using Azure::Core::Diagnostics::Logger;
+  using Azure::Core::Diagnostics::_internal::Log;
+
+  if (!Log::ShouldWrite(Logger::Level::Verbose))
+  {
+    nextPolicy.SendAsync(request, context, std::move(callback));
+    return;
+  }
+
+  Log::Write(
+      Logger::Level::Informational, std::make_unique<RequestLogRecord>(m_httpSanitizer, request));
+
+  auto const start = std::chrono::system_clock::now();
+  nextPolicy.SendAsync(
+      request,
+      context,
+      [httpSanitizer = m_httpSanitizer, start, callback = std::move(callback)](
+          std::unique_ptr<RawResponse> response, std::exception_ptr error) {
+        if (response)
+        {
+          auto const end = std::chrono::system_clock::now();
+          Log::Write(
+              Logger::Level::Informational,
+              std::make_unique<ResponseLogRecord>(httpSanitizer, *response, end - start));
+        }
+        callback(std::move(response), error);
+      });
+}
@@ -5,6 +5,10 @@
 
 #include "azure/core/http/http.hpp"
 
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
 using Azure::Core::Context;
 using namespace Azure::Core::Http;
 using namespace Azure::Core::Http::Policies;
@@ -21,3 +25,34 @@ std::unique_ptr<RawResponse> NextHttpPolicy::Send(Request& request, Context cons
 
   return m_policies[m_index + 1]->Send(request, NextHttpPolicy{m_index + 1, m_policies}, context);
 }
+
+void NextHttpPolicy::SendAsync(Request& request, Context const& context, SendCallback callback)
+{
+  if (m_index == m_policies.size() - 1)
+  {
+    // All the policies have run without running a transport policy
+    throw std::invalid_argument("Invalid pipeline. No transport policy found. Endless policy.");
+  }
+
+  m_policies[m_index + 1]->SendAsync(
+      request, NextHttpPolicy{m_index + 1, m_policies}, context, std::move(callback));
+}
+
+void HttpPolicy::SendAsync(
+    Request& request,
+    NextHttpPolicy nextPolicy,
+    Context const& context,
+    SendCallback callback) const
+{
+  std::unique_ptr<RawResponse> response;
+  try
+  {
+    response = Send(request, nextPolicy, context);
+  }
+  catch (...)
+  {
+    callback(nullptr, std::current_exception());
+    return;
+  }
+  callback(std::move(response), nullptr);
+}
@@ -4,10 +4,19 @@
 #include "azure/core/http/raw_response.hpp"
 
 #include "azure/core/http/http.hpp"
+#include "azure/core/http/response_buffer_pool.hpp"
 
 using namespace Azure::Core::IO;
 using namespace Azure::Core::Http;
 
+RawResponse::~RawResponse()
+{
+  if (m_bodyPool)
+  {
+    m_bodyPool->Release(std::move(m_body));
+  }
+}
+
 HttpStatusCode RawResponse::GetStatusCode() const { return m_statusCode; }
 
 std::string const& RawResponse::GetReasonPhrase() const { return m_reasonPhrase; }
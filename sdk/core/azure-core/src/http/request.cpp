@@ -13,18 +13,6 @@ using namespace Azure::Core;
 using namespace Azure::Core::Http;
 using namespace Azure::Core::IO::_internal;
 
-namespace {
-// returns left map plus all items in right
-// when duplicates, left items are preferred
-static Azure::Core::CaseInsensitiveMap MergeMaps(
-    Azure::Core::CaseInsensitiveMap left,
-    Azure::Core::CaseInsensitiveMap const& right)
-{
-  left.insert(right.begin(), right.end());
-  return left;
-}
-} // namespace
-
 Request::Request(HttpMethod httpMethod, Url url, bool shouldBufferResponse)
     : Request(httpMethod, std::move(url), NullBodyStream::GetNullBodyStream(), shouldBufferResponse)
 {
@@ -37,36 +25,40 @@ Request::Request(HttpMethod httpMethod, Url url)
 
 Azure::Nullable<std::string> Request::GetHeader(std::string const& name)
 {
-  for (auto const& hdrs : {m_retryHeaders, m_headers})
+  for (auto const headers : {&m_retryHeaders, &m_headers})
   {
-    auto const header = hdrs.find(name);
-    if (header != hdrs.end())
+    if (auto const value = headers->Find(name))
     {
-      return header->second;
+      return *value;
     }
   }
 
   return {};
 }
 
+bool Request::HasHeader(std::string const& name) const
+{
+  auto const hash = Azure::Core::Http::_internal::HttpHeaders::Hash(name);
+  return m_retryHeaders.Find(name, hash) != nullptr || m_headers.Find(name, hash) != nullptr;
+}
+
 void Request::SetHeader(std::string const& name, std::string const& value)
 {
+  // The headers are stored in lowercase.
   return _detail::RawResponseHelpers::InsertHeaderWithValidation(
-      m_retryModeEnabled ? m_retryHeaders : m_headers,
-      Azure::Core::_internal::StringExtensions::ToLower(name),
-      value);
+      m_retryModeEnabled ? m_retryHeaders : m_headers, name, value);
 }
 
 void Request::RemoveHeader(std::string const& name)
 {
-  this->m_headers.erase(name);
-  this->m_retryHeaders.erase(name);
+  this->m_headers.Erase(name);
+  this->m_retryHeaders.Erase(name);
 }
 
 void Request::StartTry()
 {
   this->m_retryModeEnabled = true;
-  this->m_retryHeaders.clear();
+  this->m_retryHeaders.Clear();
 
   // Make sure to rewind the body stream before each attempt, including the first.
   // It's possible the request doesn't have a body, so make sure to check if a body stream exists.
@@ -82,5 +74,8 @@ Azure::Core::CaseInsensitiveMap Request::GetHeaders() const
 {
   // create map with retry headers which are the most important and we don't want
   // to override them with any duplicate header
-  return MergeMaps(this->m_retryHeaders, this->m_headers);
+  Azure::Core::CaseInsensitiveMap headers;
+  m_retryHeaders.CopyTo(headers);
+  m_headers.CopyTo(headers);
+  return headers;
 }
@@ -6,6 +6,8 @@
 #include "azure/core/internal/tracing/service_tracing.hpp"
 
 #include <algorithm>
+#include <exception>
+#include <memory>
 #include <sstream>
 #include <thread>
 
@@ -15,25 +17,28 @@ using namespace Azure::Core::Http::Policies;
 using namespace Azure::Core::Http::Policies::_internal;
 using namespace Azure::Core::Tracing::_internal;
 
-std::unique_ptr<RawResponse> RequestActivityPolicy::Send(
+namespace {
+// Creates a tracing span over the HTTP request, and propagates it to the HTTP headers.
+TracingContextFactory::TracingContext CreateRequestSpan(
+    TracingContextFactory const& tracingFactory,
+    Azure::Core::Http::_internal::HttpSanitizer const& httpSanitizer,
     Request& request,
-    NextHttpPolicy nextPolicy,
-    Context const& context) const
+    Context const& context)
 {
-  // Find a tracing factory from our context. Note that the factory value is owned by the
-  // context chain so we can manage a raw pointer to the factory.
-  auto tracingFactory = TracingContextFactory::CreateFromContext(context);
+  std::string spanName("HTTP ");
+  spanName.append(request.GetMethod().ToString());
 
-  // If our tracing factory has a tracer attached to it, register the request with the tracer.
-  if (tracingFactory && tracingFactory->HasTracer())
-  {
-    // Create a tracing span over the HTTP request.
-    std::string spanName("HTTP ");
-    spanName.append(request.GetMethod().ToString());
+  // The span is created before computing its attributes, which are only added when the span is
+  // sampled, so that the requests which aren't traced don't pay for the URL sanitization.
+  CreateSpanOptions createOptions;
+  createOptions.Kind = SpanKind::Client;
+
+  auto contextAndSpan = tracingFactory.CreateTracingContext(spanName, createOptions, context);
+  auto& scope = contextAndSpan.Span;
 
-    CreateSpanOptions createOptions;
-    createOptions.Kind = SpanKind::Client;
-    createOptions.Attributes = tracingFactory->CreateAttributeSet();
+  if (scope.IsRecording())
+  {
+    auto attributes = tracingFactory.CreateAttributeSet();
     // Note that the AttributeSet takes a *reference* to the values passed into the
     // AttributeSet. This means that all the values passed into the AttributeSet MUST be
     // stabilized across the lifetime of the AttributeSet.
@@ -41,38 +46,72 @@ std::unique_ptr<RawResponse> RequestActivityPolicy::Send(
     // Note that request.GetMethod() returns an HttpMethod object, which is always a static
     // object, and thus its lifetime is constant. That is not the case for the other values
     // stored in the attributes.
-    createOptions.Attributes->AddAttribute(
+    attributes->AddAttribute(
         TracingAttributes::HttpMethod.ToString(), request.GetMethod().ToString());
 
-    const std::string sanitizedUrl = m_httpSanitizer.SanitizeUrl(request.GetUrl()).GetAbsoluteUrl();
-    createOptions.Attributes->AddAttribute(TracingAttributes::HttpUrl.ToString(), sanitizedUrl);
+    const std::string sanitizedUrl = httpSanitizer.SanitizeUrl(request.GetUrl()).GetAbsoluteUrl();
+    attributes->AddAttribute(TracingAttributes::HttpUrl.ToString(), sanitizedUrl);
 
-    createOptions.Attributes->AddAttribute(
-        TracingAttributes::NetPeerPort.ToString(), request.GetUrl().GetPort());
+    attributes->AddAttribute(TracingAttributes::NetPeerPort.ToString(), request.GetUrl().GetPort());
     const std::string host = request.GetUrl().GetScheme() + "://" + request.GetUrl().GetHost();
-    createOptions.Attributes->AddAttribute(TracingAttributes::NetPeerName.ToString(), host);
+    attributes->AddAttribute(TracingAttributes::NetPeerName.ToString(), host);
 
     const Azure::Nullable<std::string> requestId = request.GetHeader("x-ms-client-request-id");
     if (requestId.HasValue())
     {
-      createOptions.Attributes->AddAttribute(
-          TracingAttributes::RequestId.ToString(), requestId.Value());
+      attributes->AddAttribute(TracingAttributes::RequestId.ToString(), requestId.Value());
     }
 
     auto userAgent{request.GetHeader("User-Agent")};
     if (userAgent.HasValue())
     {
-      createOptions.Attributes->AddAttribute(
-          TracingAttributes::HttpUserAgent.ToString(), userAgent.Value());
+      attributes->AddAttribute(TracingAttributes::HttpUserAgent.ToString(), userAgent.Value());
     }
 
-    auto contextAndSpan = tracingFactory->CreateTracingContext(spanName, createOptions, context);
-    auto scope = std::move(contextAndSpan.Span);
+    scope.AddAttributes(*attributes);
+  }
+
+  // Propagate information from the scope to the HTTP headers.
+  //
+  // This will add the "traceparent" header and any other OpenTelemetry related headers.
+  scope.PropagateToHttpHeaders(request);
 
-    // Propagate information from the scope to the HTTP headers.
-    //
-    // This will add the "traceparent" header and any other OpenTelemetry related headers.
-    scope.PropagateToHttpHeaders(request);
+  return contextAndSpan;
+}
+
+// Registers the headers we received from the service.
+void AddResponseAttributes(ServiceSpan& scope, RawResponse const& response)
+{
+  if (scope.IsRecording())
+  {
+    scope.AddAttribute(
+        TracingAttributes::HttpStatusCode.ToString(),
+        std::to_string(static_cast<int>(response.GetStatusCode())));
+    auto const& responseHeaders = response.GetHeaders();
+    auto serviceRequestId = responseHeaders.find("x-ms-request-id");
+    if (serviceRequestId != responseHeaders.end())
+    {
+      scope.AddAttribute(TracingAttributes::ServiceRequestId.ToString(), serviceRequestId->second);
+    }
+  }
+}
+} // namespace
+
+std::unique_ptr<RawResponse> RequestActivityPolicy::Send(
+    Request& request,
+    NextHttpPolicy nextPolicy,
+    Context const& context) const
+{
+  // Find a tracing factory from our context. Note that the factory value is owned by the
+  // context chain so we can manage a raw pointer to the factory.
+  auto tracingFactory = TracingContextFactory::CreateFromContext(context);
+
+  // If our tracing factory has a tracer attached to it, register the request with the tracer.
+  if (tracingFactory && tracingFactory->HasTracer())
+  {
+    // Create a tracing span over the HTTP request.
+    auto contextAndSpan = CreateRequestSpan(*tracingFactory, m_httpSanitizer, request, context);
+    auto scope = std::move(contextAndSpan.Span);
 
     try
     {
@@ -80,16 +119,7 @@ std::unique_ptr<RawResponse> RequestActivityPolicy::Send(
       auto response = nextPolicy.Send(request, contextAndSpan.Context);
 
       // And register the headers we received from the service.
-      scope.AddAttribute(
-          TracingAttributes::HttpStatusCode.ToString(),
-          std::to_string(static_cast<int>(response->GetStatusCode())));
-      auto const& responseHeaders = response->GetHeaders();
-      auto serviceRequestId = responseHeaders.find("x-ms-request-id");
-      if (serviceRequestId != responseHeaders.end())
-      {
-        scope.AddAttribute(
-            TracingAttributes::ServiceRequestId.ToString(), serviceRequestId->second);
-      }
+      AddResponseAttributes(scope, *response);
 
       return response;
     }
@@ -107,3 +137,51 @@ std::unique_ptr<RawResponse> RequestActivityPolicy::Send(
     return nextPolicy.Send(request, context);
   }
 }
+
+void RequestActivityPolicy::SendAsync(
+    Request& request,
+    NextHttpPolicy nextPolicy,
+    Context const& context,
+    SendCallback callback) const
+{
+  auto tracingFactory = TracingContextFactory::CreateFromContext(context);
+  if (!tracingFactory || !tracingFactory->HasTracer())
+  {
+    nextPolicy.SendAsync(request, context, std::move(callback));
+    return;
+  }
+
+  auto contextAndSpan = CreateRequestSpan(*tracingFactory, m_httpSanitizer, request, context);
+  auto scope = std::make_shared<ServiceSpan>(std::move(contextAndSpan.Span));
+  nextPolicy.SendAsync(
+      request,
+      contextAndSpan.Context,
+      [scope, callback = std::move(callback)](
+          std::unique_ptr<RawResponse> response, std::exception_ptr error) {
+        if (response)
+        {
+          AddResponseAttributes(*scope, *response);
+        }
+        else
+        {
+          try
+          {
+            std::rethrow_exception(error);
+          }
+          catch (const TransportException& e)
+          {
+            scope->AddEvent(e);
+            scope->SetStatus(SpanStatus::Error);
+          }
+          catch (...)
+          {
+          }
+        }
+
+        {
+          // The span ends before the response goes up the stack, as when Send() returns.
+          auto const ended = std::move(*scope);
+        }
+        callback(std::move(response), error);
+      });
+}
@@ -0,0 +1,132 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/core/http/policies/policy.hpp"
+#include "azure/core/internal/metrics/service_metrics.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <string>
+#include <utility>
+
+using Azure::Core::Context;
+using namespace Azure::Core::Http;
+using namespace Azure::Core::Http::Policies;
+using namespace Azure::Core::Http::Policies::_internal;
+using Azure::Core::Metrics::_internal::HttpClientMetrics;
+
+namespace {
+void RecordRequest(HttpClientMetrics const& metrics, Request const& request)
+{
+  metrics.RequestBodySize->Record(
+      static_cast<double>(request.GetBodyStream()->Length()),
+      {{HttpClientMetrics::HttpRequestMethod, request.GetMethod().ToString()},
+       {HttpClientMetrics::ServerAddress, request.GetUrl().GetHost()}});
+}
+
+void RecordTransportFailure(
+    HttpClientMetrics const& metrics,
+    std::string const& method,
+    std::string const& host,
+    std::chrono::steady_clock::time_point start)
+{
+  metrics.RequestDuration->Record(
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(),
+      {{HttpClientMetrics::HttpRequestMethod, method},
+       {HttpClientMetrics::ServerAddress, host},
+       {HttpClientMetrics::ErrorType, "TransportException"}});
+}
+
+void RecordResponse(
+    HttpClientMetrics const& metrics,
+    std::string const& method,
+    std::string const& host,
+    std::chrono::steady_clock::time_point start,
+    RawResponse const& response)
+{
+  auto const statusCode = std::to_string(static_cast<int>(response.GetStatusCode()));
+  metrics.RequestDuration->Record(
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(),
+      {{HttpClientMetrics::HttpRequestMethod, method},
+       {HttpClientMetrics::ServerAddress, host},
+       {HttpClientMetrics::HttpResponseStatusCode, statusCode}});
+
+  auto const& responseHeaders = response.GetHeaders();
+  auto const contentLength = responseHeaders.find("Content-Length");
+  if (contentLength != responseHeaders.end())
+  {
+    metrics.ResponseBodySize->Record(
+        std::strtod(contentLength->second.c_str(), nullptr),
+        {{HttpClientMetrics::HttpRequestMethod, method},
+         {HttpClientMetrics::ServerAddress, host},
+         {HttpClientMetrics::HttpResponseStatusCode, statusCode}});
+  }
+}
+} // namespace
+
+std::unique_ptr<RawResponse> RequestMetricsPolicy::Send(
+    Request& request,
+    NextHttpPolicy nextPolicy,
+    Context const& context) const
+{
+  auto const& method = request.GetMethod().ToString();
+  auto const& host = request.GetUrl().GetHost();
+
+  RecordRequest(*m_metrics, request);
+
+  auto const start = std::chrono::steady_clock::now();
+  std::unique_ptr<RawResponse> response;
+  try
+  {
+    response = nextPolicy.Send(request, context);
+  }
+  catch (const TransportException&)
+  {
+    RecordTransportFailure(*m_metrics, method, host, start);
+    throw;
+  }
+
+  RecordResponse(*m_metrics, method, host, start, *response);
+  return response;
+}
+
+void RequestMetricsPolicy::SendAsync(
+    Request& request,
+    NextHttpPolicy nextPolicy,
+    Context const& context,
+    SendCallback callback) const
+{
+  RecordRequest(*m_metrics, request);
+
+  auto const start = std::chrono::steady_clock::now();
+  nextPolicy.SendAsync(
+      request,
+      context,
+      [metrics = m_metrics,
+       method = request.GetMethod().ToString(),
+       host = request.GetUrl().GetHost(),
+       start,
+       callback = std::move(callback)](
+          std::unique_ptr<RawResponse> response, std::exception_ptr error) {
+        if (response)
+        {
+          RecordResponse(*metrics, method, host, start, *response);
+        }
+        else
+        {
+          try
+          {
+            std::rethrow_exception(error);
+          }
+          catch (const TransportException&)
+          {
+            RecordTransportFailure(*metrics, method, host, start);
+          }
+          catch (...)
+          {
+          }
+        }
+        callback(std::move(response), error);
+      });
+}
@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/core/http/response_buffer_pool.hpp"
+
+#include <utility>
+
+using Azure::Core::Http::ResponseBufferPool;
+
+std::vector<uint8_t> ResponseBufferPool::Acquire(size_t sizeHint)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_buffers.empty())
+  {
+    return {};
+  }
+
+  // Take the smallest buffer large enough for the content, or else the largest one, so that the
+  // large buffers are kept for the large responses.
+  size_t best = 0;
+  for (size_t i = 1; i < m_buffers.size(); ++i)
+  {
+    auto const capacity = m_buffers[i].capacity();
+    auto const bestCapacity = m_buffers[best].capacity();
+    if (bestCapacity >= sizeHint ? (capacity >= sizeHint && capacity < bestCapacity)
+                                 : capacity > bestCapacity)
+    {
+      best = i;
+    }
+  }
+
+  std::vector<uint8_t> buffer(std::move(m_buffers[best]));
+  if (best != m_buffers.size() - 1)
+  {
+    m_buffers[best] = std::move(m_buffers.back());
+  }
+  m_buffers.pop_back();
+  return buffer;
+}
+
+void ResponseBufferPool::Release(std::vector<uint8_t> buffer)
+{
+  if (buffer.capacity() == 0 || buffer.capacity() > m_options.MaxBufferSize)
+  {
+    return;
+  }
+
+  buffer.clear();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_buffers.size() < m_options.MaxBufferCount)
+  {
+    m_buffers.push_back(std::move(buffer));
+  }
+}
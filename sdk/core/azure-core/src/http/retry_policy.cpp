@@ -3,17 +3,27 @@
 
 #include "azure/core/http/policies/policy.hpp"
 #include "azure/core/internal/diagnostics/log.hpp"
+#include "delayed_task_queue_private.hpp"
+#include "retry_policy_private.hpp"
 
 #include <algorithm>
 #include <cstdlib>
+#include <exception>
+#include <functional>
 #include <limits>
+#include <map>
+#include <memory>
 #include <sstream>
+#include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 using Azure::Core::Context;
 using namespace Azure::Core::Http;
 using namespace Azure::Core::Http::Policies;
 using namespace Azure::Core::Http::Policies::_internal;
+using Azure::Core::Metrics::_internal::HttpClientMetrics;
 
 namespace {
 bool GetResponseHeaderBasedDelay(RawResponse const& response, std::chrono::milliseconds& retryAfter)
@@ -100,9 +110,70 @@ bool WasLastAttempt(RetryOptions const& retryOptions, int32_t attempt)
   return attempt > retryOptions.MaxRetries;
 }
 
+void LogAndCountRetry(
+    Request const& request,
+    Context const& context,
+    int32_t attempt,
+    std::chrono::milliseconds retryAfter)
+{
+  using Azure::Core::Diagnostics::Logger;
+  using Azure::Core::Diagnostics::_internal::Log;
+
+  if (Log::ShouldWrite(Logger::Level::Informational))
+  {
+    std::ostringstream log;
+
+    log << "HTTP Retry attempt #" << attempt << " will be made in "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(retryAfter).count() << "ms.";
+
+    Log::Write(Logger::Level::Informational, log.str());
+  }
+
+  if (auto const metrics = HttpClientMetrics::CreateFromContext(context))
+  {
+    metrics->Retries->Add(
+        1,
+        {{HttpClientMetrics::HttpRequestMethod, request.GetMethod().ToString()},
+         {HttpClientMetrics::ServerAddress, request.GetUrl().GetHost()}});
+  }
+}
+
 Context::Key const RetryKey;
 } // namespace
 
+namespace Azure { namespace Core { namespace Http { namespace Policies { namespace _detail {
+  // The state of a request sent with RetryPolicy::SendAsync(), shared by its tries.
+  struct RetryState final
+  {
+    Request& TheRequest;
+    NextHttpPolicy NextPolicy;
+    Context OriginalContext;
+    SendCallback Callback;
+    // retryCount needs to be apart from RetryNumber attempt.
+    int32_t RetryCount = 0;
+    int32_t Attempt = 0;
+    Context RetryContext;
+    std::map<std::string, std::string> OriginalQueryParameters;
+
+    RetryState(
+        Request& request,
+        NextHttpPolicy nextPolicy,
+        Context const& context,
+        SendCallback callback)
+        : TheRequest(request), NextPolicy(std::move(nextPolicy)), OriginalContext(context),
+          Callback(std::move(callback)), RetryContext(context.WithValue(RetryKey, &RetryCount))
+    {
+    }
+  };
+}}}}} // namespace Azure::Core::Http::Policies::_detail
+
+Context Azure::Core::Http::Policies::_detail::WithRetryCount(
+    Context const& context,
+    int32_t* retryCount)
+{
+  return context.WithValue(RetryKey, retryCount);
+}
+
 int32_t RetryPolicy::GetRetryCount(Context const& context)
 {
   int32_t number = -1;
@@ -162,15 +233,7 @@ std::unique_ptr<RawResponse> RetryPolicy::Send(
       }
     }
 
-    if (Log::ShouldWrite(Logger::Level::Informational))
-    {
-      std::ostringstream log;
-
-      log << "HTTP Retry attempt #" << attempt << " will be made in "
-          << std::chrono::duration_cast<std::chrono::milliseconds>(retryAfter).count() << "ms.";
-
-      Log::Write(Logger::Level::Informational, log.str());
-    }
+    LogAndCountRetry(request, context, attempt, retryAfter);
 
     // Sleep(0) behavior is implementation-defined: it may yield, or may do nothing. Let's make sure
     // we proceed immediately if it is 0.
@@ -189,6 +252,121 @@ std::unique_ptr<RawResponse> RetryPolicy::Send(
   }
 }
 
+void RetryPolicy::SendAsync(
+    Request& request,
+    NextHttpPolicy nextPolicy,
+    Context const& context,
+    SendCallback callback) const
+{
+  SendTryAsync(std::make_shared<_detail::RetryState>(
+      request, std::move(nextPolicy), context, std::move(callback)));
+}
+
+void RetryPolicy::SendTryAsync(std::shared_ptr<_detail::RetryState> state) const
+{
+  using Azure::Core::Diagnostics::Logger;
+  using Azure::Core::Diagnostics::_internal::Log;
+
+  state->Attempt += 1;
+  state->TheRequest.StartTry();
+  // creates a copy of original query parameters from request
+  state->OriginalQueryParameters = state->TheRequest.GetUrl().GetQueryParameters();
+
+  state->NextPolicy.SendAsync(
+      state->TheRequest,
+      state->RetryContext,
+      [this, state](std::unique_ptr<RawResponse> response, std::exception_ptr error) {
+        std::chrono::milliseconds retryAfter{};
+        bool shouldRetry = false;
+        try
+        {
+          if (response)
+          {
+            shouldRetry = ShouldRetryOnResponse(
+                *response.get(), m_retryOptions, state->Attempt, retryAfter);
+          }
+          else
+          {
+            try
+            {
+              std::rethrow_exception(error);
+            }
+            catch (const TransportException& e)
+            {
+              if (Log::ShouldWrite(Logger::Level::Warning))
+              {
+                Log::Write(
+                    Logger::Level::Warning, std::string("HTTP Transport error: ") + e.what());
+              }
+
+              shouldRetry
+                  = ShouldRetryOnTransportFailure(m_retryOptions, state->Attempt, retryAfter);
+            }
+          }
+
+          if (shouldRetry)
+          {
+            LogAndCountRetry(state->TheRequest, state->OriginalContext, state->Attempt, retryAfter);
+
+            // Before waiting, check to make sure that the context hasn't already been cancelled.
+            if (retryAfter.count() > 0)
+            {
+              state->OriginalContext.ThrowIfCancelled();
+            }
+          }
+        }
+        catch (...)
+        {
+          error = std::current_exception();
+          response.reset();
+          shouldRetry = false;
+        }
+
+        if (!shouldRetry)
+        {
+          auto const callback = std::move(state->Callback);
+          callback(std::move(response), error);
+          return;
+        }
+
+        auto const retry = [this, state]() {
+          try
+          {
+            // Restore the original query parameters before next retry
+            state->TheRequest.GetUrl().SetQueryParameters(
+                std::move(state->OriginalQueryParameters));
+
+            // Update retry number
+            state->RetryCount += 1;
+            SendTryAsync(state);
+          }
+          catch (...)
+          {
+            // The try couldn't be sent. Once the callback was called, the exception comes from it
+            // and is the caller's.
+            if (!state->Callback)
+            {
+              throw;
+            }
+            auto const callback = std::move(state->Callback);
+            callback(nullptr, std::current_exception());
+          }
+        };
+
+        // Proceed immediately when there is no delay. Otherwise, the retry runs on a thread of its
+        // own once the delay expires, since the next policies may block until the response is
+        // received.
+        if (retryAfter.count() > 0)
+        {
+          Azure::Core::Http::_detail::DelayedTaskQueue::Get().Schedule(retryAfter, retry);
+        }
+        else
+        {
+          retry();
+        }
+      });
+}
+
 bool RetryPolicy::ShouldRetryOnTransportFailure(
     RetryOptions const& retryOptions,
     int32_t attempt,
@@ -0,0 +1,22 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "azure/core/context.hpp"
+
+#include <cstdint>
+
+namespace Azure { namespace Core { namespace Http { namespace Policies { namespace _detail {
+
+  /**
+   * @brief Creates a child of \p context on which
+   * #Azure::Core::Http::Policies::_internal::RetryPolicy::GetRetryCount() reports the value
+   * pointed to by \p retryCount.
+   *
+   * @remark Used by policies which send a try from a thread that may outlive the retry policy
+   * stack frame.
+   */
+  Context WithRetryCount(Context const& context, int32_t* retryCount);
+
+}}}}} // namespace Azure::Core::Http::Policies::_detail
@@ -3,18 +3,23 @@
 
 #include "azure/core/http/policies/policy.hpp"
 
+#include <string>
+#include <utility>
+
 using Azure::Core::Context;
 using namespace Azure::Core::Http;
 using namespace Azure::Core::Http::Policies;
 using namespace Azure::Core::Http::Policies::_internal;
 
+namespace {
+std::string const UserAgent{"User-Agent"};
+} // namespace
+
 std::unique_ptr<RawResponse> Azure::Core::Http::Policies::_internal::TelemetryPolicy::Send(
     Request& request,
     NextHttpPolicy nextPolicy,
     Context const& context) const
 {
-  static std::string const UserAgent{"User-Agent"};
-
   if (!request.GetHeader(UserAgent).HasValue())
   {
     request.SetHeader(UserAgent, m_telemetryId);
@@ -22,3 +27,17 @@ std::unique_ptr<RawResponse> Azure::Core::Http::Policies::_internal::TelemetryPo
 
   return nextPolicy.Send(request, context);
 }
+
+void Azure::Core::Http::Policies::_internal::TelemetryPolicy::SendAsync(
+    Request& request,
+    NextHttpPolicy nextPolicy,
+    Context const& context,
+    SendCallback callback) const
+{
+  if (!request.GetHeader(UserAgent).HasValue())
+  {
+    request.SetHeader(UserAgent, m_telemetryId);
+  }
+
+  nextPolicy.SendAsync(request, context, std::move(callback));
+}
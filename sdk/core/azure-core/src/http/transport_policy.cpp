@@ -11,8 +11,12 @@
 #include "azure/core/http/win_http_transport.hpp"
 #endif
 
+#include "../io/body_stream_private.hpp"
+
+#include <exception>
 #include <sstream>
 #include <string>
+#include <utility>
 
 using Azure::Core::Context;
 using namespace Azure::Core::IO;
@@ -92,6 +96,41 @@ TransportPolicy::TransportPolicy(TransportOptions const& options) : m_options(op
   }
 }
 
+void TransportPolicy::BufferResponse(
+    Request const& request,
+    RawResponse& response,
+    Context const& context) const
+{
+  auto statusCode = static_cast<typename std::underlying_type<Http::HttpStatusCode>::type>(
+      response.GetStatusCode());
+
+  // special case to return a response with BodyStream to read directly from socket
+  // Return only if response did not fail.
+  if (!request.ShouldBufferResponse() && statusCode < 300)
+  {
+    return;
+  }
+
+  // At this point, either the request is `shouldBufferResponse` or it return with an error code.
+  // The entire payload needs must be downloaded to the response's buffer.
+  auto bodyStream = response.ExtractBodyStream();
+  auto const length = bodyStream->Length();
+  if (m_options.ResponseBufferPool && length != 0)
+  {
+    auto body = m_options.ResponseBufferPool->Acquire(length > 0 ? static_cast<size_t>(length) : 0);
+    Azure::Core::IO::_detail::ReadToEnd(*bodyStream, body, context);
+    response.m_body = std::move(body);
+    response.m_bodyPool = m_options.ResponseBufferPool;
+  }
+  else
+  {
+    response.SetBody(bodyStream->ReadToEnd(context));
+  }
+
+  // BodyStream is moved out of response. This makes transport implementation to clean any active
+  // session with sockets or internal state.
+}
+
 std::unique_ptr<RawResponse> TransportPolicy::Send(
     Request& request,
     NextHttpPolicy,
@@ -118,22 +157,46 @@ std::unique_ptr<RawResponse> TransportPolicy::Send(
    *
    */
   auto response = m_options.Transport->Send(request, context);
-  auto statusCode = static_cast<typename std::underlying_type<Http::HttpStatusCode>::type>(
-      response->GetStatusCode());
+  BufferResponse(request, *response, context);
+  return response;
+}
 
-  // special case to return a response with BodyStream to read directly from socket
-  // Return only if response did not fail.
-  if (!request.ShouldBufferResponse() && statusCode < 300)
+void TransportPolicy::SendAsync(
+    Request& request,
+    NextHttpPolicy,
+    Context const& context,
+    SendCallback callback) const
+{
+  if (context.IsCancelled())
   {
-    return response;
+    callback(
+        nullptr,
+        std::make_exception_ptr(
+            Azure::Core::OperationCancelledException("Request was cancelled by context.")));
+    return;
   }
 
-  // At this point, either the request is `shouldBufferResponse` or it return with an error code.
-  // The entire payload needs must be downloaded to the response's buffer.
-  auto bodyStream = response->ExtractBodyStream();
-  response->SetBody(bodyStream->ReadToEnd(context));
-
-  // BodyStream is moved out of response. This makes transport implementation to clean any active
-  // session with sockets or internal state.
-  return response;
+  // The body is buffered on the thread calling the callback. The transports which mustn't be
+  // blocked, e.g. the HTTP/2 mode of the libcurl transport, complete a request whose response is
+  // buffered once its body is received.
+  auto const requestContext = context;
+  m_options.Transport->SendAsync(
+      request,
+      context,
+      [this, &request, requestContext, callback = std::move(callback)](
+          std::unique_ptr<RawResponse> response, std::exception_ptr error) {
+        if (response)
+        {
+          try
+          {
+            BufferResponse(request, *response, requestContext);
+          }
+          catch (...)
+          {
+            error = std::current_exception();
+            response.reset();
+          }
+        }
+        callback(std::move(response), error);
+      });
 }
@@ -258,24 +258,19 @@ std::string GetHeadersAsString(Azure::Core::Http::Request const& request)
 {
   std::string requestHeaderString;
 
-  // request.GetHeaders() aggregates the pre- and post-retry headers into a single map. Capture it
-  // so we don't recalculate the merge multiple times.
-  auto requestHeaders = request.GetHeaders();
-
-  for (auto const& header : requestHeaders)
-  {
-    requestHeaderString += header.first; // string (key)
+  request.ForEachHeader([&](std::string const& name, std::string const& value) {
+    requestHeaderString += name;
     requestHeaderString += ": ";
-    requestHeaderString += header.second; // string's value
+    requestHeaderString += value;
     requestHeaderString += "\r\n";
-  }
+  });
 
   // The test recording infrastructure requires that a Patch verb have a Content-Length header,
   // because it does not distinguish between requests with and without a body if there's no
   // Content-Length header.
   if (request.GetMethod() == HttpMethod::Patch)
   {
-    if (requestHeaders.find("Content-Length") == requestHeaders.end())
+    if (!request.HasHeader("Content-Length"))
     {
       if (request.GetBodyStream() == nullptr || request.GetBodyStream()->Length() == 0)
       {
@@ -1503,8 +1498,9 @@ namespace Azure { namespace Core { namespace Http { namespace _detail {
     std::wstring encodedHeaders;
     int encodedHeadersLength = 0;
 
-    auto requestHeaders = request.GetHeaders();
-    if (requestHeaders.size() != 0)
+    bool hasHeaders = false;
+    request.ForEachHeader([&](std::string const&, std::string const&) { hasHeaders = true; });
+    if (hasHeaders)
     {
       // The encodedHeaders will be null-terminated and the length is calculated.
       encodedHeadersLength = -1;
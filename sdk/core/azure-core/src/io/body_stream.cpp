@@ -22,6 +22,7 @@
 #include "azure/core/context.hpp"
 #include "azure/core/internal/io/null_body_stream.hpp"
 #include "azure/core/io/body_stream.hpp"
+#include "body_stream_private.hpp"
 
 #include <algorithm>
 #include <codecvt>
@@ -61,22 +62,53 @@ size_t BodyStream::ReadToCount(uint8_t* buffer, size_t count, Context const& con
 }
 
 std::vector<uint8_t> BodyStream::ReadToEnd(Context const& context)
+{
+  std::vector<uint8_t> buffer;
+  _detail::ReadToEnd(*this, buffer, context);
+  return buffer;
+}
+
+void Azure::Core::IO::_detail::ReadToEnd(
+    BodyStream& bodyStream,
+    std::vector<uint8_t>& buffer,
+    Context const& context)
 {
   constexpr size_t chunkSize = 1024 * 8;
-  auto buffer = std::vector<uint8_t>();
+  // Beyond this size, the buffer only grows as the content is received, so that a wrong length
+  // doesn't make the stream allocate much more than it reads.
+  constexpr int64_t maxPreallocatedSize = 1024 * 1024 * 64;
+
+  auto const length = bodyStream.Length();
+  buffer.clear();
+  if (length > 0)
+  {
+    buffer.resize(static_cast<size_t>((std::min)(length, maxPreallocatedSize)));
+  }
+  else
+  {
+    buffer.resize((std::max)(buffer.capacity(), chunkSize));
+  }
 
-  for (auto chunkNumber = 0;; chunkNumber++)
+  size_t size = 0;
+  for (;;)
   {
-    buffer.resize((static_cast<decltype(buffer)::size_type>(chunkNumber) + 1) * chunkSize);
-    size_t readBytes
-        = this->ReadToCount(buffer.data() + (chunkNumber * chunkSize), chunkSize, context);
+    size += bodyStream.ReadToCount(buffer.data() + size, buffer.size() - size, context);
+    if (size < buffer.size())
+    {
+      break;
+    }
 
-    if (readBytes < chunkSize)
+    // The buffer is full, which is expected when the length is known: make sure that the stream
+    // ended before growing the buffer.
+    uint8_t nextByte = 0;
+    if (bodyStream.ReadToCount(&nextByte, 1, context) == 0)
     {
-      buffer.resize(static_cast<size_t>((chunkNumber * chunkSize) + readBytes));
-      return buffer;
+      break;
     }
+    buffer.resize(buffer.size() * 2);
+    buffer[size++] = nextByte;
   }
+  buffer.resize(size);
 }
 
 size_t MemoryBodyStream::OnRead(uint8_t* buffer, size_t count, Context const& context)
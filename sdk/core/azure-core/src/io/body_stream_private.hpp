@@ -0,0 +1,26 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "azure/core/context.hpp"
+#include "azure/core/io/body_stream.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Azure { namespace Core { namespace IO { namespace _detail {
+
+  /**
+   * @brief Reads \p bodyStream to end into \p buffer, replacing its content but reusing its
+   * capacity.
+   *
+   * @details When the length of the stream is known, the buffer is sized for it and the content is
+   * read with a single #Azure::Core::IO::BodyStream::ReadToCount() call.
+   */
+  void ReadToEnd(
+      Azure::Core::IO::BodyStream& bodyStream,
+      std::vector<uint8_t>& buffer,
+      Azure::Core::Context const& context);
+
+}}}} // namespace Azure::Core::IO::_detail
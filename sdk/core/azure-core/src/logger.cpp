@@ -4,10 +4,14 @@
 #include "azure/core/diagnostics/logger.hpp"
 
 #include "azure/core/internal/diagnostics/log.hpp"
+#include "private/async_log_sink.hpp"
 #include "private/environment_log_level_listener.hpp"
 
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
+#include <system_error>
+#include <thread>
 
 using namespace Azure::Core::Diagnostics;
 using namespace Azure::Core::Diagnostics::_internal;
@@ -16,6 +20,41 @@ namespace {
 std::shared_timed_mutex g_logListenerMutex{};
 std::function<void(Logger::Level level, std::string const& message)> g_logListener(
     _detail::EnvironmentLogLevelListener::GetLogListener());
+// Not destroyed when the application exits: joining its thread from a static destructor could
+// deadlock, e.g. while a DLL is unloaded on Windows. Shared with the threads waiting in
+// Logger::Flush(), which don't hold the lock while they wait.
+std::shared_ptr<_detail::AsyncLogSink>* const g_asyncLogSink
+    = new std::shared_ptr<_detail::AsyncLogSink>();
+
+void SetLogListener(
+    std::function<void(Logger::Level level, std::string const& message)> listener,
+    std::shared_ptr<_detail::AsyncLogSink> asyncLogSink)
+{
+  std::shared_ptr<_detail::AsyncLogSink> previousAsyncLogSink;
+  {
+    std::unique_lock<std::shared_timed_mutex> loggerLock(g_logListenerMutex);
+    previousAsyncLogSink = std::move(*g_asyncLogSink);
+    *g_asyncLogSink = std::move(asyncLogSink);
+    g_logListener = std::move(listener);
+    Log::EnableLogging(g_logListener != nullptr);
+  }
+
+  // The messages queued for the previous listener are delivered when its sink is destroyed,
+  // outside of the lock since the previous listener may log. The destructor joins the listener
+  // thread, so the listener setting another listener leaves the sink to a thread of its own.
+  if (previousAsyncLogSink && previousAsyncLogSink->IsListenerThread())
+  {
+    // Leaked if no thread can be started, rather than joining the calling thread.
+    auto const sink = new std::shared_ptr<_detail::AsyncLogSink>(std::move(previousAsyncLogSink));
+    try
+    {
+      std::thread([sink]() { delete sink; }).detach();
+    }
+    catch (std::system_error const&)
+    {
+    }
+  }
+}
 } // namespace
 
 std::atomic<bool> Log::g_isLoggingEnabled(
@@ -33,19 +72,70 @@ void Log::Write(Logger::Level level, std::string const& message)
   if (ShouldWrite(level) && !message.empty())
   {
     std::shared_lock<std::shared_timed_mutex> loggerLock(g_logListenerMutex);
-    if (g_logListener)
+    if (*g_asyncLogSink)
+    {
+      (*g_asyncLogSink)->Write(level, message);
+    }
+    else if (g_logListener)
     {
       g_logListener(level, message);
     }
   }
 }
 
+void Log::Write(Logger::Level level, std::unique_ptr<LogRecord> record)
+{
+  if (ShouldWrite(level) && record != nullptr)
+  {
+    std::shared_lock<std::shared_timed_mutex> loggerLock(g_logListenerMutex);
+    if (*g_asyncLogSink)
+    {
+      (*g_asyncLogSink)->Write(level, std::move(record));
+    }
+    else if (g_logListener)
+    {
+      auto const message = record->Format();
+      if (!message.empty())
+      {
+        g_logListener(level, message);
+      }
+    }
+  }
+}
+
 void Logger::SetListener(
     std::function<void(Logger::Level level, std::string const& message)> listener)
 {
-  std::unique_lock<std::shared_timed_mutex> loggerLock(g_logListenerMutex);
-  g_logListener = std::move(listener);
-  Log::EnableLogging(g_logListener != nullptr);
+  SetLogListener(std::move(listener), nullptr);
+}
+
+void Logger::SetAsyncListener(
+    std::function<void(Logger::Level level, std::string const& message)> listener,
+    AsyncLogListenerOptions const& options)
+{
+  std::shared_ptr<_detail::AsyncLogSink> asyncLogSink;
+  if (listener)
+  {
+    asyncLogSink = std::make_shared<_detail::AsyncLogSink>(listener, options.Capacity);
+  }
+  SetLogListener(std::move(listener), std::move(asyncLogSink));
+}
+
+void Logger::Flush()
+{
+  // Waiting with the lock held would deadlock with a listener that logs, once a thread setting
+  // the listener queues for the lock. The listener itself can't wait for its own messages, and
+  // mustn't release the last reference to its sink, which joins the listener thread.
+  std::shared_ptr<_detail::AsyncLogSink> asyncLogSink;
+  {
+    std::shared_lock<std::shared_timed_mutex> loggerLock(g_logListenerMutex);
+    if (!*g_asyncLogSink || (*g_asyncLogSink)->IsListenerThread())
+    {
+      return;
+    }
+    asyncLogSink = *g_asyncLogSink;
+  }
+  asyncLogSink->Flush();
 }
 
 void Logger::SetLevel(Logger::Level level) { Log::SetLogLevel(level); }
@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/core/context.hpp"
+#include "azure/core/internal/metrics/metrics_impl.hpp"
+#include "azure/core/internal/metrics/service_metrics.hpp"
+
+namespace Azure { namespace Core { namespace Metrics { namespace _internal {
+
+  constexpr const char* HttpClientMetrics::HttpRequestMethod;
+  constexpr const char* HttpClientMetrics::HttpResponseStatusCode;
+  constexpr const char* HttpClientMetrics::ServerAddress;
+  constexpr const char* HttpClientMetrics::ErrorType;
+  constexpr const char* HttpClientMetrics::TlsResumed;
+
+  std::shared_ptr<MeterProviderImpl> MeterProviderImplGetter::MeterImplFromMeter(
+      std::shared_ptr<MeterProvider> const& provider)
+  {
+    const auto pointer = static_cast<MeterProvider*>(provider.get());
+    return std::shared_ptr<MeterProviderImpl>(provider, pointer);
+  }
+
+  HttpClientMetrics::HttpClientMetrics(
+      std::shared_ptr<Azure::Core::Metrics::MeterProvider> const& meterProvider,
+      std::string const& packageName,
+      std::string const& packageVersion)
+  {
+    auto const meter = MeterProviderImplGetter::MeterImplFromMeter(meterProvider)
+                           ->CreateMeter("azure-" + packageName, packageVersion);
+
+    RequestDuration = meter->CreateHistogram(
+        "http.client.request.duration", "Duration of HTTP client requests.", "s");
+    RequestBodySize = meter->CreateHistogram(
+        "http.client.request.body.size", "Size of HTTP client request bodies.", "By");
+    ResponseBodySize = meter->CreateHistogram(
+        "http.client.response.body.size", "Size of HTTP client response bodies.", "By");
+    Retries = meter->CreateCounter(
+        "azure.core.http.client.retries", "Number of HTTP client requests retried.", "{retry}");
+    PooledConnectionsReused = meter->CreateCounter(
+        "azure.core.http.client.connection.reuses",
+        "Number of pooled connections reused by HTTP client requests.",
+        "{connection}");
+    ConnectionsCreated = meter->CreateCounter(
+        "azure.core.http.client.connection.creations",
+        "Number of connections opened by HTTP client requests.",
+        "{connection}");
+    TlsHandshakes = meter->CreateCounter(
+        "azure.core.http.client.tls.handshakes",
+        "Number of TLS handshakes of the connections opened by HTTP client requests.",
+        "{handshake}");
+  }
+
+  Azure::Core::Context HttpClientMetrics::ApplyToContext(Azure::Core::Context const& context) const
+  {
+    return context.WithValue(ContextKey, this);
+  }
+
+  HttpClientMetrics const* HttpClientMetrics::CreateFromContext(
+      Azure::Core::Context const& context)
+  {
+    HttpClientMetrics const* metrics;
+    if (context.TryGetValue(ContextKey, metrics))
+    {
+      return metrics;
+    }
+    return nullptr;
+  }
+
+  Azure::Core::Context::Key HttpClientMetrics::ContextKey;
+}}}} // namespace Azure::Core::Metrics::_internal
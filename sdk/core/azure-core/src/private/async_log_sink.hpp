@@ -0,0 +1,106 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "azure/core/diagnostics/logger.hpp"
+#include "azure/core/internal/diagnostics/log.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Azure { namespace Core { namespace Diagnostics { namespace _detail {
+
+  /**
+   * @brief Delivers log messages to a listener from a background thread.
+   *
+   * @details The threads logging a message add it to a bounded lock-free multi-producer
+   * single-consumer ring buffer, and the background thread drains it into the listener. A message
+   * logged while the buffer is full is dropped and counted, the background thread then reports
+   * the number of dropped messages with a warning.
+   *
+   * The ring buffer is the bounded queue of Dmitry Vyukov: each entry has a sequence number which
+   * tells whether it is free for the producer at a given position, or holds a message for the
+   * consumer at that position.
+   */
+  class AsyncLogSink final {
+  public:
+    using Listener = std::function<void(Logger::Level level, std::string const& message)>;
+
+    /**
+     * @brief Starts the background thread.
+     *
+     * @param listener The listener to deliver the messages to.
+     * @param capacity Number of messages which can wait in the queue, rounded up to a power of 2.
+     */
+    explicit AsyncLogSink(Listener listener, size_t capacity);
+
+    /**
+     * @brief Delivers the messages left in the queue and stops the background thread.
+     *
+     * @remark No message must be written concurrently, and it must not be called from the
+     * listener thread, which it joins.
+     */
+    ~AsyncLogSink();
+
+    AsyncLogSink(AsyncLogSink const&) = delete;
+    AsyncLogSink& operator=(AsyncLogSink const&) = delete;
+
+    /** @brief Queues a message, or drops it when the queue is full. */
+    void Write(Logger::Level level, std::string const& message);
+
+    /** @brief Queues a record, or drops it when the queue is full. */
+    void Write(Logger::Level level, std::unique_ptr<_internal::LogRecord> record);
+
+    /** @brief Waits until the messages queued before the call are delivered. */
+    void Flush();
+
+    /** @brief Tells whether the calling thread is the one delivering the messages. */
+    bool IsListenerThread() const { return std::this_thread::get_id() == m_thread.get_id(); }
+
+  private:
+    struct Entry final
+    {
+      std::atomic<size_t> Sequence;
+      Logger::Level Level;
+      std::string Message;
+      std::unique_ptr<_internal::LogRecord> Record;
+    };
+
+    std::unique_ptr<Entry[]> m_entries;
+    size_t m_mask;
+    std::atomic<size_t> m_enqueuePosition{0};
+    // Only written by the background thread, read by Flush().
+    std::atomic<size_t> m_dequeuePosition{0};
+    std::atomic<uint64_t> m_droppedCount{0};
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeUp;
+    std::condition_variable m_flushed;
+    std::atomic<bool> m_isSleeping{false};
+    std::atomic<int> m_flushWaiters{0};
+    bool m_stop = false;
+
+    Listener m_listener;
+    std::thread m_thread;
+
+    Entry* TryClaim(size_t& position);
+    void Publish(Entry& entry, size_t position);
+    bool HasEntry() const;
+    bool TryDeliver();
+    void ReportDropped();
+    void Deliver(
+        Logger::Level level,
+        std::string const& message,
+        _internal::LogRecord const* record);
+    void Drain();
+  };
+
+}}}} // namespace Azure::Core::Diagnostics::_detail
@@ -0,0 +1,167 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test the Base64 encoding and decoding performance.
+ *
+ */
+
+#pragma once
+
+#include <azure/core.hpp>
+#include <azure/core/base64.hpp>
+#include <azure/perf.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Core { namespace Test {
+
+  /**
+   * @brief Measure the throughput of the Base64 conversions, with the vectorized or the scalar
+   * implementation. The throughput in bytes per second is the number of operations per second
+   * multiplied by the size of the binary data.
+   */
+  class Base64Test : public Azure::Perf::PerfTest {
+    enum class Action
+    {
+      Encode,
+      Decode,
+      UrlEncode,
+      UrlDecode
+    };
+
+    Action m_action;
+    std::vector<uint8_t> m_data;
+    std::string m_text;
+    bool m_vectorizationEnabled = true;
+
+  public:
+    /**
+     * @brief Construct a new Base64Test test.
+     *
+     * @param options The test options.
+     */
+    Base64Test(Azure::Perf::TestOptions options) : PerfTest(options) {}
+
+    void GlobalSetup() override
+    {
+      auto const implementation
+          = m_options.GetOptionOrDefault<std::string>("Implementation", "vectorized");
+      if (implementation != "vectorized" && implementation != "scalar")
+      {
+        throw std::invalid_argument("Implementation must be vectorized or scalar.");
+      }
+      if (implementation == "vectorized"
+          && !Azure::Core::_detail::Base64Vectorization::IsSupported())
+      {
+        throw std::invalid_argument("The CPU doesn't support the vectorized implementation.");
+      }
+      m_vectorizationEnabled
+          = Azure::Core::_detail::Base64Vectorization::SetEnabled(implementation == "vectorized");
+    }
+
+    void Setup() override
+    {
+      auto const action = m_options.GetOptionOrDefault<std::string>("Action", "encode");
+      if (action == "encode")
+      {
+        m_action = Action::Encode;
+      }
+      else if (action == "decode")
+      {
+        m_action = Action::Decode;
+      }
+      else if (action == "urlencode")
+      {
+        m_action = Action::UrlEncode;
+      }
+      else if (action == "urldecode")
+      {
+        m_action = Action::UrlDecode;
+      }
+      else
+      {
+        throw std::invalid_argument("Action must be encode, decode, urlencode or urldecode.");
+      }
+
+      m_data.resize(m_options.GetOptionOrDefault<size_t>("Size", 1024 * 1024));
+      for (size_t i = 0; i < m_data.size(); i++)
+      {
+        m_data[i] = static_cast<uint8_t>(i * 7 + (i >> 8));
+      }
+      m_text = m_action == Action::UrlDecode
+          ? Azure::Core::_internal::Base64Url::Base64UrlEncode(m_data)
+          : Azure::Core::Convert::Base64Encode(m_data);
+    }
+
+    void GlobalCleanup() override
+    {
+      Azure::Core::_detail::Base64Vectorization::SetEnabled(m_vectorizationEnabled);
+    }
+
+    /**
+     * @brief Encode or decode the data.
+     *
+     */
+    void Run(Azure::Core::Context const&) override
+    {
+      switch (m_action)
+      {
+        case Action::Encode:
+          Azure::Core::Convert::Base64Encode(m_data);
+          break;
+        case Action::Decode:
+          Azure::Core::Convert::Base64Decode(m_text);
+          break;
+        case Action::UrlEncode:
+          Azure::Core::_internal::Base64Url::Base64UrlEncode(m_data);
+          break;
+        case Action::UrlDecode:
+          Azure::Core::_internal::Base64Url::Base64UrlDecode(m_text);
+          break;
+      }
+    }
+
+    /**
+     * @brief Define the test options for the test.
+     *
+     * @return The list of test options.
+     */
+    std::vector<Azure::Perf::TestOption> GetTestOptions() override
+    {
+      return {
+          {"Action",
+           {"--action"},
+           "encode, decode, urlencode or urldecode, default encode",
+           1,
+           false},
+          {"Implementation",
+           {"--implementation"},
+           "vectorized or scalar, default vectorized",
+           1,
+           false},
+          {"Size", {"--size"}, "The size of the binary data in bytes, default 1048576", 1, false}};
+    }
+
+    /**
+     * @brief Get the static Test Metadata for the test.
+     *
+     * @return Azure::Perf::TestMetadata describing the test.
+     */
+    static Azure::Perf::TestMetadata GetTestMetadata()
+    {
+      return {
+          "base64",
+          "Measures the throughput of the Base64 encoding and decoding",
+          [](Azure::Perf::TestOptions options) {
+            return std::make_unique<Azure::Core::Test::Base64Test>(options);
+          }};
+    }
+  };
+
+}}} // namespace Azure::Core::Test
@@ -0,0 +1,250 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test the cost of distributed tracing in the HTTP pipeline.
+ *
+ */
+
+#pragma once
+
+#include <azure/core.hpp>
+#include <azure/core/http/policies/policy.hpp>
+#include <azure/core/internal/http/pipeline.hpp>
+#include <azure/core/internal/tracing/service_tracing.hpp>
+#include <azure/core/internal/tracing/tracing_impl.hpp>
+#include <azure/perf.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Azure { namespace Core { namespace Test {
+
+  namespace _detail {
+    class PerfAttributeSet final : public Azure::Core::Tracing::_internal::AttributeSet {
+    public:
+      std::vector<std::pair<std::string, std::string>> Attributes;
+
+      void AddAttribute(std::string const& name, bool value) override
+      {
+        Attributes.emplace_back(name, value ? "true" : "false");
+      }
+      void AddAttribute(std::string const& name, int32_t value) override
+      {
+        Attributes.emplace_back(name, std::to_string(value));
+      }
+      void AddAttribute(std::string const& name, int64_t value) override
+      {
+        Attributes.emplace_back(name, std::to_string(value));
+      }
+      void AddAttribute(std::string const& name, uint64_t value) override
+      {
+        Attributes.emplace_back(name, std::to_string(value));
+      }
+      void AddAttribute(std::string const& name, double value) override
+      {
+        Attributes.emplace_back(name, std::to_string(value));
+      }
+      void AddAttribute(std::string const& name, const char* value) override
+      {
+        Attributes.emplace_back(name, value);
+      }
+      void AddAttribute(std::string const& name, std::string const& value) override
+      {
+        Attributes.emplace_back(name, value);
+      }
+    };
+
+    // A span which keeps its attributes when it is sampled, like an exporting tracer would.
+    class PerfSpan final : public Azure::Core::Tracing::_internal::Span {
+      bool m_recording;
+      std::vector<std::pair<std::string, std::string>> m_attributes;
+
+    public:
+      PerfSpan(Azure::Core::Tracing::_internal::CreateSpanOptions const& options, bool recording)
+          : m_recording(recording)
+      {
+        if (m_recording && options.Attributes)
+        {
+          AddAttributes(*options.Attributes);
+        }
+      }
+
+      void End(Azure::Nullable<Azure::DateTime>) override {}
+      void AddAttributes(Azure::Core::Tracing::_internal::AttributeSet const& attributes) override
+      {
+        if (m_recording)
+        {
+          auto const& added = static_cast<PerfAttributeSet const&>(attributes).Attributes;
+          m_attributes.insert(m_attributes.end(), added.begin(), added.end());
+        }
+      }
+      void AddAttribute(std::string const& name, std::string const& value) override
+      {
+        if (m_recording)
+        {
+          m_attributes.emplace_back(name, value);
+        }
+      }
+      void AddEvent(std::string const&, Azure::Core::Tracing::_internal::AttributeSet const&)
+          override
+      {
+      }
+      void AddEvent(std::string const&) override {}
+      void AddEvent(std::exception const&) override {}
+      void SetStatus(Azure::Core::Tracing::_internal::SpanStatus const&, std::string const&)
+          override
+      {
+      }
+      void PropagateToHttpHeaders(Azure::Core::Http::Request&) override {}
+      bool IsRecording() const override { return m_recording; }
+    };
+
+    class PerfTracer final : public Azure::Core::Tracing::_internal::Tracer {
+      bool m_recording;
+
+    public:
+      explicit PerfTracer(bool recording) : m_recording(recording) {}
+
+      std::shared_ptr<Azure::Core::Tracing::_internal::Span> CreateSpan(
+          std::string const&,
+          Azure::Core::Tracing::_internal::CreateSpanOptions const& options) const override
+      {
+        return std::make_shared<PerfSpan>(options, m_recording);
+      }
+
+      std::unique_ptr<Azure::Core::Tracing::_internal::AttributeSet> CreateAttributeSet()
+          const override
+      {
+        return std::make_unique<PerfAttributeSet>();
+      }
+    };
+
+    class PerfTracerProvider final : public Azure::Core::Tracing::TracerProvider {
+      bool m_recording;
+
+    public:
+      explicit PerfTracerProvider(bool recording) : m_recording(recording) {}
+
+      std::shared_ptr<Azure::Core::Tracing::_internal::Tracer> CreateTracer(
+          std::string const&,
+          std::string const&) const override
+      {
+        return std::make_shared<PerfTracer>(m_recording);
+      }
+    };
+
+    class OkResponsePolicy final : public Azure::Core::Http::Policies::HttpPolicy {
+    public:
+      std::unique_ptr<HttpPolicy> Clone() const override
+      {
+        return std::make_unique<OkResponsePolicy>(*this);
+      }
+
+      std::unique_ptr<Azure::Core::Http::RawResponse> Send(
+          Azure::Core::Http::Request&,
+          Azure::Core::Http::Policies::NextHttpPolicy,
+          Azure::Core::Context const&) const override
+      {
+        return std::make_unique<Azure::Core::Http::RawResponse>(
+            1, 1, Azure::Core::Http::HttpStatusCode::Ok, "OK");
+      }
+    };
+  } // namespace _detail
+
+  /**
+   * @brief Measure the cost of the RequestActivityPolicy for a request, when tracing is disabled,
+   * when the spans aren't sampled and when they are.
+   */
+  class RequestActivityTest : public Azure::Perf::PerfTest {
+    std::unique_ptr<Azure::Core::Http::_internal::HttpPipeline> m_pipeline;
+    std::unique_ptr<Azure::Core::Tracing::_internal::TracingContextFactory> m_tracingFactory;
+
+  public:
+    /**
+     * @brief Construct a new RequestActivityTest test.
+     *
+     * @param options The test options.
+     */
+    RequestActivityTest(Azure::Perf::TestOptions options) : PerfTest(options) {}
+
+    void Setup() override
+    {
+      auto const tracing = m_options.GetOptionOrDefault<std::string>("Tracing", "sampled");
+
+      Azure::Core::_internal::ClientOptions clientOptions;
+      if (tracing == "sampled" || tracing == "unsampled")
+      {
+        clientOptions.Telemetry.TracingProvider
+            = std::make_shared<_detail::PerfTracerProvider>(tracing == "sampled");
+      }
+      else if (tracing != "disabled")
+      {
+        throw std::invalid_argument("Tracing must be disabled, unsampled or sampled.");
+      }
+      m_tracingFactory = std::make_unique<Azure::Core::Tracing::_internal::TracingContextFactory>(
+          clientOptions, "Azure.Test", "test", "1.0.0");
+
+      std::vector<std::unique_ptr<Azure::Core::Http::Policies::HttpPolicy>> policies;
+      policies.emplace_back(
+          std::make_unique<Azure::Core::Http::Policies::_internal::RequestIdPolicy>());
+      policies.emplace_back(
+          std::make_unique<Azure::Core::Http::Policies::_internal::TelemetryPolicy>(
+              "test", "1.0.0"));
+      policies.emplace_back(
+          std::make_unique<Azure::Core::Http::Policies::_internal::RequestActivityPolicy>(
+              Azure::Core::Http::_internal::HttpSanitizer{}));
+      policies.emplace_back(std::make_unique<_detail::OkResponsePolicy>());
+      m_pipeline
+          = std::make_unique<Azure::Core::Http::_internal::HttpPipeline>(std::move(policies));
+    }
+
+    /**
+     * @brief Send a request through the pipeline, from a traced service method.
+     *
+     */
+    void Run(Azure::Core::Context const& context) override
+    {
+      auto contextAndSpan = m_tracingFactory->CreateTracingContext("Test.Run", context);
+      Azure::Core::Http::Request request(
+          Azure::Core::Http::HttpMethod::Get,
+          Azure::Core::Url("https://account.blob.core.windows.net/container/blob?sig=secret"));
+      m_pipeline->Send(request, contextAndSpan.Context);
+    }
+
+    /**
+     * @brief Define the test options for the test.
+     *
+     * @return The list of test options.
+     */
+    std::vector<Azure::Perf::TestOption> GetTestOptions() override
+    {
+      return {
+          {"Tracing",
+           {"--tracing"},
+           "How requests are traced: disabled, unsampled or sampled. default:sampled",
+           1,
+           false}};
+    }
+
+    /**
+     * @brief Get the static Test Metadata for the test.
+     *
+     * @return Azure::Perf::TestMetadata describing the test.
+     */
+    static Azure::Perf::TestMetadata GetTestMetadata()
+    {
+      return {
+          "requestActivity",
+          "Measures the cost of distributed tracing in the HTTP pipeline",
+          [](Azure::Perf::TestOptions options) {
+            return std::make_unique<Azure::Core::Test::RequestActivityTest>(options);
+          }};
+    }
+  };
+
+}}} // namespace Azure::Core::Test
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation.
 // Licensed under the MIT License.
 
+#include "azure/core/test/base64_test.hpp"
 #include "azure/core/test/delay_test.hpp"
 #include "azure/core/test/exception_test.hpp"
 #include "azure/core/test/extended_options_test.hpp"
@@ -9,6 +10,7 @@
 #include "azure/core/test/no_op_test.hpp"
 #include "azure/core/test/nullable_test.hpp"
 #include "azure/core/test/pipeline_test.hpp"
+#include "azure/core/test/request_activity_test.hpp"
 #include "azure/core/test/uuid_test.hpp"
 
 #include <azure/perf.hpp>
@@ -20,6 +22,7 @@ int main(int argc, char** argv)
 
   // Create the test list
   std::vector<Azure::Perf::TestMetadata> tests{
+      Azure::Core::Test::Base64Test::GetTestMetadata(),
       Azure::Core::Test::DelayTest::GetTestMetadata(),
       Azure::Core::Test::ExceptionTest::GetTestMetadata(),
       Azure::Core::Test::ExtendedOptionsTest::GetTestMetadata(),
@@ -28,6 +31,7 @@ int main(int argc, char** argv)
       Azure::Core::Test::NoOp::GetTestMetadata(),
       Azure::Core::Test::NullableTest::GetTestMetadata(),
       Azure::Core::Test::PipelineTest::GetTestMetadata(),
+      Azure::Core::Test::RequestActivityTest::GetTestMetadata(),
       Azure::Core::Test::UuidTest::GetTestMetadata()};
 
   Azure::Perf::Program::Run(Azure::Core::Context{}, tests, argc, argv);
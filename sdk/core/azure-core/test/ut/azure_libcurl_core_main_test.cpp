@@ -63,8 +63,8 @@ namespace Azure { namespace Core { namespace Test {
     }
     // here the session is destroyed and the connection is moved to the pool
     // the same destructor also makes a call to start the cleanup thread
-    // which will sleep for DefaultCleanerIntervalMilliseconds then loop through the connections
-    // in the pool and check for the ones that are expired(DefaultConnectionExpiredMilliseconds) and
+    // which will sleep for DefaultConnectionPoolCleanupInterval then loop through the connections
+    // in the pool and check for the ones that are expired(DefaultConnectionIdleTimeout) and
     // remove them which will be the case here if we wait long enough.
     // without the calculations below test is flaky due to the
     // fact that tests in the CI pipeline might take longer than 90 sec to execute thus the cleanup
@@ -76,8 +76,7 @@ namespace Azure { namespace Core { namespace Test {
 
     // Getting number of milliseconds as a double.
     duration<double, std::milli> ms_double = t2 - t1;
-    if (ms_double < duration<double, std::milli>(
-            Azure::Core::Http::_detail::DefaultCleanerIntervalMilliseconds))
+    if (ms_double < Azure::Core::Http::_detail::DefaultConnectionPoolCleanupInterval)
     {
       // if the destructor execution took less than the cleanup thread sleep the size should be 1
       EXPECT_EQ(
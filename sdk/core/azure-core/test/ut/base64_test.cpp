@@ -186,3 +186,90 @@ TEST(Base64, InvalidDecode)
 
   // cspell::enable
 }
+
+namespace {
+// Runs a test with the vectorized implementation disabled, and restores it afterward.
+class ScalarBase64 final {
+  bool m_enabled;
+
+public:
+  ScalarBase64() : m_enabled(_detail::Base64Vectorization::SetEnabled(false)) {}
+  ~ScalarBase64() { _detail::Base64Vectorization::SetEnabled(m_enabled); }
+};
+} // namespace
+
+TEST(Base64, Vectorized)
+{
+  std::vector<size_t> lengths;
+  for (size_t len = 0; len <= 200; len++)
+  {
+    lengths.push_back(len);
+  }
+  lengths.push_back(4096);
+  lengths.push_back(1024 * 1024 + 1);
+
+  for (auto len : lengths)
+  {
+    std::vector<uint8_t> data(len);
+    RandomBuffer(data.data(), data.size());
+
+    auto const encoded = Convert::Base64Encode(data);
+    auto const urlEncoded = _internal::Base64Url::Base64UrlEncode(data);
+    EXPECT_EQ(Convert::Base64Decode(encoded), data);
+    EXPECT_EQ(_internal::Base64Url::Base64UrlDecode(urlEncoded), data);
+
+    ScalarBase64 scalar;
+    EXPECT_EQ(Convert::Base64Encode(data), encoded);
+    EXPECT_EQ(_internal::Base64Url::Base64UrlEncode(data), urlEncoded);
+    EXPECT_EQ(Convert::Base64Decode(encoded), data);
+    EXPECT_EQ(_internal::Base64Url::Base64UrlDecode(urlEncoded), data);
+  }
+}
+
+TEST(Base64, VectorizedInvalidDecode)
+{
+  std::vector<uint8_t> data(300);
+  RandomBuffer(data.data(), data.size());
+  auto const encoded = Convert::Base64Encode(data);
+
+  // Place an invalid character in each block, whether it is decoded by the vectorized
+  // implementation or by the scalar one.
+  for (auto invalid : {'@', '=', '-', '\0', '\x80', '\xFF'})
+  {
+    for (size_t i = 0; i < encoded.size() - 4; i += 7)
+    {
+      auto text = encoded;
+      text[i] = invalid;
+      EXPECT_THROW(Convert::Base64Decode(text), std::runtime_error);
+      {
+        ScalarBase64 scalar;
+        EXPECT_THROW(Convert::Base64Decode(text), std::runtime_error);
+      }
+    }
+  }
+}
+
+TEST(Base64, Url)
+{
+  // cspell:disable
+  std::vector<uint8_t> const data{0xFB, 0xFF, 0xBF, 0xFB, 0xEF};
+  EXPECT_EQ(Convert::Base64Encode(data), "+/+/++8=");
+  EXPECT_EQ(_internal::Base64Url::Base64UrlEncode(data), "-_-_--8");
+  EXPECT_EQ(_internal::Base64Url::Base64UrlEncode(std::vector<uint8_t>{}), "");
+  EXPECT_EQ(_internal::Base64Url::Base64UrlEncode(std::vector<uint8_t>{1}), "AQ");
+  EXPECT_EQ(_internal::Base64Url::Base64UrlEncode(std::vector<uint8_t>{1, 2}), "AQI");
+
+  EXPECT_EQ(_internal::Base64Url::Base64UrlDecode("-_-_--8"), data);
+  EXPECT_EQ(_internal::Base64Url::Base64UrlDecode("-_-_--8="), data);
+  EXPECT_EQ(_internal::Base64Url::Base64UrlDecode("+/+/++8="), data);
+  EXPECT_EQ(_internal::Base64Url::Base64UrlDecode("AQ"), std::vector<uint8_t>{1});
+  EXPECT_EQ(_internal::Base64Url::Base64UrlDecode("AQ=="), std::vector<uint8_t>{1});
+  EXPECT_TRUE(_internal::Base64Url::Base64UrlDecode("").empty());
+
+  EXPECT_THROW(_internal::Base64Url::Base64UrlDecode("A"), std::invalid_argument);
+  EXPECT_THROW(_internal::Base64Url::Base64UrlDecode("AQIDB"), std::invalid_argument);
+  EXPECT_THROW(_internal::Base64Url::Base64UrlDecode("A=="), std::runtime_error);
+  EXPECT_THROW(_internal::Base64Url::Base64UrlDecode("A@"), std::runtime_error);
+  EXPECT_THROW(_internal::Base64Url::Base64UrlDecode("AQ=B"), std::runtime_error);
+  // cspell:enable
+}
@@ -5,6 +5,11 @@
 #include <azure/core/http/policies/policy.hpp>
 #include <azure/core/internal/http/pipeline.hpp>
 
+#include <exception>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 using Azure::Core::Http::Policies::_internal::BearerTokenAuthenticationPolicy;
@@ -549,3 +554,62 @@ TEST(BearerTokenAuthenticationPolicy, ChallengeBasedFailure)
   EXPECT_NE(authHeader, headers.end());
   EXPECT_EQ(authHeader->second, "Bearer ACCESSTOKEN1");
 }
+
+TEST(BearerTokenAuthenticationPolicy, SendAsync)
+{
+  using namespace std::chrono_literals;
+
+  auto const sendAsync = [](HttpPipeline const& pipeline, Request& request) {
+    std::unique_ptr<RawResponse> result;
+    std::exception_ptr sendError;
+    pipeline.SendAsync(
+        request, Context(), [&](std::unique_ptr<RawResponse> response, std::exception_ptr error) {
+          result = std::move(response);
+          sendError = error;
+        });
+    if (sendError)
+    {
+      std::rethrow_exception(sendError);
+    }
+    return result;
+  };
+
+  {
+    auto accessToken = std::make_shared<AccessToken>();
+    *accessToken = {"ACCESSTOKEN1", std::chrono::system_clock::now() + 1h};
+
+    TokenRequestContext tokenRequestContext;
+    tokenRequestContext.Scopes = {"https://microsoft.com/.default"};
+
+    std::vector<std::unique_ptr<HttpPolicy>> policies;
+    policies.emplace_back(std::make_unique<BearerTokenAuthenticationPolicy>(
+        std::make_shared<TestTokenCredential>(accessToken), tokenRequestContext));
+    policies.emplace_back(std::make_unique<TestTransportPolicy>());
+    HttpPipeline pipeline(policies);
+
+    Request request(HttpMethod::Get, Url("https://www.azure.com"));
+    EXPECT_EQ(sendAsync(pipeline, request)->GetStatusCode(), HttpStatusCode::Ok);
+    EXPECT_EQ(request.GetHeader("authorization").Value(), "Bearer ACCESSTOKEN1");
+
+    Request nonHttpsRequest(HttpMethod::Get, Url("http://www.azure.com"));
+    EXPECT_THROW(sendAsync(pipeline, nonHttpsRequest), AuthenticationException);
+  }
+
+  {
+    // A policy overriding AuthorizeAndSendRequest() sends the request with it.
+    TokenRequestContext tokenRequestContext;
+    tokenRequestContext.Scopes = {"https://microsoft.com/.default"};
+
+    std::vector<std::unique_ptr<HttpPolicy>> policies;
+    policies.emplace_back(std::make_unique<TestChallengeBasedAuthenticationPolicy>(
+        std::make_shared<TestTokenCredentialForChallengeBasedTokenAuthenticationPolicy>(),
+        tokenRequestContext,
+        true));
+    policies.emplace_back(std::make_unique<TestTransportPolicy>());
+    HttpPipeline pipeline(policies);
+
+    Request request(HttpMethod::Get, Url("https://www.azure.com"));
+    EXPECT_EQ(sendAsync(pipeline, request)->GetStatusCode(), HttpStatusCode::Ok);
+    EXPECT_EQ(request.GetHeader("authorization").Value(), "Bearer ACCESSTOKEN2");
+  }
+}
@@ -19,6 +19,9 @@
 
 #include <azure/core/io/body_stream.hpp>
 
+#include <algorithm>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 using namespace Azure::Core::IO;
@@ -30,6 +33,52 @@ class TestBodyStream final : public BodyStream {
   int64_t Length() const override { return 0; }
 };
 
+// A stream whose length doesn't match its content, as with a wrong Content-Length header.
+class WrongLengthBodyStream final : public BodyStream {
+  std::vector<uint8_t> m_content;
+  int64_t m_length;
+  size_t m_offset = 0;
+
+  size_t OnRead(uint8_t* buffer, size_t count, Context const&) override
+  {
+    count = (std::min)(count, m_content.size() - m_offset);
+    std::copy_n(m_content.begin() + static_cast<std::ptrdiff_t>(m_offset), count, buffer);
+    m_offset += count;
+    return count;
+  }
+
+public:
+  WrongLengthBodyStream(std::vector<uint8_t> content, int64_t length)
+      : m_content(std::move(content)), m_length(length)
+  {
+  }
+  int64_t Length() const override { return m_length; }
+};
+
+TEST(BodyStream, ReadToEnd)
+{
+  std::vector<uint8_t> content(20000);
+  for (size_t i = 0; i < content.size(); ++i)
+  {
+    content[i] = static_cast<uint8_t>(i);
+  }
+
+  for (int64_t length : {int64_t(-1), int64_t(1), int64_t(100), int64_t(19999), int64_t(20000),
+                         int64_t(20001), int64_t(100000)})
+  {
+    WrongLengthBodyStream stream(content, length);
+    EXPECT_EQ(stream.ReadToEnd(), content) << length;
+  }
+
+  MemoryBodyStream memoryStream(content);
+  auto const body = memoryStream.ReadToEnd();
+  EXPECT_EQ(body, content);
+  EXPECT_EQ(body.capacity(), content.size());
+
+  MemoryBodyStream emptyStream(nullptr, 0);
+  EXPECT_TRUE(emptyStream.ReadToEnd().empty());
+}
+
 TEST(BodyStream, Rewind)
 {
   TestBodyStream tb;
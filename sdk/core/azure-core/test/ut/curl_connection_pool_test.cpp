@@ -4,6 +4,7 @@
 #include "transport_adapter_base_test.hpp"
 
 #include <azure/core/context.hpp>
+#include <azure/core/platform.hpp>
 #include <azure/core/http/policies/policy.hpp>
 #include <azure/core/response.hpp>
 
@@ -670,5 +671,132 @@ namespace Azure { namespace Core { namespace Test {
             0);
       }
     }
+
+    TEST(CurlConnectionPool, sharedCaches)
+    {
+      Azure::Core::Http::Request req(
+          Azure::Core::Http::HttpMethod::Get, Azure::Core::Url("https://localhost:8444/get"));
+      Azure::Core::Http::CurlTransportOptions options;
+      options.EnableSharedCaches = true;
+      options.SslVerifyPeer = false;
+
+      {
+        // Read the whole response, so that the session ticket sent by the server after the TLS
+        // handshake is received.
+        Azure::Core::Http::CurlTransport transport(options);
+        auto response = transport.Send(req, Azure::Core::Context{});
+        EXPECT_EQ(response->GetStatusCode(), Azure::Core::Http::HttpStatusCode::Ok);
+        response->ExtractBodyStream()->ReadToEnd(Azure::Core::Context{});
+      }
+
+      // Reset the pool so that a new connection is opened, which resumes the TLS session of the
+      // previous one.
+      auto connection = CurlConnectionPool::g_curlConnectionPool.ExtractOrCreateCurlConnection(
+          req, options, true);
+      auto const& curlConnection
+          = static_cast<Azure::Core::Http::CurlConnection const&>(*connection);
+      EXPECT_TRUE(curlConnection.HasTlsHandshake());
+#if defined(AZ_PLATFORM_LINUX)
+      // Send a request, after which every version of libcurl tells about the TLS session.
+      std::string const head
+          = "HEAD /get HTTP/1.1\r\nHost: " + req.GetUrl().GetHost() + "\r\n\r\n";
+      EXPECT_EQ(
+          connection->SendBuffer(
+              reinterpret_cast<uint8_t const*>(head.data()), head.size(), Azure::Core::Context{}),
+          CURLE_OK);
+      EXPECT_TRUE(curlConnection.IsTlsSessionResumed().ValueOr(false));
+#endif
+    }
+
+    TEST(CurlConnectionPool, warmUpConnections)
+    {
+      {
+        std::lock_guard<std::mutex> lock(
+            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
+        CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.clear();
+      }
+
+      Azure::Core::Url const url(AzureSdkHttpbinServer::Get());
+      std::string const connectionKey(CreateConnectionKey(
+          AzureSdkHttpbinServer::Schema(),
+          AzureSdkHttpbinServer::Host(),
+          ",0,0,0,0,0,1,1,0,0,0,0"));
+
+      Azure::Core::Http::CurlTransport transport;
+      // The same host is only warmed up once.
+      EXPECT_EQ(transport.WarmUpConnections({url, url}, 3), 3);
+      {
+        std::lock_guard<std::mutex> lock(
+            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
+        EXPECT_EQ(
+            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex[connectionKey].size(), 3);
+      }
+      // The pool has enough connections already.
+      EXPECT_EQ(transport.WarmUpConnections({url}, 2), 0);
+      EXPECT_EQ(transport.WarmUpConnections({url}, 4), 1);
+
+      // The requests use the connections of the pool.
+      Azure::Core::Http::Request request(Azure::Core::Http::HttpMethod::Get, url);
+      auto response = transport.Send(request, Azure::Core::Context{});
+      EXPECT_EQ(response->GetStatusCode(), Azure::Core::Http::HttpStatusCode::Ok);
+      {
+        std::lock_guard<std::mutex> lock(
+            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
+        EXPECT_EQ(
+            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex[connectionKey].size(), 3);
+        CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.clear();
+      }
+
+      Azure::Core::Context cancelled;
+      cancelled.Cancel();
+      EXPECT_THROW(
+          transport.WarmUpConnections({url}, 1, cancelled),
+          Azure::Core::OperationCancelledException);
+    }
+
+    TEST(CurlConnectionPool, minIdleConnections)
+    {
+      {
+        std::lock_guard<std::mutex> lock(
+            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
+        CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.clear();
+      }
+
+      Azure::Core::Url const url(AzureSdkHttpbinServer::Get());
+      std::string const connectionKey(CreateConnectionKey(
+          AzureSdkHttpbinServer::Schema(),
+          AzureSdkHttpbinServer::Host(),
+          ",0,0,0,0,0,1,1,0,0,0,0"));
+
+      Azure::Core::Http::CurlTransportOptions options;
+      options.ConnectionIdleTimeout = 10ms;
+      options.ConnectionPoolCleanupInterval = 100ms;
+      options.MinIdleConnectionsPerHost = 1;
+      Azure::Core::Http::CurlTransport transport(options);
+      EXPECT_EQ(transport.WarmUpConnections({url}, 3), 3);
+
+      // The clean thread closes the expired connections, but the last one.
+      size_t pooledConnections = 0;
+      for (int i = 0; i < 50; ++i)
+      {
+        std::this_thread::sleep_for(100ms);
+        std::lock_guard<std::mutex> lock(
+            CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
+        auto const& index = CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex;
+        auto const pool = index.find(connectionKey);
+        pooledConnections = pool != index.end() ? pool->second.size() : 0;
+        if (pooledConnections <= 1)
+        {
+          break;
+        }
+      }
+      EXPECT_EQ(pooledConnections, 1);
+
+      std::lock_guard<std::mutex> lock(
+          CurlConnectionPool::g_curlConnectionPool.ConnectionPoolMutex);
+      CurlConnectionPool::g_curlConnectionPool.CleanerInterval
+          = Azure::Core::Http::_detail::DefaultConnectionPoolCleanupInterval;
+      CurlConnectionPool::g_curlConnectionPool.ConnectionPoolIndex.clear();
+    }
 #endif
 }}} // namespace Azure::Core::Test
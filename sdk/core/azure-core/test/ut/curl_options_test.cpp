@@ -4,6 +4,7 @@
 #include <azure/core/context.hpp>
 #include <azure/core/http/http.hpp>
 #include <azure/core/http/policies/policy.hpp>
+#include <azure/core/internal/environment.hpp>
 #include <azure/core/internal/http/pipeline.hpp>
 #include <azure/core/platform.hpp>
 
@@ -18,7 +19,12 @@
 
 #include "transport_adapter_base_test.hpp"
 
+#include <chrono>
+#include <exception>
+#include <future>
+#include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <http/curl/curl_connection_pool_private.hpp>
@@ -365,4 +371,219 @@ namespace Azure { namespace Core { namespace Test {
         0);
   }
 
+
+  namespace {
+    // URL of a resource on an HTTP/2 server, preferably larger than 1 MiB. For example, the root
+    // of `nghttpd --htdocs <directory> 8443 <key> <cert>` serving a large index.html.
+    std::string Http2TestResourceUrl()
+    {
+      return Azure::Core::_internal::Environment::GetVariable("HTTP2_TEST_RESOURCE_URL");
+    }
+  } // namespace
+
+  TEST(CurlTransportOptions, http2ConnectionError)
+  {
+    Azure::Core::Http::CurlTransportOptions curlOptions;
+    curlOptions.EnableHttp2 = true;
+    Azure::Core::Http::CurlTransport transport(curlOptions);
+
+    Azure::Core::Http::Request request(
+        Azure::Core::Http::HttpMethod::Get, Azure::Core::Url("https://localhost:1/"));
+    EXPECT_THROW(
+        transport.Send(request, Azure::Core::Context{}), Azure::Core::Http::TransportException);
+
+    Azure::Core::Context context;
+    context.Cancel();
+    EXPECT_THROW(transport.Send(request, context), Azure::Core::OperationCancelledException);
+
+    // The requests sent asynchronously report the same errors to their callback.
+    for (auto const& sendContext : {Azure::Core::Context{}, context})
+    {
+      std::promise<std::unique_ptr<Azure::Core::Http::RawResponse>> promise;
+      transport.SendAsync(
+          request,
+          sendContext,
+          [&promise](
+              std::unique_ptr<Azure::Core::Http::RawResponse> response,
+              std::exception_ptr error) {
+            EXPECT_EQ(response, nullptr);
+            promise.set_exception(error);
+          });
+      if (sendContext.IsCancelled())
+      {
+        EXPECT_THROW(promise.get_future().get(), Azure::Core::OperationCancelledException);
+      }
+      else
+      {
+        EXPECT_THROW(promise.get_future().get(), Azure::Core::Http::TransportException);
+      }
+    }
+  }
+
+  TEST(CurlTransportOptions, http2Multiplexing)
+  {
+    auto const url = Http2TestResourceUrl();
+    if (url.empty())
+    {
+      GTEST_SKIP_("Skipping HTTP/2 tests because HTTP2_TEST_RESOURCE_URL is not set.");
+    }
+
+    Azure::Core::Http::CurlTransportOptions curlOptions;
+    curlOptions.EnableHttp2 = true;
+    curlOptions.SslVerifyPeer = false;
+    Azure::Core::Http::CurlTransport transport(curlOptions);
+
+    Azure::Core::Http::Request firstRequest(
+        Azure::Core::Http::HttpMethod::Get, Azure::Core::Url(url));
+    auto firstResponse = transport.Send(firstRequest, Azure::Core::Context{});
+    EXPECT_EQ(firstResponse->GetStatusCode(), Azure::Core::Http::HttpStatusCode::Ok);
+    EXPECT_EQ(firstResponse->GetMajorVersion(), 2);
+    auto const expectedBody = firstResponse->ExtractBodyStream()->ReadToEnd();
+
+    // The responses are read concurrently, one of them slowly, over the same connection.
+    constexpr size_t RequestCount = 8;
+    std::vector<std::unique_ptr<Azure::Core::Http::RawResponse>> responses(RequestCount);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < RequestCount; ++i)
+    {
+      threads.emplace_back([&, i]() {
+        Azure::Core::Http::Request request(
+            Azure::Core::Http::HttpMethod::Get, Azure::Core::Url(url));
+        responses[i] = transport.Send(request, Azure::Core::Context{});
+      });
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+    threads.clear();
+
+    std::vector<std::vector<uint8_t>> bodies(RequestCount);
+    for (size_t i = 0; i < RequestCount; ++i)
+    {
+      EXPECT_EQ(responses[i]->GetMajorVersion(), 2);
+      threads.emplace_back([&, i]() {
+        auto bodyStream = responses[i]->ExtractBodyStream();
+        if (i != 0)
+        {
+          bodies[i] = bodyStream->ReadToEnd();
+          return;
+        }
+        uint8_t buffer[64 * 1024];
+        while (auto const read = bodyStream->Read(buffer, sizeof(buffer)))
+        {
+          bodies[i].insert(bodies[i].end(), buffer, buffer + read);
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+      });
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+    for (auto const& body : bodies)
+    {
+      EXPECT_EQ(body, expectedBody);
+    }
+
+    // A response whose body isn't read doesn't hold back the next requests.
+    Azure::Core::Http::Request abandonedRequest(
+        Azure::Core::Http::HttpMethod::Get, Azure::Core::Url(url));
+    auto abandonedResponse = transport.Send(abandonedRequest, Azure::Core::Context{});
+    Azure::Core::Http::Request nextRequest(
+        Azure::Core::Http::HttpMethod::Get, Azure::Core::Url(url));
+    auto nextResponse = transport.Send(nextRequest, Azure::Core::Context{});
+    EXPECT_EQ(nextResponse->ExtractBodyStream()->ReadToEnd(), expectedBody);
+  }
+
+  TEST(CurlTransportOptions, http2SendAsync)
+  {
+    auto const url = Http2TestResourceUrl();
+    if (url.empty())
+    {
+      GTEST_SKIP_("Skipping HTTP/2 tests because HTTP2_TEST_RESOURCE_URL is not set.");
+    }
+
+    Azure::Core::Http::CurlTransportOptions curlOptions;
+    curlOptions.EnableHttp2 = true;
+    curlOptions.SslVerifyPeer = false;
+    auto const transport = std::make_shared<Azure::Core::Http::CurlTransport>(curlOptions);
+
+    Azure::Core::Http::Request firstRequest(
+        Azure::Core::Http::HttpMethod::Get, Azure::Core::Url(url));
+    auto const expectedBody
+        = transport->Send(firstRequest, Azure::Core::Context{})->ExtractBodyStream()->ReadToEnd();
+
+    Azure::Core::Http::Policies::TransportOptions options;
+    options.Transport = transport;
+    std::vector<std::unique_ptr<Azure::Core::Http::Policies::HttpPolicy>> policies;
+    policies.push_back(
+        std::make_unique<Azure::Core::Http::Policies::_internal::TransportPolicy>(options));
+    Azure::Core::Http::_internal::HttpPipeline pipeline(policies);
+
+    // The requests are sent from a single thread, half of them buffering their response. The
+    // callbacks are called from a background thread of the transport.
+    constexpr size_t RequestCount = 8;
+    std::vector<std::unique_ptr<Azure::Core::Http::Request>> requests;
+    std::vector<std::promise<std::unique_ptr<Azure::Core::Http::RawResponse>>> promises(
+        RequestCount);
+    for (size_t i = 0; i < RequestCount; ++i)
+    {
+      requests.push_back(std::make_unique<Azure::Core::Http::Request>(
+          Azure::Core::Http::HttpMethod::Get, Azure::Core::Url(url), i % 2 == 0));
+      pipeline.SendAsync(
+          *requests.back(),
+          Azure::Core::Context{},
+          [&promises, i, caller = std::this_thread::get_id()](
+              std::unique_ptr<Azure::Core::Http::RawResponse> response,
+              std::exception_ptr error) {
+            EXPECT_NE(std::this_thread::get_id(), caller);
+            if (error)
+            {
+              promises[i].set_exception(error);
+            }
+            else
+            {
+              promises[i].set_value(std::move(response));
+            }
+          });
+    }
+
+    for (size_t i = 0; i < RequestCount; ++i)
+    {
+      auto const response = promises[i].get_future().get();
+      EXPECT_EQ(response->GetMajorVersion(), 2);
+      if (i % 2 == 0)
+      {
+        EXPECT_EQ(response->GetBody(), expectedBody);
+      }
+      else
+      {
+        EXPECT_EQ(response->ExtractBodyStream()->ReadToEnd(), expectedBody);
+      }
+    }
+  }
+
+  TEST(CurlTransportOptions, http2Upload)
+  {
+    auto const url = Http2TestResourceUrl();
+    if (url.empty())
+    {
+      GTEST_SKIP_("Skipping HTTP/2 tests because HTTP2_TEST_RESOURCE_URL is not set.");
+    }
+
+    Azure::Core::Http::CurlTransportOptions curlOptions;
+    curlOptions.EnableHttp2 = true;
+    curlOptions.SslVerifyPeer = false;
+    Azure::Core::Http::CurlTransport transport(curlOptions);
+
+    std::vector<uint8_t> const content(3 * 1024 * 1024, 'x');
+    Azure::Core::IO::MemoryBodyStream bodyStream(content);
+    Azure::Core::Http::Request request(
+        Azure::Core::Http::HttpMethod::Post, Azure::Core::Url(url), &bodyStream);
+    auto response = transport.Send(request, Azure::Core::Context{});
+    EXPECT_EQ(response->GetMajorVersion(), 2);
+    EXPECT_LT(static_cast<int>(response->GetStatusCode()), 500);
+  }
+
 }}} // namespace Azure::Core::Test
@@ -0,0 +1,295 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/core/http/policies/policy.hpp"
+#include "azure/core/internal/http/pipeline.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace Azure::Core::Http;
+using namespace Azure::Core::Http::Policies;
+using namespace Azure::Core::Http::Policies::_internal;
+using namespace std::chrono_literals;
+
+namespace {
+class TestTransportPolicy final : public HttpPolicy {
+private:
+  std::function<std::unique_ptr<RawResponse>(Request&, Azure::Core::Context const&)> m_send;
+
+public:
+  TestTransportPolicy(
+      std::function<std::unique_ptr<RawResponse>(Request&, Azure::Core::Context const&)> send)
+      : m_send(send)
+  {
+  }
+
+  std::unique_ptr<RawResponse> Send(
+      Request& request,
+      NextHttpPolicy,
+      Azure::Core::Context const& context) const override
+  {
+    return m_send(request, context);
+  }
+
+  std::unique_ptr<HttpPolicy> Clone() const override
+  {
+    return std::make_unique<TestTransportPolicy>(*this);
+  }
+};
+
+// Simulates a slow server: waits until the request is cancelled or the delay expires.
+void WaitUnlessCancelled(Azure::Core::Context const& context, std::chrono::milliseconds delay)
+{
+  auto const deadline = std::chrono::steady_clock::now() + delay;
+  while (std::chrono::steady_clock::now() < deadline)
+  {
+    context.ThrowIfCancelled();
+    std::this_thread::sleep_for(1ms);
+  }
+}
+
+Azure::Core::Http::_internal::HttpPipeline CreatePipeline(
+    HedgingOptions const& options,
+    std::function<std::unique_ptr<RawResponse>(Request&, Azure::Core::Context const&)> send)
+{
+  std::vector<std::unique_ptr<HttpPolicy>> policies;
+  policies.emplace_back(std::make_unique<HedgingPolicy>(options));
+  policies.emplace_back(std::make_unique<TestTransportPolicy>(send));
+  return Azure::Core::Http::_internal::HttpPipeline(policies);
+}
+} // namespace
+
+TEST(HedgingPolicy, FastResponseIsNotHedged)
+{
+  HedgingOptions options;
+  options.Enabled = true;
+  options.HedgeDelay = 5s;
+  options.MaxHedgedRequestsPercentage = 100;
+
+  std::atomic<int> attempts(0);
+  auto pipeline = CreatePipeline(options, [&](Request&, Azure::Core::Context const&) {
+    ++attempts;
+    return std::make_unique<RawResponse>(1, 1, HttpStatusCode::Ok, "OK");
+  });
+
+  Request request(HttpMethod::Get, Azure::Core::Url("https://www.microsoft.com"));
+  auto response = pipeline.Send(request, Azure::Core::Context());
+  EXPECT_EQ(response->GetStatusCode(), HttpStatusCode::Ok);
+  EXPECT_EQ(attempts.load(), 1);
+}
+
+TEST(HedgingPolicy, SlowResponseIsHedged)
+{
+  HedgingOptions options;
+  options.Enabled = true;
+  options.HedgeDelay = 10ms;
+  options.MaxHedgedRequestsPercentage = 100;
+
+  std::atomic<int> attempts(0);
+  std::atomic<bool> originalCancelled(false);
+  {
+    auto pipeline
+        = CreatePipeline(options, [&](Request& request, Azure::Core::Context const& context) {
+            ++attempts;
+            if (HedgingPolicy::IsHedgedAttempt(context))
+            {
+              EXPECT_EQ(request.GetUrl().GetHost(), "www.microsoft.com");
+              return std::make_unique<RawResponse>(1, 1, HttpStatusCode::Accepted, "Accepted");
+            }
+            try
+            {
+              WaitUnlessCancelled(context, 30s);
+            }
+            catch (Azure::Core::OperationCancelledException const&)
+            {
+              originalCancelled = true;
+              throw;
+            }
+            return std::make_unique<RawResponse>(1, 1, HttpStatusCode::Ok, "OK");
+          });
+
+    Request request(HttpMethod::Get, Azure::Core::Url("https://www.microsoft.com"));
+    auto const start = std::chrono::steady_clock::now();
+    auto response = pipeline.Send(request, Azure::Core::Context());
+    EXPECT_EQ(response->GetStatusCode(), HttpStatusCode::Accepted);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 10s);
+  }
+
+  // The pipeline waits for the cancelled attempt when it is destroyed.
+  EXPECT_EQ(attempts.load(), 2);
+  EXPECT_TRUE(originalCancelled.load());
+}
+
+TEST(HedgingPolicy, OriginalAttemptIsSentFromCallingThread)
+{
+  HedgingOptions options;
+  options.Enabled = true;
+  options.HedgeDelay = 5s;
+  options.MaxHedgedRequestsPercentage = 100;
+
+  auto const callingThread = std::this_thread::get_id();
+  auto pipeline = CreatePipeline(options, [&](Request&, Azure::Core::Context const& context) {
+    EXPECT_FALSE(HedgingPolicy::IsHedgedAttempt(context));
+    EXPECT_EQ(std::this_thread::get_id(), callingThread);
+    return std::make_unique<RawResponse>(1, 1, HttpStatusCode::Ok, "OK");
+  });
+
+  Request request(HttpMethod::Get, Azure::Core::Url("https://www.microsoft.com"));
+  EXPECT_EQ(pipeline.Send(request, Azure::Core::Context())->GetStatusCode(), HttpStatusCode::Ok);
+}
+
+TEST(HedgingPolicy, HedgedErrorDoesNotWin)
+{
+  HedgingOptions options;
+  options.Enabled = true;
+  options.HedgeDelay = 10ms;
+  options.MaxHedgedRequestsPercentage = 100;
+
+  std::atomic<int> attempts(0);
+  {
+    auto pipeline = CreatePipeline(options, [&](Request&, Azure::Core::Context const& context) {
+      ++attempts;
+      if (HedgingPolicy::IsHedgedAttempt(context))
+      {
+        return std::make_unique<RawResponse>(1, 1, HttpStatusCode::NotFound, "Not Found");
+      }
+      WaitUnlessCancelled(context, 200ms);
+      return std::make_unique<RawResponse>(1, 1, HttpStatusCode::Ok, "OK");
+    });
+
+    Request request(HttpMethod::Get, Azure::Core::Url("https://www.microsoft.com"));
+    EXPECT_EQ(
+        pipeline.Send(request, Azure::Core::Context())->GetStatusCode(), HttpStatusCode::Ok);
+  }
+  EXPECT_EQ(attempts.load(), 2);
+}
+
+TEST(HedgingPolicy, RetriableErrorWaitsForOtherAttempt)
+{
+  HedgingOptions options;
+  options.Enabled = true;
+  options.HedgeDelay = 10ms;
+  options.MaxHedgedRequestsPercentage = 100;
+
+  auto pipeline = CreatePipeline(options, [&](Request&, Azure::Core::Context const& context) {
+    if (HedgingPolicy::IsHedgedAttempt(context))
+    {
+      WaitUnlessCancelled(context, 200ms);
+      return std::make_unique<RawResponse>(1, 1, HttpStatusCode::Ok, "OK");
+    }
+    WaitUnlessCancelled(context, 50ms);
+    return std::make_unique<RawResponse>(
+        1, 1, HttpStatusCode::ServiceUnavailable, "Service Unavailable");
+  });
+
+  Request request(HttpMethod::Get, Azure::Core::Url("https://www.microsoft.com"));
+  EXPECT_EQ(pipeline.Send(request, Azure::Core::Context())->GetStatusCode(), HttpStatusCode::Ok);
+}
+
+TEST(HedgingPolicy, AllAttemptsFailWithStatus)
+{
+  HedgingOptions options;
+  options.Enabled = true;
+  options.HedgeDelay = 10ms;
+  options.MaxHedgedRequestsPercentage = 100;
+
+  auto pipeline = CreatePipeline(options, [&](Request&, Azure::Core::Context const& context) {
+    if (HedgingPolicy::IsHedgedAttempt(context))
+    {
+      return std::make_unique<RawResponse>(1, 1, HttpStatusCode::NotFound, "Not Found");
+    }
+    WaitUnlessCancelled(context, 50ms);
+    return std::make_unique<RawResponse>(
+        1, 1, HttpStatusCode::ServiceUnavailable, "Service Unavailable");
+  });
+
+  // The response of the original attempt is preferred.
+  Request request(HttpMethod::Get, Azure::Core::Url("https://www.microsoft.com"));
+  EXPECT_EQ(
+      pipeline.Send(request, Azure::Core::Context())->GetStatusCode(),
+      HttpStatusCode::ServiceUnavailable);
+}
+
+TEST(HedgingPolicy, NonIdempotentRequestIsNotHedged)
+{
+  HedgingOptions options;
+  options.Enabled = true;
+  options.HedgeDelay = 1ms;
+  options.MaxHedgedRequestsPercentage = 100;
+
+  std::atomic<int> attempts(0);
+  auto pipeline = CreatePipeline(options, [&](Request&, Azure::Core::Context const& context) {
+    ++attempts;
+    EXPECT_FALSE(HedgingPolicy::IsHedgedAttempt(context));
+    std::this_thread::sleep_for(50ms);
+    return std::make_unique<RawResponse>(1, 1, HttpStatusCode::Created, "Created");
+  });
+
+  Request request(HttpMethod::Put, Azure::Core::Url("https://www.microsoft.com"));
+  auto response = pipeline.Send(request, Azure::Core::Context());
+  EXPECT_EQ(response->GetStatusCode(), HttpStatusCode::Created);
+  EXPECT_EQ(attempts.load(), 1);
+}
+
+TEST(HedgingPolicy, HedgedRequestsAreCapped)
+{
+  HedgingOptions options;
+  options.Enabled = true;
+  options.HedgeDelay = 1ms;
+  options.MaxHedgedRequestsPercentage = 50;
+
+  std::atomic<int> attempts(0);
+  {
+    auto pipeline = CreatePipeline(options, [&](Request&, Azure::Core::Context const&) {
+      ++attempts;
+      std::this_thread::sleep_for(50ms);
+      return std::make_unique<RawResponse>(1, 1, HttpStatusCode::Ok, "OK");
+    });
+
+    for (int i = 0; i < 4; ++i)
+    {
+      Request request(HttpMethod::Get, Azure::Core::Url("https://www.microsoft.com"));
+      EXPECT_EQ(
+          pipeline.Send(request, Azure::Core::Context())->GetStatusCode(), HttpStatusCode::Ok);
+    }
+  }
+
+  // Requests 1 and 3 are hedged, requests 2 and 4 would exceed the 50% budget.
+  EXPECT_EQ(attempts.load(), 6);
+}
+
+TEST(HedgingPolicy, AllAttemptsFail)
+{
+  HedgingOptions options;
+  options.Enabled = true;
+  options.HedgeDelay = 1ms;
+  options.MaxHedgedRequestsPercentage = 100;
+
+  auto pipeline = CreatePipeline(
+      options, [&](Request&, Azure::Core::Context const&) -> std::unique_ptr<RawResponse> {
+        std::this_thread::sleep_for(20ms);
+        throw TransportException("Test transport failure");
+      });
+
+  Request request(HttpMethod::Get, Azure::Core::Url("https://www.microsoft.com"));
+  EXPECT_THROW(pipeline.Send(request, Azure::Core::Context()), TransportException);
+}
+
+TEST(HedgingPolicy, ClientOptions)
+{
+  Azure::Core::_internal::ClientOptions clientOptions;
+  clientOptions.Hedging.Enabled = true;
+  clientOptions.Hedging.HedgeDelay = 1ms;
+  clientOptions.Hedging.MaxHedgedRequestsPercentage = 100;
+
+  Azure::Core::_internal::ClientOptions copy(clientOptions);
+  EXPECT_TRUE(copy.Hedging.Enabled);
+  EXPECT_EQ(copy.Hedging.HedgeDelay, 1ms);
+  EXPECT_EQ(copy.Hedging.MaxHedgedRequestsPercentage, 100);
+  EXPECT_FALSE(copy.Hedging.LatencyPercentile.HasValue());
+}
@@ -249,4 +249,73 @@ namespace Azure { namespace Core { namespace Test {
     }
   }
 
+  TEST(TestHttp, RequestHeadersView)
+  {
+    Http::Request req(Http::HttpMethod::Get, Url("http://test.com"));
+    req.SetHeader("Accept", "application/json");
+    req.SetHeader("x-ms-version", "2024-08-04");
+
+    req.StartTry();
+    req.SetHeader("X-MS-Version", "2025-01-05");
+    req.SetHeader("x-ms-date", "Sat, 18 Oct 2026 16:38:20 GMT");
+
+    EXPECT_TRUE(req.HasHeader("accept"));
+    EXPECT_TRUE(req.HasHeader("X-Ms-Date"));
+    EXPECT_FALSE(req.HasHeader("authorization"));
+    EXPECT_EQ(req.GetHeader("x-ms-version").Value(), "2025-01-05");
+
+    // The headers of the current try come first and override the ones of the request.
+    std::vector<std::pair<std::string, std::string>> headers;
+    req.ForEachHeader([&](std::string const& name, std::string const& value) {
+      headers.emplace_back(name, value);
+    });
+    std::vector<std::pair<std::string, std::string>> const expected{
+        {"x-ms-version", "2025-01-05"},
+        {"x-ms-date", "Sat, 18 Oct 2026 16:38:20 GMT"},
+        {"accept", "application/json"}};
+    EXPECT_EQ(headers, expected);
+
+    req.StartTry();
+    EXPECT_FALSE(req.HasHeader("x-ms-date"));
+    EXPECT_EQ(req.GetHeader("x-ms-version").Value(), "2024-08-04");
+
+    req.RemoveHeader("X-MS-VERSION");
+    EXPECT_FALSE(req.HasHeader("x-ms-version"));
+    EXPECT_EQ(req.GetHeaders().size(), 1ul);
+  }
+
+  TEST(TestHttp, HttpHeaders)
+  {
+    Http::_internal::HttpHeaders headers;
+    EXPECT_TRUE(headers.IsEmpty());
+    EXPECT_EQ(headers.Find("Content-Type"), nullptr);
+
+    headers.Set("Content-Type", "text/plain");
+    headers.Set("content-length", "0");
+    headers.Set("CONTENT-TYPE", "application/json");
+    EXPECT_EQ(headers.Size(), 2ul);
+    EXPECT_EQ(
+        Http::_internal::HttpHeaders::Hash("Content-Type"),
+        Http::_internal::HttpHeaders::Hash("content-type"));
+
+    ASSERT_NE(headers.Find("content-type"), nullptr);
+    EXPECT_EQ(*headers.Find("content-type"), "application/json");
+    // Names are stored in lowercase, in insertion order.
+    EXPECT_EQ(headers.begin()->first, "content-type");
+
+    headers.Erase("Content-Type");
+    EXPECT_EQ(headers.Find("content-type"), nullptr);
+    ASSERT_NE(headers.Find("Content-Length"), nullptr);
+    EXPECT_EQ(*headers.Find("Content-Length"), "0");
+
+    CaseInsensitiveMap map{{"content-length", "42"}};
+    headers.Set("accept", "*/*");
+    headers.CopyTo(map);
+    EXPECT_EQ(map.size(), 2ul);
+    EXPECT_EQ(map["Content-Length"], "42");
+
+    headers.Clear();
+    EXPECT_TRUE(headers.IsEmpty());
+  }
+
 }}} // namespace Azure::Core::Test
@@ -3,12 +3,40 @@
 
 #include <azure/core/internal/diagnostics/log.hpp>
 
+#include <chrono>
+#include <condition_variable>
 #include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
+using Azure::Core::Diagnostics::AsyncLogListenerOptions;
 using Azure::Core::Diagnostics::Logger;
 using Azure::Core::Diagnostics::_internal::Log;
+using Azure::Core::Diagnostics::_internal::LogRecord;
+
+namespace {
+class TestLogRecord final : public LogRecord {
+  std::string m_message;
+  std::thread::id* m_formattingThread;
+
+public:
+  TestLogRecord(std::string message, std::thread::id* formattingThread)
+      : m_message(std::move(message)), m_formattingThread(formattingThread)
+  {
+  }
+
+  std::string Format() const override
+  {
+    *m_formattingThread = std::this_thread::get_id();
+    return m_message;
+  }
+};
+} // namespace
 
 TEST(Logger, Levels)
 {
@@ -303,3 +331,206 @@ TEST(Logger, LoggerStreamInsertion)
   Log::Stream(Logger::Level::Verbose)
       << "Verbose" << std::put_time(localtime(&time_t), "%c") << std::endl;
 }
+
+TEST(Logger, LogRecord)
+{
+  std::vector<std::string> messages;
+  Logger::SetListener([&](auto, auto msg) { messages.push_back(msg); });
+
+  std::thread::id formattingThread;
+  Logger::SetLevel(Logger::Level::Warning);
+  Log::Write(
+      Logger::Level::Verbose, std::make_unique<TestLogRecord>("Verbose", &formattingThread));
+  EXPECT_EQ(formattingThread, std::thread::id());
+
+  Log::Write(Logger::Level::Error, std::make_unique<TestLogRecord>("Error", &formattingThread));
+  EXPECT_EQ(formattingThread, std::this_thread::get_id());
+  Log::Write(Logger::Level::Error, std::make_unique<TestLogRecord>("", &formattingThread));
+
+  ASSERT_EQ(messages.size(), 1ul);
+  EXPECT_EQ(messages[0], "Error");
+
+  Logger::SetListener(nullptr);
+}
+
+TEST(Logger, AsyncListener)
+{
+  std::vector<std::string> messages;
+  std::thread::id listenerThread;
+  Logger::SetAsyncListener([&](auto lvl, auto msg) {
+    EXPECT_EQ(lvl, Logger::Level::Informational);
+    listenerThread = std::this_thread::get_id();
+    messages.push_back(msg);
+  });
+  Logger::SetLevel(Logger::Level::Verbose);
+
+  std::thread::id formattingThread;
+  Log::Write(Logger::Level::Informational, "First");
+  Log::Stream(Logger::Level::Informational) << "Second " << 2;
+  Log::Write(
+      Logger::Level::Informational, std::make_unique<TestLogRecord>("Third", &formattingThread));
+  Logger::Flush();
+
+  ASSERT_EQ(messages.size(), 3ul);
+  EXPECT_EQ(messages[0], "First");
+  EXPECT_EQ(messages[1], "Second 2");
+  EXPECT_EQ(messages[2], "Third");
+  EXPECT_NE(listenerThread, std::this_thread::get_id());
+  EXPECT_EQ(formattingThread, listenerThread);
+
+  // Setting another listener delivers the messages which are still queued.
+  Log::Write(Logger::Level::Informational, "Fourth");
+  Logger::SetListener(nullptr);
+  ASSERT_EQ(messages.size(), 4ul);
+  EXPECT_EQ(messages[3], "Fourth");
+
+  Logger::SetLevel(Logger::Level::Warning);
+}
+
+TEST(Logger, AsyncListenerConcurrentWriters)
+{
+  constexpr int ThreadCount = 4;
+  constexpr int MessageCount = 1000;
+
+  std::vector<std::string> messages;
+  AsyncLogListenerOptions options;
+  options.Capacity = ThreadCount * MessageCount;
+  Logger::SetAsyncListener([&](auto, auto msg) { messages.push_back(msg); }, options);
+  Logger::SetLevel(Logger::Level::Verbose);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < ThreadCount; ++i)
+  {
+    threads.emplace_back([i]() {
+      for (int j = 0; j < MessageCount; ++j)
+      {
+        Log::Write(Logger::Level::Verbose, std::to_string(i) + ":" + std::to_string(j));
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  Logger::Flush();
+
+  ASSERT_EQ(messages.size(), static_cast<size_t>(ThreadCount * MessageCount));
+  // The messages of each thread are delivered in order.
+  std::vector<int> next(ThreadCount, 0);
+  for (auto const& message : messages)
+  {
+    auto const separator = message.find(':');
+    auto const thread = std::stoi(message.substr(0, separator));
+    EXPECT_EQ(std::stoi(message.substr(separator + 1)), next[thread]++);
+  }
+
+  Logger::SetListener(nullptr);
+  Logger::SetLevel(Logger::Level::Warning);
+}
+
+TEST(Logger, AsyncListenerDropsWhenFull)
+{
+  std::mutex mutex;
+  std::condition_variable released;
+  bool isReleased = false;
+  std::vector<std::pair<Logger::Level, std::string>> messages;
+
+  AsyncLogListenerOptions options;
+  options.Capacity = 2;
+  Logger::SetAsyncListener(
+      [&](auto lvl, auto msg) {
+        std::unique_lock<std::mutex> lock(mutex);
+        released.wait(lock, [&]() { return isReleased; });
+        messages.emplace_back(lvl, msg);
+      },
+      options);
+  Logger::SetLevel(Logger::Level::Verbose);
+
+  // The listener blocks on the first message, so that at most 3 messages are held: 1 by the
+  // listener and 2 in the queue.
+  for (int i = 0; i < 10; ++i)
+  {
+    Log::Write(Logger::Level::Verbose, "Message " + std::to_string(i));
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    isReleased = true;
+  }
+  released.notify_all();
+  Logger::Flush();
+  Logger::SetListener(nullptr);
+
+  ASSERT_GE(messages.size(), 3ul);
+  ASSERT_LE(messages.size(), 4ul);
+  auto const delivered = messages.size() - 1;
+  EXPECT_EQ(messages[0].second, "Message 0");
+  EXPECT_EQ(messages.back().first, Logger::Level::Warning);
+  EXPECT_EQ(
+      messages.back().second,
+      "Dropped " + std::to_string(10 - delivered)
+          + " log messages because the queue of the asynchronous log listener was full.");
+
+  Logger::SetLevel(Logger::Level::Warning);
+}
+
+TEST(Logger, AsyncListenerFlushes)
+{
+  std::vector<std::string> messages;
+  Logger::SetAsyncListener([&](auto, auto msg) {
+    // There is nothing to wait for on the listener thread.
+    Logger::Flush();
+    if (messages.empty())
+    {
+      Log::Write(Logger::Level::Verbose, "Logged by the listener");
+    }
+    messages.push_back(msg);
+  });
+  Logger::SetLevel(Logger::Level::Verbose);
+
+  Log::Write(Logger::Level::Verbose, "First");
+  Logger::Flush();
+  Logger::Flush();
+  Logger::SetListener(nullptr);
+
+  ASSERT_EQ(messages.size(), 2ul);
+  EXPECT_EQ(messages[0], "First");
+  EXPECT_EQ(messages[1], "Logged by the listener");
+
+  Logger::SetLevel(Logger::Level::Warning);
+}
+
+TEST(Logger, AsyncListenerSetsListener)
+{
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::vector<std::string> messages;
+  Logger::SetAsyncListener([&](auto, auto msg) {
+    // Replacing the listener from its own thread leaves the sink to be stopped by another thread.
+    Logger::SetListener([&](auto, auto innerMsg) {
+      std::lock_guard<std::mutex> lock(mutex);
+      messages.push_back("Synchronous " + innerMsg);
+      changed.notify_all();
+    });
+    std::lock_guard<std::mutex> lock(mutex);
+    messages.push_back(msg);
+    changed.notify_all();
+  });
+  Logger::SetLevel(Logger::Level::Verbose);
+
+  Log::Write(Logger::Level::Verbose, "First");
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(changed.wait_for(lock, std::chrono::seconds(10), [&]() {
+      return !messages.empty();
+    }));
+  }
+  Log::Write(Logger::Level::Verbose, "Second");
+  Logger::SetListener(nullptr);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_EQ(messages.size(), 2ul);
+  EXPECT_EQ(messages[0], "First");
+  EXPECT_EQ(messages[1], "Synchronous Second");
+
+  Logger::SetLevel(Logger::Level::Warning);
+}
@@ -2,8 +2,19 @@
 // Licensed under the MIT License.
 
 #include <azure/core/http/policies/policy.hpp>
+#include <azure/core/http/response_buffer_pool.hpp>
 #include <azure/core/internal/http/pipeline.hpp>
+#include <azure/core/io/body_stream.hpp>
 
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -223,3 +234,355 @@ TEST(Policy, RetryPolicyKeepContext)
   auto withValueContext = Context{}.WithValue(TheKey, std::string("TheValue"));
   pipeline.Send(request, withValueContext);
 }
+
+namespace {
+class BodyTransport final : public Azure::Core::Http::HttpTransport {
+  std::vector<uint8_t> m_body;
+
+public:
+  explicit BodyTransport(std::vector<uint8_t> body) : m_body(std::move(body)) {}
+
+  std::unique_ptr<Azure::Core::Http::RawResponse> Send(
+      Azure::Core::Http::Request&,
+      Azure::Core::Context const&) override
+  {
+    auto response = std::make_unique<Azure::Core::Http::RawResponse>(
+        1, 1, Azure::Core::Http::HttpStatusCode::Ok, "OK");
+    response->SetBodyStream(std::make_unique<Azure::Core::IO::MemoryBodyStream>(m_body));
+    return response;
+  }
+};
+} // namespace
+
+TEST(Policy, ResponseBufferPool)
+{
+  using Azure::Core::Http::ResponseBufferPool;
+  using Azure::Core::Http::ResponseBufferPoolOptions;
+
+  ResponseBufferPoolOptions options;
+  options.MaxBufferCount = 2;
+  options.MaxBufferSize = 1024;
+  ResponseBufferPool pool(options);
+
+  EXPECT_EQ(pool.Acquire(10).capacity(), 0);
+
+  std::vector<uint8_t> small(100, 1);
+  std::vector<uint8_t> large(1000, 1);
+  std::vector<uint8_t> tooLarge(2000, 1);
+  auto const smallData = small.data();
+  auto const largeData = large.data();
+  pool.Release(std::move(tooLarge));
+  pool.Release(std::move(large));
+  pool.Release(std::move(small));
+  pool.Release(std::vector<uint8_t>(10));
+
+  // The smallest buffer that fits is preferred, otherwise the largest buffer.
+  auto buffer = pool.Acquire(50);
+  EXPECT_EQ(buffer.data(), smallData);
+  EXPECT_TRUE(buffer.empty());
+  pool.Release(std::move(buffer));
+  buffer = pool.Acquire(5000);
+  EXPECT_EQ(buffer.data(), largeData);
+  buffer = pool.Acquire(0);
+  EXPECT_EQ(buffer.data(), smallData);
+  EXPECT_EQ(pool.Acquire(0).capacity(), 0);
+}
+
+TEST(Policy, TransportPolicyResponseBufferPool)
+{
+  using namespace Azure::Core;
+  using namespace Azure::Core::Http;
+  using namespace Azure::Core::Http::_internal;
+  using namespace Azure::Core::Http::Policies;
+  using namespace Azure::Core::Http::Policies::_internal;
+
+  std::vector<uint8_t> const content(20000, 'a');
+  TransportOptions options;
+  options.Transport = std::make_shared<BodyTransport>(content);
+  options.ResponseBufferPool = std::make_shared<ResponseBufferPool>();
+
+  std::vector<std::unique_ptr<HttpPolicy>> policies;
+  policies.push_back(std::make_unique<TransportPolicy>(options));
+  HttpPipeline pipeline(policies);
+
+  Request request(HttpMethod::Get, Url("url"));
+  auto response = pipeline.Send(request, Context{});
+  EXPECT_EQ(response->GetBody(), content);
+  // The length of the body is known, so that the buffer isn't larger than the body.
+  EXPECT_EQ(response->GetBody().capacity(), content.size());
+  auto const data = response->GetBody().data();
+
+  // The buffer goes back to the pool with the response, and is reused by the next response.
+  response.reset();
+  response = pipeline.Send(request, Context{});
+  EXPECT_EQ(response->GetBody(), content);
+  EXPECT_EQ(response->GetBody().data(), data);
+}
+
+namespace {
+// Completes each request from a thread of its own, after a short delay.
+class AsyncTransport final : public Azure::Core::Http::HttpTransport {
+  std::vector<std::function<std::unique_ptr<Azure::Core::Http::RawResponse>()>> m_responses;
+  size_t m_sent = 0;
+  std::mutex m_mutex;
+  std::vector<std::thread> m_threads;
+
+public:
+  explicit AsyncTransport(
+      std::vector<std::function<std::unique_ptr<Azure::Core::Http::RawResponse>()>> responses)
+      : m_responses(std::move(responses))
+  {
+  }
+
+  ~AsyncTransport() override
+  {
+    for (auto& thread : m_threads)
+    {
+      thread.join();
+    }
+  }
+
+  std::unique_ptr<Azure::Core::Http::RawResponse> Send(
+      Azure::Core::Http::Request&,
+      Azure::Core::Context const&) override
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_responses[m_sent++]();
+  }
+
+  void SendAsync(
+      Azure::Core::Http::Request&,
+      Azure::Core::Context const&,
+      Azure::Core::Http::SendCallback callback) override
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto respond = m_responses[m_sent++];
+    m_threads.emplace_back([respond, callback]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      std::unique_ptr<Azure::Core::Http::RawResponse> response;
+      try
+      {
+        response = respond();
+      }
+      catch (...)
+      {
+        callback(nullptr, std::current_exception());
+        return;
+      }
+      callback(std::move(response), nullptr);
+    });
+  }
+};
+
+// Fails to send the retries of a request, before sending them to the next policy.
+struct ThrowWhenRetried final : public Azure::Core::Http::Policies::HttpPolicy
+{
+  std::unique_ptr<HttpPolicy> Clone() const override
+  {
+    return std::make_unique<ThrowWhenRetried>(*this);
+  }
+
+  std::unique_ptr<Azure::Core::Http::RawResponse> Send(
+      Azure::Core::Http::Request& request,
+      Azure::Core::Http::Policies::NextHttpPolicy nextPolicy,
+      Azure::Core::Context const& context) const override
+  {
+    return nextPolicy.Send(request, context);
+  }
+
+  void SendAsync(
+      Azure::Core::Http::Request& request,
+      Azure::Core::Http::Policies::NextHttpPolicy nextPolicy,
+      Azure::Core::Context const& context,
+      Azure::Core::Http::SendCallback callback) const override
+  {
+    if (Azure::Core::Http::Policies::_internal::RetryPolicy::GetRetryCount(context) > 0)
+    {
+      throw std::runtime_error("Can't send the retry.");
+    }
+    nextPolicy.SendAsync(request, context, std::move(callback));
+  }
+};
+
+std::unique_ptr<Azure::Core::Http::RawResponse> CreateResponse(
+    Azure::Core::Http::HttpStatusCode statusCode,
+    std::vector<uint8_t> const& body)
+{
+  auto response = std::make_unique<Azure::Core::Http::RawResponse>(1, 1, statusCode, "");
+  response->SetBodyStream(std::make_unique<Azure::Core::IO::MemoryBodyStream>(body));
+  return response;
+}
+} // namespace
+
+TEST(Policy, SendAsync)
+{
+  using namespace Azure::Core;
+  using namespace Azure::Core::Http;
+  using namespace Azure::Core::Http::_internal;
+  using namespace Azure::Core::Http::Policies;
+  using namespace Azure::Core::Http::Policies::_internal;
+  // Clean the validation global state
+  retryCounterState = 0;
+
+  std::vector<uint8_t> const content(100, 'a');
+  TransportOptions options;
+  options.Transport = std::make_shared<AsyncTransport>(
+      std::vector<std::function<std::unique_ptr<RawResponse>()>>{
+          []() -> std::unique_ptr<RawResponse> { throw TransportException("Cable Unplugged"); },
+          [&]() { return CreateResponse(HttpStatusCode::ServiceUnavailable, {}); },
+          [&]() { return CreateResponse(HttpStatusCode::Ok, content); }});
+
+  std::vector<std::unique_ptr<HttpPolicy>> policies;
+  RetryOptions opt;
+  opt.RetryDelay = std::chrono::milliseconds(100);
+  policies.push_back(std::make_unique<RequestIdPolicy>());
+  policies.push_back(std::make_unique<RetryPolicy>(opt));
+  // A policy which doesn't support sending asynchronously.
+  policies.push_back(std::make_unique<TestRetryPolicySharedState>());
+  policies.push_back(std::make_unique<TransportPolicy>(options));
+  HttpPipeline pipeline(policies);
+
+  Request request(HttpMethod::Get, Url("url"));
+  std::promise<std::unique_ptr<RawResponse>> promise;
+  pipeline.SendAsync(
+      request, Context{}, [&](std::unique_ptr<RawResponse> response, std::exception_ptr error) {
+        if (error)
+        {
+          promise.set_exception(error);
+        }
+        else
+        {
+          promise.set_value(std::move(response));
+        }
+      });
+
+  // The policy after the retry policy sends synchronously, so that the first try is sent from the
+  // calling thread, and the retries from the threads started once their delay expires. The call
+  // returns before the response is received.
+  auto result = promise.get_future();
+  EXPECT_EQ(result.wait_for(std::chrono::milliseconds(0)), std::future_status::timeout);
+  ASSERT_EQ(result.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+  auto const response = result.get();
+  EXPECT_EQ(response->GetStatusCode(), HttpStatusCode::Ok);
+  EXPECT_EQ(response->GetBody(), content);
+  EXPECT_EQ(retryCounterState, 3);
+  EXPECT_TRUE(request.GetHeader("x-ms-client-request-id").HasValue());
+}
+
+TEST(Policy, SendAsyncDelayedRetry)
+{
+  using namespace Azure::Core;
+  using namespace Azure::Core::Http;
+  using namespace Azure::Core::Http::_internal;
+  using namespace Azure::Core::Http::Policies;
+  using namespace Azure::Core::Http::Policies::_internal;
+
+  std::vector<uint8_t> const content(100, 'a');
+  TransportOptions options;
+  options.Transport = std::make_shared<AsyncTransport>(
+      std::vector<std::function<std::unique_ptr<RawResponse>()>>{
+          [&]() { return CreateResponse(HttpStatusCode::ServiceUnavailable, {}); },
+          [&]() { return CreateResponse(HttpStatusCode::Ok, content); }});
+
+  // Every policy sends asynchronously.
+  std::vector<std::unique_ptr<HttpPolicy>> policies;
+  RetryOptions opt;
+  opt.RetryDelay = std::chrono::milliseconds(100);
+  policies.push_back(std::make_unique<RequestIdPolicy>());
+  policies.push_back(std::make_unique<RetryPolicy>(opt));
+  policies.push_back(std::make_unique<TransportPolicy>(options));
+  HttpPipeline pipeline(policies);
+
+  Request request(HttpMethod::Get, Url("url"));
+  std::promise<std::unique_ptr<RawResponse>> promise;
+  std::thread::id callbackThread;
+  pipeline.SendAsync(
+      request, Context{}, [&](std::unique_ptr<RawResponse> response, std::exception_ptr error) {
+        callbackThread = std::this_thread::get_id();
+        if (error)
+        {
+          promise.set_exception(error);
+        }
+        else
+        {
+          promise.set_value(std::move(response));
+        }
+      });
+
+  auto result = promise.get_future();
+  EXPECT_EQ(result.wait_for(std::chrono::milliseconds(0)), std::future_status::timeout);
+  ASSERT_EQ(result.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+  auto const response = result.get();
+  EXPECT_EQ(response->GetStatusCode(), HttpStatusCode::Ok);
+  EXPECT_EQ(response->GetBody(), content);
+  EXPECT_NE(callbackThread, std::this_thread::get_id());
+}
+
+TEST(Policy, SendAsyncErrors)
+{
+  using namespace Azure::Core;
+  using namespace Azure::Core::Http;
+  using namespace Azure::Core::Http::_internal;
+  using namespace Azure::Core::Http::Policies;
+  using namespace Azure::Core::Http::Policies::_internal;
+
+  auto const sendAsync = [](HttpPipeline const& pipeline, Context const& context) {
+    Request request(HttpMethod::Get, Url("url"));
+    std::promise<std::unique_ptr<RawResponse>> promise;
+    pipeline.SendAsync(
+        request, context, [&](std::unique_ptr<RawResponse> response, std::exception_ptr error) {
+          EXPECT_NE(response == nullptr, error == nullptr);
+          if (error)
+          {
+            promise.set_exception(error);
+          }
+          else
+          {
+            promise.set_value(std::move(response));
+          }
+        });
+    return promise.get_future().get();
+  };
+
+  RetryOptions opt;
+  opt.MaxRetries = 1;
+  opt.RetryDelay = std::chrono::milliseconds(10);
+
+  {
+    // The error of the last try is the error of the request.
+    TransportOptions options;
+    options.Transport = std::make_shared<AsyncTransport>(
+        std::vector<std::function<std::unique_ptr<RawResponse>()>>(
+            2, []() -> std::unique_ptr<RawResponse> { throw TransportException("Unplugged"); }));
+    std::vector<std::unique_ptr<HttpPolicy>> policies;
+    policies.push_back(std::make_unique<RetryPolicy>(opt));
+    policies.push_back(std::make_unique<TransportPolicy>(options));
+    EXPECT_THROW(sendAsync(HttpPipeline(policies), Context{}), TransportException);
+  }
+
+  {
+    // The context is checked before waiting for a retry.
+    std::vector<std::unique_ptr<HttpPolicy>> policies;
+    policies.push_back(std::make_unique<RetryPolicy>(opt));
+    policies.push_back(std::make_unique<SuccessAfter>());
+    auto context = Context{}.WithDeadline(std::chrono::system_clock::now());
+    EXPECT_THROW(sendAsync(HttpPipeline(policies), context), OperationCancelledException);
+  }
+
+  for (auto const delay : {std::chrono::milliseconds(0), std::chrono::milliseconds(10)})
+  {
+    // A retry which can't be sent, right away or after a delay, fails the request.
+    RetryOptions retryOptions = opt;
+    retryOptions.RetryDelay = delay;
+    TransportOptions options;
+    options.Transport = std::make_shared<AsyncTransport>(
+        std::vector<std::function<std::unique_ptr<RawResponse>()>>{[]() {
+          return CreateResponse(HttpStatusCode::ServiceUnavailable, {});
+        }});
+    std::vector<std::unique_ptr<HttpPolicy>> policies;
+    policies.push_back(std::make_unique<RetryPolicy>(retryOptions));
+    policies.push_back(std::make_unique<ThrowWhenRetried>());
+    policies.push_back(std::make_unique<TransportPolicy>(options));
+    EXPECT_THROW(sendAsync(HttpPipeline(policies), Context{}), std::runtime_error);
+  }
+}
@@ -65,7 +65,7 @@ public:
     m_attributes.emplace(std::make_pair(key, val));
   }
 
-  std::map<std::string, std::string> const& GetAttributes() { return m_attributes; }
+  std::map<std::string, std::string> const& GetAttributes() const { return m_attributes; }
 };
 
 // Dummy service tracing class.
@@ -73,10 +73,11 @@ class TestSpan final : public Azure::Core::Tracing::_internal::Span {
   std::vector<std::string> m_events;
   std::map<std::string, std::string> m_stringAttributes;
   std::string m_spanName;
+  bool m_recording;
 
 public:
-  TestSpan(std::string const& spanName, CreateSpanOptions const& options)
-      : Azure::Core::Tracing::_internal::Span(), m_spanName(spanName)
+  TestSpan(std::string const& spanName, CreateSpanOptions const& options, bool recording)
+      : Azure::Core::Tracing::_internal::Span(), m_spanName(spanName), m_recording(recording)
   {
     if (options.Attributes)
     {
@@ -90,7 +91,13 @@ public:
   }
 
   // Inherited via Span
-  virtual void AddAttributes(AttributeSet const&) override {}
+  virtual void AddAttributes(AttributeSet const& attributes) override
+  {
+    for (auto const& attribute : static_cast<TestAttributeSet const&>(attributes).GetAttributes())
+    {
+      m_stringAttributes.emplace(attribute);
+    }
+  }
   virtual void AddAttribute(std::string const& attributeName, std::string const& attributeValue)
       override
   {
@@ -110,6 +117,8 @@ public:
   // Inherited via Span
   virtual void PropagateToHttpHeaders(Azure::Core::Http::Request&) override {}
 
+  virtual bool IsRecording() const override { return m_recording; }
+
   std::string const& GetName() { return m_spanName; }
   std::vector<std::string> const& GetEvents() { return m_events; }
   std::map<std::string, std::string> const& GetAttributes() { return m_stringAttributes; }
@@ -117,13 +126,17 @@ public:
 
 class TestTracer final : public Azure::Core::Tracing::_internal::Tracer {
   mutable std::vector<std::shared_ptr<TestSpan>> m_spans;
+  bool m_recording;
 
 public:
-  TestTracer(std::string const&, std::string const&) : Azure::Core::Tracing::_internal::Tracer() {}
+  TestTracer(std::string const&, std::string const&, bool recording)
+      : Azure::Core::Tracing::_internal::Tracer(), m_recording(recording)
+  {
+  }
   std::shared_ptr<Span> CreateSpan(std::string const& spanName, CreateSpanOptions const& options)
       const override
   {
-    auto returnSpan(std::make_shared<TestSpan>(spanName, options));
+    auto returnSpan(std::make_shared<TestSpan>(spanName, options, m_recording));
     m_spans.push_back(returnSpan);
     return returnSpan;
   }
@@ -138,15 +151,17 @@ public:
 
 class TestTracingProvider final : public Azure::Core::Tracing::TracerProvider {
   mutable std::list<std::shared_ptr<TestTracer>> m_tracers;
+  bool m_recording;
 
 public:
-  TestTracingProvider() : TracerProvider() {}
+  // When recording is false, the spans behave like spans which aren't sampled.
+  TestTracingProvider(bool recording = true) : TracerProvider(), m_recording(recording) {}
   ~TestTracingProvider() {}
   std::shared_ptr<Azure::Core::Tracing::_internal::Tracer> CreateTracer(
       std::string const& serviceName,
       std::string const& serviceVersion) const override
   {
-    auto returnTracer = std::make_shared<TestTracer>(serviceName, serviceVersion);
+    auto returnTracer = std::make_shared<TestTracer>(serviceName, serviceVersion, m_recording);
     m_tracers.push_back(returnTracer);
     return returnTracer;
   };
@@ -235,6 +250,47 @@ TEST(RequestActivityPolicy, Basic)
   }
 }
 
+TEST(RequestActivityPolicy, NotRecording)
+{
+  auto testTracer = std::make_shared<TestTracingProvider>(false);
+
+  Azure::Core::_internal::ClientOptions clientOptions;
+  clientOptions.Telemetry.TracingProvider = testTracer;
+  Azure::Core::Tracing::_internal::TracingContextFactory serviceTrace(
+      clientOptions, "My.Service", "my-service-cpp", "1.0b2");
+
+  auto contextAndSpan = serviceTrace.CreateTracingContext("My API", Context{});
+  Azure::Core::Context callContext = std::move(contextAndSpan.Context);
+  Request request(HttpMethod::Get, Url("https://www.microsoft.com"));
+
+  {
+    std::vector<std::unique_ptr<Azure::Core::Http::Policies::HttpPolicy>> policies;
+    policies.emplace_back(std::make_unique<RequestIdPolicy>());
+    policies.emplace_back(
+        std::make_unique<RequestActivityPolicy>(Azure::Core::Http::_internal::HttpSanitizer{}));
+    policies.emplace_back(std::make_unique<NoOpPolicy>([&](Request& request) {
+      auto response = std::make_unique<RawResponse>(1, 1, HttpStatusCode::Ok, "Something");
+      response->SetHeader("x-ms-request-id", request.GetHeader("x-ms-client-request-id").Value());
+      return response;
+    }));
+
+    Azure::Core::Http::_internal::HttpPipeline(policies).Send(request, callContext);
+  }
+
+  // The span of the request is created, but none of the attributes of the request and the
+  // response are computed.
+  EXPECT_EQ(1ul, testTracer->GetTracers().size());
+  auto& tracer = testTracer->GetTracers().front();
+  EXPECT_EQ(2ul, tracer->GetSpans().size());
+  EXPECT_EQ("HTTP GET", tracer->GetSpans()[1]->GetName());
+  auto const& attributes = tracer->GetSpans()[1]->GetAttributes();
+  EXPECT_EQ(0ul, attributes.count("http.method"));
+  EXPECT_EQ(0ul, attributes.count("http.url"));
+  EXPECT_EQ(0ul, attributes.count("az.client_request_id"));
+  EXPECT_EQ(0ul, attributes.count("http.status_code"));
+  EXPECT_EQ(0ul, attributes.count("az.service_request_id"));
+}
+
 TEST(RequestActivityPolicy, TryRetries)
 {
   {
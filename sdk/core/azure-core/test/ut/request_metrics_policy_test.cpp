@@ -0,0 +1,231 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/core/http/policies/policy.hpp"
+#include "azure/core/internal/http/pipeline.hpp"
+#include "azure/core/internal/metrics/metrics_impl.hpp"
+#include "azure/core/internal/metrics/service_metrics.hpp"
+#include "azure/core/io/body_stream.hpp"
+#include "azure/core/metrics/metrics.hpp"
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Azure::Core;
+using namespace Azure::Core::Http;
+using namespace Azure::Core::Http::Policies;
+using namespace Azure::Core::Metrics::_internal;
+
+namespace {
+
+struct TestMeasurement
+{
+  double Value;
+  std::map<std::string, std::string> Attributes;
+};
+
+class TestInstrument final : public Counter, public Histogram {
+  mutable std::mutex m_mutex;
+  std::vector<TestMeasurement> m_measurements;
+
+  void Save(double value, MetricAttributes attributes)
+  {
+    TestMeasurement measurement{value, {}};
+    for (auto const& attribute : attributes)
+    {
+      measurement.Attributes.emplace(attribute.Name, attribute.Value);
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_measurements.push_back(std::move(measurement));
+  }
+
+public:
+  void Add(uint64_t value, MetricAttributes attributes) override
+  {
+    Save(static_cast<double>(value), attributes);
+  }
+
+  void Record(double value, MetricAttributes attributes) override { Save(value, attributes); }
+
+  std::vector<TestMeasurement> GetMeasurements() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_measurements;
+  }
+};
+
+class TestMeter final : public Meter {
+public:
+  mutable std::map<std::string, std::shared_ptr<TestInstrument>> Instruments;
+
+  std::shared_ptr<Counter> CreateCounter(
+      std::string const& name,
+      std::string const&,
+      std::string const&) const override
+  {
+    return Instruments.emplace(name, std::make_shared<TestInstrument>()).first->second;
+  }
+
+  std::shared_ptr<Histogram> CreateHistogram(
+      std::string const& name,
+      std::string const&,
+      std::string const&) const override
+  {
+    return Instruments.emplace(name, std::make_shared<TestInstrument>()).first->second;
+  }
+};
+
+class TestMeterProvider final : public Azure::Core::Metrics::MeterProvider {
+public:
+  mutable std::string MeterName;
+  mutable std::shared_ptr<TestMeter> CreatedMeter;
+
+  std::shared_ptr<Meter> CreateMeter(std::string const& name, std::string const&) const override
+  {
+    MeterName = name;
+    CreatedMeter = std::make_shared<TestMeter>();
+    return CreatedMeter;
+  }
+};
+
+// The transport policy reads the body of the responses.
+std::unique_ptr<RawResponse> CreateResponse(HttpStatusCode statusCode)
+{
+  auto response = std::make_unique<RawResponse>(1, 1, statusCode, "Status");
+  response->SetBodyStream(std::make_unique<Azure::Core::IO::MemoryBodyStream>(nullptr, 0));
+  return response;
+}
+
+class TestTransport final : public HttpTransport {
+  std::function<std::unique_ptr<RawResponse>(Request&, Context const&)> m_send;
+
+public:
+  explicit TestTransport(
+      std::function<std::unique_ptr<RawResponse>(Request&, Context const&)> send)
+      : m_send(std::move(send))
+  {
+  }
+
+  std::unique_ptr<RawResponse> Send(Request& request, Context const& context) override
+  {
+    return m_send(request, context);
+  }
+};
+} // namespace
+
+TEST(RequestMetricsPolicy, Basic)
+{
+  auto meterProvider = std::make_shared<TestMeterProvider>();
+  bool hasMetrics = false;
+
+  Azure::Core::_internal::ClientOptions clientOptions;
+  clientOptions.Telemetry.MeterProvider = meterProvider;
+  clientOptions.Transport.Transport
+      = std::make_shared<TestTransport>([&](Request&, Context const& context) {
+          hasMetrics = HttpClientMetrics::CreateFromContext(context) != nullptr;
+          auto response = CreateResponse(HttpStatusCode::Ok);
+          response->SetHeader("Content-Length", "42");
+          return response;
+        });
+  Azure::Core::Http::_internal::HttpPipeline pipeline(clientOptions, "my-service", "1.0.0", {}, {});
+
+  Request request(HttpMethod::Get, Url("https://www.microsoft.com"));
+  pipeline.Send(request, Context{});
+
+  EXPECT_TRUE(hasMetrics);
+  EXPECT_EQ("azure-my-service", meterProvider->MeterName);
+  auto& instruments = meterProvider->CreatedMeter->Instruments;
+
+  auto const durations = instruments.at("http.client.request.duration")->GetMeasurements();
+  ASSERT_EQ(1ul, durations.size());
+  EXPECT_GE(durations[0].Value, 0.0);
+  EXPECT_EQ("GET", durations[0].Attributes.at("http.request.method"));
+  EXPECT_EQ("200", durations[0].Attributes.at("http.response.status_code"));
+  EXPECT_EQ("www.microsoft.com", durations[0].Attributes.at("server.address"));
+
+  auto const requestSizes = instruments.at("http.client.request.body.size")->GetMeasurements();
+  ASSERT_EQ(1ul, requestSizes.size());
+  EXPECT_EQ(0.0, requestSizes[0].Value);
+
+  auto const responseSizes = instruments.at("http.client.response.body.size")->GetMeasurements();
+  ASSERT_EQ(1ul, responseSizes.size());
+  EXPECT_EQ(42.0, responseSizes[0].Value);
+
+  EXPECT_TRUE(instruments.at("azure.core.http.client.retries")->GetMeasurements().empty());
+}
+
+TEST(RequestMetricsPolicy, Retries)
+{
+  auto meterProvider = std::make_shared<TestMeterProvider>();
+  int tries = 0;
+
+  Azure::Core::_internal::ClientOptions clientOptions;
+  clientOptions.Telemetry.MeterProvider = meterProvider;
+  clientOptions.Retry.RetryDelay = std::chrono::milliseconds(1);
+  clientOptions.Transport.Transport
+      = std::make_shared<TestTransport>([&](Request&, Context const&) {
+          return CreateResponse(
+              ++tries < 3 ? HttpStatusCode::ServiceUnavailable : HttpStatusCode::Ok);
+        });
+  Azure::Core::Http::_internal::HttpPipeline pipeline(clientOptions, "my-service", "1.0.0", {}, {});
+
+  Request request(HttpMethod::Put, Url("https://www.microsoft.com"));
+  pipeline.Send(request, Context{});
+
+  auto& instruments = meterProvider->CreatedMeter->Instruments;
+  auto const retries = instruments.at("azure.core.http.client.retries")->GetMeasurements();
+  ASSERT_EQ(2ul, retries.size());
+  EXPECT_EQ(1.0, retries[0].Value);
+  EXPECT_EQ("PUT", retries[0].Attributes.at("http.request.method"));
+
+  auto const durations = instruments.at("http.client.request.duration")->GetMeasurements();
+  ASSERT_EQ(3ul, durations.size());
+  EXPECT_EQ("503", durations[0].Attributes.at("http.response.status_code"));
+  EXPECT_EQ("200", durations[2].Attributes.at("http.response.status_code"));
+}
+
+TEST(RequestMetricsPolicy, TransportError)
+{
+  auto meterProvider = std::make_shared<TestMeterProvider>();
+
+  Azure::Core::_internal::ClientOptions clientOptions;
+  clientOptions.Telemetry.MeterProvider = meterProvider;
+  clientOptions.Retry.MaxRetries = 0;
+  clientOptions.Transport.Transport = std::make_shared<TestTransport>(
+      [&](Request&, Context const&) -> std::unique_ptr<RawResponse> {
+        throw TransportException("Connection refused.");
+      });
+  Azure::Core::Http::_internal::HttpPipeline pipeline(clientOptions, "my-service", "1.0.0", {}, {});
+
+  Request request(HttpMethod::Get, Url("https://www.microsoft.com"));
+  EXPECT_THROW(pipeline.Send(request, Context{}), TransportException);
+
+  auto const durations = meterProvider->CreatedMeter->Instruments.at("http.client.request.duration")
+                             ->GetMeasurements();
+  ASSERT_EQ(1ul, durations.size());
+  EXPECT_EQ("TransportException", durations[0].Attributes.at("error.type"));
+  EXPECT_EQ(0ul, durations[0].Attributes.count("http.response.status_code"));
+}
+
+TEST(RequestMetricsPolicy, NoMeterProvider)
+{
+  bool hasMetrics = true;
+
+  Azure::Core::_internal::ClientOptions clientOptions;
+  clientOptions.Transport.Transport
+      = std::make_shared<TestTransport>([&](Request&, Context const& context) {
+          hasMetrics = HttpClientMetrics::CreateFromContext(context) != nullptr;
+          return CreateResponse(HttpStatusCode::Ok);
+        });
+  Azure::Core::Http::_internal::HttpPipeline pipeline(clientOptions, "my-service", "1.0.0", {}, {});
+
+  Request request(HttpMethod::Get, Url("https://www.microsoft.com"));
+  pipeline.Send(request, Context{});
+
+  EXPECT_FALSE(hasMetrics);
+}
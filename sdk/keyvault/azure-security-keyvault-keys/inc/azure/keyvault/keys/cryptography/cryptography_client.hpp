@@ -36,6 +36,9 @@ namespace Azure {
      *
      */
     class CryptoClientInternalAccess;
+
+    class LocalCryptographyProvider;
+    struct LocalKeyCache;
   } // namespace _detail
 
   /**
@@ -46,6 +49,7 @@ namespace Azure {
     Azure::Core::Url m_keyId;
     std::string m_apiVersion;
     std::shared_ptr<Azure::Core::Http::_internal::HttpPipeline> m_pipeline;
+    std::shared_ptr<_detail::LocalKeyCache> m_localKeyCache;
 
   private:
     // Provide private-access to the internal layer
@@ -61,6 +65,9 @@ namespace Azure {
         std::string const& payload,
         Azure::Core::Context const& context) const;
 
+    std::shared_ptr<_detail::LocalCryptographyProvider const> GetLocalProvider(
+        Azure::Core::Context const& context) const;
+
     /**
      * @brief Construct a new Cryptography client that re-uses a pre-existing pipeline.
      *
@@ -15,6 +15,9 @@
 
 #include <azure/core/internal/client_options.hpp>
 
+#include <chrono>
+#include <string>
+
 namespace Azure {
   namespace Security {
     namespace KeyVault {
@@ -37,6 +40,31 @@ namespace Azure {
      */
     std::string Version;
 
+    /**
+     * @brief Performs operations that only need the public key locally, instead of sending them
+     * to the service.
+     *
+     * @details When enabled, the key is retrieved once, which requires the keys/get permission,
+     * and cached. #CryptographyClient::Encrypt, #CryptographyClient::WrapKey,
+     * #CryptographyClient::Verify and #CryptographyClient::VerifyData are then performed locally
+     * for RSA and EC keys. Operations that need the private key, operations the key or the
+     * platform doesn't support locally, and operations on keys that are disabled or outside their
+     * validity period are sent to the service. The RawResponse of an operation performed locally
+     * is null.
+     *
+     * @remark Local operations are only available on platforms where the SDK uses OpenSSL.
+     *
+     */
+    bool EnableLocalCryptography = false;
+
+    /**
+     * @brief How long the key is cached before it is retrieved again, when local cryptography is
+     * enabled and the key identifier doesn't contain a version. Keys identified by version are
+     * cached for the lifetime of the client.
+     *
+     */
+    std::chrono::seconds LocalKeyCacheDuration = std::chrono::minutes(10);
+
     /**
      * @brief Construct a new Key Client Options object.
      *
@@ -10,6 +10,7 @@
 #include "../private/key_verify_parameters.hpp"
 #include "../private/key_wrap_parameters.hpp"
 #include "../private/keyvault_protocol.hpp"
+#include "../private/local_cryptography_provider.hpp"
 #include "../private/package_version.hpp"
 #include "azure/keyvault/keys/key_client_models.hpp"
 
@@ -21,7 +22,9 @@
 #include <azure/keyvault/shared/keyvault_shared.hpp>
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -91,6 +94,43 @@ std::unique_ptr<Azure::Core::Http::RawResponse> CryptographyClient::SendCryptoRe
       *m_pipeline, request, context);
 }
 
+std::shared_ptr<LocalCryptographyProvider const> CryptographyClient::GetLocalProvider(
+    Azure::Core::Context const& context) const
+{
+  if (!m_localKeyCache)
+  {
+    return nullptr;
+  }
+
+  auto& cache = *m_localKeyCache;
+  std::lock_guard<std::mutex> lock(cache.Mutex);
+  auto const now = std::chrono::steady_clock::now();
+  if (now < cache.RefreshOn)
+  {
+    return cache.Provider;
+  }
+
+  // A versioned key never changes, and is retrieved again only if that failed.
+  cache.Provider.reset();
+  try
+  {
+    auto request = CreateRequest(HttpMethod::Get, {});
+    auto rawResponse = Azure::Security::KeyVault::_detail::KeyVaultKeysCommonRequest::SendRequest(
+        *m_pipeline, request, context);
+    cache.Provider = LocalCryptographyProvider::Create(
+        KeyVaultKeySerializer::KeyVaultKeyDeserialize(*rawResponse));
+  }
+  catch (Azure::Core::RequestFailedException const&)
+  {
+    // Without the keys/get permission, every operation is sent to the service until the cache
+    // expires.
+  }
+  cache.RefreshOn = (cache.IsVersioned && cache.Provider)
+      ? (std::chrono::steady_clock::time_point::max)()
+      : now + cache.CacheDuration;
+  return cache.Provider;
+}
+
 CryptographyClient::~CryptographyClient() = default;
 
 CryptographyClient::CryptographyClient(
@@ -116,12 +156,31 @@ CryptographyClient::CryptographyClient(
       PackageVersion::ToString(),
       std::move(perRetryPolicies),
       std::move(perCallPolicies));
+
+  if (options.EnableLocalCryptography)
+  {
+    m_localKeyCache = std::make_shared<LocalKeyCache>();
+    m_localKeyCache->CacheDuration = options.LocalKeyCacheDuration;
+    // The identifier of a versioned key has the path "keys/{name}/{version}".
+    auto const& path = m_keyId.GetPath();
+    m_localKeyCache->IsVersioned = std::count(path.begin(), path.end(), '/') >= 2
+        && path.back() != '/';
+  }
 }
 
 Azure::Response<EncryptResult> CryptographyClient::Encrypt(
     EncryptParameters const& parameters,
     Azure::Core::Context const& context)
 {
+  if (auto localProvider = GetLocalProvider(context))
+  {
+    auto value = localProvider->Encrypt(parameters);
+    if (value.HasValue())
+    {
+      return Azure::Response<EncryptResult>(std::move(value.Value()), nullptr);
+    }
+  }
+
   // Send and parse response
   auto rawResponse = SendCryptoRequest(
       {EncryptValue}, EncryptParametersSerializer::EncryptParametersSerialize(parameters), context);
@@ -147,6 +206,15 @@ Azure::Response<WrapResult> CryptographyClient::WrapKey(
     std::vector<uint8_t> const& key,
     Azure::Core::Context const& context)
 {
+  if (auto localProvider = GetLocalProvider(context))
+  {
+    auto value = localProvider->WrapKey(algorithm, key);
+    if (value.HasValue())
+    {
+      return Azure::Response<WrapResult>(std::move(value.Value()), nullptr);
+    }
+  }
+
   // Send and parse response
   auto rawResponse = SendCryptoRequest(
       {WrapKeyValue},
@@ -212,6 +280,16 @@ Azure::Response<VerifyResult> CryptographyClient::Verify(
     std::vector<uint8_t> const& signature,
     Azure::Core::Context const& context)
 {
+  if (auto localProvider = GetLocalProvider(context))
+  {
+    auto value = localProvider->Verify(algorithm, digest, signature);
+    if (value.HasValue())
+    {
+      value.Value().KeyId = this->m_keyId.GetAbsoluteUrl();
+      return Azure::Response<VerifyResult>(std::move(value.Value()), nullptr);
+    }
+  }
+
   // Send and parse response
   auto rawResponse = SendCryptoRequest(
       {VerifyValue},
@@ -0,0 +1,581 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "../private/local_cryptography_provider.hpp"
+
+#include <azure/core/internal/unique_handle.hpp>
+#include <azure/core/platform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(AZ_PLATFORM_POSIX)
+#include <openssl/opensslv.h>
+#if OPENSSL_VERSION_NUMBER < 0x30000000L
+#define USE_OPENSSL_1
+#else
+#define USE_OPENSSL_3
+#endif // OPENSSL_VERSION_NUMBER < 0x30000000L
+
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/ecdsa.h>
+#include <openssl/evp.h>
+#include <openssl/obj_mac.h>
+#include <openssl/rsa.h>
+#if defined(USE_OPENSSL_3)
+#include <openssl/core_names.h>
+#include <openssl/param_build.h>
+#endif // USE_OPENSSL_3
+#endif // AZ_PLATFORM_POSIX
+
+using namespace Azure::Security::KeyVault::Keys;
+using namespace Azure::Security::KeyVault::Keys::Cryptography;
+using namespace Azure::Security::KeyVault::Keys::Cryptography::_detail;
+
+#if defined(AZ_PLATFORM_POSIX)
+struct LocalCryptographyProvider::KeyHandle final
+{
+  EVP_PKEY* Key;
+
+  explicit KeyHandle(EVP_PKEY* key) : Key(key) {}
+  ~KeyHandle() { EVP_PKEY_free(Key); }
+  KeyHandle(KeyHandle const&) = delete;
+  KeyHandle& operator=(KeyHandle const&) = delete;
+};
+
+namespace {
+template <typename> struct UniqueHandleHelper;
+
+template <> struct UniqueHandleHelper<BIGNUM>
+{
+  using type = Azure::Core::_internal::BasicUniqueHandle<BIGNUM, BN_free>;
+};
+
+template <> struct UniqueHandleHelper<EVP_PKEY>
+{
+  using type = Azure::Core::_internal::BasicUniqueHandle<EVP_PKEY, EVP_PKEY_free>;
+};
+
+template <> struct UniqueHandleHelper<EVP_PKEY_CTX>
+{
+  using type = Azure::Core::_internal::BasicUniqueHandle<EVP_PKEY_CTX, EVP_PKEY_CTX_free>;
+};
+
+template <> struct UniqueHandleHelper<ECDSA_SIG>
+{
+  using type = Azure::Core::_internal::BasicUniqueHandle<ECDSA_SIG, ECDSA_SIG_free>;
+};
+
+#if defined(USE_OPENSSL_3)
+template <> struct UniqueHandleHelper<OSSL_PARAM_BLD>
+{
+  using type = Azure::Core::_internal::BasicUniqueHandle<OSSL_PARAM_BLD, OSSL_PARAM_BLD_free>;
+};
+
+template <> struct UniqueHandleHelper<OSSL_PARAM>
+{
+  using type = Azure::Core::_internal::BasicUniqueHandle<OSSL_PARAM, OSSL_PARAM_free>;
+};
+#else
+template <> struct UniqueHandleHelper<RSA>
+{
+  using type = Azure::Core::_internal::BasicUniqueHandle<RSA, RSA_free>;
+};
+
+template <> struct UniqueHandleHelper<EC_KEY>
+{
+  using type = Azure::Core::_internal::BasicUniqueHandle<EC_KEY, EC_KEY_free>;
+};
+#endif // USE_OPENSSL_3
+
+template <typename T>
+using UniqueHandle = Azure::Core::_internal::UniqueHandle<T, UniqueHandleHelper>;
+
+struct CurveInfo final
+{
+  int Nid;
+  char const* GroupName;
+  // The size of a coordinate, and of each half of a signature.
+  size_t FieldSize;
+};
+
+Azure::Nullable<CurveInfo> GetCurveInfo(KeyCurveName const& curveName)
+{
+  if (curveName == KeyCurveName::P256)
+  {
+    return CurveInfo{NID_X9_62_prime256v1, SN_X9_62_prime256v1, 32};
+  }
+  if (curveName == KeyCurveName::P256K)
+  {
+    return CurveInfo{NID_secp256k1, SN_secp256k1, 32};
+  }
+  if (curveName == KeyCurveName::P384)
+  {
+    return CurveInfo{NID_secp384r1, SN_secp384r1, 48};
+  }
+  if (curveName == KeyCurveName::P521)
+  {
+    return CurveInfo{NID_secp521r1, SN_secp521r1, 66};
+  }
+  return {};
+}
+
+UniqueHandle<BIGNUM> ToBigNum(std::vector<uint8_t> const& value)
+{
+  return UniqueHandle<BIGNUM>(
+      BN_bin2bn(value.data(), static_cast<int>(value.size()), nullptr));
+}
+
+UniqueHandle<EVP_PKEY> CreateRsaKey(JsonWebKey const& jsonWebKey)
+{
+  auto n = ToBigNum(jsonWebKey.N);
+  auto e = ToBigNum(jsonWebKey.E);
+  if (!n || !e)
+  {
+    return nullptr;
+  }
+
+#if defined(USE_OPENSSL_3)
+  UniqueHandle<OSSL_PARAM_BLD> builder(OSSL_PARAM_BLD_new());
+  if (!builder || OSSL_PARAM_BLD_push_BN(builder.get(), OSSL_PKEY_PARAM_RSA_N, n.get()) != 1
+      || OSSL_PARAM_BLD_push_BN(builder.get(), OSSL_PKEY_PARAM_RSA_E, e.get()) != 1)
+  {
+    return nullptr;
+  }
+  UniqueHandle<OSSL_PARAM> params(OSSL_PARAM_BLD_to_param(builder.get()));
+  UniqueHandle<EVP_PKEY_CTX> context(EVP_PKEY_CTX_new_from_name(nullptr, "RSA", nullptr));
+  EVP_PKEY* key = nullptr;
+  if (!params || !context || EVP_PKEY_fromdata_init(context.get()) != 1
+      || EVP_PKEY_fromdata(context.get(), &key, EVP_PKEY_PUBLIC_KEY, params.get()) != 1)
+  {
+    return nullptr;
+  }
+  return UniqueHandle<EVP_PKEY>(key);
+#else
+  UniqueHandle<RSA> rsa(RSA_new());
+  if (!rsa || RSA_set0_key(rsa.get(), n.get(), e.get(), nullptr) != 1)
+  {
+    return nullptr;
+  }
+  // The RSA key owns the numbers now.
+  n.release();
+  e.release();
+
+  UniqueHandle<EVP_PKEY> key(EVP_PKEY_new());
+  if (!key || EVP_PKEY_assign_RSA(key.get(), rsa.get()) != 1)
+  {
+    return nullptr;
+  }
+  rsa.release();
+  return key;
+#endif // USE_OPENSSL_3
+}
+
+UniqueHandle<EVP_PKEY> CreateEcKey(JsonWebKey const& jsonWebKey)
+{
+  if (!jsonWebKey.CurveName.HasValue())
+  {
+    return nullptr;
+  }
+  auto const curve = GetCurveInfo(jsonWebKey.CurveName.Value());
+  if (!curve.HasValue() || jsonWebKey.X.size() > curve.Value().FieldSize
+      || jsonWebKey.Y.size() > curve.Value().FieldSize)
+  {
+    return nullptr;
+  }
+
+#if defined(USE_OPENSSL_3)
+  // Uncompressed point: 0x04 || X || Y, with both coordinates left-padded to the field size.
+  auto const fieldSize = curve.Value().FieldSize;
+  std::vector<uint8_t> point(1 + 2 * fieldSize);
+  point[0] = 0x04;
+  std::copy(
+      jsonWebKey.X.begin(), jsonWebKey.X.end(), point.end() - fieldSize - jsonWebKey.X.size());
+  std::copy(jsonWebKey.Y.begin(), jsonWebKey.Y.end(), point.end() - jsonWebKey.Y.size());
+
+  UniqueHandle<OSSL_PARAM_BLD> builder(OSSL_PARAM_BLD_new());
+  if (!builder
+      || OSSL_PARAM_BLD_push_utf8_string(
+             builder.get(), OSSL_PKEY_PARAM_GROUP_NAME, curve.Value().GroupName, 0)
+          != 1
+      || OSSL_PARAM_BLD_push_octet_string(
+             builder.get(), OSSL_PKEY_PARAM_PUB_KEY, point.data(), point.size())
+          != 1)
+  {
+    return nullptr;
+  }
+  UniqueHandle<OSSL_PARAM> params(OSSL_PARAM_BLD_to_param(builder.get()));
+  UniqueHandle<EVP_PKEY_CTX> context(EVP_PKEY_CTX_new_from_name(nullptr, "EC", nullptr));
+  EVP_PKEY* key = nullptr;
+  if (!params || !context || EVP_PKEY_fromdata_init(context.get()) != 1
+      || EVP_PKEY_fromdata(context.get(), &key, EVP_PKEY_PUBLIC_KEY, params.get()) != 1)
+  {
+    return nullptr;
+  }
+  return UniqueHandle<EVP_PKEY>(key);
+#else
+  auto x = ToBigNum(jsonWebKey.X);
+  auto y = ToBigNum(jsonWebKey.Y);
+  UniqueHandle<EC_KEY> ecKey(EC_KEY_new_by_curve_name(curve.Value().Nid));
+  if (!x || !y || !ecKey
+      || EC_KEY_set_public_key_affine_coordinates(ecKey.get(), x.get(), y.get()) != 1)
+  {
+    return nullptr;
+  }
+
+  UniqueHandle<EVP_PKEY> key(EVP_PKEY_new());
+  if (!key || EVP_PKEY_assign_EC_KEY(key.get(), ecKey.get()) != 1)
+  {
+    return nullptr;
+  }
+  ecKey.release();
+  return key;
+#endif // USE_OPENSSL_3
+}
+
+// Encrypts with one of the RSA algorithms shared by Encrypt and WrapKey.
+Azure::Nullable<std::vector<uint8_t>> RsaEncrypt(
+    EVP_PKEY* key,
+    std::string const& algorithm,
+    std::vector<uint8_t> const& plaintext)
+{
+  int padding = RSA_PKCS1_OAEP_PADDING;
+  EVP_MD const* oaepDigest = nullptr;
+  if (algorithm == EncryptionAlgorithm::Rsa15.ToString())
+  {
+    padding = RSA_PKCS1_PADDING;
+  }
+  else if (algorithm == EncryptionAlgorithm::RsaOaep.ToString())
+  {
+    oaepDigest = EVP_sha1();
+  }
+  else if (algorithm == EncryptionAlgorithm::RsaOaep256.ToString())
+  {
+    oaepDigest = EVP_sha256();
+  }
+  else
+  {
+    return {};
+  }
+
+  UniqueHandle<EVP_PKEY_CTX> context(EVP_PKEY_CTX_new(key, nullptr));
+  if (!context || EVP_PKEY_encrypt_init(context.get()) != 1
+      || EVP_PKEY_CTX_set_rsa_padding(context.get(), padding) <= 0)
+  {
+    return {};
+  }
+  if (oaepDigest != nullptr
+      && (EVP_PKEY_CTX_set_rsa_oaep_md(context.get(), oaepDigest) <= 0
+          || EVP_PKEY_CTX_set_rsa_mgf1_md(context.get(), oaepDigest) <= 0))
+  {
+    return {};
+  }
+
+  size_t ciphertextLength = 0;
+  if (EVP_PKEY_encrypt(
+          context.get(), nullptr, &ciphertextLength, plaintext.data(), plaintext.size())
+      != 1)
+  {
+    return {};
+  }
+  std::vector<uint8_t> ciphertext(ciphertextLength);
+  if (EVP_PKEY_encrypt(
+          context.get(), ciphertext.data(), &ciphertextLength, plaintext.data(), plaintext.size())
+      != 1)
+  {
+    return {};
+  }
+  ciphertext.resize(ciphertextLength);
+  return ciphertext;
+}
+
+// Converts a JWS signature (R || S) to the DER encoding OpenSSL expects.
+std::vector<uint8_t> EcSignatureToDer(std::vector<uint8_t> const& signature)
+{
+  auto const half = static_cast<int>(signature.size() / 2);
+  UniqueHandle<ECDSA_SIG> ecdsaSignature(ECDSA_SIG_new());
+  UniqueHandle<BIGNUM> r(BN_bin2bn(signature.data(), half, nullptr));
+  UniqueHandle<BIGNUM> s(BN_bin2bn(signature.data() + half, half, nullptr));
+  if (!ecdsaSignature || !r || !s || ECDSA_SIG_set0(ecdsaSignature.get(), r.get(), s.get()) != 1)
+  {
+    return {};
+  }
+  // The signature owns the numbers now.
+  r.release();
+  s.release();
+
+  auto const derLength = i2d_ECDSA_SIG(ecdsaSignature.get(), nullptr);
+  if (derLength <= 0)
+  {
+    return {};
+  }
+  std::vector<uint8_t> der(static_cast<size_t>(derLength));
+  auto* derBuffer = der.data();
+  i2d_ECDSA_SIG(ecdsaSignature.get(), &derBuffer);
+  return der;
+}
+} // namespace
+
+std::unique_ptr<LocalCryptographyProvider> LocalCryptographyProvider::Create(
+    KeyVaultKey const& key)
+{
+  // The service reports the error for a disabled key.
+  if (key.Properties.Enabled.HasValue() && !key.Properties.Enabled.Value())
+  {
+    return nullptr;
+  }
+
+  auto const& keyType = key.Key.KeyType;
+  UniqueHandle<EVP_PKEY> handle;
+  if (keyType == KeyVaultKeyType::Rsa || keyType == KeyVaultKeyType::RsaHsm)
+  {
+    handle = CreateRsaKey(key.Key);
+  }
+  else if (keyType == KeyVaultKeyType::Ec || keyType == KeyVaultKeyType::EcHsm)
+  {
+    handle = CreateEcKey(key.Key);
+  }
+  if (!handle)
+  {
+    return nullptr;
+  }
+
+  return std::unique_ptr<LocalCryptographyProvider>(
+      new LocalCryptographyProvider(key, std::make_unique<KeyHandle>(handle.release())));
+}
+
+Azure::Nullable<EncryptResult> LocalCryptographyProvider::Encrypt(
+    EncryptParameters const& parameters) const
+{
+  if (!CanPerform(KeyOperation::Encrypt, true))
+  {
+    return {};
+  }
+  auto ciphertext
+      = RsaEncrypt(m_key->Key, parameters.Algorithm.ToString(), parameters.Plaintext);
+  if (!ciphertext.HasValue())
+  {
+    return {};
+  }
+
+  EncryptResult result;
+  result.KeyId = m_keyId;
+  result.Ciphertext = std::move(ciphertext.Value());
+  result.Algorithm = parameters.Algorithm;
+  return result;
+}
+
+Azure::Nullable<WrapResult> LocalCryptographyProvider::WrapKey(
+    KeyWrapAlgorithm const& algorithm,
+    std::vector<uint8_t> const& key) const
+{
+  if (!CanPerform(KeyOperation::WrapKey, true))
+  {
+    return {};
+  }
+  auto encryptedKey = RsaEncrypt(m_key->Key, algorithm.ToString(), key);
+  if (!encryptedKey.HasValue())
+  {
+    return {};
+  }
+
+  WrapResult result;
+  result.KeyId = m_keyId;
+  result.EncryptedKey = std::move(encryptedKey.Value());
+  result.Algorithm = algorithm;
+  return result;
+}
+
+Azure::Nullable<VerifyResult> LocalCryptographyProvider::Verify(
+    SignatureAlgorithm const& algorithm,
+    std::vector<uint8_t> const& digest,
+    std::vector<uint8_t> const& signature) const
+{
+  // Signatures made before a key expired remain verifiable, so only the key operations apply.
+  if (!CanPerform(KeyOperation::Verify, false))
+  {
+    return {};
+  }
+
+  bool const isRsaKey = m_jsonWebKey.KeyType == KeyVaultKeyType::Rsa
+      || m_jsonWebKey.KeyType == KeyVaultKeyType::RsaHsm;
+  EVP_MD const* md = nullptr;
+  int padding = 0;
+  Azure::Nullable<KeyCurveName> curveName;
+  if (algorithm == SignatureAlgorithm::RS256 || algorithm == SignatureAlgorithm::PS256
+      || algorithm == SignatureAlgorithm::ES256 || algorithm == SignatureAlgorithm::ES256K)
+  {
+    md = EVP_sha256();
+  }
+  else if (
+      algorithm == SignatureAlgorithm::RS384 || algorithm == SignatureAlgorithm::PS384
+      || algorithm == SignatureAlgorithm::ES384)
+  {
+    md = EVP_sha384();
+  }
+  else if (
+      algorithm == SignatureAlgorithm::RS512 || algorithm == SignatureAlgorithm::PS512
+      || algorithm == SignatureAlgorithm::ES512)
+  {
+    md = EVP_sha512();
+  }
+  else
+  {
+    return {};
+  }
+
+  if (algorithm == SignatureAlgorithm::RS256 || algorithm == SignatureAlgorithm::RS384
+      || algorithm == SignatureAlgorithm::RS512)
+  {
+    padding = RSA_PKCS1_PADDING;
+  }
+  else if (
+      algorithm == SignatureAlgorithm::PS256 || algorithm == SignatureAlgorithm::PS384
+      || algorithm == SignatureAlgorithm::PS512)
+  {
+    padding = RSA_PKCS1_PSS_PADDING;
+  }
+  else if (algorithm == SignatureAlgorithm::ES256)
+  {
+    curveName = KeyCurveName::P256;
+  }
+  else if (algorithm == SignatureAlgorithm::ES256K)
+  {
+    curveName = KeyCurveName::P256K;
+  }
+  else if (algorithm == SignatureAlgorithm::ES384)
+  {
+    curveName = KeyCurveName::P384;
+  }
+  else
+  {
+    curveName = KeyCurveName::P521;
+  }
+
+  // Let the service report algorithms that don't match the key, and malformed digests.
+  if (isRsaKey == curveName.HasValue()
+      || (curveName.HasValue()
+          && (!m_jsonWebKey.CurveName.HasValue()
+              || !(m_jsonWebKey.CurveName.Value() == curveName.Value())))
+      || digest.size() != static_cast<size_t>(EVP_MD_size(md)))
+  {
+    return {};
+  }
+
+  VerifyResult result;
+  result.KeyId = m_keyId;
+  result.Algorithm = algorithm;
+  result.IsValid = false;
+
+  std::vector<uint8_t> encodedSignature;
+  if (curveName.HasValue())
+  {
+    // A JWS signature has two halves of the field size, anything else can't be valid.
+    if (signature.size() != 2 * GetCurveInfo(curveName.Value()).Value().FieldSize)
+    {
+      return result;
+    }
+    encodedSignature = EcSignatureToDer(signature);
+  }
+  auto const& signatureToVerify = curveName.HasValue() ? encodedSignature : signature;
+
+  UniqueHandle<EVP_PKEY_CTX> context(EVP_PKEY_CTX_new(m_key->Key, nullptr));
+  if (!context || EVP_PKEY_verify_init(context.get()) != 1
+      || EVP_PKEY_CTX_set_signature_md(context.get(), md) <= 0)
+  {
+    return {};
+  }
+  if (padding != 0 && EVP_PKEY_CTX_set_rsa_padding(context.get(), padding) <= 0)
+  {
+    return {};
+  }
+  if (padding == RSA_PKCS1_PSS_PADDING
+      && (EVP_PKEY_CTX_set_rsa_pss_saltlen(context.get(), RSA_PSS_SALTLEN_DIGEST) <= 0
+          || EVP_PKEY_CTX_set_rsa_mgf1_md(context.get(), md) <= 0))
+  {
+    return {};
+  }
+
+  result.IsValid = EVP_PKEY_verify(
+                       context.get(),
+                       signatureToVerify.data(),
+                       signatureToVerify.size(),
+                       digest.data(),
+                       digest.size())
+      == 1;
+  return result;
+}
+#else
+struct LocalCryptographyProvider::KeyHandle final
+{
+};
+
+std::unique_ptr<LocalCryptographyProvider> LocalCryptographyProvider::Create(KeyVaultKey const&)
+{
+  // Local cryptography is only implemented with OpenSSL.
+  return nullptr;
+}
+
+Azure::Nullable<EncryptResult> LocalCryptographyProvider::Encrypt(EncryptParameters const&) const
+{
+  return {};
+}
+
+Azure::Nullable<WrapResult> LocalCryptographyProvider::WrapKey(
+    KeyWrapAlgorithm const&,
+    std::vector<uint8_t> const&) const
+{
+  return {};
+}
+
+Azure::Nullable<VerifyResult> LocalCryptographyProvider::Verify(
+    SignatureAlgorithm const&,
+    std::vector<uint8_t> const&,
+    std::vector<uint8_t> const&) const
+{
+  return {};
+}
+#endif // AZ_PLATFORM_POSIX
+
+LocalCryptographyProvider::LocalCryptographyProvider(
+    KeyVaultKey const& key,
+    std::unique_ptr<KeyHandle> handle)
+    : m_key(std::move(handle)), m_keyId(key.Key.Id), m_jsonWebKey(key.Key),
+      m_notBefore(key.Properties.NotBefore), m_expiresOn(key.Properties.ExpiresOn)
+{
+  // Only the public key is needed.
+  m_jsonWebKey.D.clear();
+  m_jsonWebKey.DP.clear();
+  m_jsonWebKey.DQ.clear();
+  m_jsonWebKey.QI.clear();
+  m_jsonWebKey.P.clear();
+  m_jsonWebKey.Q.clear();
+  m_jsonWebKey.K.clear();
+}
+
+LocalCryptographyProvider::~LocalCryptographyProvider() = default;
+
+bool LocalCryptographyProvider::CanPerform(
+    KeyOperation const& operation,
+    bool checkValidityPeriod) const
+{
+  if (!m_jsonWebKey.KeyOperations().empty() && !m_jsonWebKey.SupportsOperation(operation))
+  {
+    return false;
+  }
+  if (checkValidityPeriod)
+  {
+    auto const now = Azure::DateTime(std::chrono::system_clock::now());
+    if ((m_notBefore.HasValue() && now < m_notBefore.Value())
+        || (m_expiresOn.HasValue() && now >= m_expiresOn.Value()))
+    {
+      return false;
+    }
+  }
+  return true;
+}
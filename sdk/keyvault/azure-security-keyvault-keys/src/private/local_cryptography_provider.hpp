@@ -0,0 +1,91 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Performs public key operations locally.
+ *
+ */
+
+#pragma once
+
+#include "azure/keyvault/keys/cryptography/cryptography_client_models.hpp"
+#include "azure/keyvault/keys/key_client_models.hpp"
+
+#include <azure/core/datetime.hpp>
+#include <azure/core/nullable.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Azure {
+  namespace Security {
+    namespace KeyVault {
+      namespace Keys {
+        namespace Cryptography {
+  namespace _detail {
+
+    /**
+     * @brief Performs the operations of a #KeyVaultKey that only need its public key.
+     *
+     * @details Every operation returns null when it can't be performed locally, in which case the
+     * caller sends it to the service. This includes invalid input, so that the caller gets the
+     * same error it would get without local cryptography.
+     *
+     */
+    class LocalCryptographyProvider final {
+      struct KeyHandle;
+
+      std::unique_ptr<KeyHandle> m_key;
+      std::string m_keyId;
+      JsonWebKey m_jsonWebKey;
+      Azure::Nullable<Azure::DateTime> m_notBefore;
+      Azure::Nullable<Azure::DateTime> m_expiresOn;
+
+      LocalCryptographyProvider(KeyVaultKey const& key, std::unique_ptr<KeyHandle> handle);
+
+      bool CanPerform(KeyOperation const& operation, bool checkValidityPeriod) const;
+
+    public:
+      /**
+       * @brief Creates a provider for \p key, or returns null if the key can't be used locally.
+       *
+       */
+      static std::unique_ptr<LocalCryptographyProvider> Create(KeyVaultKey const& key);
+
+      ~LocalCryptographyProvider();
+
+      Azure::Nullable<EncryptResult> Encrypt(EncryptParameters const& parameters) const;
+
+      Azure::Nullable<WrapResult> WrapKey(
+          KeyWrapAlgorithm const& algorithm,
+          std::vector<uint8_t> const& key) const;
+
+      Azure::Nullable<VerifyResult> Verify(
+          SignatureAlgorithm const& algorithm,
+          std::vector<uint8_t> const& digest,
+          std::vector<uint8_t> const& signature) const;
+    };
+
+    /**
+     * @brief The key cached by a #CryptographyClient for local cryptography.
+     *
+     */
+    struct LocalKeyCache final
+    {
+      std::mutex Mutex;
+      // Null when the key hasn't been retrieved or can't be used locally.
+      std::shared_ptr<LocalCryptographyProvider const> Provider;
+      // When the key, or the failure to retrieve it, must be refreshed.
+      std::chrono::steady_clock::time_point RefreshOn;
+      // How long a versionless key is cached.
+      std::chrono::seconds CacheDuration;
+      // Whether the key identifier contains a version, so the key never changes.
+      bool IsVersioned = false;
+    };
+  } // namespace _detail
+}}}}} // namespace Azure::Security::KeyVault::Keys::Cryptography
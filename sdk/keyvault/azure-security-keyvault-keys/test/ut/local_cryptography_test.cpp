@@ -0,0 +1,358 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "private/local_cryptography_provider.hpp"
+
+#include <azure/core/base64.hpp>
+#include <azure/core/credentials/credentials.hpp>
+#include <azure/core/http/transport.hpp>
+#include <azure/core/internal/cryptography/sha_hash.hpp>
+#include <azure/core/io/body_stream.hpp>
+#include <azure/core/platform.hpp>
+#include <azure/keyvault/keys.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#if defined(AZ_PLATFORM_POSIX)
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/ecdsa.h>
+#include <openssl/evp.h>
+#include <openssl/obj_mac.h>
+#include <openssl/opensslv.h>
+#include <openssl/rsa.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#endif
+
+using namespace Azure::Security::KeyVault::Keys;
+using namespace Azure::Security::KeyVault::Keys::Cryptography;
+using namespace Azure::Security::KeyVault::Keys::Cryptography::_detail;
+
+namespace Azure { namespace Security { namespace KeyVault { namespace Keys { namespace Test {
+  namespace {
+    using PrivateKey = std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)>;
+    using KeyContext = std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)>;
+
+    std::string const KeyId = "https://account.vault.azure.net/keys/name/version";
+
+    PrivateKey GenerateKey(int keyType)
+    {
+      KeyContext context(EVP_PKEY_CTX_new_id(keyType, nullptr), EVP_PKEY_CTX_free);
+      EVP_PKEY* key = nullptr;
+      if (context && EVP_PKEY_keygen_init(context.get()) == 1
+          && (keyType == EVP_PKEY_RSA
+                  ? EVP_PKEY_CTX_set_rsa_keygen_bits(context.get(), 2048)
+                  : EVP_PKEY_CTX_set_ec_paramgen_curve_nid(context.get(), NID_X9_62_prime256v1))
+              > 0)
+      {
+        EVP_PKEY_keygen(context.get(), &key);
+      }
+      return PrivateKey(key, EVP_PKEY_free);
+    }
+
+    std::vector<uint8_t> ToBytes(BIGNUM const* number, int size = 0)
+    {
+      std::vector<uint8_t> bytes(static_cast<size_t>(size > 0 ? size : BN_num_bytes(number)));
+      BN_bn2binpad(number, bytes.data(), static_cast<int>(bytes.size()));
+      return bytes;
+    }
+
+    KeyVaultKey GetPublicKey(EVP_PKEY* key)
+    {
+      KeyVaultKey keyVaultKey("name");
+      keyVaultKey.Key.Id = KeyId;
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+      auto const getParameter = [&](char const* name, int size) {
+        BIGNUM* number = nullptr;
+        EVP_PKEY_get_bn_param(key, name, &number);
+        auto bytes = ToBytes(number, size);
+        BN_free(number);
+        return bytes;
+      };
+      if (EVP_PKEY_get_base_id(key) == EVP_PKEY_RSA)
+      {
+        keyVaultKey.Key.KeyType = KeyVaultKeyType::Rsa;
+        keyVaultKey.Key.N = getParameter(OSSL_PKEY_PARAM_RSA_N, 0);
+        keyVaultKey.Key.E = getParameter(OSSL_PKEY_PARAM_RSA_E, 0);
+      }
+      else
+      {
+        keyVaultKey.Key.KeyType = KeyVaultKeyType::Ec;
+        keyVaultKey.Key.CurveName = KeyCurveName::P256;
+        keyVaultKey.Key.X = getParameter(OSSL_PKEY_PARAM_EC_PUB_X, 32);
+        keyVaultKey.Key.Y = getParameter(OSSL_PKEY_PARAM_EC_PUB_Y, 32);
+      }
+#else
+      if (EVP_PKEY_base_id(key) == EVP_PKEY_RSA)
+      {
+        BIGNUM const* n = nullptr;
+        BIGNUM const* e = nullptr;
+        RSA_get0_key(EVP_PKEY_get0_RSA(key), &n, &e, nullptr);
+        keyVaultKey.Key.KeyType = KeyVaultKeyType::Rsa;
+        keyVaultKey.Key.N = ToBytes(n);
+        keyVaultKey.Key.E = ToBytes(e);
+      }
+      else
+      {
+        auto const* ecKey = EVP_PKEY_get0_EC_KEY(key);
+        BIGNUM* x = BN_new();
+        BIGNUM* y = BN_new();
+        EC_POINT_get_affine_coordinates_GFp(
+            EC_KEY_get0_group(ecKey), EC_KEY_get0_public_key(ecKey), x, y, nullptr);
+        keyVaultKey.Key.KeyType = KeyVaultKeyType::Ec;
+        keyVaultKey.Key.CurveName = KeyCurveName::P256;
+        keyVaultKey.Key.X = ToBytes(x, 32);
+        keyVaultKey.Key.Y = ToBytes(y, 32);
+        BN_free(x);
+        BN_free(y);
+      }
+#endif
+      return keyVaultKey;
+    }
+
+    std::vector<uint8_t> Sign(EVP_PKEY* key, std::vector<uint8_t> const& digest, int padding)
+    {
+      KeyContext context(EVP_PKEY_CTX_new(key, nullptr), EVP_PKEY_CTX_free);
+      EVP_PKEY_sign_init(context.get());
+      EVP_PKEY_CTX_set_signature_md(context.get(), EVP_sha256());
+      if (padding != 0)
+      {
+        EVP_PKEY_CTX_set_rsa_padding(context.get(), padding);
+      }
+      if (padding == RSA_PKCS1_PSS_PADDING)
+      {
+        EVP_PKEY_CTX_set_rsa_pss_saltlen(context.get(), RSA_PSS_SALTLEN_DIGEST);
+      }
+      size_t length = 0;
+      EVP_PKEY_sign(context.get(), nullptr, &length, digest.data(), digest.size());
+      std::vector<uint8_t> signature(length);
+      EVP_PKEY_sign(context.get(), signature.data(), &length, digest.data(), digest.size());
+      signature.resize(length);
+      if (padding != 0)
+      {
+        return signature;
+      }
+
+      // Key Vault represents an EC signature as R || S.
+      auto const* der = signature.data();
+      auto* ecdsaSignature = d2i_ECDSA_SIG(nullptr, &der, static_cast<long>(signature.size()));
+      BIGNUM const* r = nullptr;
+      BIGNUM const* s = nullptr;
+      ECDSA_SIG_get0(ecdsaSignature, &r, &s);
+      auto result = ToBytes(r, 32);
+      auto const sBytes = ToBytes(s, 32);
+      result.insert(result.end(), sBytes.begin(), sBytes.end());
+      ECDSA_SIG_free(ecdsaSignature);
+      return result;
+    }
+
+    std::vector<uint8_t> Decrypt(
+        EVP_PKEY* key,
+        std::vector<uint8_t> const& ciphertext,
+        EVP_MD const* oaepDigest)
+    {
+      KeyContext context(EVP_PKEY_CTX_new(key, nullptr), EVP_PKEY_CTX_free);
+      EVP_PKEY_decrypt_init(context.get());
+      EVP_PKEY_CTX_set_rsa_padding(context.get(), RSA_PKCS1_OAEP_PADDING);
+      EVP_PKEY_CTX_set_rsa_oaep_md(context.get(), oaepDigest);
+      EVP_PKEY_CTX_set_rsa_mgf1_md(context.get(), oaepDigest);
+      size_t length = 0;
+      EVP_PKEY_decrypt(context.get(), nullptr, &length, ciphertext.data(), ciphertext.size());
+      std::vector<uint8_t> plaintext(length);
+      EVP_PKEY_decrypt(
+          context.get(), plaintext.data(), &length, ciphertext.data(), ciphertext.size());
+      plaintext.resize(length);
+      return plaintext;
+    }
+
+    std::vector<uint8_t> CreateDigest(std::string const& data)
+    {
+      return Azure::Core::Cryptography::_internal::Sha256Hash().Final(
+          reinterpret_cast<uint8_t const*>(data.data()), data.size());
+    }
+
+    class StaticTokenCredential final : public Azure::Core::Credentials::TokenCredential {
+    public:
+      StaticTokenCredential() : TokenCredential("StaticTokenCredential") {}
+
+      Azure::Core::Credentials::AccessToken GetToken(
+          Azure::Core::Credentials::TokenRequestContext const&,
+          Azure::Core::Context const&) const override
+      {
+        Azure::Core::Credentials::AccessToken token;
+        token.Token = "token";
+        token.ExpiresOn = Azure::DateTime(std::chrono::system_clock::now() + std::chrono::hours(1));
+        return token;
+      }
+    };
+
+    // Returns the key for a GET request, and fails every cryptographic operation.
+    class KeyTransport final : public Azure::Core::Http::HttpTransport {
+      std::string m_key;
+
+    public:
+      std::atomic<int> KeyRequests{0};
+      std::atomic<int> OperationRequests{0};
+
+      explicit KeyTransport(KeyVaultKey const& key)
+      {
+        using Azure::Core::_internal::Base64Url;
+        m_key = "{\"key\":{\"kid\":\"" + KeyId + "\",\"kty\":\"RSA\",\"key_ops\":[\"verify\"],"
+            + "\"n\":\"" + Base64Url::Base64UrlEncode(key.Key.N) + "\",\"e\":\""
+            + Base64Url::Base64UrlEncode(key.Key.E) + "\"},\"attributes\":{\"enabled\":true}}";
+      }
+
+      std::unique_ptr<Azure::Core::Http::RawResponse> Send(
+          Azure::Core::Http::Request& request,
+          Azure::Core::Context const&) override
+      {
+        auto const isKeyRequest = request.GetMethod() == Azure::Core::Http::HttpMethod::Get;
+        ++(isKeyRequest ? KeyRequests : OperationRequests);
+        auto response = isKeyRequest
+            ? std::make_unique<Azure::Core::Http::RawResponse>(
+                1, 1, Azure::Core::Http::HttpStatusCode::Ok, "OK")
+            : std::make_unique<Azure::Core::Http::RawResponse>(
+                1, 1, Azure::Core::Http::HttpStatusCode::Forbidden, "Forbidden");
+        response->SetBodyStream(std::make_unique<Azure::Core::IO::MemoryBodyStream>(
+            reinterpret_cast<uint8_t const*>(m_key.data()), isKeyRequest ? m_key.size() : 0));
+        return response;
+      }
+    };
+  } // namespace
+
+  TEST(LocalCryptographyProvider, RsaVerify)
+  {
+    auto const privateKey = GenerateKey(EVP_PKEY_RSA);
+    ASSERT_TRUE(privateKey);
+    auto const provider = LocalCryptographyProvider::Create(GetPublicKey(privateKey.get()));
+    ASSERT_TRUE(provider);
+
+    auto const digest = CreateDigest("data");
+    auto const pkcs1Signature = Sign(privateKey.get(), digest, RSA_PKCS1_PADDING);
+    auto result = provider->Verify(SignatureAlgorithm::RS256, digest, pkcs1Signature);
+    ASSERT_TRUE(result.HasValue());
+    EXPECT_TRUE(result.Value().IsValid);
+    EXPECT_EQ(result.Value().KeyId, KeyId);
+
+    auto const pssSignature = Sign(privateKey.get(), digest, RSA_PKCS1_PSS_PADDING);
+    EXPECT_TRUE(provider->Verify(SignatureAlgorithm::PS256, digest, pssSignature).Value().IsValid);
+    EXPECT_FALSE(
+        provider->Verify(SignatureAlgorithm::PS256, digest, pkcs1Signature).Value().IsValid);
+    EXPECT_FALSE(provider->Verify(SignatureAlgorithm::RS256, CreateDigest("other"), pkcs1Signature)
+                     .Value()
+                     .IsValid);
+
+    // Mismatched algorithms and digests are left to the service.
+    EXPECT_FALSE(provider->Verify(SignatureAlgorithm::RS384, digest, pkcs1Signature).HasValue());
+    EXPECT_FALSE(provider->Verify(SignatureAlgorithm::ES256, digest, pkcs1Signature).HasValue());
+  }
+
+  TEST(LocalCryptographyProvider, EcVerify)
+  {
+    auto const privateKey = GenerateKey(EVP_PKEY_EC);
+    ASSERT_TRUE(privateKey);
+    auto const provider = LocalCryptographyProvider::Create(GetPublicKey(privateKey.get()));
+    ASSERT_TRUE(provider);
+
+    auto const digest = CreateDigest("data");
+    auto signature = Sign(privateKey.get(), digest, 0);
+    ASSERT_EQ(signature.size(), 64);
+    EXPECT_TRUE(provider->Verify(SignatureAlgorithm::ES256, digest, signature).Value().IsValid);
+    signature[10] ^= 1;
+    EXPECT_FALSE(provider->Verify(SignatureAlgorithm::ES256, digest, signature).Value().IsValid);
+
+    EXPECT_FALSE(provider->Verify(SignatureAlgorithm::ES256K, digest, signature).HasValue());
+    EXPECT_FALSE(provider->Verify(SignatureAlgorithm::RS256, digest, signature).HasValue());
+    EXPECT_FALSE(provider->Encrypt(EncryptParameters::RsaOaepParameters({1, 2, 3})).HasValue());
+  }
+
+  TEST(LocalCryptographyProvider, RsaEncryptAndWrapKey)
+  {
+    auto const privateKey = GenerateKey(EVP_PKEY_RSA);
+    ASSERT_TRUE(privateKey);
+    auto const provider = LocalCryptographyProvider::Create(GetPublicKey(privateKey.get()));
+    ASSERT_TRUE(provider);
+
+    std::vector<uint8_t> const plaintext{'p', 'l', 'a', 'i', 'n'};
+    auto const encrypted = provider->Encrypt(EncryptParameters::RsaOaepParameters(plaintext));
+    ASSERT_TRUE(encrypted.HasValue());
+    EXPECT_EQ(encrypted.Value().Algorithm, EncryptionAlgorithm::RsaOaep);
+    EXPECT_EQ(Decrypt(privateKey.get(), encrypted.Value().Ciphertext, EVP_sha1()), plaintext);
+
+    auto const wrapped = provider->WrapKey(KeyWrapAlgorithm::RsaOaep256, plaintext);
+    ASSERT_TRUE(wrapped.HasValue());
+    EXPECT_EQ(Decrypt(privateKey.get(), wrapped.Value().EncryptedKey, EVP_sha256()), plaintext);
+
+    // Symmetric algorithms need the service.
+    EXPECT_FALSE(
+        provider->Encrypt(EncryptParameters::A128CbcParameters(plaintext, std::vector<uint8_t>(16)))
+            .HasValue());
+  }
+
+  TEST(LocalCryptographyProvider, KeyRestrictions)
+  {
+    auto const privateKey = GenerateKey(EVP_PKEY_RSA);
+    ASSERT_TRUE(privateKey);
+    auto publicKey = GetPublicKey(privateKey.get());
+    std::vector<uint8_t> const plaintext{1, 2, 3};
+    auto const digest = CreateDigest("data");
+    auto const signature = Sign(privateKey.get(), digest, RSA_PKCS1_PADDING);
+
+    publicKey.Properties.ExpiresOn
+        = Azure::DateTime(std::chrono::system_clock::now() - std::chrono::hours(1));
+    auto provider = LocalCryptographyProvider::Create(publicKey);
+    ASSERT_TRUE(provider);
+    EXPECT_FALSE(provider->Encrypt(EncryptParameters::RsaOaepParameters(plaintext)).HasValue());
+    // Signatures made before the key expired can still be verified.
+    EXPECT_TRUE(provider->Verify(SignatureAlgorithm::RS256, digest, signature).HasValue());
+
+    publicKey.Properties.ExpiresOn = {};
+    publicKey.Key.SetKeyOperations({KeyOperation::Encrypt});
+    provider = LocalCryptographyProvider::Create(publicKey);
+    EXPECT_TRUE(provider->Encrypt(EncryptParameters::RsaOaepParameters(plaintext)).HasValue());
+    EXPECT_FALSE(provider->WrapKey(KeyWrapAlgorithm::RsaOaep, plaintext).HasValue());
+    EXPECT_FALSE(provider->Verify(SignatureAlgorithm::RS256, digest, signature).HasValue());
+
+    publicKey.Properties.Enabled = false;
+    EXPECT_FALSE(LocalCryptographyProvider::Create(publicKey));
+  }
+
+  TEST(LocalCryptographyProvider, CryptographyClient)
+  {
+    auto const privateKey = GenerateKey(EVP_PKEY_RSA);
+    ASSERT_TRUE(privateKey);
+    auto const transport = std::make_shared<KeyTransport>(GetPublicKey(privateKey.get()));
+    CryptographyClientOptions options;
+    options.Transport.Transport = transport;
+    options.Retry.MaxRetries = 0;
+    options.EnableLocalCryptography = true;
+    CryptographyClient client(KeyId, std::make_shared<StaticTokenCredential>(), options);
+
+    auto const digest = CreateDigest("data");
+    auto const signature = Sign(privateKey.get(), digest, RSA_PKCS1_PADDING);
+    for (int i = 0; i < 3; ++i)
+    {
+      auto const response = client.Verify(SignatureAlgorithm::RS256, digest, signature);
+      EXPECT_TRUE(response.Value.IsValid);
+      EXPECT_EQ(response.Value.KeyId, KeyId);
+      EXPECT_EQ(response.RawResponse, nullptr);
+    }
+    EXPECT_EQ(transport->KeyRequests.load(), 1);
+    EXPECT_EQ(transport->OperationRequests.load(), 0);
+
+    // The key doesn't allow encryption, so the service is asked to do it.
+    EXPECT_THROW(
+        client.Encrypt(EncryptParameters::RsaOaepParameters({1, 2, 3})),
+        Azure::Core::RequestFailedException);
+    EXPECT_EQ(transport->KeyRequests.load(), 1);
+    EXPECT_EQ(transport->OperationRequests.load(), 1);
+  }
+}}}}} // namespace Azure::Security::KeyVault::Keys::Test
+#endif // AZ_PLATFORM_POSIX
@@ -8,6 +8,7 @@
 #include "azure/storage/blobs/blob_service_client.hpp"
 #include "azure/storage/blobs/deferred_response.hpp"
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -49,6 +50,11 @@ namespace Azure { namespace Storage { namespace Blobs {
       virtual ~BatchSubrequest() = 0;
 
       BatchSubrequestType Type;
+      // Used by bulk submission. The number of times the subrequest can still be resubmitted after
+      // a transient failure, and whether it failed that way or for good in the last batch request.
+      int32_t RemainingRetries = 0;
+      bool Retry = false;
+      bool Failed = false;
     };
 
     class BlobBatchAccessHelper;
@@ -60,6 +66,16 @@ namespace Azure { namespace Storage { namespace Blobs {
             servicePerOperationPolicies,
         const BlobClientOptions& options);
 
+    // Submits subrequests in batch requests of at most 256 subrequests of the same type, in
+    // parallel, and resubmits the ones that failed with a transient error. submitBatch sends a
+    // single batch request.
+    Models::SubmitBulkBlobBatchResult SubmitBulkBatch(
+        const std::vector<std::shared_ptr<BatchSubrequest>>& subrequests,
+        const std::function<
+            void(std::vector<std::shared_ptr<BatchSubrequest>>, const Core::Context&)>& submitBatch,
+        const SubmitBulkBlobBatchOptions& options,
+        const Core::Context& context);
+
     std::shared_ptr<Azure::Core::Http::_internal::HttpPipeline> ConstructBatchSubrequestPolicy(
         std::unique_ptr<Azure::Core::Http::Policies::HttpPolicy>&& tokenAuthPolicy,
         std::unique_ptr<Azure::Core::Http::Policies::HttpPolicy>&& sharedKeyAuthPolicy,
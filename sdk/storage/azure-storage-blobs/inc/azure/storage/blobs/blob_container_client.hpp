@@ -285,6 +285,48 @@ namespace Azure { namespace Storage { namespace Blobs {
         const UploadBlockBlobOptions& options = UploadBlockBlobOptions(),
         const Azure::Core::Context& context = Azure::Core::Context()) const;
 
+    /**
+     * @brief Uploads the files of a local directory and its subdirectories as block blobs under
+     * this container. The requests for all the files share the same limits on the number of
+     * requests and bytes in flight, small files are uploaded with a single request and large files
+     * in blocks.
+     *
+     * @param directoryPath The path of the local directory to upload.
+     * @param blobPrefix The prefix of the names of the blobs. A file is uploaded to the blob named
+     * after the prefix followed by the path of the file relative to the directory, with '/' as
+     * separator. A '/' is appended to a non-empty prefix that doesn't end with one.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A BulkTransferResult describing the files uploaded and the ones that failed.
+     */
+    BulkTransferResult UploadDirectory(
+        const std::string& directoryPath,
+        const std::string& blobPrefix,
+        const UploadBlobDirectoryOptions& options = UploadBlobDirectoryOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
+    /**
+     * @brief Downloads the blobs of this container whose names start with a prefix to a local
+     * directory. The requests for all the blobs share the same limits on the number of requests
+     * and bytes in flight, small blobs are downloaded with a single request and large blobs in
+     * ranges.
+     *
+     * @param blobPrefix The prefix of the names of the blobs to download. A '/' is appended to a
+     * non-empty prefix that doesn't end with one. A blob is downloaded to the file whose path
+     * relative to the directory is the rest of its name, with '/' as separator.
+     * @param directoryPath The path of the local directory to download to, created if it doesn't
+     * exist. Existing files are overwritten.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A BulkTransferResult describing the blobs downloaded and the ones that failed. Blobs
+     * whose names can't be mapped to a file in the directory are reported as failed.
+     */
+    BulkTransferResult DownloadDirectory(
+        const std::string& blobPrefix,
+        const std::string& directoryPath,
+        const DownloadBlobDirectoryOptions& options = DownloadBlobDirectoryOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
     /**
      * @brief The Filter Blobs operation enables callers to list blobs in a container whose
      * tags match a given search expression.
@@ -326,6 +368,23 @@ namespace Azure { namespace Storage { namespace Blobs {
         const SubmitBlobBatchOptions& options = SubmitBlobBatchOptions(),
         const Core::Context& context = Core::Context()) const;
 
+    /**
+     * @brief Submits any number of subrequests. The subrequests are split into batch requests of
+     * at most 256 subrequests of the same type, sent in parallel, and the subrequests that failed
+     * with a transient error are resubmitted.
+     *
+     * @param batch The batch object containing subrequests.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A SubmitBulkBlobBatchResult.
+     * @remark The deferred responses of the subrequests produce their final results, including
+     * the error of the batch request for the subrequests of a batch request that failed.
+     */
+    Models::SubmitBulkBlobBatchResult SubmitBulkBatch(
+        const BlobContainerBatch& batch,
+        const SubmitBulkBlobBatchOptions& options = SubmitBulkBlobBatchOptions(),
+        const Core::Context& context = Core::Context()) const;
+
     /**
      * @brief Returns the sku name and account kind for the specified account.
      *
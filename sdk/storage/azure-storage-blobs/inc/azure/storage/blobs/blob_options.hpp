@@ -14,6 +14,7 @@
 
 #include <chrono>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <numeric>
 #include <string>
@@ -186,8 +187,9 @@ namespace Azure { namespace Storage { namespace Blobs {
     /**
      * SecondaryHostForRetryReads specifies whether the retry policy should retry a read
      * operation against another host. If SecondaryHostForRetryReads is "" (the default) then
-     * operations are not retried against another host. NOTE: Before setting this field, make sure
-     * you understand the issues around reading stale & potentially-inconsistent data at this
+     * operations are not retried against another host. When hedging is enabled in the client
+     * options, hedged read requests are sent to this host. NOTE: Before setting this field, make
+     * sure you understand the issues around reading stale & potentially-inconsistent data at this
      * webpage: https://learn.microsoft.com/azure/storage/common/geo-redundant-design.
      */
     std::string SecondaryHostForRetryReads;
@@ -685,6 +687,23 @@ namespace Azure { namespace Storage { namespace Blobs {
      */
     Azure::Nullable<Core::Http::HttpRange> Range;
 
+    /**
+     * @brief When set to true, the CRC64 of every chunk is requested from the service and compared
+     * with the CRC64 computed while the chunk is received. The service only returns the hash of a
+     * range of up to 4 MiB, so the chunk sizes are limited to 4 MiB.
+     */
+    bool ValidateContentHash = false;
+
+    /**
+     * @brief The path of a file recording the chunks already written to the destination file.
+     * When set, a download that failed or was interrupted skips the chunks written by previous
+     * attempts with the same blob, ETag, destination file and chunk sizes, instead of starting
+     * over. The first chunk is always downloaded again. The file is deleted once the download
+     * completes. Adaptive transfer isn't used with a journal, since resuming needs the same chunks
+     * in every attempt.
+     */
+    Azure::Nullable<std::string> JournalPath;
+
     /**
      * @brief Options for parallel transfer.
      */
@@ -706,6 +725,20 @@ namespace Azure { namespace Storage { namespace Blobs {
        * @brief The maximum number of threads that may be used in a parallel transfer.
        */
       int32_t Concurrency = 5;
+
+      /**
+       * @brief When set to true, the chunk size and the number of chunks transferred in parallel
+       * are tuned during the transfer based on the measured throughput, and reduced when the
+       * service throttles requests. ChunkSize is then the smallest chunk size and Concurrency the
+       * maximum number of chunks transferred in parallel.
+       */
+      bool Adaptive = false;
+
+      /**
+       * @brief How the local file is written. Memory-mapped and direct I/O reduce the copies
+       * and the page cache pressure of very large transfers.
+       */
+      Storage::FileIoMode FileIoMode = Storage::FileIoMode::Buffered;
     } TransferOptions;
   };
 
@@ -937,6 +970,20 @@ namespace Azure { namespace Storage { namespace Blobs {
        * @brief The maximum number of threads that may be used in a parallel transfer.
        */
       int32_t Concurrency = 5;
+
+      /**
+       * @brief When set to true, the chunk size and the number of chunks transferred in parallel
+       * are tuned during the transfer based on the measured throughput, and reduced when the
+       * service throttles requests. ChunkSize is then the smallest chunk size and Concurrency the
+       * maximum number of chunks transferred in parallel.
+       */
+      bool Adaptive = false;
+
+      /**
+       * @brief How the local file is read. Memory-mapped and direct I/O reduce the copies
+       * and the page cache pressure of very large transfers.
+       */
+      Storage::FileIoMode FileIoMode = Storage::FileIoMode::Buffered;
     } TransferOptions;
 
     /**
@@ -948,6 +995,100 @@ namespace Azure { namespace Storage { namespace Blobs {
      * Indicates whether the blob has a legal hold.
      */
     Azure::Nullable<bool> HasLegalHold;
+
+    /**
+     * @brief The path of a file recording the blocks already staged. When set, an upload from a
+     * file that failed or was interrupted skips the blocks staged by previous attempts with the
+     * same source file, blob and block size, and commits them with the same block IDs, instead of
+     * starting over. The file is deleted once the upload completes. Adaptive transfer isn't used
+     * with a journal, since resuming needs the same blocks in every attempt. Only used when
+     * uploading from a file in blocks.
+     */
+    Azure::Nullable<std::string> JournalPath;
+  };
+
+  /**
+   * @brief Optional parameters for #Azure::Storage::Blobs::BlobContainerClient::UploadDirectory.
+   */
+  struct UploadBlobDirectoryOptions final
+  {
+    /**
+     * @brief Indicates the tier to be set on the blobs.
+     */
+    Azure::Nullable<Models::AccessTier> AccessTier;
+
+    /**
+     * @brief Options for parallel transfer.
+     */
+    struct
+    {
+      /**
+       * @brief Files smaller than this will be uploaded with a single upload operation, larger
+       * ones in blocks. This value cannot be larger than 5000 MiB.
+       */
+      int64_t SingleUploadThreshold = 32 * 1024 * 1024;
+
+      /**
+       * @brief The size of the blocks of the files uploaded in blocks. This value cannot be larger
+       * than 4000 MiB.
+       */
+      int64_t ChunkSize = 8 * 1024 * 1024;
+
+      /**
+       * @brief The maximum number of requests in flight, shared by all the files.
+       */
+      int32_t Concurrency = 16;
+
+      /**
+       * @brief The maximum number of bytes uploaded by the requests in flight, shared by all the
+       * files.
+       */
+      int64_t MaxBytesInFlight = 256 * 1024 * 1024;
+    } TransferOptions;
+
+    /**
+     * @brief Called each time a file or a block has been uploaded or has failed.
+     */
+    std::function<void(const BulkTransferProgress&)> ProgressHandler;
+  };
+
+  /**
+   * @brief Optional parameters for #Azure::Storage::Blobs::BlobContainerClient::DownloadDirectory.
+   */
+  struct DownloadBlobDirectoryOptions final
+  {
+    /**
+     * @brief Options for parallel transfer.
+     */
+    struct
+    {
+      /**
+       * @brief Blobs smaller than this will be downloaded with a single download operation, larger
+       * ones in ranges.
+       */
+      int64_t SingleDownloadThreshold = 32 * 1024 * 1024;
+
+      /**
+       * @brief The size of the ranges of the blobs downloaded in ranges.
+       */
+      int64_t ChunkSize = 8 * 1024 * 1024;
+
+      /**
+       * @brief The maximum number of requests in flight, shared by all the blobs.
+       */
+      int32_t Concurrency = 16;
+
+      /**
+       * @brief The maximum number of bytes downloaded by the requests in flight, shared by all the
+       * blobs.
+       */
+      int64_t MaxBytesInFlight = 256 * 1024 * 1024;
+    } TransferOptions;
+
+    /**
+     * @brief Called each time a blob or a range has been downloaded or has failed.
+     */
+    std::function<void(const BulkTransferProgress&)> ProgressHandler;
   };
 
   /**
@@ -1031,6 +1172,13 @@ namespace Azure { namespace Storage { namespace Blobs {
      */
     Azure::Nullable<ContentHash> TransactionalContentHash;
 
+    /**
+     * @brief When set to true and TransactionalContentHash isn't specified, the CRC64 of the
+     * content is computed while the content is sent and compared with the one returned by the
+     * service. This validates the content without reading it twice.
+     */
+    bool ValidateContentHash = false;
+
     /**
      * @brief Optional conditions that must be met to perform this operation.
      */
@@ -1561,6 +1709,142 @@ namespace Azure { namespace Storage { namespace Blobs {
     BlobAccessConditions AccessConditions;
   };
 
+  /**
+   * @brief Optional parameters for #Azure::Storage::Blobs::PageBlobClient::UploadFrom.
+   */
+  struct UploadPageBlobFromOptions final
+  {
+    /**
+     * @brief The standard HTTP header system properties to set.
+     */
+    Models::BlobHttpHeaders HttpHeaders;
+
+    /**
+     * @brief Name-value pairs associated with the blob as metadata.
+     */
+    Storage::Metadata Metadata;
+
+    /**
+     * @brief The tags to set for this blob.
+     */
+    std::map<std::string, std::string> Tags;
+
+    /**
+     * @brief Indicates the tier to be set on the page blob.
+     */
+    Azure::Nullable<Models::AccessTier> AccessTier;
+
+    /**
+     * @brief Options for parallel transfer.
+     */
+    struct
+    {
+      /**
+       * @brief The maximum number of bytes in a single request. This value must be a multiple of
+       * 512 and cannot be larger than 4 MiB.
+       */
+      int64_t ChunkSize = 4 * 1024 * 1024;
+
+      /**
+       * @brief The maximum number of threads that may be used in a parallel transfer.
+       */
+      int32_t Concurrency = 5;
+
+      /**
+       * @brief How the local file is read. Memory-mapped and direct I/O reduce the copies
+       * and the page cache pressure of very large transfers.
+       */
+      Storage::FileIoMode FileIoMode = Storage::FileIoMode::Buffered;
+    } TransferOptions;
+  };
+
+  /**
+   * @brief Optional parameters for #Azure::Storage::Blobs::PageBlobClient::DownloadSparseTo.
+   */
+  struct DownloadSparsePageBlobToOptions final
+  {
+    /**
+     * @brief Options for parallel transfer.
+     */
+    struct
+    {
+      /**
+       * @brief The maximum number of bytes in a single request.
+       */
+      int64_t ChunkSize = 4 * 1024 * 1024;
+
+      /**
+       * @brief The maximum number of threads that may be used in a parallel transfer.
+       */
+      int32_t Concurrency = 5;
+
+      /**
+       * @brief How the local file is written. Memory-mapped and direct I/O reduce the copies
+       * and the page cache pressure of very large transfers.
+       */
+      Storage::FileIoMode FileIoMode = Storage::FileIoMode::Buffered;
+    } TransferOptions;
+  };
+
+  /**
+   * @brief Optional parameters for #Azure::Storage::Blobs::PageBlobClient::DownloadDiffTo.
+   */
+  struct DownloadPageBlobDiffToOptions final
+  {
+    /**
+     * @brief Options for parallel transfer.
+     */
+    struct
+    {
+      /**
+       * @brief The maximum number of bytes in a single request.
+       */
+      int64_t ChunkSize = 4 * 1024 * 1024;
+
+      /**
+       * @brief The maximum number of threads that may be used in a parallel transfer.
+       */
+      int32_t Concurrency = 5;
+
+      /**
+       * @brief How the local file is written. Memory-mapped and direct I/O reduce the copies
+       * and the page cache pressure of very large transfers.
+       */
+      Storage::FileIoMode FileIoMode = Storage::FileIoMode::Buffered;
+    } TransferOptions;
+  };
+
+  /**
+   * @brief Optional parameters for #Azure::Storage::Blobs::PageBlobClient::CopyDiffFrom.
+   */
+  struct CopyPageBlobDiffFromOptions final
+  {
+    /**
+     * @brief Optional. Source authorization used to access the source blob.
+     * The format is: \<scheme\> \<signature\>
+     * Only Bearer type is supported. Credentials should be a valid OAuth access token to copy
+     * source.
+     */
+    std::string SourceAuthorization;
+
+    /**
+     * @brief Options for parallel transfer.
+     */
+    struct
+    {
+      /**
+       * @brief The maximum number of bytes copied by a single request. This value must be a
+       * multiple of 512 and cannot be larger than 4 MiB.
+       */
+      int64_t ChunkSize = 4 * 1024 * 1024;
+
+      /**
+       * @brief The maximum number of requests that may be sent in parallel.
+       */
+      int32_t Concurrency = 5;
+    } TransferOptions;
+  };
+
   /**
    * @brief Optional parameters for #Azure::Storage::Blobs::BlobClient::SetLegalHold.
    */
@@ -1600,6 +1884,24 @@ namespace Azure { namespace Storage { namespace Blobs {
   {
   };
 
+  /**
+   * @brief Optional parameters for #Azure::Storage::Blobs::BlobServiceClient::SubmitBulkBatch and
+   * #Azure::Storage::Blobs::BlobContainerClient::SubmitBulkBatch.
+   */
+  struct SubmitBulkBlobBatchOptions final
+  {
+    /**
+     * @brief The maximum number of batch requests in flight.
+     */
+    int32_t Concurrency = 5;
+
+    /**
+     * @brief The maximum number of times a subrequest that failed with a transient error, e.g.
+     * because the service is busy, is resubmitted in a later batch request.
+     */
+    int32_t MaxSubrequestRetries = 3;
+  };
+
   namespace _detail {
     inline std::string TagsToString(const std::map<std::string, std::string>& tags)
     {
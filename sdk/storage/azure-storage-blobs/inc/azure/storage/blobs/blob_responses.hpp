@@ -62,6 +62,103 @@ namespace Azure { namespace Storage {
 
       using UploadBlockBlobFromResult = UploadBlockBlobResult;
 
+      /**
+       * @brief Response type for #Azure::Storage::Blobs::PageBlobClient::UploadFrom.
+       */
+      struct UploadPageBlobFromResult final
+      {
+        /**
+         * The ETag contains a value that you can use to perform operations conditionally.
+         */
+        Azure::ETag ETag;
+
+        /**
+         * The date/time that the blob was last modified. The date format follows RFC 1123.
+         */
+        Azure::DateTime LastModified;
+
+        /**
+         * True if the blob data and metadata are completely encrypted using the specified
+         * algorithm.
+         */
+        bool IsServerEncrypted = false;
+
+        /**
+         * The SHA-256 hash of the encryption key used to encrypt the blob data and metadata.
+         */
+        Azure::Nullable<std::vector<uint8_t>> EncryptionKeySha256;
+
+        /**
+         * Name of the encryption scope used to encrypt the blob data and metadata.
+         */
+        Azure::Nullable<std::string> EncryptionScope;
+
+        /**
+         * The number of bytes uploaded. The pages that contain only zeros aren't uploaded.
+         */
+        int64_t UploadedBytes = 0;
+      };
+
+      /**
+       * @brief Response type for #Azure::Storage::Blobs::PageBlobClient::DownloadSparseTo.
+       */
+      struct DownloadSparsePageBlobToResult final
+      {
+        /**
+         * The ETag contains a value that you can use to perform operations conditionally.
+         */
+        Azure::ETag ETag;
+
+        /**
+         * The date/time that the blob was last modified. The date format follows RFC 1123.
+         */
+        Azure::DateTime LastModified;
+
+        /**
+         * Size of the blob.
+         */
+        int64_t BlobSize = 0;
+
+        /**
+         * The number of bytes downloaded. Only the page ranges with data are downloaded.
+         */
+        int64_t DownloadedBytes = 0;
+      };
+
+      /**
+       * @brief Response type for #Azure::Storage::Blobs::PageBlobClient::DownloadDiffTo and
+       * #Azure::Storage::Blobs::PageBlobClient::CopyDiffFrom.
+       */
+      struct SyncPageBlobDiffResult final
+      {
+        /**
+         * The ETag of the version of the blob whose changes were synchronized.
+         */
+        Azure::ETag ETag;
+
+        /**
+         * The date/time that the blob was last modified. The date format follows RFC 1123.
+         */
+        Azure::DateTime LastModified;
+
+        /**
+         * Size of the blob.
+         */
+        int64_t BlobSize = 0;
+
+        /**
+         * The number of bytes of the page ranges changed since the previous snapshot, which were
+         * transferred.
+         */
+        int64_t ChangedBytes = 0;
+
+        /**
+         * The number of bytes of the page ranges cleared since the previous snapshot, which were
+         * cleared in the destination.
+         */
+        int64_t ClearedBytes = 0;
+      };
+
       /**
        * @brief Response type for #Azure::Storage::Blobs::BlobLeaseClient::Acquire.
        */
@@ -213,6 +310,24 @@ namespace Azure { namespace Storage {
       {
       };
 
+      /**
+       * @brief Response type for #Azure::Storage::Blobs::BlobServiceClient::SubmitBulkBatch and
+       * #Azure::Storage::Blobs::BlobContainerClient::SubmitBulkBatch.
+       */
+      struct SubmitBulkBlobBatchResult final
+      {
+        /**
+         * The number of batch requests sent, including the ones resubmitting subrequests.
+         */
+        int64_t SubmittedBatches = 0;
+
+        /**
+         * The number of subrequests that failed. Their deferred responses throw the error that
+         * occurred.
+         */
+        int64_t FailedSubrequests = 0;
+      };
+
     } // namespace Models
 
     /**
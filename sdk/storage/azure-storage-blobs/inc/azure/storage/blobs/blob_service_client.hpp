@@ -268,6 +268,23 @@ namespace Azure { namespace Storage { namespace Blobs {
         const SubmitBlobBatchOptions& options = SubmitBlobBatchOptions(),
         const Core::Context& context = Core::Context()) const;
 
+    /**
+     * @brief Submits any number of subrequests. The subrequests are split into batch requests of
+     * at most 256 subrequests of the same type, sent in parallel, and the subrequests that failed
+     * with a transient error are resubmitted.
+     *
+     * @param batch The batch object containing subrequests.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A SubmitBulkBlobBatchResult.
+     * @remark The deferred responses of the subrequests produce their final results, including
+     * the error of the batch request for the subrequests of a batch request that failed.
+     */
+    Models::SubmitBulkBlobBatchResult SubmitBulkBatch(
+        const BlobServiceBatch& batch,
+        const SubmitBulkBlobBatchOptions& options = SubmitBulkBlobBatchOptions(),
+        const Core::Context& context = Core::Context()) const;
+
   private:
     Azure::Core::Url m_serviceUrl;
     std::shared_ptr<Azure::Core::Http::_internal::HttpPipeline> m_pipeline;
@@ -285,6 +285,89 @@ namespace Azure { namespace Storage { namespace Blobs {
         const StartBlobCopyIncrementalOptions& options = StartBlobCopyIncrementalOptions(),
         const Azure::Core::Context& context = Azure::Core::Context()) const;
 
+    /**
+     * @brief Creates a page blob with the content of a buffer, uploaded in parallel. The pages that
+     * contain only zeros aren't uploaded, so that a mostly empty disk image is uploaded quickly.
+     *
+     * @param buffer A memory buffer containing the content to upload.
+     * @param bufferSize Size of the memory buffer, which must be a multiple of 512.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return An UploadPageBlobFromResult describing the state of the updated page blob.
+     */
+    Azure::Response<Models::UploadPageBlobFromResult> UploadFrom(
+        const uint8_t* buffer,
+        size_t bufferSize,
+        const UploadPageBlobFromOptions& options = UploadPageBlobFromOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
+    /**
+     * @brief Creates a page blob with the content of a file, uploaded in parallel. The pages that
+     * contain only zeros aren't uploaded, so that a mostly empty disk image is uploaded quickly.
+     *
+     * @param fileName A file containing the content to upload, whose size must be a multiple of
+     * 512.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return An UploadPageBlobFromResult describing the state of the updated page blob.
+     */
+    Azure::Response<Models::UploadPageBlobFromResult> UploadFrom(
+        const std::string& fileName,
+        const UploadPageBlobFromOptions& options = UploadPageBlobFromOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
+    /**
+     * @brief Downloads the page blob to a sparse file. Only the valid page ranges are downloaded,
+     * in parallel, the other ranges of the file read as zeros and don't take space on disk where
+     * the file system supports sparse files.
+     *
+     * @param fileName A file path to write the downloaded content to.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A DownloadSparsePageBlobToResult describing the downloaded page blob.
+     */
+    Azure::Response<Models::DownloadSparsePageBlobToResult> DownloadSparseTo(
+        const std::string& fileName,
+        const DownloadSparsePageBlobToOptions& options = DownloadSparsePageBlobToOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
+    /**
+     * @brief Updates a file containing a previous snapshot of the page blob to the version of this
+     * client. Only the page ranges changed since the previous snapshot are downloaded, in
+     * parallel, and the ones cleared since are zeroed.
+     *
+     * @param previousSnapshot The snapshot of the page blob the file contains.
+     * @param fileName A file containing the previous snapshot of the page blob. Its size is set to
+     * the size of the page blob.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A SyncPageBlobDiffResult describing the synchronized changes.
+     */
+    Azure::Response<Models::SyncPageBlobDiffResult> DownloadDiffTo(
+        const std::string& previousSnapshot,
+        const std::string& fileName,
+        const DownloadPageBlobDiffToOptions& options = DownloadPageBlobDiffToOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
+    /**
+     * @brief Updates this page blob, which contains a copy of a previous snapshot of a source page
+     * blob, to the version of the source client. Only the page ranges changed since the previous
+     * snapshot are copied by the service, in parallel, and the ones cleared since are cleared.
+     *
+     * @param sourceClient The client of the version of the source page blob to copy. Its URL must
+     * be readable by the service, e.g. with a shared access signature, or authorized with
+     * SourceAuthorization.
+     * @param previousSnapshot The snapshot of the source page blob this page blob contains.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A SyncPageBlobDiffResult describing the synchronized changes.
+     */
+    Azure::Response<Models::SyncPageBlobDiffResult> CopyDiffFrom(
+        const PageBlobClient& sourceClient,
+        const std::string& previousSnapshot,
+        const CopyPageBlobDiffFromOptions& options = CopyPageBlobDiffFromOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
   private:
     explicit PageBlobClient(BlobClient blobClient);
 
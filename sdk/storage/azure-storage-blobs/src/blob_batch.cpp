@@ -14,10 +14,14 @@
 #include <azure/storage/common/internal/shared_key_policy.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstring>
+#include <exception>
 #include <functional>
 #include <future>
 #include <stdexcept>
+#include <thread>
 
 namespace Azure { namespace Storage { namespace Blobs {
 
@@ -50,12 +54,26 @@ namespace Azure { namespace Storage { namespace Blobs {
     static Core::Context::Key s_subrequestKey;
     static Core::Context::Key s_subresponseKey;
 
+    constexpr size_t MaxSubrequestsPerBatch = 256;
+
+    // The status codes retried by default by the retry policy.
+    bool IsTransientFailure(Core::Http::HttpStatusCode statusCode)
+    {
+      return statusCode == Core::Http::HttpStatusCode::RequestTimeout
+          || statusCode == Core::Http::HttpStatusCode::TooManyRequests
+          || statusCode == Core::Http::HttpStatusCode::InternalServerError
+          || statusCode == Core::Http::HttpStatusCode::BadGateway
+          || statusCode == Core::Http::HttpStatusCode::ServiceUnavailable
+          || statusCode == Core::Http::HttpStatusCode::GatewayTimeout;
+    }
+
     struct Parser final
     {
       explicit Parser(const std::string& str)
           : startPos(str.data()), currPos(startPos), endPos(startPos + str.length())
       {
       }
+      Parser(const char* begin, const char* end) : startPos(begin), currPos(begin), endPos(end) {}
       explicit Parser(const std::vector<uint8_t>& str)
           : startPos(reinterpret_cast<const char*>(str.data())),
             currPos(reinterpret_cast<const char*>(startPos)),
@@ -115,9 +133,16 @@ namespace Azure { namespace Storage { namespace Blobs {
       }
     };
 
-    std::unique_ptr<Core::Http::RawResponse> ParseRawResponse(const std::string& responseText)
+    // A part of the body of a batch response, which outlives the parsing of the subresponses.
+    struct SubresponseText final
     {
-      Parser parser(responseText);
+      const char* Begin = nullptr;
+      const char* End = nullptr;
+    };
+
+    std::unique_ptr<Core::Http::RawResponse> ParseRawResponse(const SubresponseText& responseText)
+    {
+      Parser parser(responseText.Begin, responseText.End);
 
       parser.Consume("HTTP/");
       int32_t httpMajorVersion = std::stoi(parser.GetBeforeNextAndConsume("."));
@@ -186,21 +211,28 @@ namespace Azure { namespace Storage { namespace Blobs {
 
         if (subrequestText)
         {
-          std::string requestText = request.GetMethod().ToString() + " /"
-              + request.GetUrl().GetRelativeUrl() + " HTTP/1.1" + LineEnding;
+          // Appended to the body of the batch request.
+          std::string& requestText = *subrequestText;
+          requestText += request.GetMethod().ToString();
+          requestText += " /";
+          requestText += request.GetUrl().GetRelativeUrl();
+          requestText += " HTTP/1.1";
+          requestText += LineEnding;
           for (const auto& header : request.GetHeaders())
           {
-            requestText += header.first + ": " + header.second + LineEnding;
+            requestText += header.first;
+            requestText += ": ";
+            requestText += header.second;
+            requestText += LineEnding;
           }
           requestText += LineEnding;
-          *subrequestText = std::move(requestText);
 
           auto rawResponse = std::make_unique<Core::Http::RawResponse>(
               1, 1, Core::Http::HttpStatusCode::Accepted, "Accepted");
           return rawResponse;
         }
 
-        std::string* subresponseText = nullptr;
+        const SubresponseText* subresponseText = nullptr;
         context.TryGetValue(s_subresponseKey, subresponseText);
         if (subresponseText)
         {
@@ -299,16 +331,20 @@ namespace Azure { namespace Storage { namespace Blobs {
     {
       const std::string boundary = "batch_" + Azure::Core::Uuid::CreateUuid().ToString();
 
-      auto getBatchBoundary = [&boundary, subRequestCounter = 0]() mutable {
-        std::string ret;
-        ret += "--" + boundary + LineEnding;
-        ret += "Content-Type: application/http" + LineEnding + "Content-Transfer-Encoding: binary"
-            + LineEnding + "Content-ID: " + std::to_string(subRequestCounter++) + LineEnding
-            + LineEnding;
-        return ret;
-      };
-
       std::string requestBody;
+      auto appendBatchBoundary = [&requestBody, &boundary, subRequestCounter = 0]() mutable {
+        requestBody += "--";
+        requestBody += boundary;
+        requestBody += LineEnding;
+        requestBody += "Content-Type: application/http";
+        requestBody += LineEnding;
+        requestBody += "Content-Transfer-Encoding: binary";
+        requestBody += LineEnding;
+        requestBody += "Content-ID: ";
+        requestBody += std::to_string(subRequestCounter++);
+        requestBody += LineEnding;
+        requestBody += LineEnding;
+      };
 
       std::unique_ptr<_detail::BlobBatchAccessHelper> batchAccessHelper;
       {
@@ -328,28 +364,25 @@ namespace Azure { namespace Storage { namespace Blobs {
         }
       }
 
+      // Subrequests are a few hundred bytes each.
+      requestBody.reserve(batchAccessHelper->Subrequests().size() * 512);
       for (const auto& subrequestPtr : batchAccessHelper->Subrequests())
       {
         if (subrequestPtr->Type == _detail::BatchSubrequestType::DeleteBlob)
         {
           auto& subrequest = *static_cast<DeleteBlobSubrequest*>(subrequestPtr.get());
-          requestBody += getBatchBoundary();
-          std::string subrequestText;
+          appendBatchBoundary();
           subrequest.Client.Delete(
-              subrequest.Options, Core::Context().WithValue(s_subrequestKey, &subrequestText));
-          requestBody += subrequestText;
+              subrequest.Options, Core::Context().WithValue(s_subrequestKey, &requestBody));
         }
         else if (subrequestPtr->Type == _detail::BatchSubrequestType::SetBlobAccessTier)
         {
           auto& subrequest = *static_cast<SetBlobAccessTierSubrequest*>(subrequestPtr.get());
-          requestBody += getBatchBoundary();
-
-          std::string subrequestText;
+          appendBatchBoundary();
           subrequest.Client.SetAccessTier(
               subrequest.Tier,
               subrequest.Options,
-              Core::Context().WithValue(s_subrequestKey, &subrequestText));
-          requestBody += subrequestText;
+              Core::Context().WithValue(s_subrequestKey, &requestBody));
         }
         else
         {
@@ -383,7 +416,7 @@ namespace Azure { namespace Storage { namespace Blobs {
           = rawResponse->ExtractBodyStream()->ReadToEnd(context);
       Parser parser(responseBody);
 
-      std::vector<std::string> subresponses;
+      std::vector<SubresponseText> subresponses;
       while (true)
       {
         parser.Consume("--" + boundary);
@@ -407,12 +440,12 @@ namespace Azure { namespace Storage { namespace Blobs {
           {
             subresponses.resize(id + 1);
           }
-          subresponses[id] = std::string(responseStartPos, responseEndPos);
+          subresponses[id] = SubresponseText{responseStartPos, responseEndPos};
           parser.currPos = responseEndPos;
         }
         else
         {
-          rawResponse = ParseRawResponse(std::string(responseStartPos, responseEndPos));
+          rawResponse = ParseRawResponse(SubresponseText{responseStartPos, responseEndPos});
           parser.currPos = responseEndPos;
           return;
         }
@@ -436,45 +469,91 @@ namespace Azure { namespace Storage { namespace Blobs {
         }
       }
 
+      // Subrequests that failed with a transient error are left pending when they can be
+      // resubmitted.
+      auto completeSubrequest = [](_detail::BatchSubrequest& subrequest, auto& promise, auto send) {
+        try
+        {
+          promise.set_value(send());
+        }
+        catch (const Core::RequestFailedException& e)
+        {
+          if (subrequest.RemainingRetries > 0 && IsTransientFailure(e.StatusCode))
+          {
+            --subrequest.RemainingRetries;
+            subrequest.Retry = true;
+            return;
+          }
+          subrequest.Failed = true;
+          promise.set_exception(std::current_exception());
+        }
+        catch (...)
+        {
+          subrequest.Failed = true;
+          promise.set_exception(std::current_exception());
+        }
+      };
+
+      const SubresponseText missingSubresponse;
       size_t subresponseCounter = 0;
       for (const auto& subrequestPtr : batchAccessHelper->Subrequests())
       {
+        // A missing subresponse fails to parse.
+        const SubresponseText* subresponseText = subresponseCounter < subresponses.size()
+            ? &subresponses[subresponseCounter]
+            : &missingSubresponse;
+        ++subresponseCounter;
         if (subrequestPtr->Type == _detail::BatchSubrequestType::DeleteBlob)
         {
           auto& subrequest = *static_cast<DeleteBlobSubrequest*>(subrequestPtr.get());
-          try
-          {
-            auto response = subrequest.Client.Delete(
-                subrequest.Options,
-                Core::Context().WithValue(s_subresponseKey, &subresponses[subresponseCounter++]));
-            subrequest.Promise.set_value(std::move(response));
-          }
-          catch (...)
-          {
-            subrequest.Promise.set_exception(std::current_exception());
-          }
+          completeSubrequest(subrequest, subrequest.Promise, [&]() {
+            return subrequest.Client.Delete(
+                subrequest.Options, Core::Context().WithValue(s_subresponseKey, subresponseText));
+          });
         }
         else if (subrequestPtr->Type == _detail::BatchSubrequestType::SetBlobAccessTier)
         {
           auto& subrequest = *static_cast<SetBlobAccessTierSubrequest*>(subrequestPtr.get());
-          try
-          {
-            auto response = subrequest.Client.SetAccessTier(
+          completeSubrequest(subrequest, subrequest.Promise, [&]() {
+            return subrequest.Client.SetAccessTier(
                 subrequest.Tier,
                 subrequest.Options,
-                Core::Context().WithValue(s_subresponseKey, &subresponses[subresponseCounter++]));
-            subrequest.Promise.set_value(std::move(response));
-          }
-          catch (...)
-          {
-            subrequest.Promise.set_exception(std::current_exception());
-          }
+                Core::Context().WithValue(s_subresponseKey, subresponseText));
+          });
+        }
+        else
+        {
+          AZURE_UNREACHABLE_CODE();
+        }
+      }
+    }
+
+    // Completes a subrequest that can't be sent or whose batch request failed.
+    void FailSubrequest(_detail::BatchSubrequest& subrequestBase, std::exception_ptr error)
+    {
+      const bool failed = subrequestBase.Failed;
+      subrequestBase.Retry = false;
+      subrequestBase.Failed = true;
+      try
+      {
+        if (subrequestBase.Type == _detail::BatchSubrequestType::DeleteBlob)
+        {
+          static_cast<DeleteBlobSubrequest&>(subrequestBase).Promise.set_exception(error);
+        }
+        else if (subrequestBase.Type == _detail::BatchSubrequestType::SetBlobAccessTier)
+        {
+          static_cast<SetBlobAccessTierSubrequest&>(subrequestBase).Promise.set_exception(error);
         }
         else
         {
           AZURE_UNREACHABLE_CODE();
         }
       }
+      catch (std::future_error&)
+      {
+        // The subresponse was already parsed.
+        subrequestBase.Failed = failed;
+      }
     }
   } // namespace
 
@@ -494,6 +573,124 @@ namespace Azure { namespace Storage { namespace Blobs {
 
     BatchSubrequest::~BatchSubrequest() {}
 
+    Models::SubmitBulkBlobBatchResult SubmitBulkBatch(
+        const std::vector<std::shared_ptr<BatchSubrequest>>& subrequests,
+        const std::function<
+            void(std::vector<std::shared_ptr<BatchSubrequest>>, const Core::Context&)>& submitBatch,
+        const SubmitBulkBlobBatchOptions& options,
+        const Core::Context& context)
+    {
+      Models::SubmitBulkBlobBatchResult result;
+      std::vector<std::shared_ptr<BatchSubrequest>> pendingSubrequests;
+      for (const auto& subrequest : subrequests)
+      {
+        subrequest->RemainingRetries = (std::max)(options.MaxSubrequestRetries, 0);
+        subrequest->Retry = false;
+        subrequest->Failed = false;
+        pendingSubrequests.push_back(subrequest);
+      }
+
+      for (int32_t attempt = 0; !pendingSubrequests.empty(); ++attempt)
+      {
+        if (attempt != 0)
+        {
+          // Backs off before resubmitting, waking up regularly to check for cancellation.
+          const auto retryTime = std::chrono::steady_clock::now()
+              + std::chrono::milliseconds(500) * (1 << (std::min)(attempt - 1, 6));
+          while (!context.IsCancelled() && std::chrono::steady_clock::now() < retryTime)
+          {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+          }
+        }
+
+        // A batch request can't mix types of subrequests.
+        std::vector<std::vector<std::shared_ptr<BatchSubrequest>>> batches;
+        for (const auto type :
+             {BatchSubrequestType::DeleteBlob, BatchSubrequestType::SetBlobAccessTier})
+        {
+          for (const auto& subrequest : pendingSubrequests)
+          {
+            if (subrequest->Type != type)
+            {
+              continue;
+            }
+            if (batches.empty() || batches.back().front()->Type != type
+                || batches.back().size() == MaxSubrequestsPerBatch)
+            {
+              batches.emplace_back();
+            }
+            batches.back().push_back(subrequest);
+          }
+        }
+
+        std::atomic<size_t> nextBatch{0};
+        std::atomic<int64_t> submittedBatches{0};
+        auto threadFunc = [&]() {
+          for (size_t i = nextBatch++; i < batches.size(); i = nextBatch++)
+          {
+            try
+            {
+              context.ThrowIfCancelled();
+              ++submittedBatches;
+              submitBatch(batches[i], context);
+            }
+            catch (...)
+            {
+              for (const auto& subrequest : batches[i])
+              {
+                FailSubrequest(*subrequest, std::current_exception());
+              }
+            }
+          }
+        };
+        std::vector<std::future<void>> threadHandles;
+        const size_t numThreads
+            = (std::min)(batches.size(), static_cast<size_t>((std::max)(options.Concurrency, 1)));
+        for (size_t i = 1; i < numThreads; ++i)
+        {
+          threadHandles.emplace_back(std::async(std::launch::async, threadFunc));
+        }
+        threadFunc();
+        for (auto& handle : threadHandles)
+        {
+          handle.get();
+        }
+        result.SubmittedBatches += submittedBatches;
+
+        std::vector<std::shared_ptr<BatchSubrequest>> retrySubrequests;
+        for (const auto& subrequest : pendingSubrequests)
+        {
+          if (!subrequest->Retry)
+          {
+            continue;
+          }
+          subrequest->Retry = false;
+          if (context.IsCancelled())
+          {
+            FailSubrequest(
+                *subrequest,
+                std::make_exception_ptr(
+                    Core::OperationCancelledException("Request was cancelled by context.")));
+          }
+          else
+          {
+            retrySubrequests.push_back(subrequest);
+          }
+        }
+        pendingSubrequests = std::move(retrySubrequests);
+      }
+
+      for (const auto& subrequest : subrequests)
+      {
+        if (subrequest->Failed)
+        {
+          ++result.FailedSubrequests;
+        }
+      }
+      context.ThrowIfCancelled();
+      return result;
+    }
+
     std::shared_ptr<Azure::Core::Http::_internal::HttpPipeline> ConstructBatchRequestPolicy(
         const std::vector<std::unique_ptr<Azure::Core::Http::Policies::HttpPolicy>>&
             servicePerRetryPolicies,
@@ -14,6 +14,7 @@
 #include <azure/storage/common/internal/concurrent_transfer.hpp>
 #include <azure/storage/common/internal/constants.hpp>
 #include <azure/storage/common/internal/file_io.hpp>
+#include <azure/storage/common/internal/hashing_body_stream.hpp>
 #include <azure/storage/common/internal/reliable_stream.hpp>
 #include <azure/storage/common/internal/shared_key_policy.hpp>
 #include <azure/storage/common/internal/storage_bearer_token_auth.hpp>
@@ -324,6 +325,16 @@ namespace Azure { namespace Storage { namespace Blobs {
     // keep downloading it in chunks.
     const int64_t firstChunkOffset = options.Range.HasValue() ? options.Range.Value().Offset : 0;
     int64_t firstChunkLength = options.TransferOptions.InitialChunkSize;
+    int64_t chunkSize = options.TransferOptions.ChunkSize;
+    int64_t maxChunkSize = (std::numeric_limits<int64_t>::max)();
+    Azure::Nullable<HashAlgorithm> chunkHashAlgorithm;
+    if (options.ValidateContentHash)
+    {
+      firstChunkLength = (std::min)(firstChunkLength, _internal::MaxHashedRangeSize);
+      chunkSize = (std::min)(chunkSize, _internal::MaxHashedRangeSize);
+      maxChunkSize = _internal::MaxHashedRangeSize;
+      chunkHashAlgorithm = HashAlgorithm::Crc64;
+    }
     if (options.Range.HasValue() && options.Range.Value().Length.HasValue())
     {
       firstChunkLength = (std::min)(firstChunkLength, options.Range.Value().Length.Value());
@@ -331,12 +342,34 @@ namespace Azure { namespace Storage { namespace Blobs {
 
     DownloadBlobOptions firstChunkOptions;
     firstChunkOptions.Range = options.Range;
+    if (options.ValidateContentHash && !firstChunkOptions.Range.HasValue())
+    {
+      // The service only returns the hash of a range.
+      firstChunkOptions.Range = Core::Http::HttpRange();
+    }
     if (firstChunkOptions.Range.HasValue())
     {
       firstChunkOptions.Range.Value().Length = firstChunkLength;
     }
+    firstChunkOptions.RangeHashAlgorithm = chunkHashAlgorithm;
 
-    auto firstChunk = Download(firstChunkOptions, context);
+    auto firstChunk = [&]() {
+      try
+      {
+        return Download(firstChunkOptions, context);
+      }
+      catch (StorageException& e)
+      {
+        if (!options.ValidateContentHash || options.Range.HasValue()
+            || e.StatusCode != Azure::Core::Http::HttpStatusCode::RangeNotSatisfiable)
+        {
+          throw;
+        }
+      }
+      // The blob is empty, so there's no range to request the hash of.
+      firstChunkOptions = DownloadBlobOptions();
+      return Download(firstChunkOptions, context);
+    }();
     const Azure::ETag eTag = firstChunk.Value.Details.ETag;
 
     const int64_t blobSize = firstChunk.Value.BlobSize;
@@ -362,12 +395,19 @@ namespace Azure { namespace Storage { namespace Blobs {
           "Buffer is not big enough, blob range size is " + std::to_string(blobRangeSize) + ".");
     }
 
-    int64_t bytesRead = firstChunk.Value.BodyStream->ReadToCount(
-        buffer, static_cast<size_t>(firstChunkLength), context);
-    if (bytesRead != firstChunkLength)
-    {
-      throw Azure::Core::RequestFailedException("Error when reading body stream.");
-    }
+    _internal::ReadAndVerifyContentHash(
+        *firstChunk.Value.BodyStream,
+        firstChunkOptions.RangeHashAlgorithm,
+        firstChunk.Value.TransactionalContentHash,
+        "Download",
+        [&](Azure::Core::IO::BodyStream& stream) {
+          int64_t bytesRead
+              = stream.ReadToCount(buffer, static_cast<size_t>(firstChunkLength), context);
+          if (bytesRead != firstChunkLength)
+          {
+            throw Azure::Core::RequestFailedException("Error when reading body stream.");
+          }
+        });
     firstChunk.Value.BodyStream.reset();
 
     auto returnTypeConverter = [](Azure::Response<Models::DownloadBlobResult>& response) {
@@ -383,29 +423,38 @@ namespace Azure { namespace Storage { namespace Blobs {
     auto ret = returnTypeConverter(firstChunk);
 
     // Keep downloading the remaining in parallel
-    auto downloadChunkFunc
-        = [&](int64_t offset, int64_t length, int64_t chunkId, int64_t numChunks) {
-            DownloadBlobOptions chunkOptions;
-            chunkOptions.Range = Core::Http::HttpRange();
-            chunkOptions.Range.Value().Offset = offset;
-            chunkOptions.Range.Value().Length = length;
-            chunkOptions.AccessConditions.IfMatch = eTag;
-            auto chunk = Download(chunkOptions, context);
-            int64_t bytesRead = chunk.Value.BodyStream->ReadToCount(
-                buffer + (offset - firstChunkOffset),
-                static_cast<size_t>(chunkOptions.Range.Value().Length.Value()),
-                context);
-            if (bytesRead != chunkOptions.Range.Value().Length.Value())
+    auto downloadChunkFunc = [&](int64_t offset,
+                                 int64_t length,
+                                 int64_t chunkId,
+                                 int64_t numChunks,
+                                 const Azure::Core::Context& chunkContext) {
+      DownloadBlobOptions chunkOptions;
+      chunkOptions.Range = Core::Http::HttpRange();
+      chunkOptions.Range.Value().Offset = offset;
+      chunkOptions.Range.Value().Length = length;
+      chunkOptions.RangeHashAlgorithm = chunkHashAlgorithm;
+      chunkOptions.AccessConditions.IfMatch = eTag;
+      auto chunk = Download(chunkOptions, chunkContext);
+      _internal::ReadAndVerifyContentHash(
+          *chunk.Value.BodyStream,
+          chunkHashAlgorithm,
+          chunk.Value.TransactionalContentHash,
+          "Download",
+          [&](Azure::Core::IO::BodyStream& stream) {
+            int64_t bytesRead = stream.ReadToCount(
+                buffer + (offset - firstChunkOffset), static_cast<size_t>(length), chunkContext);
+            if (bytesRead != length)
             {
               throw Azure::Core::RequestFailedException("Error when reading body stream.");
             }
+          });
 
-            if (chunkId == numChunks - 1)
-            {
-              ret = returnTypeConverter(chunk);
-              ret.Value.TransactionalContentHash.Reset();
-            }
-          };
+      if (chunkId == numChunks - 1)
+      {
+        ret = returnTypeConverter(chunk);
+        ret.Value.TransactionalContentHash.Reset();
+      }
+    };
 
     int64_t remainingOffset = firstChunkOffset + firstChunkLength;
     int64_t remainingSize = blobRangeSize - firstChunkLength;
@@ -413,8 +462,11 @@ namespace Azure { namespace Storage { namespace Blobs {
     _internal::ConcurrentTransfer(
         remainingOffset,
         remainingSize,
-        options.TransferOptions.ChunkSize,
+        chunkSize,
+        maxChunkSize,
         options.TransferOptions.Concurrency,
+        options.TransferOptions.Adaptive,
+        context,
         downloadChunkFunc);
     ret.Value.ContentRange.Offset = firstChunkOffset;
     ret.Value.ContentRange.Length = blobRangeSize;
@@ -431,6 +483,16 @@ namespace Azure { namespace Storage { namespace Blobs {
     // keep downloading it in chunks.
     const int64_t firstChunkOffset = options.Range.HasValue() ? options.Range.Value().Offset : 0;
     int64_t firstChunkLength = options.TransferOptions.InitialChunkSize;
+    int64_t chunkSize = options.TransferOptions.ChunkSize;
+    int64_t maxChunkSize = (std::numeric_limits<int64_t>::max)();
+    Azure::Nullable<HashAlgorithm> chunkHashAlgorithm;
+    if (options.ValidateContentHash)
+    {
+      firstChunkLength = (std::min)(firstChunkLength, _internal::MaxHashedRangeSize);
+      chunkSize = (std::min)(chunkSize, _internal::MaxHashedRangeSize);
+      maxChunkSize = _internal::MaxHashedRangeSize;
+      chunkHashAlgorithm = HashAlgorithm::Crc64;
+    }
     if (options.Range.HasValue() && options.Range.Value().Length.HasValue())
     {
       firstChunkLength = (std::min)(firstChunkLength, options.Range.Value().Length.Value());
@@ -438,12 +500,34 @@ namespace Azure { namespace Storage { namespace Blobs {
 
     DownloadBlobOptions firstChunkOptions;
     firstChunkOptions.Range = options.Range;
+    if (options.ValidateContentHash && !firstChunkOptions.Range.HasValue())
+    {
+      // The service only returns the hash of a range.
+      firstChunkOptions.Range = Core::Http::HttpRange();
+    }
     if (firstChunkOptions.Range.HasValue())
     {
       firstChunkOptions.Range.Value().Length = firstChunkLength;
     }
+    firstChunkOptions.RangeHashAlgorithm = chunkHashAlgorithm;
 
-    auto firstChunk = Download(firstChunkOptions, context);
+    auto firstChunk = [&]() {
+      try
+      {
+        return Download(firstChunkOptions, context);
+      }
+      catch (StorageException& e)
+      {
+        if (!options.ValidateContentHash || options.Range.HasValue()
+            || e.StatusCode != Azure::Core::Http::HttpStatusCode::RangeNotSatisfiable)
+        {
+          throw;
+        }
+      }
+      // The blob is empty, so there's no range to request the hash of.
+      firstChunkOptions = DownloadBlobOptions();
+      return Download(firstChunkOptions, context);
+    }();
     const Azure::ETag eTag = firstChunk.Value.Details.ETag;
 
     const int64_t blobSize = firstChunk.Value.BlobSize;
@@ -462,29 +546,55 @@ namespace Azure { namespace Storage { namespace Blobs {
     }
     firstChunkLength = (std::min)(firstChunkLength, blobRangeSize);
 
-    auto bodyStreamToFile = [](Azure::Core::IO::BodyStream& stream,
-                               _internal::FileWriter& fileWriter,
-                               int64_t offset,
-                               int64_t length,
-                               const Azure::Core::Context& context) {
-      constexpr size_t bufferSize = 4 * 1024 * 1024;
-      std::vector<uint8_t> buffer(bufferSize);
-      while (length > 0)
+    std::unique_ptr<_internal::TransferJournal> journal;
+    if (options.JournalPath.HasValue())
+    {
+      // The query is left out, so that the SAS token isn't written to the journal.
+      const std::string journalKey = "DownloadTo\n" + m_blobUrl.GetScheme() + "://"
+          + m_blobUrl.GetHost() + "/" + m_blobUrl.GetPath() + "\n" + eTag.ToString() + "\n"
+          + fileName + "\n" + std::to_string(firstChunkOffset) + "\n"
+          + std::to_string(blobRangeSize) + "\n" + std::to_string(firstChunkLength) + "\n"
+          + std::to_string(chunkSize);
+      const int64_t numChunks = (blobRangeSize - firstChunkLength + chunkSize - 1) / chunkSize;
+      journal = std::make_unique<_internal::TransferJournal>(
+          options.JournalPath.Value(), journalKey, numChunks);
+      if (journal->IsResumed())
       {
-        size_t readSize = static_cast<size_t>(std::min<int64_t>(bufferSize, length));
-        size_t bytesRead = stream.ReadToCount(buffer.data(), readSize, context);
-        if (bytesRead != readSize)
+        bool isFileIntact = false;
+        try
+        {
+          _internal::FileReader existingFile(fileName);
+          isFileIntact = existingFile.GetFileSize() == blobRangeSize;
+        }
+        catch (std::runtime_error&)
         {
-          throw Azure::Core::RequestFailedException("Error when reading body stream.");
         }
-        fileWriter.Write(buffer.data(), bytesRead, offset);
-        length -= bytesRead;
-        offset += bytesRead;
+        if (!isFileIntact)
+        {
+          // The ranges written by the previous attempt are gone.
+          journal->Remove();
+          journal = std::make_unique<_internal::TransferJournal>(
+              options.JournalPath.Value(), journalKey, numChunks);
+        }
       }
-    };
+    }
 
-    _internal::FileWriter fileWriter(fileName);
-    bodyStreamToFile(*(firstChunk.Value.BodyStream), fileWriter, 0, firstChunkLength, context);
+    // With a journal, the size of the file is set up front, so that a resumed download can tell
+    // whether the file is still the one written by the previous attempt.
+    _internal::FileWriter fileWriter(
+        fileName,
+        !(journal && journal->IsResumed()),
+        options.TransferOptions.FileIoMode,
+        blobRangeSize,
+        journal != nullptr);
+    _internal::ReadAndVerifyContentHash(
+        *firstChunk.Value.BodyStream,
+        firstChunkOptions.RangeHashAlgorithm,
+        firstChunk.Value.TransactionalContentHash,
+        "Download",
+        [&](Azure::Core::IO::BodyStream& stream) {
+          fileWriter.WriteFromStream(stream, 0, firstChunkLength, context);
+        });
     firstChunk.Value.BodyStream.reset();
 
     auto returnTypeConverter = [](Azure::Response<Models::DownloadBlobResult>& response) {
@@ -500,37 +610,63 @@ namespace Azure { namespace Storage { namespace Blobs {
     auto ret = returnTypeConverter(firstChunk);
 
     // Keep downloading the remaining in parallel
-    auto downloadChunkFunc
-        = [&](int64_t offset, int64_t length, int64_t chunkId, int64_t numChunks) {
-            DownloadBlobOptions chunkOptions;
-            chunkOptions.Range = Core::Http::HttpRange();
-            chunkOptions.Range.Value().Offset = offset;
-            chunkOptions.Range.Value().Length = length;
-            chunkOptions.AccessConditions.IfMatch = eTag;
-            auto chunk = Download(chunkOptions, context);
-            bodyStreamToFile(
-                *(chunk.Value.BodyStream),
-                fileWriter,
-                offset - firstChunkOffset,
-                chunkOptions.Range.Value().Length.Value(),
-                context);
-
-            if (chunkId == numChunks - 1)
-            {
-              ret = returnTypeConverter(chunk);
-              ret.Value.TransactionalContentHash.Reset();
-            }
-          };
+    auto downloadChunkFunc = [&](int64_t offset,
+                                 int64_t length,
+                                 int64_t chunkId,
+                                 int64_t numChunks,
+                                 const Azure::Core::Context& chunkContext) {
+      if (journal && journal->IsChunkDone(chunkId))
+      {
+        return;
+      }
+      DownloadBlobOptions chunkOptions;
+      chunkOptions.Range = Core::Http::HttpRange();
+      chunkOptions.Range.Value().Offset = offset;
+      chunkOptions.Range.Value().Length = length;
+      chunkOptions.RangeHashAlgorithm = chunkHashAlgorithm;
+      chunkOptions.AccessConditions.IfMatch = eTag;
+      auto chunk = Download(chunkOptions, chunkContext);
+      _internal::ReadAndVerifyContentHash(
+          *chunk.Value.BodyStream,
+          chunkHashAlgorithm,
+          chunk.Value.TransactionalContentHash,
+          "Download",
+          [&](Azure::Core::IO::BodyStream& stream) {
+            fileWriter.WriteFromStream(stream, offset - firstChunkOffset, length, chunkContext);
+          });
+      if (journal)
+      {
+        journal->SetChunkDone(chunkId);
+      }
+
+      if (chunkId == numChunks - 1)
+      {
+        ret = returnTypeConverter(chunk);
+        ret.Value.TransactionalContentHash.Reset();
+      }
+    };
 
     int64_t remainingOffset = firstChunkOffset + firstChunkLength;
     int64_t remainingSize = blobRangeSize - firstChunkLength;
+    // The hash of the first chunk isn't the hash of the range, whichever chunk is downloaded last.
+    if (remainingSize > 0)
+    {
+      ret.Value.TransactionalContentHash.Reset();
+    }
 
     _internal::ConcurrentTransfer(
         remainingOffset,
         remainingSize,
-        options.TransferOptions.ChunkSize,
+        chunkSize,
+        maxChunkSize,
         options.TransferOptions.Concurrency,
+        options.TransferOptions.Adaptive && !journal,
+        context,
         downloadChunkFunc);
+    if (journal)
+    {
+      journal->Remove();
+    }
     ret.Value.ContentRange.Offset = firstChunkOffset;
     ret.Value.ContentRange.Length = blobRangeSize;
     return ret;
@@ -11,7 +11,9 @@
 
 #include <azure/core/http/policies/policy.hpp>
 #include <azure/storage/common/crypt.hpp>
+#include <azure/storage/common/internal/bulk_transfer.hpp>
 #include <azure/storage/common/internal/constants.hpp>
+#include <azure/storage/common/internal/file_io.hpp>
 #include <azure/storage/common/internal/shared_key_policy.hpp>
 #include <azure/storage/common/internal/storage_bearer_token_auth.hpp>
 #include <azure/storage/common/internal/storage_per_retry_policy.hpp>
@@ -20,6 +22,10 @@
 #include <azure/storage/common/storage_common.hpp>
 #include <azure/storage/common/storage_exception.hpp>
 
+#include <limits>
+#include <map>
+#include <vector>
+
 namespace Azure { namespace Storage { namespace Blobs {
 
   namespace {
@@ -101,6 +107,16 @@ namespace Azure { namespace Storage { namespace Blobs {
       }
       return blobItem;
     }
+
+    // A '/' is appended to a non-empty prefix, so that it names a virtual directory.
+    std::string BulkTransferPrefix(const std::string& blobPrefix)
+    {
+      if (blobPrefix.empty() || blobPrefix.back() == '/')
+      {
+        return blobPrefix;
+      }
+      return blobPrefix + '/';
+    }
   } // namespace
 
   BlobContainerClient BlobContainerClient::CreateFromConnectionString(
@@ -468,6 +484,189 @@ namespace Azure { namespace Storage { namespace Blobs {
         std::move(blockBlobClient), std::move(response.RawResponse));
   }
 
+  BulkTransferResult BlobContainerClient::UploadDirectory(
+      const std::string& directoryPath,
+      const std::string& blobPrefix,
+      const UploadBlobDirectoryOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    constexpr int64_t MaxStageBlockSize = 4000 * 1024 * 1024ULL;
+    constexpr int64_t MaxBlockNumber = 50000;
+
+    if (options.TransferOptions.ChunkSize > MaxStageBlockSize)
+    {
+      throw Azure::Core::RequestFailedException("Block size is too big.");
+    }
+
+    const std::string prefix = BulkTransferPrefix(blobPrefix);
+    std::vector<_internal::BulkTransferItem> items;
+    for (auto& file : _internal::ListFilesRecursively(directoryPath))
+    {
+      _internal::BulkTransferItem item;
+      item.Path = std::move(file.Path);
+      item.Size = file.Size;
+      items.push_back(std::move(item));
+    }
+
+    auto getBlockId = [](int64_t id) {
+      constexpr size_t BlockIdLength = 64;
+      std::string blockId = std::to_string(id);
+      blockId = std::string(BlockIdLength - blockId.length(), '0') + blockId;
+      return Azure::Core::Convert::Base64Encode(
+          std::vector<uint8_t>(blockId.begin(), blockId.end()));
+    };
+
+    _internal::BulkTransferOperations operations;
+    operations.TransferFile
+        = [&](const _internal::BulkTransferItem& item, const Azure::Core::Context& fileContext) {
+            Azure::Core::IO::FileBodyStream contentStream(directoryPath + '/' + item.Path);
+            UploadBlockBlobOptions uploadOptions;
+            uploadOptions.AccessTier = options.AccessTier;
+            GetBlockBlobClient(prefix + item.Path)
+                .Upload(contentStream, uploadOptions, fileContext);
+          };
+    operations.TransferChunk = [&](const _internal::BulkTransferItem& item,
+                                   int64_t offset,
+                                   int64_t length,
+                                   int64_t chunkId,
+                                   const Azure::Core::Context& chunkContext) {
+      _internal::FileReader fileReader(directoryPath + '/' + item.Path);
+      Azure::Core::IO::_internal::RandomAccessFileBodyStream contentStream(
+          fileReader.GetHandle(), offset, length);
+      GetBlockBlobClient(prefix + item.Path)
+          .StageBlock(getBlockId(chunkId), contentStream, StageBlockOptions(), chunkContext);
+    };
+    operations.CommitChunks = [&](const _internal::BulkTransferItem& item,
+                                  int64_t numChunks,
+                                  const Azure::Core::Context& fileContext) {
+      std::vector<std::string> blockIds;
+      blockIds.reserve(static_cast<size_t>(numChunks));
+      for (int64_t i = 0; i < numChunks; ++i)
+      {
+        blockIds.push_back(getBlockId(i));
+      }
+      CommitBlockListOptions commitBlockListOptions;
+      commitBlockListOptions.AccessTier = options.AccessTier;
+      GetBlockBlobClient(prefix + item.Path)
+          .CommitBlockList(blockIds, commitBlockListOptions, fileContext);
+    };
+
+    _internal::BulkTransferOptions transferOptions;
+    transferOptions.Concurrency = options.TransferOptions.Concurrency;
+    transferOptions.MaxBytesInFlight = options.TransferOptions.MaxBytesInFlight;
+    transferOptions.SingleTransferThreshold = options.TransferOptions.SingleUploadThreshold;
+    transferOptions.ChunkSize = options.TransferOptions.ChunkSize;
+    transferOptions.MaxChunkCount = MaxBlockNumber;
+    transferOptions.ProgressHandler = options.ProgressHandler;
+    return _internal::BulkTransfer(items, transferOptions, operations, context);
+  }
+
+  BulkTransferResult BlobContainerClient::DownloadDirectory(
+      const std::string& blobPrefix,
+      const std::string& directoryPath,
+      const DownloadBlobDirectoryOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    const std::string prefix = BulkTransferPrefix(blobPrefix);
+    std::vector<_internal::BulkTransferItem> items;
+    std::map<std::string, std::string> invalidBlobs;
+    ListBlobsOptions listBlobsOptions;
+    if (!prefix.empty())
+    {
+      listBlobsOptions.Prefix = prefix;
+    }
+    for (auto page = ListBlobs(listBlobsOptions, context); page.HasPage();
+         page.MoveToNextPage(context))
+    {
+      for (auto& blob : page.Blobs)
+      {
+        // Blobs whose names end with '/' mark directories.
+        if (blob.Name.back() == '/')
+        {
+          continue;
+        }
+        _internal::BulkTransferItem item;
+        item.Path = blob.Name.substr(prefix.length());
+        if (!_internal::IsValidRelativePath(item.Path))
+        {
+          invalidBlobs[item.Path] = "The blob name cannot be mapped to a local file.";
+          continue;
+        }
+        item.Size = blob.BlobSize;
+        item.ETag = std::move(blob.Details.ETag);
+        items.push_back(std::move(item));
+      }
+    }
+    _internal::CreateDirectories(directoryPath);
+
+    auto createParentDirectories = [&](const _internal::BulkTransferItem& item) {
+      const size_t pos = item.Path.rfind('/');
+      if (pos != std::string::npos)
+      {
+        _internal::CreateDirectories(directoryPath + '/' + item.Path.substr(0, pos));
+      }
+    };
+    auto downloadToFile = [&](const _internal::BulkTransferItem& item,
+                              Azure::Nullable<Core::Http::HttpRange> range,
+                              _internal::FileWriter& fileWriter,
+                              const Azure::Core::Context& downloadContext) {
+      DownloadBlobOptions downloadOptions;
+      downloadOptions.Range = std::move(range);
+      downloadOptions.AccessConditions.IfMatch = item.ETag;
+      auto response = GetBlobClient(prefix + item.Path).Download(downloadOptions, downloadContext);
+      int64_t offset = downloadOptions.Range.HasValue() ? downloadOptions.Range.Value().Offset : 0;
+      constexpr int64_t BufferSize = 4 * 1024 * 1024;
+      std::vector<uint8_t> buffer(
+          static_cast<size_t>((std::max<int64_t>)((std::min)(BufferSize, item.Size), 1)));
+      while (true)
+      {
+        const size_t bytesRead
+            = response.Value.BodyStream->Read(buffer.data(), buffer.size(), downloadContext);
+        if (bytesRead == 0)
+        {
+          break;
+        }
+        fileWriter.Write(buffer.data(), bytesRead, offset);
+        offset += bytesRead;
+      }
+    };
+
+    _internal::BulkTransferOperations operations;
+    operations.TransferFile
+        = [&](const _internal::BulkTransferItem& item, const Azure::Core::Context& fileContext) {
+            createParentDirectories(item);
+            _internal::FileWriter fileWriter(directoryPath + '/' + item.Path);
+            downloadToFile(item, Azure::Nullable<Core::Http::HttpRange>(), fileWriter, fileContext);
+          };
+    operations.PrepareChunks
+        = [&](const _internal::BulkTransferItem& item, const Azure::Core::Context&) {
+            createParentDirectories(item);
+            _internal::FileWriter fileWriter(directoryPath + '/' + item.Path);
+          };
+    operations.TransferChunk = [&](const _internal::BulkTransferItem& item,
+                                   int64_t offset,
+                                   int64_t length,
+                                   int64_t,
+                                   const Azure::Core::Context& chunkContext) {
+      _internal::FileWriter fileWriter(directoryPath + '/' + item.Path, false);
+      Core::Http::HttpRange range;
+      range.Offset = offset;
+      range.Length = length;
+      downloadToFile(item, range, fileWriter, chunkContext);
+    };
+
+    _internal::BulkTransferOptions transferOptions;
+    transferOptions.Concurrency = options.TransferOptions.Concurrency;
+    transferOptions.MaxBytesInFlight = options.TransferOptions.MaxBytesInFlight;
+    transferOptions.SingleTransferThreshold = options.TransferOptions.SingleDownloadThreshold;
+    transferOptions.ChunkSize = options.TransferOptions.ChunkSize;
+    transferOptions.MaxChunkCount = std::numeric_limits<int64_t>::max();
+    transferOptions.ProgressHandler = options.ProgressHandler;
+    auto result = _internal::BulkTransfer(items, transferOptions, operations, context);
+    result.FailedFiles.insert(invalidBlobs.begin(), invalidBlobs.end());
+    return result;
+  }
+
   FindBlobsByTagsPagedResponse BlobContainerClient::FindBlobsByTags(
       const std::string& tagFilterSqlExpression,
       const FindBlobsByTagsOptions& options,
@@ -517,6 +716,24 @@ namespace Azure { namespace Storage { namespace Blobs {
         Models::SubmitBlobBatchResult(), std::move(response.RawResponse));
   }
 
+  Models::SubmitBulkBlobBatchResult BlobContainerClient::SubmitBulkBatch(
+      const BlobContainerBatch& batch,
+      const SubmitBulkBlobBatchOptions& options,
+      const Core::Context& context) const
+  {
+    return _detail::SubmitBulkBatch(
+        batch.m_subrequests,
+        [this](
+            std::vector<std::shared_ptr<_detail::BatchSubrequest>> subrequests,
+            const Core::Context& batchContext) {
+          BlobContainerBatch subBatch(*this);
+          subBatch.m_subrequests = std::move(subrequests);
+          SubmitBatch(subBatch, SubmitBlobBatchOptions(), batchContext);
+        },
+        options,
+        context);
+  }
+
   Azure::Response<Models::AccountInfo> BlobContainerClient::GetAccountInfo(
       const GetAccountInfoOptions& options,
       const Azure::Core::Context& context) const
@@ -334,4 +334,22 @@ namespace Azure { namespace Storage { namespace Blobs {
         Models::SubmitBlobBatchResult(), std::move(response.RawResponse));
   }
 
+  Models::SubmitBulkBlobBatchResult BlobServiceClient::SubmitBulkBatch(
+      const BlobServiceBatch& batch,
+      const SubmitBulkBlobBatchOptions& options,
+      const Core::Context& context) const
+  {
+    return _detail::SubmitBulkBatch(
+        batch.m_subrequests,
+        [this](
+            std::vector<std::shared_ptr<_detail::BatchSubrequest>> subrequests,
+            const Core::Context& batchContext) {
+          BlobServiceBatch subBatch(*this);
+          subBatch.m_subrequests = std::move(subrequests);
+          SubmitBatch(subBatch, SubmitBlobBatchOptions(), batchContext);
+        },
+        options,
+        context);
+  }
+
 }}} // namespace Azure::Storage::Blobs
@@ -22,6 +22,7 @@
 #include <azure/storage/common/internal/concurrent_transfer.hpp>
 #include <azure/storage/common/internal/constants.hpp>
 #include <azure/storage/common/internal/file_io.hpp>
+#include <azure/storage/common/internal/hashing_body_stream.hpp>
 #include <azure/storage/common/internal/storage_switch_to_secondary_policy.hpp>
 #include <azure/storage/common/storage_common.hpp>
 #include <azure/storage/common/storage_exception.hpp>
@@ -199,10 +200,14 @@ namespace Azure { namespace Storage { namespace Blobs {
           std::vector<uint8_t>(blockId.begin(), blockId.end()));
     };
 
-    auto uploadBlockFunc = [&](int64_t offset, int64_t length, int64_t chunkId, int64_t numChunks) {
+    auto uploadBlockFunc = [&](int64_t offset,
+                               int64_t length,
+                               int64_t chunkId,
+                               int64_t numChunks,
+                               const Azure::Core::Context& chunkContext) {
       Azure::Core::IO::MemoryBodyStream contentStream(buffer + offset, static_cast<size_t>(length));
       StageBlockOptions chunkOptions;
-      auto blockInfo = StageBlock(getBlockId(chunkId), contentStream, chunkOptions, context);
+      auto blockInfo = StageBlock(getBlockId(chunkId), contentStream, chunkOptions, chunkContext);
       if (chunkId == numChunks - 1)
       {
         blockIds.resize(static_cast<size_t>(numChunks));
@@ -210,7 +215,14 @@ namespace Azure { namespace Storage { namespace Blobs {
     };
 
     _internal::ConcurrentTransfer(
-        0, bufferSize, chunkSize, options.TransferOptions.Concurrency, uploadBlockFunc);
+        0,
+        bufferSize,
+        chunkSize,
+        MaxStageBlockSize,
+        options.TransferOptions.Concurrency,
+        options.TransferOptions.Adaptive,
+        context,
+        uploadBlockFunc);
 
     for (size_t i = 0; i < blockIds.size(); ++i)
     {
@@ -271,17 +283,29 @@ namespace Azure { namespace Storage { namespace Blobs {
           std::vector<uint8_t>(blockId.begin(), blockId.end()));
     };
 
-    _internal::FileReader fileReader(fileName);
+    _internal::FileReader fileReader(fileName, options.TransferOptions.FileIoMode);
+    std::unique_ptr<_internal::TransferJournal> journal;
 
-    auto uploadBlockFunc = [&](int64_t offset, int64_t length, int64_t chunkId, int64_t numChunks) {
-      Azure::Core::IO::_internal::RandomAccessFileBodyStream contentStream(
-          fileReader.GetHandle(), offset, length);
-      StageBlockOptions chunkOptions;
-      auto blockInfo = StageBlock(getBlockId(chunkId), contentStream, chunkOptions, context);
+    auto uploadBlockFunc = [&](int64_t offset,
+                               int64_t length,
+                               int64_t chunkId,
+                               int64_t numChunks,
+                               const Azure::Core::Context& chunkContext) {
       if (chunkId == numChunks - 1)
       {
         blockIds.resize(static_cast<size_t>(numChunks));
       }
+      if (journal && journal->IsChunkDone(chunkId))
+      {
+        return;
+      }
+      auto contentStream = fileReader.GetRangeStream(offset, length);
+      StageBlockOptions chunkOptions;
+      auto blockInfo = StageBlock(getBlockId(chunkId), *contentStream, chunkOptions, chunkContext);
+      if (journal)
+      {
+        journal->SetChunkDone(chunkId);
+      }
     };
 
     int64_t chunkSize;
@@ -300,11 +324,27 @@ namespace Azure { namespace Storage { namespace Blobs {
       throw Azure::Core::RequestFailedException("Block size is too big.");
     }
 
+    if (options.JournalPath.HasValue())
+    {
+      // The query is left out, so that the SAS token isn't written to the journal.
+      const std::string journalKey = "UploadFrom\n" + fileName + "\n"
+          + std::to_string(fileReader.GetFileSize()) + "\n"
+          + std::to_string(fileReader.GetLastWriteTime()) + "\n" + m_blobUrl.GetScheme() + "://"
+          + m_blobUrl.GetHost() + "/" + m_blobUrl.GetPath() + "\n" + std::to_string(chunkSize);
+      journal = std::make_unique<_internal::TransferJournal>(
+          options.JournalPath.Value(),
+          journalKey,
+          (fileReader.GetFileSize() + chunkSize - 1) / chunkSize);
+    }
+
     _internal::ConcurrentTransfer(
         0,
         fileReader.GetFileSize(),
         chunkSize,
+        MaxStageBlockSize,
         options.TransferOptions.Concurrency,
+        options.TransferOptions.Adaptive && !journal,
+        context,
         uploadBlockFunc);
 
     for (size_t i = 0; i < blockIds.size(); ++i)
@@ -318,7 +358,26 @@ namespace Azure { namespace Storage { namespace Blobs {
     commitBlockListOptions.AccessTier = options.AccessTier;
     commitBlockListOptions.ImmutabilityPolicy = options.ImmutabilityPolicy;
     commitBlockListOptions.HasLegalHold = options.HasLegalHold;
-    auto commitBlockListResponse = CommitBlockList(blockIds, commitBlockListOptions, context);
+    auto commitBlockListResponse = [&]() {
+      try
+      {
+        return CommitBlockList(blockIds, commitBlockListOptions, context);
+      }
+      catch (StorageException& e)
+      {
+        // The staged blocks were discarded, e.g. because they expired or another list of blocks
+        // was committed, so the next attempt must start over.
+        if (journal && e.ErrorCode == "InvalidBlockList")
+        {
+          journal->Remove();
+        }
+        throw;
+      }
+    }();
+    if (journal)
+    {
+      journal->Remove();
+    }
 
     Models::UploadBlockBlobFromResult result;
     result.ETag = commitBlockListResponse.Value.ETag;
@@ -417,6 +476,16 @@ namespace Azure { namespace Storage { namespace Blobs {
       protocolLayerOptions.EncryptionAlgorithm = m_customerProvidedKey.Value().Algorithm.ToString();
     }
     protocolLayerOptions.EncryptionScope = m_encryptionScope;
+    if (options.ValidateContentHash && !options.TransactionalContentHash.HasValue())
+    {
+      // The service always returns the CRC64 of the block it received.
+      _internal::HashingBodyStream hashingStream(content, HashAlgorithm::Crc64);
+      auto response = _detail::BlockBlobClient::StageBlock(
+          *m_pipeline, m_blobUrl, hashingStream, protocolLayerOptions, context);
+      _internal::VerifyContentHash(
+          hashingStream.GetHash(), response.Value.TransactionalContentHash, "StageBlock");
+      return response;
+    }
     return _detail::BlockBlobClient::StageBlock(
         *m_pipeline, m_blobUrl, content, protocolLayerOptions, context);
   }
@@ -11,8 +11,180 @@
 #include <azure/storage/common/storage_common.hpp>
 #include <azure/storage/common/storage_exception.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
 namespace Azure { namespace Storage { namespace Blobs {
 
+  namespace {
+    constexpr int64_t PageSize = 512;
+    constexpr int64_t MaxUploadPagesSize = 4 * 1024 * 1024;
+
+    // Checked a word at a time, which compilers vectorize.
+    bool IsZeroPage(const uint8_t* page)
+    {
+      uint64_t bits = 0;
+      for (int64_t i = 0; i < PageSize; i += sizeof(uint64_t))
+      {
+        uint64_t word;
+        std::memcpy(&word, page + i, sizeof(word));
+        bits |= word;
+      }
+      return bits == 0;
+    }
+
+    // Uploads the runs of pages of a chunk that don't contain only zeros, which read as zeros in a
+    // new page blob anyway. Returns the number of bytes uploaded.
+    int64_t UploadNonZeroPages(
+        const PageBlobClient& client,
+        const uint8_t* data,
+        int64_t offset,
+        int64_t length,
+        const Azure::Core::Context& context)
+    {
+      int64_t uploadedBytes = 0;
+      int64_t runOffset = 0;
+      for (int64_t pageOffset = 0; pageOffset <= length; pageOffset += PageSize)
+      {
+        if (pageOffset < length && !IsZeroPage(data + pageOffset))
+        {
+          continue;
+        }
+        if (pageOffset > runOffset)
+        {
+          Azure::Core::IO::MemoryBodyStream contentStream(
+              data + runOffset, static_cast<size_t>(pageOffset - runOffset));
+          client.UploadPages(offset + runOffset, contentStream, UploadPagesOptions(), context);
+          uploadedBytes += pageOffset - runOffset;
+        }
+        runOffset = pageOffset + PageSize;
+      }
+      return uploadedBytes;
+    }
+
+    // Splits page ranges into chunks of at most chunkSize bytes, returned as offset and length.
+    std::vector<std::pair<int64_t, int64_t>> SplitPageRanges(
+        const std::vector<Core::Http::HttpRange>& ranges,
+        int64_t chunkSize,
+        int64_t blobSize)
+    {
+      if (chunkSize <= 0)
+      {
+        throw Azure::Core::RequestFailedException("Chunk size must be positive.");
+      }
+      std::vector<std::pair<int64_t, int64_t>> chunks;
+      for (const auto& range : ranges)
+      {
+        const int64_t rangeEnd = (std::min)(range.Offset + range.Length.Value(), blobSize);
+        int64_t offset = range.Offset;
+        while (offset < rangeEnd)
+        {
+          const int64_t length = (std::min)(chunkSize, rangeEnd - offset);
+          chunks.emplace_back(offset, length);
+          offset += length;
+        }
+      }
+      return chunks;
+    }
+
+    struct PageRangesDiff final
+    {
+      Azure::ETag ETag;
+      Azure::DateTime LastModified;
+      int64_t BlobSize = 0;
+      std::vector<Core::Http::HttpRange> PageRanges;
+      std::vector<Core::Http::HttpRange> ClearRanges;
+      std::unique_ptr<Azure::Core::Http::RawResponse> RawResponse;
+    };
+
+    // Lists all the pages of the diff, from the same version of the blob.
+    PageRangesDiff ListPageRangesDiff(
+        const PageBlobClient& client,
+        const std::string& previousSnapshot,
+        const Azure::Core::Context& context)
+    {
+      PageRangesDiff diff;
+      GetPageRangesOptions getPageRangesOptions;
+      do
+      {
+        auto pageResult = client.GetPageRangesDiff(previousSnapshot, getPageRangesOptions, context);
+        if (!diff.RawResponse)
+        {
+          diff.ETag = std::move(pageResult.ETag);
+          diff.LastModified = std::move(pageResult.LastModified);
+          diff.BlobSize = pageResult.BlobSize;
+          diff.RawResponse = std::move(pageResult.RawResponse);
+          getPageRangesOptions.AccessConditions.IfMatch = diff.ETag;
+        }
+        diff.PageRanges.insert(
+            diff.PageRanges.end(), pageResult.PageRanges.begin(), pageResult.PageRanges.end());
+        diff.ClearRanges.insert(
+            diff.ClearRanges.end(), pageResult.ClearRanges.begin(), pageResult.ClearRanges.end());
+        getPageRangesOptions.ContinuationToken = pageResult.NextPageToken;
+      } while (getPageRangesOptions.ContinuationToken.HasValue()
+               && !getPageRangesOptions.ContinuationToken.Value().empty());
+      return diff;
+    }
+
+    // getChunk returns the content of a range, given its offset, length and a buffer it may use.
+    template <class GetChunkFunc>
+    Azure::Response<Models::UploadPageBlobFromResult> UploadPageBlobFrom(
+        const PageBlobClient& client,
+        int64_t size,
+        const UploadPageBlobFromOptions& options,
+        const GetChunkFunc& getChunk,
+        const Azure::Core::Context& context)
+    {
+      if (size % PageSize != 0)
+      {
+        throw Azure::Core::RequestFailedException(
+            "The size of a page blob must be a multiple of 512 bytes.");
+      }
+      const int64_t chunkSize = options.TransferOptions.ChunkSize;
+      if (chunkSize <= 0 || chunkSize % PageSize != 0 || chunkSize > MaxUploadPagesSize)
+      {
+        throw Azure::Core::RequestFailedException(
+            "Chunk size must be a multiple of 512 bytes, up to 4 MiB.");
+      }
+
+      CreatePageBlobOptions createOptions;
+      createOptions.HttpHeaders = options.HttpHeaders;
+      createOptions.Metadata = options.Metadata;
+      createOptions.Tags = options.Tags;
+      createOptions.AccessTier = options.AccessTier;
+      client.Create(size, createOptions, context);
+
+      std::atomic<int64_t> uploadedBytes{0};
+      _internal::ConcurrentTransfer(
+          0,
+          size,
+          chunkSize,
+          options.TransferOptions.Concurrency,
+          [&](int64_t offset, int64_t length, int64_t, int64_t) {
+            std::vector<uint8_t> buffer;
+            const uint8_t* chunk = getChunk(offset, length, buffer);
+            uploadedBytes += UploadNonZeroPages(client, chunk, offset, length, context);
+          });
+
+      // The uploads complete in any order, so the state of the blob is read once they're done.
+      auto propertiesResponse = client.GetProperties(GetBlobPropertiesOptions(), context);
+      Models::UploadPageBlobFromResult result;
+      result.ETag = std::move(propertiesResponse.Value.ETag);
+      result.LastModified = std::move(propertiesResponse.Value.LastModified);
+      result.IsServerEncrypted = propertiesResponse.Value.IsServerEncrypted;
+      result.EncryptionKeySha256 = std::move(propertiesResponse.Value.EncryptionKeySha256);
+      result.EncryptionScope = std::move(propertiesResponse.Value.EncryptionScope);
+      result.UploadedBytes = uploadedBytes;
+      return Azure::Response<Models::UploadPageBlobFromResult>(
+          std::move(result), std::move(propertiesResponse.RawResponse));
+    }
+  } // namespace
+
   PageBlobClient PageBlobClient::CreateFromConnectionString(
       const std::string& connectionString,
       const std::string& blobContainerName,
@@ -457,4 +629,210 @@ namespace Azure { namespace Storage { namespace Blobs {
     return res;
   }
 
+  Azure::Response<Models::UploadPageBlobFromResult> PageBlobClient::UploadFrom(
+      const uint8_t* buffer,
+      size_t bufferSize,
+      const UploadPageBlobFromOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    return UploadPageBlobFrom(
+        *this,
+        static_cast<int64_t>(bufferSize),
+        options,
+        [buffer](int64_t offset, int64_t, std::vector<uint8_t>&) { return buffer + offset; },
+        context);
+  }
+
+  Azure::Response<Models::UploadPageBlobFromResult> PageBlobClient::UploadFrom(
+      const std::string& fileName,
+      const UploadPageBlobFromOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    _internal::FileReader fileReader(fileName, options.TransferOptions.FileIoMode);
+    return UploadPageBlobFrom(
+        *this,
+        fileReader.GetFileSize(),
+        options,
+        [&](int64_t offset, int64_t length, std::vector<uint8_t>& chunkBuffer) {
+          auto contentStream = fileReader.GetRangeStream(offset, length);
+          chunkBuffer.resize(static_cast<size_t>(length));
+          if (contentStream->ReadToCount(chunkBuffer.data(), chunkBuffer.size(), context)
+              != chunkBuffer.size())
+          {
+            throw Azure::Core::RequestFailedException("Error when reading body stream.");
+          }
+          return static_cast<const uint8_t*>(chunkBuffer.data());
+        },
+        context);
+  }
+
+  Azure::Response<Models::DownloadSparsePageBlobToResult> PageBlobClient::DownloadSparseTo(
+      const std::string& fileName,
+      const DownloadSparsePageBlobToOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    Models::DownloadSparsePageBlobToResult result;
+    std::unique_ptr<Azure::Core::Http::RawResponse> rawResponse;
+    std::vector<Core::Http::HttpRange> pageRanges;
+    GetPageRangesOptions getPageRangesOptions;
+    do
+    {
+      auto pageResult = GetPageRanges(getPageRangesOptions, context);
+      if (!rawResponse)
+      {
+        result.ETag = std::move(pageResult.ETag);
+        result.LastModified = std::move(pageResult.LastModified);
+        result.BlobSize = pageResult.BlobSize;
+        rawResponse = std::move(pageResult.RawResponse);
+        // The next pages must list the ranges of the same version of the blob.
+        getPageRangesOptions.AccessConditions.IfMatch = result.ETag;
+      }
+      pageRanges.insert(
+          pageRanges.end(), pageResult.PageRanges.begin(), pageResult.PageRanges.end());
+      getPageRangesOptions.ContinuationToken = pageResult.NextPageToken;
+    } while (getPageRangesOptions.ContinuationToken.HasValue()
+             && !getPageRangesOptions.ContinuationToken.Value().empty());
+
+    const auto chunks
+        = SplitPageRanges(pageRanges, options.TransferOptions.ChunkSize, result.BlobSize);
+
+    // The ranges that aren't downloaded are left as holes of the file.
+    _internal::FileWriter fileWriter(
+        fileName, true, options.TransferOptions.FileIoMode, result.BlobSize, true);
+    std::atomic<int64_t> downloadedBytes{0};
+    _internal::ConcurrentTransfer(
+        0,
+        static_cast<int64_t>(chunks.size()),
+        1,
+        options.TransferOptions.Concurrency,
+        [&](int64_t chunkId, int64_t, int64_t, int64_t) {
+          const auto& chunk = chunks[static_cast<size_t>(chunkId)];
+          DownloadBlobOptions chunkOptions;
+          chunkOptions.Range = Core::Http::HttpRange();
+          chunkOptions.Range.Value().Offset = chunk.first;
+          chunkOptions.Range.Value().Length = chunk.second;
+          chunkOptions.AccessConditions.IfMatch = result.ETag;
+          auto chunkResponse = Download(chunkOptions, context);
+          fileWriter.WriteFromStream(
+              *chunkResponse.Value.BodyStream, chunk.first, chunk.second, context);
+          downloadedBytes += chunk.second;
+        });
+    result.DownloadedBytes = downloadedBytes;
+    return Azure::Response<Models::DownloadSparsePageBlobToResult>(
+        std::move(result), std::move(rawResponse));
+  }
+
+  Azure::Response<Models::SyncPageBlobDiffResult> PageBlobClient::DownloadDiffTo(
+      const std::string& previousSnapshot,
+      const std::string& fileName,
+      const DownloadPageBlobDiffToOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    {
+      // Throws if the file doesn't exist, since the unchanged ranges are read from it.
+      _internal::FileReader previousFile(fileName);
+    }
+    auto diff = ListPageRangesDiff(*this, previousSnapshot, context);
+    const auto changedChunks
+        = SplitPageRanges(diff.PageRanges, options.TransferOptions.ChunkSize, diff.BlobSize);
+    const auto clearedChunks
+        = SplitPageRanges(diff.ClearRanges, options.TransferOptions.ChunkSize, diff.BlobSize);
+
+    _internal::FileWriter fileWriter(
+        fileName, false, options.TransferOptions.FileIoMode, diff.BlobSize, true);
+    const std::vector<uint8_t> zeros(
+        static_cast<size_t>((std::min)(options.TransferOptions.ChunkSize, diff.BlobSize)));
+    std::atomic<int64_t> changedBytes{0};
+    std::atomic<int64_t> clearedBytes{0};
+    _internal::ConcurrentTransfer(
+        0,
+        static_cast<int64_t>(changedChunks.size() + clearedChunks.size()),
+        1,
+        options.TransferOptions.Concurrency,
+        [&](int64_t chunkId, int64_t, int64_t, int64_t) {
+          if (static_cast<size_t>(chunkId) >= changedChunks.size())
+          {
+            const auto& chunk = clearedChunks[static_cast<size_t>(chunkId) - changedChunks.size()];
+            fileWriter.Write(zeros.data(), static_cast<size_t>(chunk.second), chunk.first);
+            clearedBytes += chunk.second;
+            return;
+          }
+          const auto& chunk = changedChunks[static_cast<size_t>(chunkId)];
+          DownloadBlobOptions chunkOptions;
+          chunkOptions.Range = Core::Http::HttpRange();
+          chunkOptions.Range.Value().Offset = chunk.first;
+          chunkOptions.Range.Value().Length = chunk.second;
+          chunkOptions.AccessConditions.IfMatch = diff.ETag;
+          auto chunkResponse = Download(chunkOptions, context);
+          fileWriter.WriteFromStream(
+              *chunkResponse.Value.BodyStream, chunk.first, chunk.second, context);
+          changedBytes += chunk.second;
+        });
+
+    Models::SyncPageBlobDiffResult result;
+    result.ETag = std::move(diff.ETag);
+    result.LastModified = std::move(diff.LastModified);
+    result.BlobSize = diff.BlobSize;
+    result.ChangedBytes = changedBytes;
+    result.ClearedBytes = clearedBytes;
+    return Azure::Response<Models::SyncPageBlobDiffResult>(
+        std::move(result), std::move(diff.RawResponse));
+  }
+
+  Azure::Response<Models::SyncPageBlobDiffResult> PageBlobClient::CopyDiffFrom(
+      const PageBlobClient& sourceClient,
+      const std::string& previousSnapshot,
+      const CopyPageBlobDiffFromOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    const int64_t chunkSize = options.TransferOptions.ChunkSize;
+    if (chunkSize <= 0 || chunkSize % PageSize != 0 || chunkSize > MaxUploadPagesSize)
+    {
+      throw Azure::Core::RequestFailedException(
+          "Chunk size must be a multiple of 512 bytes, up to 4 MiB.");
+    }
+
+    auto diff = ListPageRangesDiff(sourceClient, previousSnapshot, context);
+    const auto changedChunks = SplitPageRanges(diff.PageRanges, chunkSize, diff.BlobSize);
+    // The cleared ranges aren't limited in size.
+    const auto clearedChunks = SplitPageRanges(
+        diff.ClearRanges, (std::numeric_limits<int64_t>::max)(), diff.BlobSize);
+
+    Resize(diff.BlobSize, ResizePageBlobOptions(), context);
+
+    const std::string sourceUrl = sourceClient.GetUrl();
+    std::atomic<int64_t> changedBytes{0};
+    std::atomic<int64_t> clearedBytes{0};
+    _internal::ConcurrentTransfer(
+        0,
+        static_cast<int64_t>(changedChunks.size() + clearedChunks.size()),
+        1,
+        options.TransferOptions.Concurrency,
+        [&](int64_t chunkId, int64_t, int64_t, int64_t) {
+          if (static_cast<size_t>(chunkId) >= changedChunks.size())
+          {
+            const auto& chunk = clearedChunks[static_cast<size_t>(chunkId) - changedChunks.size()];
+            ClearPages({chunk.first, chunk.second}, ClearPagesOptions(), context);
+            clearedBytes += chunk.second;
+            return;
+          }
+          const auto& chunk = changedChunks[static_cast<size_t>(chunkId)];
+          UploadPagesFromUriOptions chunkOptions;
+          chunkOptions.SourceAccessConditions.IfMatch = diff.ETag;
+          chunkOptions.SourceAuthorization = options.SourceAuthorization;
+          UploadPagesFromUri(
+              chunk.first, sourceUrl, {chunk.first, chunk.second}, chunkOptions, context);
+          changedBytes += chunk.second;
+        });
+
+    Models::SyncPageBlobDiffResult result;
+    result.ETag = std::move(diff.ETag);
+    result.LastModified = std::move(diff.LastModified);
+    result.BlobSize = diff.BlobSize;
+    result.ChangedBytes = changedBytes;
+    result.ClearedBytes = clearedBytes;
+    return Azure::Response<Models::SyncPageBlobDiffResult>(
+        std::move(result), std::move(diff.RawResponse));
+  }
+
 }}} // namespace Azure::Storage::Blobs
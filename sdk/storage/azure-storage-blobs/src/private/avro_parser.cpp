@@ -184,6 +184,14 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     return AvailableBytes();
   }
 
+  const uint8_t* AvroStreamReader::ReadInPlace(size_t n, const Core::Context& context)
+  {
+    Preload(n, context);
+    const uint8_t* data = m_streambuffer.data() + m_pos.Offset;
+    m_pos.Offset += n;
+    return data;
+  }
+
   void AvroStreamReader::Discard()
   {
     constexpr size_t MinimumReleaseMemory = 128 * 1024;
@@ -556,47 +564,212 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     AZURE_UNREACHABLE_CODE();
   }
 
+  const uint8_t* AvroBufferReader::Advance(size_t n)
+  {
+    if (n > static_cast<size_t>(m_end - m_pos))
+    {
+      throw std::runtime_error("Unexpected end of Avro block.");
+    }
+    const uint8_t* data = m_pos;
+    m_pos += n;
+    return data;
+  }
+
+  int64_t AvroBufferReader::ReadLong()
+  {
+    uint64_t r = 0;
+    for (int nb = 0; nb < 10; ++nb)
+    {
+      if (m_pos == m_end)
+      {
+        break;
+      }
+      const uint8_t c = *m_pos++;
+      r = r | ((static_cast<uint64_t>(c) & 0x7f) << (nb * 7));
+      if (!(c & 0x80))
+      {
+        return static_cast<int64_t>(r >> 1) ^ -static_cast<int64_t>(r & 0x01);
+      }
+    }
+    throw std::runtime_error("Invalid Avro long.");
+  }
+
+  bool AvroBufferReader::ReadBool() { return *Advance(1) != 0; }
+
+  AvroDatum::StringView AvroBufferReader::ReadBytes()
+  {
+    const int64_t length = ReadLong();
+    if (length < 0)
+    {
+      throw std::runtime_error("Invalid Avro bytes length.");
+    }
+    const uint8_t* data = Advance(static_cast<size_t>(length));
+    return AvroDatum::StringView{data, static_cast<size_t>(length)};
+  }
+
+  void AvroBufferReader::Skip(const AvroSchema& schema)
+  {
+    switch (schema.Type())
+    {
+      case AvroDatumType::String:
+      case AvroDatumType::Bytes:
+        ReadBytes();
+        break;
+      case AvroDatumType::Int:
+      case AvroDatumType::Long:
+      case AvroDatumType::Enum:
+        ReadLong();
+        break;
+      case AvroDatumType::Float:
+        Advance(4);
+        break;
+      case AvroDatumType::Double:
+        Advance(8);
+        break;
+      case AvroDatumType::Bool:
+        Advance(1);
+        break;
+      case AvroDatumType::Null:
+        break;
+      case AvroDatumType::Record:
+        for (const auto& fieldSchema : schema.FieldSchemas())
+        {
+          Skip(fieldSchema);
+        }
+        break;
+      case AvroDatumType::Array:
+      case AvroDatumType::Map:
+        while (true)
+        {
+          int64_t numElementsInBlock = ReadLong();
+          if (numElementsInBlock == 0)
+          {
+            break;
+          }
+          if (numElementsInBlock < 0)
+          {
+            // The size of the block in bytes follows its negated number of elements.
+            const int64_t blockSize = ReadLong();
+            if (blockSize < 0)
+            {
+              throw std::runtime_error("Invalid Avro block size.");
+            }
+            Advance(static_cast<size_t>(blockSize));
+            continue;
+          }
+          for (int64_t i = 0; i < numElementsInBlock; ++i)
+          {
+            if (schema.Type() == AvroDatumType::Map)
+            {
+              ReadBytes();
+            }
+            Skip(schema.ItemSchema());
+          }
+        }
+        break;
+      case AvroDatumType::Union: {
+        const int64_t i = ReadLong();
+        if (i < 0 || static_cast<uint64_t>(i) >= schema.FieldSchemas().size())
+        {
+          throw std::runtime_error("Invalid Avro union index.");
+        }
+        Skip(schema.FieldSchemas()[static_cast<size_t>(i)]);
+        break;
+      }
+      case AvroDatumType::Fixed:
+        Advance(schema.Size());
+        break;
+    }
+  }
+
   AvroObjectContainerReader::AvroObjectContainerReader(Core::IO::BodyStream& stream)
       : m_reader(std::make_unique<AvroStreamReader>(stream))
   {
   }
 
+  namespace {
+    constexpr size_t SyncMarkerSize = 16;
+
+    const AvroSchema& SyncMarkerSchema()
+    {
+      static const auto Schema = AvroSchema::FixedSchema("Sync", SyncMarkerSize);
+      return Schema;
+    }
+  } // namespace
+
+  void AvroObjectContainerReader::ReadHeader(const Core::Context& context)
+  {
+    static AvroSchema FileHeaderSchema = []() {
+      std::vector<std::pair<std::string, AvroSchema>> fieldsSchema;
+      fieldsSchema.push_back(std::make_pair("magic", AvroSchema::FixedSchema("Magic", 4)));
+      fieldsSchema.push_back(
+          std::make_pair("meta", AvroSchema::MapSchema(AvroSchema::BytesSchema)));
+      fieldsSchema.push_back(std::make_pair("sync", SyncMarkerSchema()));
+      return AvroSchema::RecordSchema("org.apache.avro.file.Header", std::move(fieldsSchema));
+    }();
+    auto fileHeaderDatum = AvroDatum(FileHeaderSchema);
+    fileHeaderDatum.Fill(*m_reader, context);
+    auto fileHeader = fileHeaderDatum.Value<AvroRecord>();
+    if (fileHeader.Field("magic").Value<std::string>() != "Obj\01")
+    {
+      throw std::runtime_error("Invalid Avro object container magic.");
+    }
+    AvroMap meta = fileHeader.Field("meta").Value<AvroMap>();
+    std::string objectSchemaJson = meta["avro.schema"].Value<std::string>();
+    std::string codec = "null";
+    if (meta.count("avro.codec") != 0)
+    {
+      codec = meta["avro.codec"].Value<std::string>();
+    }
+    if (codec != "null")
+    {
+      throw std::runtime_error("Unsupported Avro codec: " + codec);
+    }
+    m_syncMarker = fileHeader.Field("sync").Value<std::string>();
+    m_objectSchema = std::make_unique<AvroSchema>(ParseSchemaFromJsonString(objectSchemaJson));
+  }
+
+  bool AvroObjectContainerReader::NextBlock(AvroBlock& block, const Core::Context& context)
+  {
+    AZURE_ASSERT(m_remainingObjectInCurrentBlock == 0);
+    if (!m_objectSchema)
+    {
+      ReadHeader(context);
+    }
+    m_reader->Discard();
+    // Checked before reading the block, so that the data of the block isn't moved afterwards.
+    if (m_eof || m_reader->TryPreload(1, context) == 0)
+    {
+      m_eof = true;
+      return false;
+    }
+    const int64_t objectCount = m_reader->ParseInt(context);
+    const int64_t blockSize = m_reader->ParseInt(context);
+    if (objectCount < 0 || blockSize < 0)
+    {
+      throw std::runtime_error("Invalid Avro block.");
+    }
+    // The block is read along with the sync marker that follows it.
+    const uint8_t* data
+        = m_reader->ReadInPlace(static_cast<size_t>(blockSize) + SyncMarkerSize, context);
+    if (std::memcmp(data + blockSize, m_syncMarker.data(), SyncMarkerSize) != 0)
+    {
+      throw std::runtime_error("Sync marker doesn't match.");
+    }
+    block.ObjectCount = objectCount;
+    block.Data = data;
+    block.Length = static_cast<size_t>(blockSize);
+    return true;
+  }
+
   AvroDatum AvroObjectContainerReader::NextImpl(
       const AvroSchema* schema,
       const Core::Context& context)
   {
     AZURE_ASSERT_FALSE(m_eof);
-    static const auto SyncMarkerSchema = AvroSchema::FixedSchema("Sync", 16);
     if (!schema)
     {
-      static AvroSchema FileHeaderSchema = []() {
-        std::vector<std::pair<std::string, AvroSchema>> fieldsSchema;
-        fieldsSchema.push_back(std::make_pair("magic", AvroSchema::FixedSchema("Magic", 4)));
-        fieldsSchema.push_back(
-            std::make_pair("meta", AvroSchema::MapSchema(AvroSchema::BytesSchema)));
-        fieldsSchema.push_back(std::make_pair("sync", SyncMarkerSchema));
-        return AvroSchema::RecordSchema("org.apache.avro.file.Header", std::move(fieldsSchema));
-      }();
-      auto fileHeaderDatum = AvroDatum(FileHeaderSchema);
-      fileHeaderDatum.Fill(*m_reader, context);
-      auto fileHeader = fileHeaderDatum.Value<AvroRecord>();
-      if (fileHeader.Field("magic").Value<std::string>() != "Obj\01")
-      {
-        throw std::runtime_error("Invalid Avro object container magic.");
-      }
-      AvroMap meta = fileHeader.Field("meta").Value<AvroMap>();
-      std::string objectSchemaJson = meta["avro.schema"].Value<std::string>();
-      std::string codec = "null";
-      if (meta.count("avro.codec") != 0)
-      {
-        codec = meta["avro.codec"].Value<std::string>();
-      }
-      if (codec != "null")
-      {
-        throw std::runtime_error("Unsupported Avro codec: " + codec);
-      }
-      m_syncMarker = fileHeader.Field("sync").Value<std::string>();
-      m_objectSchema = std::make_unique<AvroSchema>(ParseSchemaFromJsonString(objectSchemaJson));
+      ReadHeader(context);
       schema = m_objectSchema.get();
     }
 
@@ -612,7 +785,7 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     objectDatum.Fill(*m_reader, context);
     if (--m_remainingObjectInCurrentBlock == 0)
     {
-      auto markerDatum = AvroDatum(SyncMarkerSchema);
+      auto markerDatum = AvroDatum(SyncMarkerSchema());
       markerDatum.Fill(*m_reader, context);
       auto marker = markerDatum.Value<std::string>();
       if (marker != m_syncMarker)
@@ -624,57 +797,190 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     return objectDatum;
   }
 
-  size_t AvroStreamParser::OnRead(
-      uint8_t* buffer,
-      size_t count,
-      Azure::Core::Context const& context)
+  void AvroStreamParser::InitRecordDecoders()
   {
-    if (m_parserBuffer.Length != 0)
+    const AvroSchema& objectSchema = m_parser.ObjectSchema();
+    m_isUnion = objectSchema.Type() == AvroDatumType::Union;
+    std::vector<const AvroSchema*> recordSchemas;
+    if (m_isUnion)
     {
-      size_t bytesToCopy = (std::min)(m_parserBuffer.Length, count);
-      std::memcpy(buffer, m_parserBuffer.Data, bytesToCopy);
-      m_parserBuffer.Data += bytesToCopy;
-      m_parserBuffer.Length -= bytesToCopy;
-      return bytesToCopy;
+      for (const auto& schema : objectSchema.FieldSchemas())
+      {
+        recordSchemas.push_back(&schema);
+      }
     }
-    while (!m_parser.End())
+    else
     {
-      auto datum = m_parser.Next(context);
-      if (datum.Schema().Type() == AvroDatumType::Union)
+      recordSchemas.push_back(&objectSchema);
+    }
+
+    const std::string namePrefix = "com.microsoft.azure.storage.queryBlobContents.";
+    for (const auto schema : recordSchemas)
+    {
+      QueryRecordDecoder decoder;
+      decoder.Schema = schema;
+      if (schema->Type() == AvroDatumType::Record)
       {
-        datum = datum.Value<AvroDatum>();
+        if (schema->Name() == namePrefix + "resultData")
+        {
+          decoder.Type = QueryRecordType::ResultData;
+        }
+        else if (schema->Name() == namePrefix + "progress" && m_progressCallback)
+        {
+          decoder.Type = QueryRecordType::Progress;
+        }
+        else if (schema->Name() == namePrefix + "error" && m_errorCallback)
+        {
+          decoder.Type = QueryRecordType::Error;
+        }
+        for (size_t i = 0; i < schema->FieldNames().size(); ++i)
+        {
+          const auto& fieldName = schema->FieldNames()[i];
+          const auto fieldType = schema->FieldSchemas()[i].Type();
+          const bool isLong = fieldType == AvroDatumType::Long || fieldType == AvroDatumType::Int;
+          QueryField field = QueryField::Skip;
+          if (decoder.Type == QueryRecordType::ResultData && fieldName == "data"
+              && fieldType == AvroDatumType::Bytes)
+          {
+            field = QueryField::Data;
+          }
+          else if (decoder.Type == QueryRecordType::Progress && isLong)
+          {
+            if (fieldName == "bytesScanned")
+            {
+              field = QueryField::BytesScanned;
+            }
+            else if (fieldName == "totalBytes")
+            {
+              field = QueryField::TotalBytes;
+            }
+          }
+          else if (decoder.Type == QueryRecordType::Error)
+          {
+            if (fieldName == "name" && fieldType == AvroDatumType::String)
+            {
+              field = QueryField::Name;
+            }
+            else if (fieldName == "description" && fieldType == AvroDatumType::String)
+            {
+              field = QueryField::Description;
+            }
+            else if (fieldName == "fatal" && fieldType == AvroDatumType::Bool)
+            {
+              field = QueryField::Fatal;
+            }
+            else if (fieldName == "position" && isLong)
+            {
+              field = QueryField::Position;
+            }
+          }
+          decoder.Fields.emplace_back(field, &schema->FieldSchemas()[i]);
+        }
       }
-      if (datum.Schema().Type() != AvroDatumType::Record)
+      m_recordDecoders.push_back(std::move(decoder));
+    }
+  }
+
+  void AvroStreamParser::DecodeObject()
+  {
+    size_t branch = 0;
+    if (m_isUnion)
+    {
+      const int64_t i = m_blockReader.ReadLong();
+      if (i < 0 || static_cast<uint64_t>(i) >= m_recordDecoders.size())
       {
-        continue;
+        throw std::runtime_error("Invalid Avro union index.");
       }
-      if (datum.Schema().Name() == "com.microsoft.azure.storage.queryBlobContents.resultData")
+      branch = static_cast<size_t>(i);
+    }
+    const QueryRecordDecoder& decoder = m_recordDecoders[branch];
+    if (decoder.Type == QueryRecordType::Other)
+    {
+      m_blockReader.Skip(*decoder.Schema);
+      return;
+    }
+
+    int64_t bytesScanned = 0;
+    int64_t totalBytes = 0;
+    BlobQueryError error;
+    for (const auto& field : decoder.Fields)
+    {
+      switch (field.first)
       {
-        auto record = datum.Value<AvroRecord>();
-        auto dataDatum = record.Field("data");
-        m_parserBuffer = dataDatum.Value<AvroDatum::StringView>();
-        return OnRead(buffer, count, context);
+        case QueryField::Skip:
+          m_blockReader.Skip(*field.second);
+          break;
+        case QueryField::Data:
+          m_parserBuffer = m_blockReader.ReadBytes();
+          break;
+        case QueryField::BytesScanned:
+          bytesScanned = m_blockReader.ReadLong();
+          break;
+        case QueryField::TotalBytes:
+          totalBytes = m_blockReader.ReadLong();
+          break;
+        case QueryField::Name: {
+          const auto name = m_blockReader.ReadBytes();
+          error.Name.assign(name.Data, name.Data + name.Length);
+          break;
+        }
+        case QueryField::Description: {
+          const auto description = m_blockReader.ReadBytes();
+          error.Description.assign(description.Data, description.Data + description.Length);
+          break;
+        }
+        case QueryField::Fatal:
+          error.IsFatal = m_blockReader.ReadBool();
+          break;
+        case QueryField::Position:
+          error.Position = m_blockReader.ReadLong();
+          break;
       }
-      if (datum.Schema().Name() == "com.microsoft.azure.storage.queryBlobContents.progress"
-          && m_progressCallback)
+    }
+    if (decoder.Type == QueryRecordType::Progress)
+    {
+      m_progressCallback(bytesScanned, totalBytes);
+    }
+    else if (decoder.Type == QueryRecordType::Error)
+    {
+      m_errorCallback(std::move(error));
+    }
+  }
+
+  size_t AvroStreamParser::OnRead(
+      uint8_t* buffer,
+      size_t count,
+      Azure::Core::Context const& context)
+  {
+    // Objects are decoded in place from whole blocks, the result data is copied once from the
+    // block to the buffer of the caller.
+    while (m_parserBuffer.Length == 0)
+    {
+      if (m_remainingObjectsInBlock == 0)
       {
-        auto record = datum.Value<AvroRecord>();
-        auto bytesScanned = record.Field("bytesScanned").Value<int64_t>();
-        auto totalBytes = record.Field("totalBytes").Value<int64_t>();
-        m_progressCallback(bytesScanned, totalBytes);
+        AvroBlock block;
+        if (!m_parser.NextBlock(block, context))
+        {
+          return 0;
+        }
+        if (m_recordDecoders.empty())
+        {
+          InitRecordDecoders();
+        }
+        m_blockReader = AvroBufferReader(block.Data, block.Length);
+        m_remainingObjectsInBlock = block.ObjectCount;
+        continue;
       }
-      if (datum.Schema().Name() == "com.microsoft.azure.storage.queryBlobContents.error"
-          && m_errorCallback)
+      DecodeObject();
+      if (--m_remainingObjectsInBlock == 0 && !m_blockReader.End())
       {
-        auto record = datum.Value<AvroRecord>();
-        BlobQueryError e;
-        e.Name = record.Field("name").Value<std::string>();
-        e.Description = record.Field("description").Value<std::string>();
-        e.IsFatal = record.Field("fatal").Value<bool>();
-        e.Position = record.Field("position").Value<int64_t>();
-        m_errorCallback(std::move(e));
+        throw std::runtime_error("Invalid Avro block size.");
       }
     }
-    return 0;
+    size_t bytesToCopy = (std::min)(m_parserBuffer.Length, count);
+    std::memcpy(buffer, m_parserBuffer.Data, bytesToCopy);
+    m_parserBuffer.Data += bytesToCopy;
+    m_parserBuffer.Length -= bytesToCopy;
+    return bytesToCopy;
   }
 }}}} // namespace Azure::Storage::Blobs::_detail
@@ -7,9 +7,13 @@
 
 #include <azure/core/io/body_stream.hpp>
 
+#include <functional>
 #include <map>
 #include <memory>
+#include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
   enum class AvroDatumType
@@ -51,6 +55,9 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     // available in m_streambuffer;
     size_t Preload(size_t n, const Core::Context& context);
     size_t TryPreload(size_t n, const Core::Context& context);
+    // Reads n bytes in place. The pointer is valid until the next call to Preload, TryPreload or
+    // Discard.
+    const uint8_t* ReadInPlace(size_t n, const Core::Context& context);
     // discards data that's before m_pos
     void Discard();
 
@@ -150,6 +157,36 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     friend class AvroDatum;
   };
 
+  // A block of objects of an object container file.
+  struct AvroBlock final
+  {
+    int64_t ObjectCount = 0;
+    const uint8_t* Data = nullptr;
+    size_t Length = 0;
+  };
+
+  // Decodes values from a buffer holding whole objects, without copying them.
+  class AvroBufferReader final {
+  public:
+    AvroBufferReader() = default;
+    AvroBufferReader(const uint8_t* data, size_t length) : m_pos(data), m_end(data + length) {}
+
+    bool End() const { return m_pos == m_end; }
+    int64_t ReadLong();
+    bool ReadBool();
+    // Reads a string or bytes value. The view points into the buffer.
+    AvroDatum::StringView ReadBytes();
+    // Skips a value of any type.
+    void Skip(const AvroSchema& schema);
+
+  private:
+    const uint8_t* Advance(size_t n);
+
+  private:
+    const uint8_t* m_pos = nullptr;
+    const uint8_t* m_end = nullptr;
+  };
+
   class AvroObjectContainerReader final {
   public:
     explicit AvroObjectContainerReader(Core::IO::BodyStream& stream);
@@ -159,7 +196,16 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
     // AvroDatums propagated from there.
     AvroDatum Next(const Core::Context& context) { return NextImpl(m_objectSchema.get(), context); }
 
+    // Reads the next block of objects in the buffer of the reader, and checks its sync marker.
+    // Calling NextBlock() invalidates the data of the previous block. Returns false at the end of
+    // the stream. Can't be mixed with Next() in the middle of a block.
+    bool NextBlock(AvroBlock& block, const Core::Context& context);
+
+    // The schema of the objects, once the header was read.
+    const AvroSchema& ObjectSchema() const { return *m_objectSchema; }
+
   private:
+    void ReadHeader(const Core::Context& context);
     AvroDatum NextImpl(const AvroSchema* schema, const Core::Context& context);
 
   private:
@@ -187,12 +233,48 @@ namespace Azure { namespace Storage { namespace Blobs { namespace _detail {
   private:
     size_t OnRead(uint8_t* buffer, size_t count, const Azure::Core::Context& context) override;
 
+    enum class QueryRecordType
+    {
+      Other,
+      ResultData,
+      Progress,
+      Error,
+    };
+
+    enum class QueryField
+    {
+      Skip,
+      Data,
+      BytesScanned,
+      TotalBytes,
+      Name,
+      Description,
+      Fatal,
+      Position,
+    };
+
+    // How an object of one of the types of the union of query records is decoded, resolved once
+    // from the schema.
+    struct QueryRecordDecoder final
+    {
+      const AvroSchema* Schema = nullptr;
+      QueryRecordType Type = QueryRecordType::Other;
+      std::vector<std::pair<QueryField, const AvroSchema*>> Fields;
+    };
+
+    void InitRecordDecoders();
+    void DecodeObject();
+
   private:
     std::unique_ptr<Azure::Core::IO::BodyStream> m_inner;
     AvroObjectContainerReader m_parser;
     std::function<void(int64_t, int64_t)> m_progressCallback;
     std::function<void(BlobQueryError)> m_errorCallback;
     AvroDatum::StringView m_parserBuffer;
+    AvroBufferReader m_blockReader;
+    int64_t m_remainingObjectsInBlock = 0;
+    bool m_isUnion = false;
+    std::vector<QueryRecordDecoder> m_recordDecoders;
   };
 
 }}}} // namespace Azure::Storage::Blobs::_detail
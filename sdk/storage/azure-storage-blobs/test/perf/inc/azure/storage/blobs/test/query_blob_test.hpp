@@ -0,0 +1,222 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test the performance of decoding the result of a blob query.
+ *
+ */
+
+#pragma once
+
+#include <azure/core/http/policies/policy.hpp>
+#include <azure/core/io/body_stream.hpp>
+#include <azure/perf.hpp>
+#include <azure/storage/blobs.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace Blobs { namespace Test {
+
+  /**
+   * @brief Completes every request with a query response whose body is a given Avro stream,
+   * instead of sending it.
+   *
+   */
+  class QueryResponsePolicy final : public Azure::Core::Http::Policies::HttpPolicy {
+  public:
+    explicit QueryResponsePolicy(std::shared_ptr<const std::vector<uint8_t>> body)
+        : m_body(std::move(body))
+    {
+    }
+
+    std::unique_ptr<HttpPolicy> Clone() const override
+    {
+      return std::make_unique<QueryResponsePolicy>(*this);
+    }
+
+    std::unique_ptr<Azure::Core::Http::RawResponse> Send(
+        Azure::Core::Http::Request&,
+        Azure::Core::Http::Policies::NextHttpPolicy,
+        Azure::Core::Context const&) const override
+    {
+      auto response = std::make_unique<Azure::Core::Http::RawResponse>(
+          1, 1, Azure::Core::Http::HttpStatusCode::Ok, "OK");
+      response->SetHeader("x-ms-server-encrypted", "true");
+      response->SetBodyStream(std::make_unique<Azure::Core::IO::MemoryBodyStream>(*m_body));
+      return response;
+    }
+
+  private:
+    std::shared_ptr<const std::vector<uint8_t>> m_body;
+  };
+
+  /**
+   * @brief A test to measure the decoding of the Avro stream returned by a blob query. It doesn't
+   * need a storage account, no request is sent.
+   *
+   */
+  class QueryBlob : public Azure::Perf::PerfTest {
+  private:
+    std::unique_ptr<BlockBlobClient> m_blockBlobClient;
+    std::vector<uint8_t> m_readBuffer;
+    int64_t m_size = 0;
+
+    static void WriteLong(std::vector<uint8_t>& buffer, int64_t value)
+    {
+      uint64_t n = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+      while (n >= 0x80)
+      {
+        buffer.push_back(static_cast<uint8_t>(n | 0x80));
+        n >>= 7;
+      }
+      buffer.push_back(static_cast<uint8_t>(n));
+    }
+
+    static void WriteBytes(std::vector<uint8_t>& buffer, const std::string& value)
+    {
+      WriteLong(buffer, static_cast<int64_t>(value.size()));
+      buffer.insert(buffer.end(), value.begin(), value.end());
+    }
+
+    // Builds an Avro object container like the service returns: blocks of result data records,
+    // each followed by a progress record, and an end record.
+    static std::vector<uint8_t> BuildQueryResult(int64_t size, int64_t recordSize)
+    {
+      const std::string prefix = "com.microsoft.azure.storage.queryBlobContents.";
+      const std::string schema = R"([{"type":"record","name":")" + prefix
+          + R"(resultData","fields":[{"name":"data","type":"bytes"}]},)"
+          + R"({"type":"record","name":")" + prefix
+          + R"(error","fields":[{"name":"fatal","type":"boolean"},)"
+          + R"({"name":"name","type":"string"},{"name":"description","type":"string"},)"
+          + R"({"name":"position","type":"long"}]},)" + R"({"type":"record","name":")" + prefix
+          + R"(progress","fields":[{"name":"bytesScanned","type":"long"},)"
+          + R"({"name":"totalBytes","type":"long"}]},)" + R"({"type":"record","name":")" + prefix
+          + R"(end","fields":[{"name":"totalBytes","type":"long"}]}])";
+      const std::string syncMarker(16, 's');
+
+      std::vector<uint8_t> result{'O', 'b', 'j', 1};
+      WriteLong(result, 2);
+      WriteBytes(result, "avro.schema");
+      WriteBytes(result, schema);
+      WriteBytes(result, "avro.codec");
+      WriteBytes(result, "null");
+      WriteLong(result, 0);
+      result.insert(result.end(), syncMarker.begin(), syncMarker.end());
+
+      const int64_t recordsPerBlock = 16;
+      const std::string record(static_cast<size_t>(recordSize), 'x');
+      int64_t bytesScanned = 0;
+      std::vector<uint8_t> block;
+      while (bytesScanned < size)
+      {
+        block.clear();
+        int64_t numObjects = 0;
+        for (; numObjects < recordsPerBlock && bytesScanned < size; ++numObjects)
+        {
+          const auto recordLength = (std::min)(recordSize, size - bytesScanned);
+          WriteLong(block, 0);
+          WriteBytes(block, record.substr(0, static_cast<size_t>(recordLength)));
+          bytesScanned += recordLength;
+        }
+        WriteLong(block, 2);
+        WriteLong(block, bytesScanned);
+        WriteLong(block, size);
+        WriteLong(result, numObjects + 1);
+        WriteLong(result, static_cast<int64_t>(block.size()));
+        result.insert(result.end(), block.begin(), block.end());
+        result.insert(result.end(), syncMarker.begin(), syncMarker.end());
+      }
+      block.clear();
+      WriteLong(block, 3);
+      WriteLong(block, size);
+      WriteLong(result, 1);
+      WriteLong(result, static_cast<int64_t>(block.size()));
+      result.insert(result.end(), block.begin(), block.end());
+      result.insert(result.end(), syncMarker.begin(), syncMarker.end());
+      return result;
+    }
+
+  public:
+    /**
+     * @brief Construct a new QueryBlob test.
+     *
+     * @param options The test options.
+     */
+    QueryBlob(Azure::Perf::TestOptions options) : PerfTest(options) {}
+
+    /**
+     * @brief Build the query result and the client receiving it.
+     *
+     */
+    void Setup() override
+    {
+      m_size = m_options.GetOptionOrDefault<int64_t>("Size", 10 * 1024 * 1024);
+      const auto recordSize = m_options.GetOptionOrDefault<int64_t>("RecordSize", 100);
+      auto body
+          = std::make_shared<const std::vector<uint8_t>>(BuildQueryResult(m_size, recordSize));
+
+      BlobClientOptions clientOptions;
+      clientOptions.PerRetryPolicies.emplace_back(
+          std::make_unique<QueryResponsePolicy>(std::move(body)));
+      m_blockBlobClient = std::make_unique<BlockBlobClient>(
+          "https://account.blob.core.windows.net/container/blob", clientOptions);
+      m_readBuffer.resize(64 * 1024);
+    }
+
+    /**
+     * @brief Define the test
+     *
+     */
+    void Run(Azure::Core::Context const& context) override
+    {
+      QueryBlobOptions queryOptions;
+      queryOptions.ProgressHandler = [](int64_t, int64_t) {};
+      auto response = m_blockBlobClient->Query("SELECT * from BlobStorage", queryOptions, context);
+      int64_t totalRead = 0;
+      size_t bytesRead = 0;
+      while ((bytesRead
+              = response.Value.BodyStream->Read(m_readBuffer.data(), m_readBuffer.size(), context))
+             != 0)
+      {
+        totalRead += static_cast<int64_t>(bytesRead);
+      }
+      if (totalRead != m_size)
+      {
+        throw std::runtime_error("Unexpected size of the query result.");
+      }
+    }
+
+    /**
+     * @brief Define the test options for the test.
+     *
+     * @return The list of test options.
+     */
+    std::vector<Azure::Perf::TestOption> GetTestOptions() override
+    {
+      return {
+          {"Size", {"--size"}, "Size of the query result (in bytes)", 1, false},
+          {"RecordSize", {"--record-size"}, "Size of each record (in bytes)", 1, false}};
+    }
+
+    /**
+     * @brief Get the static Test Metadata for the test.
+     *
+     * @return Azure::Perf::TestMetadata describing the test.
+     */
+    static Azure::Perf::TestMetadata GetTestMetadata()
+    {
+      return {
+          "QueryBlob",
+          "Decode the Avro stream of a blob query result. No request is sent.",
+          [](Azure::Perf::TestOptions options) {
+            return std::make_unique<Azure::Storage::Blobs::Test::QueryBlob>(options);
+          }};
+    }
+  };
+
+}}}} // namespace Azure::Storage::Blobs::Test
@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ * @brief Test the performance of signing requests with a storage account key.
+ *
+ */
+
+#pragma once
+
+#include <azure/core/http/policies/policy.hpp>
+#include <azure/core/internal/http/pipeline.hpp>
+#include <azure/perf.hpp>
+#include <azure/storage/common/internal/shared_key_policy.hpp>
+#include <azure/storage/common/storage_credential.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace Blobs { namespace Test {
+
+  /**
+   * @brief Completes every request with an empty response instead of sending it.
+   *
+   */
+  class NoOpTransportPolicy final : public Azure::Core::Http::Policies::HttpPolicy {
+  public:
+    std::unique_ptr<HttpPolicy> Clone() const override
+    {
+      return std::make_unique<NoOpTransportPolicy>(*this);
+    }
+
+    std::unique_ptr<Azure::Core::Http::RawResponse> Send(
+        Azure::Core::Http::Request&,
+        Azure::Core::Http::Policies::NextHttpPolicy,
+        Azure::Core::Context const&) const override
+    {
+      return std::make_unique<Azure::Core::Http::RawResponse>(
+          1, 1, Azure::Core::Http::HttpStatusCode::Created, "Created");
+    }
+  };
+
+  /**
+   * @brief A test to measure the cost of the SharedKey authorization of a Put Block request. It
+   * doesn't need a storage account, no request is sent.
+   *
+   */
+  class SharedKeySigning : public Azure::Perf::PerfTest {
+  private:
+    std::unique_ptr<Azure::Core::Http::_internal::HttpPipeline> m_pipeline;
+    std::unique_ptr<Azure::Core::Http::Request> m_request;
+
+  public:
+    /**
+     * @brief Construct a new SharedKeySigning test.
+     *
+     * @param options The test options.
+     */
+    SharedKeySigning(Azure::Perf::TestOptions options) : PerfTest(options) {}
+
+    /**
+     * @brief Create the pipeline and the request to sign.
+     *
+     */
+    void Setup() override
+    {
+      auto credential = std::make_shared<StorageSharedKeyCredential>(
+          "account", Azure::Core::Convert::Base64Encode(std::vector<uint8_t>(64, 'k')));
+      std::vector<std::unique_ptr<Azure::Core::Http::Policies::HttpPolicy>> policies;
+      policies.emplace_back(
+          std::make_unique<Azure::Storage::_internal::SharedKeyPolicy>(std::move(credential)));
+      policies.emplace_back(std::make_unique<NoOpTransportPolicy>());
+      m_pipeline = std::make_unique<Azure::Core::Http::_internal::HttpPipeline>(policies);
+
+      m_request = std::make_unique<Azure::Core::Http::Request>(
+          Azure::Core::Http::HttpMethod::Put,
+          Azure::Core::Url("https://account.blob.core.windows.net/container/blob?comp=block&"
+                           "blockid=YmxvY2stMDAwMDE%3D&timeout=30"));
+      m_request->SetHeader("Content-Length", "1024");
+      m_request->SetHeader("Content-MD5", "1B2M2Y8AsgTpgAmY7PhCfg==");
+      m_request->SetHeader("x-ms-client-request-id", "3a1b3c5d-0000-4000-8000-000000000000");
+      m_request->SetHeader("x-ms-date", "Thu, 01 Jan 2024 00:00:00 GMT");
+      m_request->SetHeader("x-ms-version", "2024-08-04");
+    }
+
+    /**
+     * @brief Define the test
+     *
+     */
+    void Run(Azure::Core::Context const& context) override
+    {
+      m_pipeline->Send(*m_request, context);
+    }
+
+    /**
+     * @brief Define the test options for the test.
+     *
+     * @return The list of test options.
+     */
+    std::vector<Azure::Perf::TestOption> GetTestOptions() override { return {}; }
+
+    /**
+     * @brief Get the static Test Metadata for the test.
+     *
+     * @return Azure::Perf::TestMetadata describing the test.
+     */
+    static Azure::Perf::TestMetadata GetTestMetadata()
+    {
+      return {
+          "SharedKeySigning",
+          "Sign a Put Block request with a storage account key. No request is sent.",
+          [](Azure::Perf::TestOptions options) {
+            return std::make_unique<Azure::Storage::Blobs::Test::SharedKeySigning>(options);
+          }};
+    }
+  };
+
+}}}} // namespace Azure::Storage::Blobs::Test
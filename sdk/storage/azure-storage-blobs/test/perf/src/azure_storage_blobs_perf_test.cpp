@@ -12,6 +12,8 @@
 #endif
 
 #include "azure/storage/blobs/test/list_blob_test.hpp"
+#include "azure/storage/blobs/test/query_blob_test.hpp"
+#include "azure/storage/blobs/test/shared_key_signing_test.hpp"
 #include "azure/storage/blobs/test/upload_blob_test.hpp"
 
 int main(int argc, char** argv)
@@ -25,6 +27,8 @@ int main(int argc, char** argv)
         Azure::Storage::Blobs::Test::UploadBlob::GetTestMetadata(),
         Azure::Storage::Blobs::Test::ListBlob::GetTestMetadata(),
         Azure::Storage::Blobs::Test::DownloadBlobSas::GetTestMetadata(),
+        Azure::Storage::Blobs::Test::SharedKeySigning::GetTestMetadata(),
+        Azure::Storage::Blobs::Test::QueryBlob::GetTestMetadata(),
 #if defined(BUILD_CURL_HTTP_TRANSPORT_ADAPTER)
         Azure::Storage::Blobs::Test::DownloadBlobWithTransportOnly::GetTestMetadata(),
 #endif
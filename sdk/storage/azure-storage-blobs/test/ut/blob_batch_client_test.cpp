@@ -5,6 +5,11 @@
 
 #include <azure/storage/blobs.hpp>
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace Azure { namespace Storage { namespace Test {
 
   TEST_F(BlobContainerClientTest, ServiceBatchSubmitDelete_LIVEONLY_)
@@ -187,6 +192,56 @@ namespace Azure { namespace Storage { namespace Test {
         blob2Client.GetProperties().Value.AccessTier.Value(), Blobs::Models::AccessTier::Cold);
   }
 
+  TEST_F(BlobContainerClientTest, ContainerBatchSubmitBulk_LIVEONLY_)
+  {
+    auto containerClient = *m_blobContainerClient;
+
+    // More subrequests than fit in a batch request, of mixed types.
+    const size_t numBlobs = 300;
+    std::vector<std::string> blobNames;
+    for (size_t i = 0; i < numBlobs; ++i)
+    {
+      blobNames.push_back("b" + std::to_string(i));
+      containerClient.GetBlockBlobClient(blobNames.back()).UploadFrom(nullptr, 0);
+    }
+
+    auto batch = containerClient.CreateBatch();
+    std::vector<DeferredResponse<Blobs::Models::SetBlobAccessTierResult>> setTierResponses;
+    std::vector<DeferredResponse<Blobs::Models::DeleteBlobResult>> deleteResponses;
+    for (size_t i = 0; i < numBlobs; ++i)
+    {
+      if (i % 2 == 0)
+      {
+        setTierResponses.push_back(
+            batch.SetBlobAccessTier(blobNames[i], Blobs::Models::AccessTier::Cool));
+      }
+      else
+      {
+        deleteResponses.push_back(batch.DeleteBlob(blobNames[i]));
+      }
+    }
+    auto deleteNotExistsResponse = batch.DeleteBlob("BlobNameNotExists");
+    Blobs::SubmitBulkBlobBatchOptions options;
+    options.Concurrency = 2;
+    auto result = containerClient.SubmitBulkBatch(batch, options);
+
+    EXPECT_GE(result.SubmittedBatches, 2);
+    EXPECT_EQ(result.FailedSubrequests, 1);
+    for (auto& response : setTierResponses)
+    {
+      EXPECT_NO_THROW(response.GetResponse());
+    }
+    for (auto& response : deleteResponses)
+    {
+      EXPECT_TRUE(response.GetResponse().Value.Deleted);
+    }
+    EXPECT_THROW(deleteNotExistsResponse.GetResponse(), StorageException);
+    EXPECT_EQ(
+        containerClient.GetBlobClient(blobNames[0]).GetProperties().Value.AccessTier.Value(),
+        Blobs::Models::AccessTier::Cool);
+    EXPECT_THROW(containerClient.GetBlobClient(blobNames[1]).GetProperties(), StorageException);
+  }
+
   TEST_F(BlobContainerClientTest, BatchTokenAuthorization_LIVEONLY_)
   {
     Blobs::BlobClientOptions clientOptions;
@@ -342,4 +397,92 @@ namespace Azure { namespace Storage { namespace Test {
     containerClient.Delete();
   }
 
+  namespace {
+    // A subrequest that records how many times it was submitted. The fake submit function
+    // completes it the way the parser of a batch response does.
+    struct FakeSubrequest final : public Blobs::_detail::BatchSubrequest
+    {
+      FakeSubrequest(Blobs::_detail::BatchSubrequestType type, size_t index)
+          : BatchSubrequest(type), Index(index)
+      {
+      }
+
+      size_t Index;
+      int Submissions = 0;
+    };
+  } // namespace
+
+  TEST(BlobBatchTest, SubmitBulkBatch)
+  {
+    // Every 50th subrequest fails for good, every 7th fails transiently the first time and the 4th
+    // always fails transiently.
+    const auto isPermanentFailure = [](size_t index) { return index % 50 == 1; };
+    const auto isTransientFailure = [](size_t index, int submissions) {
+      return index == 3 || (index % 7 == 0 && submissions == 1);
+    };
+
+    std::vector<std::shared_ptr<Blobs::_detail::BatchSubrequest>> subrequests;
+    for (size_t i = 0; i < 600; ++i)
+    {
+      subrequests.push_back(std::make_shared<FakeSubrequest>(
+          i % 2 == 0 ? Blobs::_detail::BatchSubrequestType::DeleteBlob
+                     : Blobs::_detail::BatchSubrequestType::SetBlobAccessTier,
+          i));
+    }
+
+    std::mutex batchSizesMutex;
+    std::vector<size_t> batchSizes;
+    auto submitBatch = [&](std::vector<std::shared_ptr<Blobs::_detail::BatchSubrequest>> batch,
+                           const Core::Context&) {
+      {
+        std::lock_guard<std::mutex> guard(batchSizesMutex);
+        batchSizes.push_back(batch.size());
+      }
+      for (const auto& subrequestBase : batch)
+      {
+        EXPECT_EQ(subrequestBase->Type, batch.front()->Type);
+        auto& subrequest = static_cast<FakeSubrequest&>(*subrequestBase);
+        ++subrequest.Submissions;
+        if (isPermanentFailure(subrequest.Index))
+        {
+          subrequest.Failed = true;
+        }
+        else if (isTransientFailure(subrequest.Index, subrequest.Submissions))
+        {
+          if (subrequest.RemainingRetries > 0)
+          {
+            --subrequest.RemainingRetries;
+            subrequest.Retry = true;
+          }
+          else
+          {
+            subrequest.Failed = true;
+          }
+        }
+      }
+    };
+
+    Blobs::SubmitBulkBlobBatchOptions options;
+    options.Concurrency = 3;
+    options.MaxSubrequestRetries = 1;
+    auto result = Blobs::_detail::SubmitBulkBatch(subrequests, submitBatch, options, {});
+
+    // 300 subrequests of each type are split into batches of 256 and 44, then the 86 subrequests
+    // that failed transiently are resubmitted in a batch for each type.
+    std::sort(batchSizes.begin(), batchSizes.end());
+    EXPECT_EQ(batchSizes, (std::vector<size_t>{43, 43, 44, 44, 256, 256}));
+    EXPECT_EQ(result.SubmittedBatches, 6);
+    EXPECT_EQ(result.FailedSubrequests, 13);
+    for (const auto& subrequestBase : subrequests)
+    {
+      const auto& subrequest = static_cast<const FakeSubrequest&>(*subrequestBase);
+      const bool resubmitted = !isPermanentFailure(subrequest.Index)
+          && isTransientFailure(subrequest.Index, 1);
+      EXPECT_EQ(subrequest.Submissions, resubmitted ? 2 : 1);
+      EXPECT_EQ(
+          subrequest.Failed, isPermanentFailure(subrequest.Index) || subrequest.Index == 3);
+      EXPECT_FALSE(subrequest.Retry);
+    }
+  }
+
 }}} // namespace Azure::Storage::Test
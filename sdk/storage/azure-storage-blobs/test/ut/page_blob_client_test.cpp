@@ -780,4 +780,107 @@ namespace Azure { namespace Storage { namespace Test {
     EXPECT_NO_THROW(blockBlobClient.GetProperties());
   }
 
+  TEST_F(PageBlobClientTest, SparseUploadDownload_LIVEONLY_)
+  {
+    auto pageBlobClient = *m_pageBlobClient;
+
+    // Three runs of pages with data, 2 KB in total, the other pages contain only zeros.
+    std::vector<uint8_t> blobContent(static_cast<size_t>(8_KB));
+    for (const auto& range :
+         {std::make_pair(0, 1024), std::make_pair(2560, 512), std::make_pair(7680, 512)})
+    {
+      auto randomContent = RandomBuffer(static_cast<size_t>(range.second));
+      std::copy(randomContent.begin(), randomContent.end(), blobContent.begin() + range.first);
+    }
+
+    Blobs::UploadPageBlobFromOptions uploadOptions;
+    uploadOptions.TransferOptions.ChunkSize = 2_KB;
+    uploadOptions.TransferOptions.Concurrency = 2;
+    auto uploadResult
+        = pageBlobClient.UploadFrom(blobContent.data(), blobContent.size(), uploadOptions);
+    EXPECT_EQ(uploadResult.Value.UploadedBytes, 2048);
+    EXPECT_TRUE(uploadResult.Value.ETag.HasValue());
+
+    std::vector<Core::Http::HttpRange> pageRanges;
+    for (auto pageResult = pageBlobClient.GetPageRanges(); pageResult.HasPage();
+         pageResult.MoveToNextPage())
+    {
+      pageRanges.insert(
+          pageRanges.end(), pageResult.PageRanges.begin(), pageResult.PageRanges.end());
+    }
+    ASSERT_EQ(pageRanges.size(), static_cast<size_t>(3));
+    EXPECT_EQ(pageRanges[0].Offset, 0);
+    EXPECT_EQ(pageRanges[0].Length.Value(), 1024);
+
+    const std::string tempFilename = "file" + RandomString();
+    WriteFile(tempFilename, blobContent);
+    pageBlobClient.Delete();
+    uploadResult = pageBlobClient.UploadFrom(tempFilename, uploadOptions);
+    EXPECT_EQ(uploadResult.Value.UploadedBytes, 2048);
+    DeleteFile(tempFilename);
+
+    Blobs::DownloadSparsePageBlobToOptions downloadOptions;
+    downloadOptions.TransferOptions.ChunkSize = 512;
+    downloadOptions.TransferOptions.Concurrency = 2;
+    auto downloadResult = pageBlobClient.DownloadSparseTo(tempFilename, downloadOptions);
+    EXPECT_EQ(downloadResult.Value.BlobSize, static_cast<int64_t>(blobContent.size()));
+    EXPECT_EQ(downloadResult.Value.DownloadedBytes, 2048);
+    EXPECT_EQ(downloadResult.Value.ETag, uploadResult.Value.ETag);
+    EXPECT_EQ(ReadFile(tempFilename), blobContent);
+    DeleteFile(tempFilename);
+
+    downloadOptions.TransferOptions.ChunkSize = 0;
+    EXPECT_THROW(
+        pageBlobClient.DownloadSparseTo(tempFilename, downloadOptions),
+        Azure::Core::RequestFailedException);
+
+    std::vector<uint8_t> unalignedContent(1000);
+    EXPECT_THROW(
+        pageBlobClient.UploadFrom(unalignedContent.data(), unalignedContent.size()),
+        Azure::Core::RequestFailedException);
+  }
+
+  TEST_F(PageBlobClientTest, SyncSnapshotDiff_LIVEONLY_)
+  {
+    auto pageBlobClient = *m_pageBlobClient;
+
+    std::vector<uint8_t> blobContent = RandomBuffer(static_cast<size_t>(8_KB));
+    pageBlobClient.UploadFrom(blobContent.data(), blobContent.size());
+    const auto previousSnapshot = pageBlobClient.CreateSnapshot().Value.Snapshot;
+
+    const std::string tempFilename = "file" + RandomString();
+    WriteFile(tempFilename, blobContent);
+    auto pageBlobClient2 = GetPageBlobClientTestForTest(RandomString());
+    pageBlobClient2.UploadFrom(blobContent.data(), blobContent.size());
+
+    auto pageContent = RandomBuffer(static_cast<size_t>(2_KB));
+    auto pageContentStream = Azure::Core::IO::MemoryBodyStream(pageContent);
+    pageBlobClient.UploadPages(4_KB, pageContentStream);
+    pageBlobClient.ClearPages({1_KB, 1_KB});
+    std::copy(pageContent.begin(), pageContent.end(), blobContent.begin() + 4_KB);
+    std::fill(blobContent.begin() + 1_KB, blobContent.begin() + 2_KB, '\x00');
+    const auto snapshot = pageBlobClient.CreateSnapshot().Value.Snapshot;
+
+    Blobs::DownloadPageBlobDiffToOptions downloadOptions;
+    downloadOptions.TransferOptions.ChunkSize = 1_KB;
+    auto downloadResult = pageBlobClient.WithSnapshot(snapshot).DownloadDiffTo(
+        previousSnapshot, tempFilename, downloadOptions);
+    EXPECT_EQ(downloadResult.Value.ChangedBytes, 2048);
+    EXPECT_EQ(downloadResult.Value.ClearedBytes, 1024);
+    EXPECT_EQ(ReadFile(tempFilename), blobContent);
+    DeleteFile(tempFilename);
+
+    auto sourceClient = Blobs::PageBlobClient(
+        pageBlobClient.GetUrl() + GetSas(), InitStorageClientOptions<Blobs::BlobClientOptions>());
+    auto copyResult
+        = pageBlobClient2.CopyDiffFrom(sourceClient.WithSnapshot(snapshot), previousSnapshot);
+    EXPECT_EQ(copyResult.Value.ChangedBytes, 2048);
+    EXPECT_EQ(copyResult.Value.ClearedBytes, 1024);
+    EXPECT_EQ(ReadBodyStream(pageBlobClient2.Download().Value.BodyStream), blobContent);
+
+    EXPECT_THROW(
+        pageBlobClient.DownloadDiffTo(previousSnapshot, "file" + RandomString()),
+        std::runtime_error);
+  }
+
 }}} // namespace Azure::Storage::Test
@@ -7,6 +7,7 @@
 #include <azure/core/cryptography/hash.hpp>
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -41,6 +42,29 @@ namespace Azure { namespace Storage {
     std::vector<uint8_t> HmacSha256(
         const std::vector<uint8_t>& data,
         const std::vector<uint8_t>& key);
+
+    /**
+     * @brief An HMAC-SHA256 key prepared once, so that computing a hash with it doesn't need to
+     * process the key again. It can be used from multiple threads concurrently.
+     */
+    class HmacSha256Context final {
+    public:
+      static constexpr size_t HashSize = 32;
+
+      explicit HmacSha256Context(const std::vector<uint8_t>& key);
+      HmacSha256Context(const HmacSha256Context&) = delete;
+      HmacSha256Context& operator=(const HmacSha256Context&) = delete;
+      ~HmacSha256Context();
+
+      /**
+       * @brief Computes the hash of \p data into \p hash, which must hold #HashSize bytes.
+       */
+      void Compute(const uint8_t* data, size_t length, uint8_t* hash) const;
+
+    private:
+      struct Implementation;
+      std::unique_ptr<Implementation> m_implementation;
+    };
     std::string UrlEncodeQueryParameter(const std::string& value);
     std::string UrlEncodePath(const std::string& value);
   } // namespace _internal
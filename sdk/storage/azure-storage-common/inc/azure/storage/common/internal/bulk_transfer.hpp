@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "azure/storage/common/storage_common.hpp"
+
+#include <azure/core/context.hpp>
+#include <azure/core/etag.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace _internal {
+
+  /**
+   * @brief A file transferred by #BulkTransfer.
+   *
+   */
+  struct BulkTransferItem final
+  {
+    // The path of the file relative to the transferred directory, with '/' as separator.
+    std::string Path;
+    int64_t Size = 0;
+    // The ETag of the source of a download, used to detect changes between chunks.
+    Azure::ETag ETag;
+  };
+
+  struct BulkTransferOptions final
+  {
+    // The maximum number of requests in flight, across all the files.
+    int Concurrency = 1;
+    // The maximum number of bytes transferred by the requests in flight. A larger request is only
+    // sent when no other request is in flight.
+    int64_t MaxBytesInFlight = 0;
+    // Files up to this size are transferred by TransferFile, larger ones in chunks.
+    int64_t SingleTransferThreshold = 0;
+    int64_t ChunkSize = 0;
+    // Larger files are transferred in larger chunks so that they don't have more chunks than this.
+    int64_t MaxChunkCount = 0;
+    std::function<void(const BulkTransferProgress&)> ProgressHandler;
+  };
+
+  struct BulkTransferOperations final
+  {
+    // Transfers a file with a single request.
+    std::function<void(const BulkTransferItem&, const Azure::Core::Context&)> TransferFile;
+    // Optional, called once before the chunks of a file are transferred.
+    std::function<void(const BulkTransferItem&, const Azure::Core::Context&)> PrepareChunks;
+    // Transfers a chunk of a file, given its offset, length and ID.
+    std::function<
+        void(const BulkTransferItem&, int64_t, int64_t, int64_t, const Azure::Core::Context&)>
+        TransferChunk;
+    // Optional, called once after all the chunks of a file were transferred, given their number.
+    std::function<void(const BulkTransferItem&, int64_t, const Azure::Core::Context&)>
+        CommitChunks;
+  };
+
+  // Returns whether a path relative to a directory, with '/' as separator, names a file inside the
+  // directory. Empty, "." and ".." components are rejected.
+  bool IsValidRelativePath(const std::string& path);
+
+  /**
+   * @brief Transfers many files with a shared budget of requests and bytes in flight.
+   *
+   * @details Small files are transferred with a single request and large files in chunks. The
+   * chunks of the files already started are scheduled before new files, so that few files are in
+   * progress at the same time. A file that fails is reported in the result without stopping the
+   * transfer of the other files.
+   */
+  BulkTransferResult BulkTransfer(
+      const std::vector<BulkTransferItem>& items,
+      const BulkTransferOptions& options,
+      const BulkTransferOperations& operations,
+      const Azure::Core::Context& context);
+
+}}} // namespace Azure::Storage::_internal
@@ -3,11 +3,16 @@
 
 #pragma once
 
+#include "azure/storage/common/dll_import_export.hpp"
+
+#include <azure/core/context.hpp>
+
 #include <algorithm>
 #include <atomic>
 #include <cstdlib>
 #include <functional>
 #include <future>
+#include <memory>
 #include <stdexcept>
 #include <vector>
 
@@ -65,4 +70,74 @@ namespace Azure { namespace Storage { namespace _internal {
     }
   }
 
+  /**
+   * @brief Context key of a std::shared_ptr<std::atomic<int64_t>> that counts the responses of the
+   * service throttling a request, including the ones that were retried.
+   *
+   */
+  AZ_STORAGE_COMMON_DLLEXPORT extern const Azure::Core::Context::Key ThrottledResponseCountKey;
+
+  /**
+   * @brief Transfers a range in chunks like #ConcurrentTransfer, but tunes the chunk size and the
+   * number of chunks in flight while the transfer runs.
+   *
+   * @details The transfer starts with a single chunk in flight. After every round of chunks, the
+   * goodput of the round is compared with the previous one: while it improves, the number of
+   * chunks in flight is doubled, then increased by one once the goodput stops improving, and the
+   * chunk size is increased by \p chunkSize. If the service throttled a request of the round, both
+   * are halved.
+   *
+   * @param offset The offset of the range to transfer.
+   * @param length The length of the range to transfer.
+   * @param chunkSize The initial and smallest chunk size.
+   * @param maxChunkSize The largest chunk size the service accepts.
+   * @param concurrency The maximum number of chunks in flight.
+   * @param context The context for the transfer.
+   * @param transferFunc Transfers a chunk, given its offset, length, ID, the number of chunks and
+   * the context to send its requests with. Chunk sizes vary, so the number of chunks is only known
+   * when the last chunk is transferred; it is an estimate greater than the chunk ID plus one for
+   * the other chunks.
+   */
+  void AdaptiveConcurrentTransfer(
+      int64_t offset,
+      int64_t length,
+      int64_t chunkSize,
+      int64_t maxChunkSize,
+      int concurrency,
+      const Azure::Core::Context& context,
+      const std::function<
+          void(int64_t, int64_t, int64_t, int64_t, const Azure::Core::Context&)>& transferFunc);
+
+  /**
+   * @brief Transfers a range in chunks with #AdaptiveConcurrentTransfer when \p adaptive is true,
+   * or with fixed size chunks and concurrency otherwise.
+   *
+   */
+  inline void ConcurrentTransfer(
+      int64_t offset,
+      int64_t length,
+      int64_t chunkSize,
+      int64_t maxChunkSize,
+      int concurrency,
+      bool adaptive,
+      const Azure::Core::Context& context,
+      const std::function<
+          void(int64_t, int64_t, int64_t, int64_t, const Azure::Core::Context&)>& transferFunc)
+  {
+    if (adaptive)
+    {
+      AdaptiveConcurrentTransfer(
+          offset, length, chunkSize, maxChunkSize, concurrency, context, transferFunc);
+      return;
+    }
+    ConcurrentTransfer(
+        offset,
+        length,
+        chunkSize,
+        concurrency,
+        [&](int64_t chunkOffset, int64_t chunkLength, int64_t chunkId, int64_t numChunks) {
+          transferFunc(chunkOffset, chunkLength, chunkId, numChunks, context);
+        });
+  }
+
 }}} // namespace Azure::Storage::_internal
@@ -3,10 +3,17 @@
 
 #pragma once
 
+#include "azure/storage/common/storage_common.hpp"
+
+#include <azure/core/context.hpp>
+#include <azure/core/io/body_stream.hpp>
 #include <azure/core/platform.hpp>
 
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace Azure { namespace Storage { namespace _internal {
 
@@ -18,31 +25,135 @@ namespace Azure { namespace Storage { namespace _internal {
 
   class FileReader final {
   public:
-    FileReader(const std::string& filename);
+    FileReader(const std::string& filename, FileIoMode mode = FileIoMode::Buffered);
 
     ~FileReader();
 
+    FileReader(const FileReader&) = delete;
+    FileReader& operator=(const FileReader&) = delete;
+
     FileHandle GetHandle() const { return m_handle; }
 
     int64_t GetFileSize() const { return m_fileSize; }
 
+    // The time of the last write to the file, in a platform-specific unit.
+    int64_t GetLastWriteTime() const;
+
+    // Returns a stream of a range of the file, read according to the mode of the reader. The
+    // stream must not outlive the reader.
+    std::unique_ptr<Azure::Core::IO::BodyStream> GetRangeStream(int64_t offset, int64_t length)
+        const;
+
   private:
     FileHandle m_handle;
     int64_t m_fileSize;
+    // Buffered when the requested mode isn't supported for the file.
+    FileIoMode m_mode;
+#if defined(AZ_PLATFORM_WINDOWS)
+    void* m_mappingHandle = nullptr;
+#endif
+    uint8_t* m_mappedView = nullptr;
   };
 
   class FileWriter final {
   public:
-    FileWriter(const std::string& filename);
+    // Creates the file, or truncates it unless truncate is false.
+    FileWriter(const std::string& filename, bool truncate = true);
+
+    // Creates the file, or truncates it unless truncate is false, and sets its size, which is
+    // needed to map it in memory. When sparse is true, the file is made sparse and its size is set
+    // in every mode, so that the ranges not written don't take space on disk where the file system
+    // supports it.
+    FileWriter(
+        const std::string& filename,
+        bool truncate,
+        FileIoMode mode,
+        int64_t fileSize,
+        bool sparse = false);
 
     ~FileWriter();
 
+    FileWriter(const FileWriter&) = delete;
+    FileWriter& operator=(const FileWriter&) = delete;
+
     FileHandle GetHandle() const { return m_handle; }
 
     void Write(const uint8_t* buffer, size_t length, int64_t offset);
 
+    // Writes a range of the file with the content of a stream, according to the mode of the
+    // writer.
+    void WriteFromStream(
+        Azure::Core::IO::BodyStream& stream,
+        int64_t offset,
+        int64_t length,
+        const Azure::Core::Context& context);
+
   private:
     FileHandle m_handle;
+    // Buffered when the requested mode isn't supported for the file.
+    FileIoMode m_mode = FileIoMode::Buffered;
+    // Bypasses the page cache, used for the aligned ranges in direct mode.
+    FileHandle m_directHandle;
+#if defined(AZ_PLATFORM_WINDOWS)
+    void* m_mappingHandle = nullptr;
+#endif
+    uint8_t* m_mappedView = nullptr;
+    int64_t m_mappedSize = 0;
   };
 
+  // A sidecar file recording which chunks of a transfer are done, so that a transfer interrupted by
+  // a failure or a crash can be resumed. The bitmap of the chunks is memory-mapped, so that a chunk
+  // marked as done survives the process.
+  class TransferJournal final {
+  public:
+    // Opens the journal, or creates it. A journal left by a transfer with another key or number of
+    // chunks is reset. The key identifies the transfer, e.g. its source, destination, the version
+    // of the source and the chunk size.
+    TransferJournal(const std::string& filename, const std::string& key, int64_t numChunks);
+
+    ~TransferJournal();
+
+    TransferJournal(const TransferJournal&) = delete;
+    TransferJournal& operator=(const TransferJournal&) = delete;
+
+    // Whether the journal was left by a previous attempt of the same transfer.
+    bool IsResumed() const { return m_resumed; }
+
+    bool IsChunkDone(int64_t chunkId) const;
+
+    void SetChunkDone(int64_t chunkId);
+
+    // Deletes the journal, once the transfer is complete or can't be resumed.
+    void Remove();
+
+  private:
+    void Close();
+
+    std::string m_filename;
+    FileHandle m_handle;
+#if defined(AZ_PLATFORM_WINDOWS)
+    void* m_mappingHandle = nullptr;
+#endif
+    uint8_t* m_mappedView = nullptr;
+    size_t m_mappedSize = 0;
+    uint8_t* m_bitmap = nullptr;
+    int64_t m_numChunks = 0;
+    bool m_resumed = false;
+    mutable std::mutex m_mutex;
+  };
+
+  struct LocalFileInfo final
+  {
+    // Relative to the listed directory, with '/' as separator.
+    std::string Path;
+    int64_t Size = 0;
+  };
+
+  // Lists the regular files in a directory and its subdirectories. Symbolic links to directories
+  // aren't followed.
+  std::vector<LocalFileInfo> ListFilesRecursively(const std::string& directory);
+
+  // Creates a directory and its missing parent directories.
+  void CreateDirectories(const std::string& path);
+
 }}} // namespace Azure::Storage::_internal
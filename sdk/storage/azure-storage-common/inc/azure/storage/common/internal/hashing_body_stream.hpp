@@ -0,0 +1,87 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "azure/storage/common/storage_common.hpp"
+
+#include <azure/core/context.hpp>
+#include <azure/core/cryptography/hash.hpp>
+#include <azure/core/io/body_stream.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Storage { namespace _internal {
+
+  /**
+   * @brief The largest range the service returns a content hash for on download.
+   *
+   */
+  constexpr int64_t MaxHashedRangeSize = 4 * 1024 * 1024;
+
+  /**
+   * @brief Decorates a body stream by computing the hash of the content while it's read, so the
+   * content can be validated without another pass over it.
+   *
+   * @remark The decorated stream isn't owned and must outlive this stream. Rewinding restarts the
+   * hash, so a request body that is sent again is hashed only once.
+   *
+   */
+  class HashingBodyStream final : public Azure::Core::IO::BodyStream {
+  private:
+    Azure::Core::IO::BodyStream& m_inner;
+    HashAlgorithm const m_algorithm;
+    std::unique_ptr<Azure::Core::Cryptography::Hash> m_hash;
+
+    size_t OnRead(uint8_t* buffer, size_t count, Azure::Core::Context const& context) override;
+
+  public:
+    explicit HashingBodyStream(Azure::Core::IO::BodyStream& inner, HashAlgorithm algorithm);
+
+    int64_t Length() const override { return m_inner.Length(); }
+    void Rewind() override;
+
+    /**
+     * @brief Gets the hash of the content read so far. It can only be called once.
+     *
+     */
+    ContentHash GetHash();
+  };
+
+  /**
+   * @brief Throws #Azure::Core::RequestFailedException if \p expected is missing or doesn't match
+   * \p actual.
+   *
+   */
+  void VerifyContentHash(
+      const ContentHash& actual,
+      const Azure::Nullable<ContentHash>& expected,
+      const std::string& operation);
+
+  /**
+   * @brief Calls \p read with \p body. When \p algorithm has a value, \p read is given a stream
+   * that hashes the content of \p body instead, and the hash is then verified against \p expected.
+   *
+   */
+  template <class ReadFunction>
+  void ReadAndVerifyContentHash(
+      Azure::Core::IO::BodyStream& body,
+      const Azure::Nullable<HashAlgorithm>& algorithm,
+      const Azure::Nullable<ContentHash>& expected,
+      const std::string& operation,
+      ReadFunction&& read)
+  {
+    if (!algorithm.HasValue())
+    {
+      read(body);
+      return;
+    }
+    HashingBodyStream hashingStream(body, algorithm.Value());
+    read(static_cast<Azure::Core::IO::BodyStream&>(hashingStream));
+    VerifyContentHash(hashingStream.GetHash(), expected, operation);
+  }
+
+}}} // namespace Azure::Storage::_internal
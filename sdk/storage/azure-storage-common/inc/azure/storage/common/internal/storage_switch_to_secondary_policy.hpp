@@ -7,6 +7,7 @@
 
 #include <azure/core/http/policies/policy.hpp>
 
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -14,9 +15,12 @@ namespace Azure { namespace Storage { namespace _internal {
 
   AZ_STORAGE_COMMON_DLLEXPORT extern const Azure::Core::Context::Key SecondaryHostReplicaStatusKey;
 
+  // The status is atomic because the original and the hedged attempts of a request read and
+  // update it concurrently.
   inline Azure::Core::Context WithReplicaStatus(const Azure::Core::Context& context)
   {
-    return context.WithValue(SecondaryHostReplicaStatusKey, std::make_shared<bool>(true));
+    return context.WithValue(
+        SecondaryHostReplicaStatusKey, std::make_shared<std::atomic<bool>>(true));
   }
 
   class StorageSwitchToSecondaryPolicy final : public Azure::Core::Http::Policies::HttpPolicy {
@@ -52,6 +52,89 @@ namespace Azure { namespace Storage {
     HashAlgorithm Algorithm = HashAlgorithm::Md5;
   };
 
+  /**
+   * @brief How a local file is read or written by a transfer.
+   */
+  enum class FileIoMode
+  {
+    /**
+     * @brief The file is read or written through buffers with regular I/O.
+     */
+    Buffered,
+
+    /**
+     * @brief The file is mapped in memory, the content is sent from or received into the mapping
+     * without intermediate buffers. The file must not be truncated by another process during the
+     * transfer.
+     */
+    MemoryMapped,
+
+    /**
+     * @brief The file is read or written bypassing the page cache of the operating system where
+     * supported, so that a very large transfer doesn't evict the cached data of other processes.
+     * The ranges not aligned with the blocks of the file system use regular I/O.
+     */
+    Direct,
+  };
+
   using Metadata = Azure::Core::CaseInsensitiveMap;
 
+  /**
+   * @brief The progress of a transfer of many files.
+   */
+  struct BulkTransferProgress final
+  {
+    /**
+     * @brief The number of files transferred so far.
+     */
+    int64_t TransferredFiles = 0;
+
+    /**
+     * @brief The number of files that couldn't be transferred so far.
+     */
+    int64_t FailedFiles = 0;
+
+    /**
+     * @brief The number of files to transfer.
+     */
+    int64_t TotalFiles = 0;
+
+    /**
+     * @brief The number of bytes transferred so far.
+     */
+    int64_t TransferredBytes = 0;
+
+    /**
+     * @brief The number of bytes to transfer.
+     */
+    int64_t TotalBytes = 0;
+
+    /**
+     * @brief The average throughput of the transfer so far, in bytes per second.
+     */
+    double BytesPerSecond = 0.0;
+  };
+
+  /**
+   * @brief The result of a transfer of many files.
+   */
+  struct BulkTransferResult final
+  {
+    /**
+     * @brief The number of files transferred.
+     */
+    int64_t TransferredFiles = 0;
+
+    /**
+     * @brief The number of bytes transferred.
+     */
+    int64_t TransferredBytes = 0;
+
+    /**
+     * @brief The files that couldn't be transferred, mapped to the error that occurred. The files
+     * are identified by their path relative to the transferred directory.
+     */
+    std::map<std::string, std::string> FailedFiles;
+  };
+
 }} // namespace Azure::Storage
@@ -21,7 +21,8 @@ namespace Azure { namespace Storage {
 
   namespace _internal {
     class SharedKeyPolicy;
-  }
+    class HmacSha256Context;
+  } // namespace _internal
 
   /**
    * @brief A StorageSharedKeyCredential is a credential backed by a storage account's name and
@@ -51,6 +52,7 @@ namespace Azure { namespace Storage {
     {
       std::lock_guard<std::mutex> guard(m_mutex);
       m_accountKey = std::move(accountKey);
+      m_signingContext.reset();
     }
 
     /**
@@ -71,8 +73,12 @@ namespace Azure { namespace Storage {
       return m_accountKey;
     }
 
+    std::shared_ptr<const _internal::HmacSha256Context> GetSigningContext() const;
+
     mutable std::mutex m_mutex;
     std::string m_accountKey;
+    // The decoded account key, prepared for signing. Created on first use after the key changes.
+    mutable std::shared_ptr<const _internal::HmacSha256Context> m_signingContext;
   };
 
   namespace _internal {
@@ -0,0 +1,336 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/storage/common/internal/bulk_transfer.hpp"
+
+#include <azure/core/platform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace Azure { namespace Storage { namespace _internal {
+
+  namespace {
+    enum class TaskKind
+    {
+      TransferFile,
+      PrepareChunks,
+      TransferChunk,
+      CommitChunks,
+    };
+
+    struct Task final
+    {
+      size_t Item = 0;
+      TaskKind Kind = TaskKind::TransferFile;
+      int64_t Offset = 0;
+      int64_t Length = 0;
+      int64_t ChunkId = 0;
+      int64_t NumChunks = 0;
+    };
+
+    // A file transferred in chunks.
+    struct ChunkedFile final
+    {
+      int64_t NumChunks = 0;
+      // The chunks not transferred yet, including the ones in flight.
+      int64_t PendingChunks = 0;
+      bool Failed = false;
+      std::string Error;
+    };
+  } // namespace
+
+  bool IsValidRelativePath(const std::string& path)
+  {
+    size_t begin = 0;
+    while (true)
+    {
+      const size_t end = (std::min)(path.find('/', begin), path.length());
+      const std::string component = path.substr(begin, end - begin);
+      if (component.empty() || component == "." || component == "..")
+      {
+        return false;
+      }
+#if defined(AZ_PLATFORM_WINDOWS)
+      if (component.find_first_of("\\:") != std::string::npos)
+      {
+        return false;
+      }
+#endif
+      if (end == path.length())
+      {
+        return true;
+      }
+      begin = end + 1;
+    }
+  }
+
+  BulkTransferResult BulkTransfer(
+      const std::vector<BulkTransferItem>& items,
+      const BulkTransferOptions& options,
+      const BulkTransferOperations& operations,
+      const Azure::Core::Context& context)
+  {
+    const bool hasChunkedFiles
+        = std::any_of(items.begin(), items.end(), [&](const BulkTransferItem& item) {
+            return item.Size > options.SingleTransferThreshold;
+          });
+    if (hasChunkedFiles && (options.ChunkSize <= 0 || options.MaxChunkCount <= 0))
+    {
+      throw std::invalid_argument("ChunkSize and MaxChunkCount must be positive.");
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+    BulkTransferResult result;
+    BulkTransferProgress progress;
+    progress.TotalFiles = static_cast<int64_t>(items.size());
+    for (const auto& item : items)
+    {
+      progress.TotalBytes += item.Size;
+    }
+
+    // Guards everything below, except the progress handler which is serialized by progressMutex.
+    std::mutex mutex;
+    std::mutex progressMutex;
+    std::condition_variable taskDone;
+    std::deque<Task> readyTasks;
+    std::unordered_map<size_t, ChunkedFile> chunkedFiles;
+    size_t nextItem = 0;
+    int inFlight = 0;
+    int64_t bytesInFlight = 0;
+
+    auto completeFile = [&](size_t item, bool succeeded, const std::string& error) {
+      if (succeeded)
+      {
+        ++progress.TransferredFiles;
+      }
+      else
+      {
+        ++progress.FailedFiles;
+        result.FailedFiles[items[item].Path] = error;
+      }
+    };
+
+    auto scheduleChunks = [&](size_t item) {
+      const int64_t size = items[item].Size;
+      // The ceilings are computed so that they can't overflow.
+      const int64_t chunkSize = (std::max)(
+          options.ChunkSize,
+          size / options.MaxChunkCount + (size % options.MaxChunkCount != 0 ? 1 : 0));
+      auto& file = chunkedFiles[item];
+      file.NumChunks = size / chunkSize + (size % chunkSize != 0 ? 1 : 0);
+      file.PendingChunks = file.NumChunks;
+      for (int64_t chunkId = 0; chunkId < file.NumChunks; ++chunkId)
+      {
+        Task task;
+        task.Item = item;
+        task.Kind = TaskKind::TransferChunk;
+        task.Offset = chunkId * chunkSize;
+        task.Length = (std::min)(chunkSize, size - task.Offset);
+        task.ChunkId = chunkId;
+        readyTasks.push_back(task);
+      }
+    };
+
+    auto startNextItem = [&]() {
+      Task task;
+      task.Item = nextItem++;
+      if (items[task.Item].Size <= options.SingleTransferThreshold)
+      {
+        readyTasks.push_back(task);
+        return;
+      }
+      chunkedFiles[task.Item] = ChunkedFile();
+      if (operations.PrepareChunks)
+      {
+        task.Kind = TaskKind::PrepareChunks;
+        readyTasks.push_back(task);
+      }
+      else
+      {
+        scheduleChunks(task.Item);
+      }
+    };
+
+    auto onTaskDone = [&](const Task& task, bool succeeded, const std::string& error) {
+      switch (task.Kind)
+      {
+        case TaskKind::TransferFile:
+          if (succeeded)
+          {
+            progress.TransferredBytes += items[task.Item].Size;
+          }
+          completeFile(task.Item, succeeded, error);
+          break;
+        case TaskKind::PrepareChunks:
+          if (succeeded)
+          {
+            scheduleChunks(task.Item);
+          }
+          else
+          {
+            chunkedFiles.erase(task.Item);
+            completeFile(task.Item, false, error);
+          }
+          break;
+        case TaskKind::TransferChunk: {
+          auto& file = chunkedFiles[task.Item];
+          if (succeeded)
+          {
+            progress.TransferredBytes += task.Length;
+          }
+          else if (!file.Failed)
+          {
+            file.Failed = true;
+            file.Error = error;
+          }
+          if (--file.PendingChunks != 0)
+          {
+            break;
+          }
+          if (!file.Failed && operations.CommitChunks)
+          {
+            Task commitTask = task;
+            commitTask.Kind = TaskKind::CommitChunks;
+            commitTask.NumChunks = file.NumChunks;
+            readyTasks.push_front(commitTask);
+            break;
+          }
+          completeFile(task.Item, !file.Failed, file.Error);
+          chunkedFiles.erase(task.Item);
+          break;
+        }
+        case TaskKind::CommitChunks:
+          chunkedFiles.erase(task.Item);
+          completeFile(task.Item, succeeded, error);
+          break;
+      }
+    };
+
+    auto runTask = [&](const Task& task) {
+      const auto& item = items[task.Item];
+      switch (task.Kind)
+      {
+        case TaskKind::TransferFile:
+          operations.TransferFile(item, context);
+          break;
+        case TaskKind::PrepareChunks:
+          operations.PrepareChunks(item, context);
+          break;
+        case TaskKind::TransferChunk:
+          operations.TransferChunk(item, task.Offset, task.Length, task.ChunkId, context);
+          break;
+        case TaskKind::CommitChunks:
+          operations.CommitChunks(item, task.NumChunks, context);
+          break;
+      }
+    };
+
+    auto threadFunc = [&]() {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (!context.IsCancelled())
+      {
+        if (readyTasks.empty() && nextItem < items.size())
+        {
+          startNextItem();
+        }
+        if (readyTasks.empty())
+        {
+          if (inFlight == 0)
+          {
+            break;
+          }
+          // A task in flight may schedule more tasks.
+          taskDone.wait(lock);
+          continue;
+        }
+
+        const Task task = readyTasks.front();
+        int64_t taskBytes = 0;
+        if (task.Kind == TaskKind::TransferFile)
+        {
+          taskBytes = items[task.Item].Size;
+        }
+        else if (task.Kind == TaskKind::TransferChunk)
+        {
+          taskBytes = task.Length;
+          if (chunkedFiles[task.Item].Failed)
+          {
+            readyTasks.pop_front();
+            onTaskDone(task, false, std::string());
+            continue;
+          }
+        }
+        if (inFlight != 0 && taskBytes > options.MaxBytesInFlight - bytesInFlight)
+        {
+          taskDone.wait(lock);
+          continue;
+        }
+        readyTasks.pop_front();
+        ++inFlight;
+        bytesInFlight += taskBytes;
+        lock.unlock();
+
+        bool succeeded = true;
+        std::string error;
+        try
+        {
+          runTask(task);
+        }
+        catch (const std::exception& e)
+        {
+          succeeded = false;
+          error = e.what();
+        }
+
+        lock.lock();
+        --inFlight;
+        bytesInFlight -= taskBytes;
+        onTaskDone(task, succeeded, error);
+        taskDone.notify_all();
+
+        if (options.ProgressHandler)
+        {
+          BulkTransferProgress currentProgress = progress;
+          const double seconds
+              = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime)
+                    .count();
+          currentProgress.BytesPerSecond = seconds > 0.0
+              ? static_cast<double>(currentProgress.TransferredBytes) / seconds
+              : 0.0;
+          // Taken before releasing the lock, so that the progress is reported in order.
+          std::unique_lock<std::mutex> progressLock(progressMutex);
+          lock.unlock();
+          options.ProgressHandler(currentProgress);
+          progressLock.unlock();
+          lock.lock();
+        }
+      }
+      taskDone.notify_all();
+    };
+
+    std::vector<std::future<void>> threadHandles;
+    const int numThreads = items.empty() ? 1 : (std::max)(options.Concurrency, 1);
+    for (int i = 0; i < numThreads - 1; ++i)
+    {
+      threadHandles.emplace_back(std::async(std::launch::async, threadFunc));
+    }
+    threadFunc();
+    for (auto& handle : threadHandles)
+    {
+      handle.get();
+    }
+    context.ThrowIfCancelled();
+
+    result.TransferredFiles = progress.TransferredFiles;
+    result.TransferredBytes = progress.TransferredBytes;
+    return result;
+  }
+
+}}} // namespace Azure::Storage::_internal
@@ -0,0 +1,187 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/storage/common/internal/concurrent_transfer.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace Azure { namespace Storage { namespace _internal {
+
+  Azure::Core::Context::Key const ThrottledResponseCountKey;
+
+  namespace {
+    // Larger chunks make retries expensive and leave threads idle at the end of the transfer.
+    constexpr int64_t MaxAdaptiveChunkSize = 64 * 1024 * 1024;
+    // Goodput changes smaller than this are considered noise.
+    constexpr double GoodputImprovementRatio = 1.05;
+    constexpr double GoodputDeclineRatio = 0.8;
+
+    // The state of an adaptive transfer, guarded by Mutex.
+    struct AdaptiveTransferState final
+    {
+      std::mutex Mutex;
+      std::condition_variable ChunkDone;
+      int64_t NextOffset = 0;
+      int64_t NextChunkId = 0;
+      int64_t ChunkSize = 0;
+      int InFlight = 0;
+      int ConcurrencyLimit = 1;
+      bool SlowStart = true;
+      bool Failed = false;
+
+      // The current round, which ends when as many chunks as the concurrency limit are done.
+      std::chrono::steady_clock::time_point RoundStart;
+      int RoundChunks = 0;
+      int64_t RoundBytes = 0;
+      int64_t RoundThrottledResponses = 0;
+      double LastGoodput = 0.0;
+    };
+  } // namespace
+
+  void AdaptiveConcurrentTransfer(
+      int64_t offset,
+      int64_t length,
+      int64_t chunkSize,
+      int64_t maxChunkSize,
+      int concurrency,
+      const Azure::Core::Context& context,
+      const std::function<
+          void(int64_t, int64_t, int64_t, int64_t, const Azure::Core::Context&)>& transferFunc)
+  {
+    if (length <= 0)
+    {
+      return;
+    }
+    maxChunkSize = (std::max)(chunkSize, (std::min)(maxChunkSize, MaxAdaptiveChunkSize));
+    concurrency = (std::max)(concurrency, 1);
+    const int64_t endOffset = offset + length;
+
+    auto throttledResponses = std::make_shared<std::atomic<int64_t>>(0);
+    const auto transferContext = context.WithValue(ThrottledResponseCountKey, throttledResponses);
+
+    AdaptiveTransferState state;
+    state.NextOffset = offset;
+    state.ChunkSize = chunkSize;
+    state.RoundStart = std::chrono::steady_clock::now();
+
+    // Called with the mutex held.
+    auto endRound = [&]() {
+      const auto now = std::chrono::steady_clock::now();
+      const double seconds = std::chrono::duration<double>(now - state.RoundStart).count();
+      const double goodput = seconds > 0.0 ? static_cast<double>(state.RoundBytes) / seconds : 0.0;
+      const int64_t throttled = throttledResponses->load();
+
+      if (throttled != state.RoundThrottledResponses)
+      {
+        state.ConcurrencyLimit = (std::max)(state.ConcurrencyLimit / 2, 1);
+        state.ChunkSize = (std::max)(state.ChunkSize / 2, chunkSize);
+        state.SlowStart = false;
+      }
+      else if (goodput >= state.LastGoodput * GoodputImprovementRatio)
+      {
+        state.ConcurrencyLimit = (std::min)(
+            state.SlowStart ? state.ConcurrencyLimit * 2 : state.ConcurrencyLimit + 1,
+            concurrency);
+        state.ChunkSize = (std::min)(state.ChunkSize + chunkSize, maxChunkSize);
+      }
+      else
+      {
+        state.SlowStart = false;
+        if (goodput < state.LastGoodput * GoodputDeclineRatio)
+        {
+          state.ConcurrencyLimit = (std::max)(state.ConcurrencyLimit * 3 / 4, 1);
+        }
+      }
+
+      state.LastGoodput = goodput;
+      state.RoundThrottledResponses = throttled;
+      state.RoundStart = now;
+      state.RoundChunks = 0;
+      state.RoundBytes = 0;
+    };
+
+    auto threadFunc = [&]() {
+      std::unique_lock<std::mutex> lock(state.Mutex);
+      while (true)
+      {
+        state.ChunkDone.wait(lock, [&]() {
+          return state.Failed || state.NextOffset >= endOffset
+              || state.InFlight < state.ConcurrencyLimit;
+        });
+        if (state.Failed || state.NextOffset >= endOffset)
+        {
+          break;
+        }
+        const int64_t chunkOffset = state.NextOffset;
+        const int64_t chunkLength = (std::min)(state.ChunkSize, endOffset - chunkOffset);
+        const int64_t chunkId = state.NextChunkId++;
+        state.NextOffset += chunkLength;
+        const int64_t numChunks
+            = chunkId + 1 + (endOffset - state.NextOffset + state.ChunkSize - 1) / state.ChunkSize;
+        ++state.InFlight;
+        lock.unlock();
+
+        try
+        {
+          transferFunc(chunkOffset, chunkLength, chunkId, numChunks, transferContext);
+        }
+        catch (const std::exception&)
+        {
+          lock.lock();
+          --state.InFlight;
+          const bool firstFailure = !state.Failed;
+          state.Failed = true;
+          state.ChunkDone.notify_all();
+          if (firstFailure)
+          {
+            throw;
+          }
+          break;
+        }
+
+        lock.lock();
+        --state.InFlight;
+        state.RoundBytes += chunkLength;
+        if (++state.RoundChunks >= state.ConcurrencyLimit)
+        {
+          endRound();
+        }
+        state.ChunkDone.notify_all();
+      }
+    };
+
+    const int64_t maxNumChunks = (length + chunkSize - 1) / chunkSize;
+    std::vector<std::future<void>> threadHandles;
+    for (int i = 0; i < std::min<int64_t>(concurrency, maxNumChunks) - 1; ++i)
+    {
+      threadHandles.emplace_back(std::async(std::launch::async, threadFunc));
+    }
+    std::exception_ptr failure;
+    try
+    {
+      threadFunc();
+    }
+    catch (const std::exception&)
+    {
+      failure = std::current_exception();
+    }
+    for (auto& handle : threadHandles)
+    {
+      try
+      {
+        handle.get();
+      }
+      catch (const std::exception&)
+      {
+        failure = std::current_exception();
+      }
+    }
+    if (failure)
+    {
+      std::rethrow_exception(failure);
+    }
+  }
+
+}}} // namespace Azure::Storage::_internal
@@ -26,6 +26,7 @@
 #include <azure/core/http/http.hpp>
 
 #include <algorithm>
+#include <memory>
 #include <stdexcept>
 #include <vector>
 
@@ -196,6 +197,60 @@ namespace Azure { namespace Storage {
 
       return hash;
     }
+
+    struct HmacSha256Context::Implementation final
+    {
+      std::vector<uint8_t> Key;
+    };
+
+    HmacSha256Context::HmacSha256Context(const std::vector<uint8_t>& key)
+        : m_implementation(std::make_unique<Implementation>())
+    {
+      m_implementation->Key = key;
+    }
+
+    HmacSha256Context::~HmacSha256Context() = default;
+
+    void HmacSha256Context::Compute(const uint8_t* data, size_t length, uint8_t* hash) const
+    {
+      AZURE_ASSERT_MSG(length <= (std::numeric_limits<ULONG>::max)(), "Data size is too big.");
+
+      static AlgorithmProviderInstance AlgorithmProvider(AlgorithmType::HmacSha256);
+      // CNG processes the key when the hash object is created, so only the object's memory is
+      // reused.
+      thread_local std::vector<uint8_t> context(AlgorithmProvider.ContextSize);
+
+      const auto& key = m_implementation->Key;
+      BCRYPT_HASH_HANDLE hashHandle;
+      NTSTATUS status = BCryptCreateHash(
+          AlgorithmProvider.Handle,
+          &hashHandle,
+          reinterpret_cast<PUCHAR>(context.data()),
+          static_cast<ULONG>(context.size()),
+          reinterpret_cast<PUCHAR>(const_cast<uint8_t*>(key.data())),
+          static_cast<ULONG>(key.size()),
+          0);
+      if (!BCRYPT_SUCCESS(status))
+      {
+        throw std::runtime_error("BCryptCreateHash failed.");
+      }
+
+      status = BCryptHashData(
+          hashHandle,
+          reinterpret_cast<PBYTE>(const_cast<uint8_t*>(data)),
+          static_cast<ULONG>(length),
+          0);
+      if (BCRYPT_SUCCESS(status))
+      {
+        status = BCryptFinishHash(
+            hashHandle, reinterpret_cast<PUCHAR>(hash), static_cast<ULONG>(HashSize), 0);
+      }
+      BCryptDestroyHash(hashHandle);
+      if (!BCRYPT_SUCCESS(status))
+      {
+        throw std::runtime_error("BCryptHashData failed.");
+      }
+    }
   } // namespace _internal
 
 #elif defined(AZ_PLATFORM_POSIX)
@@ -220,10 +275,102 @@ namespace Azure { namespace Storage {
       return std::vector<uint8_t>(std::begin(hash), std::begin(hash) + hashLength);
     }
 
+    namespace {
+      struct DigestContextDeleter final
+      {
+        void operator()(EVP_MD_CTX* context) const { EVP_MD_CTX_free(context); }
+      };
+      using DigestContext = std::unique_ptr<EVP_MD_CTX, DigestContextDeleter>;
+
+      constexpr size_t Sha256BlockSize = 64;
+
+      DigestContext CreateDigestContext()
+      {
+        DigestContext context(EVP_MD_CTX_new());
+        if (!context || EVP_DigestInit_ex(context.get(), EVP_sha256(), nullptr) != 1)
+        {
+          throw std::runtime_error("Failed to initialize SHA256 context.");
+        }
+        return context;
+      }
+
+      void FinishDigest(EVP_MD_CTX* context, const uint8_t* data, size_t length, uint8_t* hash)
+      {
+        if (EVP_DigestUpdate(context, data, length) != 1
+            || EVP_DigestFinal_ex(context, hash, nullptr) != 1)
+        {
+          throw std::runtime_error("Failed to compute SHA256 hash.");
+        }
+      }
+    } // namespace
+
+    // HMAC(K, m) = H((K ^ opad) || H((K ^ ipad) || m)). Both pads fill one block, so the digest
+    // states after hashing them are computed once and copied for every hash.
+    struct HmacSha256Context::Implementation final
+    {
+      DigestContext Inner;
+      DigestContext Outer;
+    };
+
+    HmacSha256Context::HmacSha256Context(const std::vector<uint8_t>& key)
+        : m_implementation(std::make_unique<Implementation>())
+    {
+      uint8_t blockKey[Sha256BlockSize] = {};
+      if (key.size() > Sha256BlockSize)
+      {
+        FinishDigest(CreateDigestContext().get(), key.data(), key.size(), blockKey);
+      }
+      else
+      {
+        std::copy(key.begin(), key.end(), blockKey);
+      }
+
+      uint8_t pad[Sha256BlockSize];
+      m_implementation->Inner = CreateDigestContext();
+      std::transform(
+          std::begin(blockKey), std::end(blockKey), pad, [](uint8_t b) { return b ^ 0x36; });
+      bool succeeded = EVP_DigestUpdate(m_implementation->Inner.get(), pad, sizeof(pad)) == 1;
+      m_implementation->Outer = CreateDigestContext();
+      std::transform(
+          std::begin(blockKey), std::end(blockKey), pad, [](uint8_t b) { return b ^ 0x5c; });
+      succeeded = succeeded
+          && EVP_DigestUpdate(m_implementation->Outer.get(), pad, sizeof(pad)) == 1;
+      if (!succeeded)
+      {
+        throw std::runtime_error("Failed to initialize HMAC-SHA256 context.");
+      }
+    }
+
+    HmacSha256Context::~HmacSha256Context() = default;
+
+    void HmacSha256Context::Compute(const uint8_t* data, size_t length, uint8_t* hash) const
+    {
+      // Reused so that computing a hash doesn't allocate a context every time.
+      thread_local DigestContext context(EVP_MD_CTX_new());
+      if (!context)
+      {
+        throw std::runtime_error("Failed to allocate SHA256 context.");
+      }
+
+      uint8_t innerHash[HashSize];
+      if (EVP_MD_CTX_copy_ex(context.get(), m_implementation->Inner.get()) != 1)
+      {
+        throw std::runtime_error("Failed to copy SHA256 context.");
+      }
+      FinishDigest(context.get(), data, length, innerHash);
+      if (EVP_MD_CTX_copy_ex(context.get(), m_implementation->Outer.get()) != 1)
+      {
+        throw std::runtime_error("Failed to copy SHA256 context.");
+      }
+      FinishDigest(context.get(), innerHash, sizeof(innerHash), hash);
+    }
+
   } // namespace _internal
 
 #endif
 
+  constexpr size_t _internal::HmacSha256Context::HashSize;
+
   static constexpr uint64_t Crc64Poly = 0x9A6C9329AC4BC9B5ULL;
   static constexpr uint64_t Crc64MU1[] = {
       0x0000000000000000ULL, 0x7f6ef0c830358979ULL, 0xfedde190606b12f2ULL, 0x81b31158505e9b8bULL,
@@ -6,9 +6,12 @@
 #include <azure/core/platform.hpp>
 
 #if defined(AZ_PLATFORM_POSIX)
+#include <dirent.h>
+#include <errno.h>
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #endif
@@ -21,55 +24,258 @@
 #define NOMINMAX
 #endif
 #include <windows.h>
+
+#include <winioctl.h>
 #endif
 
+#include <azure/core/exception.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
+#include <new>
 #include <stdexcept>
 
 namespace Azure { namespace Storage { namespace _internal {
 
-#if defined(AZ_PLATFORM_WINDOWS)
-  FileReader::FileReader(const std::string& filename)
+  namespace {
+    // The alignment of the offsets, lengths and buffers of direct I/O, which is a multiple of the
+    // logical block size of common file systems.
+    constexpr int64_t DirectIoAlignment = 4096;
+
+    constexpr char JournalMagic[] = "AZSJRNL1";
+
+    // The magic, the number of chunks, the length of the key and the key. The bitmap follows.
+    std::vector<uint8_t> GetJournalHeader(const std::string& key, int64_t numChunks)
+    {
+      std::vector<uint8_t> header(JournalMagic, JournalMagic + sizeof(JournalMagic) - 1);
+      for (const uint64_t value :
+           {static_cast<uint64_t>(numChunks), static_cast<uint64_t>(key.length())})
+      {
+        for (int i = 0; i < 8; ++i)
+        {
+          header.push_back(static_cast<uint8_t>(value >> (i * 8)));
+        }
+      }
+      header.insert(header.end(), key.begin(), key.end());
+      return header;
+    }
+  } // namespace
+
+  bool TransferJournal::IsChunkDone(int64_t chunkId) const
   {
-    int sizeNeeded = MultiByteToWideChar(
-        CP_UTF8,
-        MB_ERR_INVALID_CHARS,
-        filename.data(),
-        static_cast<int>(filename.length()),
-        nullptr,
-        0);
-    if (sizeNeeded == 0)
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_bitmap == nullptr || chunkId < 0 || chunkId >= m_numChunks)
     {
-      throw std::runtime_error("Invalid filename.");
+      return false;
     }
-    std::wstring filenameW(sizeNeeded, L'\0');
-    if (MultiByteToWideChar(
-            CP_UTF8,
-            MB_ERR_INVALID_CHARS,
-            filename.data(),
-            static_cast<int>(filename.length()),
-            &filenameW[0],
-            sizeNeeded)
-        == 0)
+    return (m_bitmap[chunkId / 8] & (1 << (chunkId % 8))) != 0;
+  }
+
+  void TransferJournal::SetChunkDone(int64_t chunkId)
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_bitmap == nullptr || chunkId < 0 || chunkId >= m_numChunks)
     {
-      throw std::runtime_error("Invalid filename.");
+      return;
     }
+    m_bitmap[chunkId / 8] = static_cast<uint8_t>(m_bitmap[chunkId / 8] | (1 << (chunkId % 8)));
+  }
 
-    HANDLE fileHandle;
+  TransferJournal::~TransferJournal() { Close(); }
 
+#if defined(AZ_PLATFORM_WINDOWS)
+  namespace {
+    std::wstring ToWideString(const std::string& str)
+    {
+      if (str.empty())
+      {
+        return std::wstring();
+      }
+      int sizeNeeded = MultiByteToWideChar(
+          CP_UTF8, MB_ERR_INVALID_CHARS, str.data(), static_cast<int>(str.length()), nullptr, 0);
+      if (sizeNeeded == 0)
+      {
+        throw std::runtime_error("Invalid path.");
+      }
+      std::wstring strW(sizeNeeded, L'\0');
+      if (MultiByteToWideChar(
+              CP_UTF8,
+              MB_ERR_INVALID_CHARS,
+              str.data(),
+              static_cast<int>(str.length()),
+              &strW[0],
+              sizeNeeded)
+          == 0)
+      {
+        throw std::runtime_error("Invalid path.");
+      }
+      return strW;
+    }
+
+    std::string ToUtf8String(const std::wstring& strW)
+    {
+      if (strW.empty())
+      {
+        return std::string();
+      }
+      int sizeNeeded = WideCharToMultiByte(
+          CP_UTF8, 0, strW.data(), static_cast<int>(strW.length()), nullptr, 0, nullptr, nullptr);
+      if (sizeNeeded == 0)
+      {
+        throw std::runtime_error("Invalid path.");
+      }
+      std::string str(sizeNeeded, '\0');
+      if (WideCharToMultiByte(
+              CP_UTF8,
+              0,
+              strW.data(),
+              static_cast<int>(strW.length()),
+              &str[0],
+              sizeNeeded,
+              nullptr,
+              nullptr)
+          == 0)
+      {
+        throw std::runtime_error("Invalid path.");
+      }
+      return str;
+    }
+
+    struct AlignedBufferDeleter final
+    {
+      void operator()(uint8_t* buffer) const { _aligned_free(buffer); }
+    };
+
+    using AlignedBuffer = std::unique_ptr<uint8_t[], AlignedBufferDeleter>;
+
+    AlignedBuffer AllocateAlignedBuffer(size_t size)
+    {
+      void* buffer = _aligned_malloc(size, DirectIoAlignment);
+      if (buffer == nullptr)
+      {
+        throw std::bad_alloc();
+      }
+      return AlignedBuffer(static_cast<uint8_t*>(buffer));
+    }
+
+    HANDLE OpenFileHandle(
+        const std::string& filename,
+        DWORD desiredAccess,
+        DWORD shareMode,
+        DWORD creationDisposition,
+        DWORD flags)
+    {
+      const std::wstring filenameW = ToWideString(filename);
 #if !defined(WINAPI_PARTITION_DESKTOP) \
     || WINAPI_PARTITION_DESKTOP // See azure/core/platform.hpp for explanation.
-    fileHandle = CreateFileW(
-        filenameW.data(),
-        GENERIC_READ,
-        FILE_SHARE_READ,
-        nullptr,
-        OPEN_EXISTING,
-        FILE_ATTRIBUTE_NORMAL,
-        NULL);
+      return CreateFileW(
+          filenameW.data(),
+          desiredAccess,
+          shareMode,
+          nullptr,
+          creationDisposition,
+          FILE_ATTRIBUTE_NORMAL | flags,
+          NULL);
 #else
-    fileHandle = CreateFile2(filenameW.data(), GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, NULL);
+      CREATEFILE2_EXTENDED_PARAMETERS parameters;
+      std::memset(&parameters, 0, sizeof(parameters));
+      parameters.dwSize = sizeof(parameters);
+      parameters.dwFileAttributes = FILE_ATTRIBUTE_NORMAL;
+      parameters.dwFileFlags = flags;
+      return CreateFile2(
+          filenameW.data(), desiredAccess, shareMode, creationDisposition, &parameters);
 #endif
+    }
+
+    // Reads up to length bytes, fewer only at the end of the file.
+    size_t ReadFileAt(HANDLE handle, uint8_t* buffer, size_t length, int64_t offset)
+    {
+      // Keeps the length aligned for direct I/O.
+      constexpr size_t MaxReadSize = 1024 * 1024 * 1024;
+      OVERLAPPED overlapped;
+      std::memset(&overlapped, 0, sizeof(overlapped));
+      overlapped.Offset = static_cast<DWORD>(static_cast<uint64_t>(offset));
+      overlapped.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(offset) >> 32);
+
+      DWORD bytesRead = 0;
+      if (!ReadFile(
+              handle,
+              buffer,
+              static_cast<DWORD>((std::min)(length, MaxReadSize)),
+              &bytesRead,
+              &overlapped)
+          && GetLastError() != ERROR_HANDLE_EOF)
+      {
+        throw std::runtime_error("Failed to read file.");
+      }
+      return static_cast<size_t>(bytesRead);
+    }
+
+    void WriteFileAt(HANDLE handle, const uint8_t* buffer, size_t length, int64_t offset)
+    {
+      if (length > (std::numeric_limits<DWORD>::max)())
+      {
+        throw std::runtime_error("Failed to write file.");
+      }
+
+      OVERLAPPED overlapped;
+      std::memset(&overlapped, 0, sizeof(overlapped));
+      overlapped.Offset = static_cast<DWORD>(static_cast<uint64_t>(offset));
+      overlapped.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(offset) >> 32);
+
+      DWORD bytesWritten;
+      BOOL ret = WriteFile(handle, buffer, static_cast<DWORD>(length), &bytesWritten, &overlapped);
+      if (!ret)
+      {
+        throw std::runtime_error("Failed to write file.");
+      }
+    }
+
+    uint8_t* MapFile(HANDLE fileHandle, int64_t size, bool writable, void*& mappingHandle)
+    {
+      const DWORD protection = writable ? PAGE_READWRITE : PAGE_READONLY;
+      const DWORD access = writable ? FILE_MAP_WRITE : FILE_MAP_READ;
+#if !defined(WINAPI_PARTITION_DESKTOP) \
+    || WINAPI_PARTITION_DESKTOP // See azure/core/platform.hpp for explanation.
+      HANDLE mapping = CreateFileMappingW(fileHandle, nullptr, protection, 0, 0, nullptr);
+#else
+      HANDLE mapping = CreateFileMappingFromApp(fileHandle, nullptr, protection, 0, nullptr);
+#endif
+      if (mapping == NULL)
+      {
+        throw std::runtime_error("Failed to map file.");
+      }
+#if !defined(WINAPI_PARTITION_DESKTOP) \
+    || WINAPI_PARTITION_DESKTOP // See azure/core/platform.hpp for explanation.
+      void* view = MapViewOfFile(mapping, access, 0, 0, static_cast<SIZE_T>(size));
+#else
+      void* view = MapViewOfFileFromApp(mapping, access, 0, static_cast<SIZE_T>(size));
+#endif
+      if (view == nullptr)
+      {
+        CloseHandle(mapping);
+        throw std::runtime_error("Failed to map file.");
+      }
+      mappingHandle = static_cast<void*>(mapping);
+      return static_cast<uint8_t*>(view);
+    }
+  } // namespace
+
+  FileReader::FileReader(const std::string& filename, FileIoMode mode) : m_mode(mode)
+  {
+    DWORD flags = 0;
+    if (m_mode == FileIoMode::Direct)
+    {
+      flags = FILE_FLAG_NO_BUFFERING;
+    }
+    else if (m_mode == FileIoMode::MemoryMapped)
+    {
+      flags = FILE_FLAG_SEQUENTIAL_SCAN;
+    }
+    HANDLE fileHandle
+        = OpenFileHandle(filename, GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, flags);
     if (fileHandle == INVALID_HANDLE_VALUE)
     {
       throw std::runtime_error("Failed to open file.");
@@ -84,89 +290,405 @@ namespace Azure { namespace Storage { namespace _internal {
     }
     m_handle = static_cast<void*>(fileHandle);
     m_fileSize = fileSize.QuadPart;
+
+    if (m_mode == FileIoMode::MemoryMapped && m_fileSize > 0)
+    {
+      try
+      {
+        m_mappedView = MapFile(fileHandle, m_fileSize, false, m_mappingHandle);
+      }
+      catch (...)
+      {
+        CloseHandle(fileHandle);
+        throw;
+      }
+    }
   }
 
-  FileReader::~FileReader() { CloseHandle(static_cast<HANDLE>(m_handle)); }
+  FileReader::~FileReader()
+  {
+    if (m_mappedView != nullptr)
+    {
+      UnmapViewOfFile(m_mappedView);
+      CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+    }
+    CloseHandle(static_cast<HANDLE>(m_handle));
+  }
 
-  FileWriter::FileWriter(const std::string& filename)
+  FileWriter::FileWriter(
+      const std::string& filename,
+      bool truncate,
+      FileIoMode mode,
+      int64_t fileSize,
+      bool sparse)
+      : m_mode(mode), m_directHandle(INVALID_HANDLE_VALUE)
   {
-    int sizeNeeded = MultiByteToWideChar(
-        CP_UTF8,
-        MB_ERR_INVALID_CHARS,
-        filename.data(),
-        static_cast<int>(filename.length()),
-        nullptr,
+    if (m_mode == FileIoMode::MemoryMapped && fileSize < 0)
+    {
+      m_mode = FileIoMode::Buffered;
+    }
+    const bool mapped = m_mode == FileIoMode::MemoryMapped;
+    HANDLE fileHandle = OpenFileHandle(
+        filename,
+        mapped ? GENERIC_READ | GENERIC_WRITE : GENERIC_WRITE,
+        FILE_SHARE_READ | FILE_SHARE_WRITE,
+        truncate ? CREATE_ALWAYS : OPEN_ALWAYS,
         0);
-    if (sizeNeeded == 0)
+    if (fileHandle == INVALID_HANDLE_VALUE)
+    {
+      throw std::runtime_error("Failed to open file.");
+    }
+    m_handle = static_cast<void*>(fileHandle);
+
+    if (sparse)
     {
-      throw std::runtime_error("Invalid filename.");
+      // Fails on file systems without sparse files, whose ranges not written are then allocated.
+      DWORD bytesReturned = 0;
+      DeviceIoControl(
+          fileHandle, FSCTL_SET_SPARSE, nullptr, 0, nullptr, 0, &bytesReturned, nullptr);
     }
-    std::wstring filenameW(sizeNeeded, L'\0');
-    if (MultiByteToWideChar(
-            CP_UTF8,
-            MB_ERR_INVALID_CHARS,
-            filename.data(),
-            static_cast<int>(filename.length()),
-            &filenameW[0],
-            sizeNeeded)
-        == 0)
+
+    if ((mapped || sparse) && fileSize >= 0)
     {
-      throw std::runtime_error("Invalid filename.");
+      LARGE_INTEGER size;
+      size.QuadPart = fileSize;
+      if (!SetFilePointerEx(fileHandle, size, nullptr, FILE_BEGIN) || !SetEndOfFile(fileHandle))
+      {
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Failed to set size of file.");
+      }
     }
 
-    HANDLE fileHandle;
+    if (mapped)
+    {
+      if (fileSize > 0)
+      {
+        try
+        {
+          m_mappedView = MapFile(fileHandle, fileSize, true, m_mappingHandle);
+        }
+        catch (...)
+        {
+          CloseHandle(fileHandle);
+          throw;
+        }
+      }
+      m_mappedSize = fileSize;
+    }
+    else if (m_mode == FileIoMode::Direct)
+    {
+      m_directHandle = static_cast<void*>(OpenFileHandle(
+          filename,
+          GENERIC_WRITE,
+          FILE_SHARE_READ | FILE_SHARE_WRITE,
+          OPEN_EXISTING,
+          FILE_FLAG_NO_BUFFERING | FILE_FLAG_WRITE_THROUGH));
+      if (m_directHandle == INVALID_HANDLE_VALUE)
+      {
+        m_mode = FileIoMode::Buffered;
+      }
+    }
+  }
+
+  FileWriter::~FileWriter()
+  {
+    if (m_mappedView != nullptr)
+    {
+      UnmapViewOfFile(m_mappedView);
+      CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+    }
+    if (m_directHandle != INVALID_HANDLE_VALUE)
+    {
+      CloseHandle(static_cast<HANDLE>(m_directHandle));
+    }
+    CloseHandle(static_cast<HANDLE>(m_handle));
+  }
+
+  std::vector<LocalFileInfo> ListFilesRecursively(const std::string& directory)
+  {
+    std::vector<LocalFileInfo> files;
+    // Relative paths of the directories left to list, ending with a separator.
+    std::vector<std::string> pendingDirectories{std::string()};
+    while (!pendingDirectories.empty())
+    {
+      const std::string relativePath = std::move(pendingDirectories.back());
+      pendingDirectories.pop_back();
+
+      const std::wstring pattern = ToWideString(directory + "\\" + relativePath + "*");
+      WIN32_FIND_DATAW findData;
+      HANDLE findHandle = FindFirstFileExW(
+          pattern.data(), FindExInfoBasic, &findData, FindExSearchNameMatch, nullptr, 0);
+      if (findHandle == INVALID_HANDLE_VALUE)
+      {
+        throw std::runtime_error("Failed to list directory.");
+      }
+      do
+      {
+        const std::wstring name = findData.cFileName;
+        if (name == L"." || name == L"..")
+        {
+          continue;
+        }
+        const std::string path = relativePath + ToUtf8String(name);
+        if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+        {
+          if (!(findData.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT))
+          {
+            pendingDirectories.push_back(path + "/");
+          }
+        }
+        else
+        {
+          LocalFileInfo file;
+          file.Path = path;
+          file.Size = static_cast<int64_t>(
+              (static_cast<uint64_t>(findData.nFileSizeHigh) << 32) | findData.nFileSizeLow);
+          files.push_back(std::move(file));
+        }
+      } while (FindNextFileW(findHandle, &findData));
+      FindClose(findHandle);
+    }
+    return files;
+  }
 
+  void CreateDirectories(const std::string& path)
+  {
+    for (size_t pos = path.find_first_of("/\\", 1); true; pos = path.find_first_of("/\\", pos + 1))
+    {
+      const std::string parent = path.substr(0, pos);
+      // Drive roots, such as "C:", can't be created.
+      if (!parent.empty() && parent.back() != ':')
+      {
+        const std::wstring parentW = ToWideString(parent);
+        if (!CreateDirectoryW(parentW.data(), nullptr) && GetLastError() != ERROR_ALREADY_EXISTS)
+        {
+          throw std::runtime_error("Failed to create directory.");
+        }
+      }
+      if (pos == std::string::npos)
+      {
+        break;
+      }
+    }
+  }
+
+  int64_t FileReader::GetLastWriteTime() const
+  {
+    FILE_BASIC_INFO basicInfo;
+    if (!GetFileInformationByHandleEx(
+            static_cast<HANDLE>(m_handle), FileBasicInfo, &basicInfo, sizeof(basicInfo)))
+    {
+      throw std::runtime_error("Failed to get last write time of file.");
+    }
+    return basicInfo.LastWriteTime.QuadPart;
+  }
+
+  TransferJournal::TransferJournal(
+      const std::string& filename,
+      const std::string& key,
+      int64_t numChunks)
+      : m_filename(filename), m_numChunks(numChunks)
+  {
+    const std::vector<uint8_t> header = GetJournalHeader(key, numChunks);
+    m_mappedSize = header.size() + static_cast<size_t>((numChunks + 7) / 8);
+
+    const std::wstring filenameW = ToWideString(filename);
+    HANDLE fileHandle;
 #if !defined(WINAPI_PARTITION_DESKTOP) \
     || WINAPI_PARTITION_DESKTOP // See azure/core/platform.hpp for explanation.
     fileHandle = CreateFileW(
         filenameW.data(),
-        GENERIC_WRITE,
-        FILE_SHARE_READ | FILE_SHARE_WRITE,
+        GENERIC_READ | GENERIC_WRITE,
+        FILE_SHARE_READ,
         nullptr,
-        CREATE_ALWAYS,
+        OPEN_ALWAYS,
         FILE_ATTRIBUTE_NORMAL,
         NULL);
 #else
     fileHandle = CreateFile2(
-        filenameW.data(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, CREATE_ALWAYS, NULL);
+        filenameW.data(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, OPEN_ALWAYS, NULL);
 #endif
     if (fileHandle == INVALID_HANDLE_VALUE)
     {
-      throw std::runtime_error("Failed to open file.");
+      throw std::runtime_error("Failed to open journal file.");
     }
     m_handle = static_cast<void*>(fileHandle);
+
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(fileHandle, &fileSize)
+        && fileSize.QuadPart == static_cast<LONGLONG>(m_mappedSize))
+    {
+      std::vector<uint8_t> existingHeader(header.size());
+      OVERLAPPED overlapped;
+      std::memset(&overlapped, 0, sizeof(overlapped));
+      DWORD bytesRead = 0;
+      m_resumed = ReadFile(
+                      fileHandle,
+                      existingHeader.data(),
+                      static_cast<DWORD>(existingHeader.size()),
+                      &bytesRead,
+                      &overlapped)
+          && bytesRead == existingHeader.size() && existingHeader == header;
+    }
+    if (!m_resumed)
+    {
+      LARGE_INTEGER position;
+      position.QuadPart = 0;
+      bool initialized = SetFilePointerEx(fileHandle, position, nullptr, FILE_BEGIN)
+          && SetEndOfFile(fileHandle);
+      position.QuadPart = static_cast<LONGLONG>(m_mappedSize);
+      initialized = initialized && SetFilePointerEx(fileHandle, position, nullptr, FILE_BEGIN)
+          && SetEndOfFile(fileHandle);
+      OVERLAPPED overlapped;
+      std::memset(&overlapped, 0, sizeof(overlapped));
+      DWORD bytesWritten = 0;
+      initialized = initialized
+          && WriteFile(
+                        fileHandle,
+                        header.data(),
+                        static_cast<DWORD>(header.size()),
+                        &bytesWritten,
+                        &overlapped)
+          && bytesWritten == header.size();
+      if (!initialized)
+      {
+        CloseHandle(fileHandle);
+        throw std::runtime_error("Failed to initialize journal file.");
+      }
+    }
+
+#if !defined(WINAPI_PARTITION_DESKTOP) \
+    || WINAPI_PARTITION_DESKTOP // See azure/core/platform.hpp for explanation.
+    HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+#else
+    HANDLE mappingHandle
+        = CreateFileMappingFromApp(fileHandle, nullptr, PAGE_READWRITE, 0, nullptr);
+#endif
+    if (mappingHandle == NULL)
+    {
+      CloseHandle(fileHandle);
+      throw std::runtime_error("Failed to map journal file.");
+    }
+#if !defined(WINAPI_PARTITION_DESKTOP) \
+    || WINAPI_PARTITION_DESKTOP // See azure/core/platform.hpp for explanation.
+    void* view = MapViewOfFile(mappingHandle, FILE_MAP_WRITE, 0, 0, m_mappedSize);
+#else
+    void* view = MapViewOfFileFromApp(mappingHandle, FILE_MAP_WRITE, 0, m_mappedSize);
+#endif
+    if (view == nullptr)
+    {
+      CloseHandle(mappingHandle);
+      CloseHandle(fileHandle);
+      throw std::runtime_error("Failed to map journal file.");
+    }
+    m_mappingHandle = static_cast<void*>(mappingHandle);
+    m_mappedView = static_cast<uint8_t*>(view);
+    m_bitmap = m_mappedView + header.size();
   }
 
-  FileWriter::~FileWriter() { CloseHandle(static_cast<HANDLE>(m_handle)); }
+  void TransferJournal::Close()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_mappedView == nullptr)
+    {
+      return;
+    }
+    UnmapViewOfFile(m_mappedView);
+    CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+    CloseHandle(static_cast<HANDLE>(m_handle));
+    m_mappedView = nullptr;
+    m_bitmap = nullptr;
+  }
 
-  void FileWriter::Write(const uint8_t* buffer, size_t length, int64_t offset)
+  void TransferJournal::Remove()
   {
-    if (length > (std::numeric_limits<DWORD>::max)())
+    Close();
+    DeleteFileW(ToWideString(m_filename).data());
+  }
+#elif defined(AZ_PLATFORM_POSIX)
+  namespace {
+    struct AlignedBufferDeleter final
     {
-      throw std::runtime_error("Failed to write file.");
+      void operator()(uint8_t* buffer) const { free(buffer); }
+    };
+
+    using AlignedBuffer = std::unique_ptr<uint8_t[], AlignedBufferDeleter>;
+
+    AlignedBuffer AllocateAlignedBuffer(size_t size)
+    {
+      void* buffer = nullptr;
+      if (posix_memalign(&buffer, DirectIoAlignment, size) != 0)
+      {
+        throw std::bad_alloc();
+      }
+      return AlignedBuffer(static_cast<uint8_t*>(buffer));
     }
 
-    OVERLAPPED overlapped;
-    std::memset(&overlapped, 0, sizeof(overlapped));
-    overlapped.Offset = static_cast<DWORD>(static_cast<uint64_t>(offset));
-    overlapped.OffsetHigh = static_cast<DWORD>(static_cast<uint64_t>(offset) >> 32);
+    // Reads up to length bytes, fewer only at the end of the file.
+    size_t ReadFileAt(int handle, uint8_t* buffer, size_t length, int64_t offset)
+    {
+      if (offset > static_cast<int64_t>((std::numeric_limits<off_t>::max)()))
+      {
+        throw std::runtime_error("Failed to read file.");
+      }
+      ssize_t bytesRead = pread(handle, buffer, length, static_cast<off_t>(offset));
+      if (bytesRead < 0)
+      {
+        throw std::runtime_error("Failed to read file.");
+      }
+      return static_cast<size_t>(bytesRead);
+    }
 
-    DWORD bytesWritten;
-    BOOL ret = WriteFile(
-        static_cast<HANDLE>(m_handle),
-        buffer,
-        static_cast<DWORD>(length),
-        &bytesWritten,
-        &overlapped);
-    if (!ret)
+    void WriteFileAt(int handle, const uint8_t* buffer, size_t length, int64_t offset)
     {
-      throw std::runtime_error("Failed to write file.");
+      if (offset > static_cast<int64_t>((std::numeric_limits<off_t>::max)()))
+      {
+        throw std::runtime_error("Failed to write file.");
+      }
+      ssize_t bytesWritten = pwrite(handle, buffer, length, static_cast<off_t>(offset));
+      if (bytesWritten < 0 || static_cast<size_t>(bytesWritten) != length)
+      {
+        throw std::runtime_error("Failed to write file.");
+      }
     }
-  }
-#elif defined(AZ_PLATFORM_POSIX)
-  FileReader::FileReader(const std::string& filename)
+
+    uint8_t* MapFile(int handle, int64_t size, bool writable)
+    {
+      void* view = mmap(
+          nullptr,
+          static_cast<size_t>(size),
+          writable ? PROT_READ | PROT_WRITE : PROT_READ,
+          MAP_SHARED,
+          handle,
+          0);
+      if (view == MAP_FAILED)
+      {
+        throw std::runtime_error("Failed to map file.");
+      }
+      // Chunks are transferred from the beginning of the file to its end.
+      madvise(view, static_cast<size_t>(size), MADV_SEQUENTIAL);
+      return static_cast<uint8_t*>(view);
+    }
+  } // namespace
+
+  FileReader::FileReader(const std::string& filename, FileIoMode mode) : m_mode(mode)
   {
-    m_handle = open(filename.data(), O_RDONLY);
+    int flags = O_RDONLY;
+#if defined(O_DIRECT)
+    if (m_mode == FileIoMode::Direct)
+    {
+      flags |= O_DIRECT;
+    }
+#endif
+    m_handle = open(filename.data(), flags);
+#if defined(O_DIRECT)
+    if (m_handle == -1 && m_mode == FileIoMode::Direct && errno == EINVAL)
+    {
+      // The file system doesn't support direct I/O.
+      m_mode = FileIoMode::Buffered;
+      m_handle = open(filename.data(), O_RDONLY);
+    }
+#endif
     if (m_handle == -1)
     {
       throw std::runtime_error("Failed to open file.");
@@ -177,34 +699,431 @@ namespace Azure { namespace Storage { namespace _internal {
       close(m_handle);
       throw std::runtime_error("Failed to get size of file.");
     }
+#if !defined(O_DIRECT)
+    if (m_mode == FileIoMode::Direct)
+    {
+#if defined(F_NOCACHE)
+      // Doesn't require aligned reads, so the file is read like a buffered one.
+      fcntl(m_handle, F_NOCACHE, 1);
+#endif
+      m_mode = FileIoMode::Buffered;
+    }
+#endif
+
+    if (m_mode == FileIoMode::MemoryMapped && m_fileSize > 0)
+    {
+      try
+      {
+        m_mappedView = MapFile(m_handle, m_fileSize, false);
+      }
+      catch (...)
+      {
+        close(m_handle);
+        throw;
+      }
+    }
   }
 
-  FileReader::~FileReader() { close(m_handle); }
+  FileReader::~FileReader()
+  {
+    if (m_mappedView != nullptr)
+    {
+      munmap(m_mappedView, static_cast<size_t>(m_fileSize));
+    }
+    close(m_handle);
+  }
 
-  FileWriter::FileWriter(const std::string& filename)
+  FileWriter::FileWriter(
+      const std::string& filename,
+      bool truncate,
+      FileIoMode mode,
+      int64_t fileSize,
+      bool sparse)
+      : m_mode(mode), m_directHandle(-1)
   {
+    if (m_mode == FileIoMode::MemoryMapped && fileSize < 0)
+    {
+      m_mode = FileIoMode::Buffered;
+    }
+    const bool mapped = m_mode == FileIoMode::MemoryMapped;
     m_handle = open(
-        filename.data(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+        filename.data(),
+        (mapped ? O_RDWR : O_WRONLY) | O_CREAT | (truncate ? O_TRUNC : 0),
+        S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
     if (m_handle == -1)
     {
       throw std::runtime_error("Failed to open file.");
     }
+
+    // The ranges of a file extended with ftruncate are sparse where the file system supports it.
+    if ((mapped || sparse) && fileSize >= 0)
+    {
+      if (ftruncate(m_handle, static_cast<off_t>(fileSize)) != 0)
+      {
+        close(m_handle);
+        throw std::runtime_error("Failed to set size of file.");
+      }
+    }
+
+    if (mapped)
+    {
+      if (fileSize > 0)
+      {
+        try
+        {
+          m_mappedView = MapFile(m_handle, fileSize, true);
+        }
+        catch (...)
+        {
+          close(m_handle);
+          throw;
+        }
+      }
+      m_mappedSize = fileSize;
+    }
+    else if (m_mode == FileIoMode::Direct)
+    {
+#if defined(O_DIRECT)
+      m_directHandle = open(filename.data(), O_WRONLY | O_DIRECT);
+      if (m_directHandle == -1)
+      {
+        // The file system doesn't support direct I/O.
+        m_mode = FileIoMode::Buffered;
+      }
+#else
+#if defined(F_NOCACHE)
+      // Doesn't require aligned writes, so the file is written like a buffered one.
+      fcntl(m_handle, F_NOCACHE, 1);
+#endif
+      m_mode = FileIoMode::Buffered;
+#endif
+    }
+  }
+
+  FileWriter::~FileWriter()
+  {
+    if (m_mappedView != nullptr)
+    {
+      munmap(m_mappedView, static_cast<size_t>(m_mappedSize));
+    }
+    if (m_directHandle != -1)
+    {
+      close(m_directHandle);
+    }
+    close(m_handle);
   }
 
-  FileWriter::~FileWriter() { close(m_handle); }
+  std::vector<LocalFileInfo> ListFilesRecursively(const std::string& directory)
+  {
+    std::vector<LocalFileInfo> files;
+    // Relative paths of the directories left to list, ending with a separator.
+    std::vector<std::string> pendingDirectories{std::string()};
+    while (!pendingDirectories.empty())
+    {
+      const std::string relativePath = std::move(pendingDirectories.back());
+      pendingDirectories.pop_back();
 
-  void FileWriter::Write(const uint8_t* buffer, size_t length, int64_t offset)
+      DIR* dir = opendir((directory + "/" + relativePath).data());
+      if (dir == nullptr)
+      {
+        throw std::runtime_error("Failed to list directory.");
+      }
+      while (dirent* entry = readdir(dir))
+      {
+        const std::string name = entry->d_name;
+        if (name == "." || name == "..")
+        {
+          continue;
+        }
+        const std::string path = relativePath + name;
+        const std::string fullPath = directory + "/" + path;
+        struct stat fileStatus;
+        if (lstat(fullPath.data(), &fileStatus) != 0)
+        {
+          continue;
+        }
+        if (S_ISDIR(fileStatus.st_mode))
+        {
+          pendingDirectories.push_back(path + "/");
+          continue;
+        }
+        // Symbolic links to files are followed, unlike the ones to directories.
+        if (S_ISLNK(fileStatus.st_mode) && stat(fullPath.data(), &fileStatus) != 0)
+        {
+          continue;
+        }
+        if (S_ISREG(fileStatus.st_mode))
+        {
+          LocalFileInfo file;
+          file.Path = path;
+          file.Size = static_cast<int64_t>(fileStatus.st_size);
+          files.push_back(std::move(file));
+        }
+      }
+      closedir(dir);
+    }
+    return files;
+  }
+
+  void CreateDirectories(const std::string& path)
   {
-    if (offset > static_cast<int64_t>((std::numeric_limits<off_t>::max)()))
+    for (size_t pos = path.find('/', 1); true; pos = path.find('/', pos + 1))
     {
-      throw std::runtime_error("Failed to write file.");
+      const std::string parent = path.substr(0, pos);
+      if (mkdir(parent.data(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH) != 0
+          && errno != EEXIST)
+      {
+        throw std::runtime_error("Failed to create directory.");
+      }
+      if (pos == std::string::npos)
+      {
+        break;
+      }
     }
-    ssize_t bytesWritten = pwrite(m_handle, buffer, length, static_cast<off_t>(offset));
-    if (bytesWritten < 0 || static_cast<size_t>(bytesWritten) != length)
+  }
+
+  int64_t FileReader::GetLastWriteTime() const
+  {
+    struct stat fileStatus;
+    if (fstat(m_handle, &fileStatus) != 0)
     {
-      throw std::runtime_error("Failed to write file.");
+      throw std::runtime_error("Failed to get last write time of file.");
     }
+#if defined(__APPLE__)
+    const auto& lastWriteTime = fileStatus.st_mtimespec;
+#else
+    const auto& lastWriteTime = fileStatus.st_mtim;
+#endif
+    return static_cast<int64_t>(lastWriteTime.tv_sec) * 1000000000
+        + static_cast<int64_t>(lastWriteTime.tv_nsec);
+  }
+
+  TransferJournal::TransferJournal(
+      const std::string& filename,
+      const std::string& key,
+      int64_t numChunks)
+      : m_filename(filename), m_numChunks(numChunks)
+  {
+    const std::vector<uint8_t> header = GetJournalHeader(key, numChunks);
+    m_mappedSize = header.size() + static_cast<size_t>((numChunks + 7) / 8);
+
+    m_handle = open(filename.data(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+    if (m_handle == -1)
+    {
+      throw std::runtime_error("Failed to open journal file.");
+    }
+
+    struct stat fileStatus;
+    if (fstat(m_handle, &fileStatus) == 0
+        && fileStatus.st_size == static_cast<off_t>(m_mappedSize))
+    {
+      std::vector<uint8_t> existingHeader(header.size());
+      m_resumed = pread(m_handle, existingHeader.data(), existingHeader.size(), 0)
+              == static_cast<ssize_t>(existingHeader.size())
+          && existingHeader == header;
+    }
+    // Truncating first zeroes the bitmap.
+    if (!m_resumed
+        && (ftruncate(m_handle, 0) != 0
+            || ftruncate(m_handle, static_cast<off_t>(m_mappedSize)) != 0
+            || pwrite(m_handle, header.data(), header.size(), 0)
+                != static_cast<ssize_t>(header.size())))
+    {
+      close(m_handle);
+      throw std::runtime_error("Failed to initialize journal file.");
+    }
+
+    void* view = mmap(nullptr, m_mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_handle, 0);
+    if (view == MAP_FAILED)
+    {
+      close(m_handle);
+      throw std::runtime_error("Failed to map journal file.");
+    }
+    m_mappedView = static_cast<uint8_t*>(view);
+    m_bitmap = m_mappedView + header.size();
+  }
+
+  void TransferJournal::Close()
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_mappedView == nullptr)
+    {
+      return;
+    }
+    munmap(m_mappedView, m_mappedSize);
+    close(m_handle);
+    m_mappedView = nullptr;
+    m_bitmap = nullptr;
+  }
+
+  void TransferJournal::Remove()
+  {
+    Close();
+    unlink(m_filename.data());
   }
 #endif
 
+  namespace {
+    // Owns the aligned buffer a range was read into with direct I/O.
+    class AlignedBufferBodyStream final : public Azure::Core::IO::BodyStream {
+    public:
+      AlignedBufferBodyStream(AlignedBuffer buffer, size_t offset, size_t length)
+          : m_buffer(std::move(buffer)), m_offset(offset), m_length(length)
+      {
+      }
+
+      int64_t Length() const override { return static_cast<int64_t>(m_length); }
+
+      void Rewind() override { m_position = 0; }
+
+    private:
+      size_t OnRead(uint8_t* buffer, size_t count, const Azure::Core::Context&) override
+      {
+        count = (std::min)(count, m_length - m_position);
+        std::memcpy(buffer, m_buffer.get() + m_offset + m_position, count);
+        m_position += count;
+        return count;
+      }
+
+      AlignedBuffer m_buffer;
+      size_t m_offset;
+      size_t m_length;
+      size_t m_position = 0;
+    };
+  } // namespace
+
+  std::unique_ptr<Azure::Core::IO::BodyStream> FileReader::GetRangeStream(
+      int64_t offset,
+      int64_t length) const
+  {
+    if (offset < 0 || length < 0 || offset > m_fileSize || length > m_fileSize - offset)
+    {
+      throw std::runtime_error("Failed to read file.");
+    }
+    if (m_mode == FileIoMode::MemoryMapped)
+    {
+      return std::make_unique<Azure::Core::IO::MemoryBodyStream>(
+          m_mappedView == nullptr ? nullptr : m_mappedView + offset, static_cast<size_t>(length));
+    }
+    if (m_mode == FileIoMode::Direct)
+    {
+      const int64_t alignedOffset = offset / DirectIoAlignment * DirectIoAlignment;
+      const int64_t alignedEnd
+          = (offset + length + DirectIoAlignment - 1) / DirectIoAlignment * DirectIoAlignment;
+      const size_t bufferSize = (std::max)(
+          static_cast<size_t>(alignedEnd - alignedOffset), static_cast<size_t>(DirectIoAlignment));
+      AlignedBuffer buffer = AllocateAlignedBuffer(bufferSize);
+      const size_t rangeEnd = static_cast<size_t>(offset + length - alignedOffset);
+      size_t bytesRead = 0;
+      while (bytesRead < rangeEnd)
+      {
+        // Direct I/O rejects unaligned offsets and lengths, so a short read which ends within a
+        // block is retried from the start of that block.
+        const size_t readOffset = bytesRead / DirectIoAlignment * DirectIoAlignment;
+        const size_t n = ReadFileAt(
+            m_handle,
+            buffer.get() + readOffset,
+            bufferSize - readOffset,
+            alignedOffset + static_cast<int64_t>(readOffset));
+        if (readOffset + n <= bytesRead)
+        {
+          throw std::runtime_error("Failed to read file.");
+        }
+        bytesRead = readOffset + n;
+      }
+      return std::make_unique<AlignedBufferBodyStream>(
+          std::move(buffer),
+          static_cast<size_t>(offset - alignedOffset),
+          static_cast<size_t>(length));
+    }
+    return std::make_unique<Azure::Core::IO::_internal::RandomAccessFileBodyStream>(
+        m_handle, offset, length);
+  }
+
+  FileWriter::FileWriter(const std::string& filename, bool truncate)
+      : FileWriter(filename, truncate, FileIoMode::Buffered, -1)
+  {
+  }
+
+  void FileWriter::Write(const uint8_t* buffer, size_t length, int64_t offset)
+  {
+    if (m_mode == FileIoMode::MemoryMapped)
+    {
+      if (offset < 0 || offset > m_mappedSize
+          || length > static_cast<uint64_t>(m_mappedSize - offset))
+      {
+        throw std::runtime_error("Failed to write file.");
+      }
+      if (length != 0)
+      {
+        std::memcpy(m_mappedView + offset, buffer, length);
+      }
+      return;
+    }
+    WriteFileAt(m_handle, buffer, length, offset);
+  }
+
+  void FileWriter::WriteFromStream(
+      Azure::Core::IO::BodyStream& stream,
+      int64_t offset,
+      int64_t length,
+      const Azure::Core::Context& context)
+  {
+    if (length <= 0)
+    {
+      return;
+    }
+    if (m_mode == FileIoMode::MemoryMapped)
+    {
+      if (offset < 0 || offset > m_mappedSize || length > m_mappedSize - offset)
+      {
+        throw std::runtime_error("Failed to write file.");
+      }
+      // Received directly into the mapping.
+      if (stream.ReadToCount(m_mappedView + offset, static_cast<size_t>(length), context)
+          != static_cast<size_t>(length))
+      {
+        throw Azure::Core::RequestFailedException("Error when reading body stream.");
+      }
+      return;
+    }
+
+    constexpr int64_t MaxBufferSize = 4 * 1024 * 1024;
+    const int64_t bufferSize = (std::min)(
+        MaxBufferSize,
+        (length + DirectIoAlignment - 1) / DirectIoAlignment * DirectIoAlignment);
+    AlignedBuffer buffer = AllocateAlignedBuffer(static_cast<size_t>(bufferSize));
+    while (length > 0)
+    {
+      int64_t writeSize = (std::min)(bufferSize, length);
+      bool direct = false;
+      if (m_mode == FileIoMode::Direct)
+      {
+        // The unaligned beginning and end of the range are written with regular I/O, so that
+        // neighboring ranges written in parallel aren't overwritten.
+        if (offset % DirectIoAlignment != 0)
+        {
+          writeSize = (std::min)(length, DirectIoAlignment - offset % DirectIoAlignment);
+        }
+        else if (length >= DirectIoAlignment)
+        {
+          writeSize = writeSize / DirectIoAlignment * DirectIoAlignment;
+          direct = true;
+        }
+      }
+      if (stream.ReadToCount(buffer.get(), static_cast<size_t>(writeSize), context)
+          != static_cast<size_t>(writeSize))
+      {
+        throw Azure::Core::RequestFailedException("Error when reading body stream.");
+      }
+      WriteFileAt(
+          direct ? m_directHandle : m_handle,
+          buffer.get(),
+          static_cast<size_t>(writeSize),
+          offset);
+      offset += writeSize;
+      length -= writeSize;
+    }
+  }
+
 }}} // namespace Azure::Storage::_internal
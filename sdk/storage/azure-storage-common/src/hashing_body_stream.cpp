@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "azure/storage/common/internal/hashing_body_stream.hpp"
+
+#include "azure/storage/common/crypt.hpp"
+
+#include <azure/core/exception.hpp>
+
+namespace Azure { namespace Storage { namespace _internal {
+
+  namespace {
+    std::unique_ptr<Azure::Core::Cryptography::Hash> CreateHash(HashAlgorithm algorithm)
+    {
+      if (algorithm == HashAlgorithm::Crc64)
+      {
+        return std::make_unique<Crc64Hash>();
+      }
+      return std::make_unique<Azure::Core::Cryptography::Md5Hash>();
+    }
+  } // namespace
+
+  HashingBodyStream::HashingBodyStream(Azure::Core::IO::BodyStream& inner, HashAlgorithm algorithm)
+      : m_inner(inner), m_algorithm(algorithm), m_hash(CreateHash(algorithm))
+  {
+  }
+
+  size_t HashingBodyStream::OnRead(
+      uint8_t* buffer,
+      size_t count,
+      Azure::Core::Context const& context)
+  {
+    const size_t bytesRead = m_inner.Read(buffer, count, context);
+    m_hash->Append(buffer, bytesRead);
+    return bytesRead;
+  }
+
+  void HashingBodyStream::Rewind()
+  {
+    m_inner.Rewind();
+    m_hash = CreateHash(m_algorithm);
+  }
+
+  ContentHash HashingBodyStream::GetHash()
+  {
+    ContentHash hash;
+    hash.Algorithm = m_algorithm;
+    hash.Value = m_hash->Final();
+    return hash;
+  }
+
+  void VerifyContentHash(
+      const ContentHash& actual,
+      const Azure::Nullable<ContentHash>& expected,
+      const std::string& operation)
+  {
+    if (!expected.HasValue())
+    {
+      throw Azure::Core::RequestFailedException(
+          operation + " response doesn't contain a content hash to validate the content with.");
+    }
+    if (expected.Value().Algorithm != actual.Algorithm || expected.Value().Value != actual.Value)
+    {
+      throw Azure::Core::RequestFailedException(
+          operation + " content hash mismatch, the content was corrupted in transit.");
+    }
+  }
+
+}}} // namespace Azure::Storage::_internal
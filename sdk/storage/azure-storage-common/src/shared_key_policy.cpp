@@ -9,6 +9,9 @@
 #include <azure/core/internal/strings.hpp>
 
 #include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace {
 /*
@@ -88,82 +91,152 @@ bool comparator(const std::string& lhs, const std::string& rhs)
   }
   return false;
 }
+
+void ToLowerInPlace(std::string& value)
+{
+  for (auto& c : value)
+  {
+    c = Azure::Core::_internal::StringExtensions::ToLower(c);
+  }
+}
+
+// Assigns the decoded query component to target, reusing target's buffer when nothing needs to be
+// decoded.
+void AssignDecoded(std::string& target)
+{
+  if (target.find_first_of("%+") != std::string::npos)
+  {
+    target = Azure::Core::Url::Decode(target);
+  }
+}
+
+struct CanonicalizationBuffers final
+{
+  std::string StringToSign;
+  std::vector<std::pair<std::string, std::string>> Entries;
+
+  void AppendEntries(size_t count)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      StringToSign.append(Entries[i].first)
+          .append(1, ':')
+          .append(Entries[i].second)
+          .append(1, '\n');
+    }
+  }
+
+  // Returns the entry at index, reusing the strings of a previous request when possible.
+  std::pair<std::string, std::string>& GetEntry(size_t index)
+  {
+    if (index == Entries.size())
+    {
+      Entries.emplace_back();
+    }
+    return Entries[index];
+  }
+};
 } // namespace
 
 namespace Azure { namespace Storage { namespace _internal {
 
   std::string SharedKeyPolicy::GetSignature(const Core::Http::Request& request) const
   {
-    std::string string_to_sign;
-    string_to_sign += request.GetMethod().ToString() + "\n";
-
-    const auto& headers = request.GetHeaders();
-    for (std::string headerName :
-         {"Content-Encoding",
-          "Content-Language",
-          "Content-Length",
-          "Content-MD5",
-          "Content-Type",
-          "Date",
-          "If-Modified-Since",
-          "If-Match",
-          "If-None-Match",
-          "If-Unmodified-Since",
-          "Range"})
-    {
-      auto ite = headers.find(headerName);
-      if (ite != headers.end())
+    static const std::string HeaderNames[] = {
+        "Content-Encoding",
+        "Content-Language",
+        "Content-Length",
+        "Content-MD5",
+        "Content-Type",
+        "Date",
+        "If-Modified-Since",
+        "If-Match",
+        "If-None-Match",
+        "If-Unmodified-Since",
+        "Range",
+    };
+    static const std::string Prefix = "x-ms-";
+
+    // The buffers keep their capacity between requests, so a thread signing similar requests
+    // doesn't allocate while canonicalizing them.
+    thread_local CanonicalizationBuffers buffers;
+    auto& stringToSign = buffers.StringToSign;
+    auto& entries = buffers.Entries;
+    stringToSign.clear();
+
+    stringToSign += request.GetMethod().ToString();
+    stringToSign += '\n';
+
+    // The headers are read in a single pass, without copying them.
+    constexpr size_t HeaderCount = sizeof(HeaderNames) / sizeof(HeaderNames[0]);
+    const std::string* headerValues[HeaderCount] = {};
+    size_t entryCount = 0;
+    request.ForEachHeader([&](const std::string& name, const std::string& value) {
+      if (name.compare(0, Prefix.length(), Prefix) == 0)
       {
-        if (headerName == "Content-Length" && ite->second == "0")
-        {
-          // do nothing
-        }
-        else
+        // canonicalized headers
+        auto& entry = buffers.GetEntry(entryCount++);
+        entry.first.assign(name);
+        ToLowerInPlace(entry.first);
+        entry.second.assign(value);
+        return;
+      }
+      for (size_t i = 0; i < HeaderCount; ++i)
+      {
+        if (Azure::Core::_internal::StringExtensions::LocaleInvariantCaseInsensitiveEqual(
+                name, HeaderNames[i]))
         {
-          string_to_sign += ite->second;
+          headerValues[i] = &value;
+          break;
         }
       }
-      string_to_sign += "\n";
-    }
-
-    // canonicalized headers
-    const std::string prefix = "x-ms-";
-    std::vector<std::pair<std::string, std::string>> ordered_kv;
-    for (auto ite = headers.lower_bound(prefix);
-         ite != headers.end() && ite->first.substr(0, prefix.length()) == prefix;
-         ++ite)
-    {
-      std::string key = Azure::Core::_internal::StringExtensions::ToLower(ite->first);
-      ordered_kv.emplace_back(std::make_pair(std::move(key), ite->second));
-    }
-    std::sort(ordered_kv.begin(), ordered_kv.end(), [](const auto& lhs, const auto& rhs) {
-      return comparator(lhs.first, rhs.first);
     });
-    for (const auto& p : ordered_kv)
+
+    for (size_t i = 0; i < HeaderCount; ++i)
     {
-      string_to_sign += p.first + ":" + p.second + "\n";
+      if (headerValues[i] != nullptr
+          && !(HeaderNames[i] == "Content-Length" && *headerValues[i] == "0"))
+      {
+        stringToSign += *headerValues[i];
+      }
+      stringToSign += '\n';
     }
-    ordered_kv.clear();
+
+    std::sort(
+        entries.begin(), entries.begin() + entryCount, [](const auto& lhs, const auto& rhs) {
+          // The headers aren't sorted by name anymore, break the ties of the comparator.
+          return comparator(lhs.first, rhs.first)
+              || (!comparator(rhs.first, lhs.first) && lhs.first < rhs.first);
+        });
+    buffers.AppendEntries(entryCount);
 
     // canonicalized resource
-    string_to_sign += "/" + m_credential->AccountName + "/" + request.GetUrl().GetPath() + "\n";
+    stringToSign.append(1, '/')
+        .append(m_credential->AccountName)
+        .append(1, '/')
+        .append(request.GetUrl().GetPath())
+        .append(1, '\n');
+    entryCount = 0;
     for (const auto& query : request.GetUrl().GetQueryParameters())
     {
-      std::string key = Azure::Core::_internal::StringExtensions::ToLower(query.first);
-      ordered_kv.emplace_back(
-          std::make_pair(Azure::Core::Url::Decode(key), Azure::Core::Url::Decode(query.second)));
-    }
-    std::sort(ordered_kv.begin(), ordered_kv.end());
-    for (const auto& p : ordered_kv)
-    {
-      string_to_sign += p.first + ":" + p.second + "\n";
+      auto& entry = buffers.GetEntry(entryCount++);
+      entry.first.assign(query.first);
+      ToLowerInPlace(entry.first);
+      AssignDecoded(entry.first);
+      entry.second.assign(query.second);
+      AssignDecoded(entry.second);
     }
+    std::sort(entries.begin(), entries.begin() + entryCount);
+    buffers.AppendEntries(entryCount);
 
     // remove last linebreak
-    string_to_sign.pop_back();
+    stringToSign.pop_back();
 
-    return Azure::Core::Convert::Base64Encode(_internal::HmacSha256(
-        std::vector<uint8_t>(string_to_sign.begin(), string_to_sign.end()),
-        Azure::Core::Convert::Base64Decode(m_credential->GetAccountKey())));
+    std::vector<uint8_t> signature(HmacSha256Context::HashSize);
+    m_credential->GetSigningContext()->Compute(
+        reinterpret_cast<const uint8_t*>(stringToSign.data()),
+        stringToSign.size(),
+        signature.data());
+    return Azure::Core::Convert::Base64Encode(signature);
   }
 }}} // namespace Azure::Storage::_internal
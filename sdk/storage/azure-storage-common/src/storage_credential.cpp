@@ -3,8 +3,26 @@
 
 #include "azure/storage/common/storage_credential.hpp"
 
+#include "azure/storage/common/crypt.hpp"
+
 #include <algorithm>
 
+namespace Azure { namespace Storage {
+
+  std::shared_ptr<const _internal::HmacSha256Context>
+  StorageSharedKeyCredential::GetSigningContext() const
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (!m_signingContext)
+    {
+      m_signingContext = std::make_shared<_internal::HmacSha256Context>(
+          Azure::Core::Convert::Base64Decode(m_accountKey));
+    }
+    return m_signingContext;
+  }
+
+}} // namespace Azure::Storage
+
 namespace Azure { namespace Storage { namespace _internal {
 
   ConnectionStringParts ParseConnectionString(const std::string& connectionString)
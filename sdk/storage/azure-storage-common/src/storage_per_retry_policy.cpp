@@ -3,6 +3,7 @@
 
 #include "azure/storage/common/internal/storage_per_retry_policy.hpp"
 
+#include "azure/storage/common/internal/concurrent_transfer.hpp"
 #include "azure/storage/common/internal/constants.hpp"
 #include "azure/storage/common/internal/reliable_stream.hpp"
 
@@ -19,8 +20,7 @@ namespace Azure { namespace Storage { namespace _internal {
       Core::Http::Policies::NextHttpPolicy nextPolicy,
       Core::Context const& context) const
   {
-    const auto& headers = request.GetHeaders();
-    if (headers.find(HttpHeaderDate) == headers.end())
+    if (!request.HasHeader(HttpHeaderDate))
     {
       // add x-ms-date header in RFC1123 format
       request.SetHeader(
@@ -54,7 +54,16 @@ namespace Azure { namespace Storage { namespace _internal {
       }
     }
 
-    return nextPolicy.Send(request, context);
+    auto response = nextPolicy.Send(request, context);
+
+    std::shared_ptr<std::atomic<int64_t>> throttledResponseCount;
+    if (response->GetStatusCode() == Core::Http::HttpStatusCode::ServiceUnavailable
+        && context.TryGetValue(ThrottledResponseCountKey, throttledResponseCount))
+    {
+      ++*throttledResponseCount;
+    }
+
+    return response;
   }
 
 }}} // namespace Azure::Storage::_internal
@@ -12,7 +12,7 @@ namespace Azure { namespace Storage { namespace _internal {
       Azure::Core::Http::Policies::NextHttpPolicy nextPolicy,
       const Azure::Core::Context& context) const
   {
-    std::shared_ptr<bool> replicaStatus;
+    std::shared_ptr<std::atomic<bool>> replicaStatus;
     context.TryGetValue(SecondaryHostReplicaStatusKey, replicaStatus);
 
     bool considerSecondary = (request.GetMethod() == Azure::Core::Http::HttpMethod::Get
@@ -20,6 +20,13 @@ namespace Azure { namespace Storage { namespace _internal {
         && !m_secondaryHost.empty() && replicaStatus && *replicaStatus;
 
     if (considerSecondary
+        && Azure::Core::Http::Policies::_internal::HedgingPolicy::IsHedgedAttempt(context))
+    {
+      // send the hedged request to the secondary host
+      request.GetUrl().SetHost(m_secondaryHost);
+    }
+    else if (
+        considerSecondary
         && Azure::Core::Http::Policies::_internal::RetryPolicy::GetRetryCount(context) > 0)
     {
       // switch host
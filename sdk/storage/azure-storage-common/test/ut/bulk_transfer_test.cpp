@@ -0,0 +1,343 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <azure/core/exception.hpp>
+#include <azure/storage/common/internal/bulk_transfer.hpp>
+#include <azure/storage/common/internal/file_io.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace Azure { namespace Storage { namespace Test {
+
+  namespace {
+    _internal::BulkTransferItem MakeItem(const std::string& path, int64_t size)
+    {
+      _internal::BulkTransferItem item;
+      item.Path = path;
+      item.Size = size;
+      return item;
+    }
+  } // namespace
+
+  TEST(BulkTransferTest, TransfersFilesAndChunks)
+  {
+    const std::vector<_internal::BulkTransferItem> items{
+        MakeItem("empty", 0),
+        MakeItem("small", 100),
+        MakeItem("dir/large", 1050),
+        MakeItem("dir/sub/larger", 4000),
+        MakeItem("threshold", 200),
+    };
+
+    std::mutex mutex;
+    std::vector<std::string> singleFiles;
+    std::vector<std::string> preparedFiles;
+    // path -> offset, length, chunk ID
+    std::map<std::string, std::vector<std::tuple<int64_t, int64_t, int64_t>>> chunks;
+    std::map<std::string, int64_t> committedFiles;
+    int64_t bytesInFlight = 0;
+    int64_t maxBytesInFlight = 0;
+
+    _internal::BulkTransferOperations operations;
+    operations.TransferFile
+        = [&](const _internal::BulkTransferItem& item, const Azure::Core::Context&) {
+            std::lock_guard<std::mutex> guard(mutex);
+            singleFiles.push_back(item.Path);
+          };
+    operations.PrepareChunks
+        = [&](const _internal::BulkTransferItem& item, const Azure::Core::Context&) {
+            std::lock_guard<std::mutex> guard(mutex);
+            preparedFiles.push_back(item.Path);
+          };
+    operations.TransferChunk = [&](const _internal::BulkTransferItem& item,
+                                   int64_t offset,
+                                   int64_t length,
+                                   int64_t chunkId,
+                                   const Azure::Core::Context&) {
+      {
+        std::lock_guard<std::mutex> guard(mutex);
+        EXPECT_TRUE(
+            std::find(preparedFiles.begin(), preparedFiles.end(), item.Path)
+            != preparedFiles.end());
+        bytesInFlight += length;
+        maxBytesInFlight = (std::max)(maxBytesInFlight, bytesInFlight);
+      }
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      std::lock_guard<std::mutex> guard(mutex);
+      bytesInFlight -= length;
+      chunks[item.Path].emplace_back(offset, length, chunkId);
+    };
+    operations.CommitChunks = [&](const _internal::BulkTransferItem& item,
+                                  int64_t numChunks,
+                                  const Azure::Core::Context&) {
+      std::lock_guard<std::mutex> guard(mutex);
+      EXPECT_EQ(chunks[item.Path].size(), static_cast<size_t>(numChunks));
+      committedFiles[item.Path] = numChunks;
+    };
+
+    std::vector<BulkTransferProgress> progress;
+    _internal::BulkTransferOptions options;
+    options.Concurrency = 4;
+    options.MaxBytesInFlight = 300;
+    options.SingleTransferThreshold = 200;
+    options.ChunkSize = 100;
+    options.MaxChunkCount = 20;
+    options.ProgressHandler = [&](const BulkTransferProgress& p) { progress.push_back(p); };
+    auto result = _internal::BulkTransfer(items, options, operations, Azure::Core::Context());
+
+    EXPECT_EQ(result.TransferredFiles, 5);
+    EXPECT_EQ(result.TransferredBytes, 5350);
+    EXPECT_TRUE(result.FailedFiles.empty());
+    std::sort(singleFiles.begin(), singleFiles.end());
+    EXPECT_EQ(singleFiles, (std::vector<std::string>{"empty", "small", "threshold"}));
+    EXPECT_LE(maxBytesInFlight, options.MaxBytesInFlight);
+
+    // The chunks of the larger file are made larger to respect MaxChunkCount.
+    const std::map<std::string, int64_t> expectedChunkSizes{
+        {"dir/large", 100},
+        {"dir/sub/larger", 200},
+    };
+    for (const auto& expected : expectedChunkSizes)
+    {
+      auto& fileChunks = chunks[expected.first];
+      std::sort(fileChunks.begin(), fileChunks.end());
+      const auto& item = *std::find_if(items.begin(), items.end(), [&](const auto& i) {
+        return i.Path == expected.first;
+      });
+      int64_t nextOffset = 0;
+      for (size_t i = 0; i < fileChunks.size(); ++i)
+      {
+        EXPECT_EQ(std::get<0>(fileChunks[i]), nextOffset);
+        EXPECT_EQ(std::get<2>(fileChunks[i]), static_cast<int64_t>(i));
+        EXPECT_LE(std::get<1>(fileChunks[i]), expected.second);
+        nextOffset += std::get<1>(fileChunks[i]);
+      }
+      EXPECT_EQ(nextOffset, item.Size);
+      EXPECT_EQ(committedFiles[expected.first], static_cast<int64_t>(fileChunks.size()));
+    }
+
+    ASSERT_FALSE(progress.empty());
+    for (size_t i = 1; i < progress.size(); ++i)
+    {
+      EXPECT_GE(progress[i].TransferredBytes, progress[i - 1].TransferredBytes);
+    }
+    EXPECT_EQ(progress.back().TransferredFiles, 5);
+    EXPECT_EQ(progress.back().TotalFiles, 5);
+    EXPECT_EQ(progress.back().TransferredBytes, 5350);
+    EXPECT_EQ(progress.back().TotalBytes, 5350);
+  }
+
+  TEST(BulkTransferTest, ReportsFailedFiles)
+  {
+    const std::vector<_internal::BulkTransferItem> items{
+        MakeItem("a", 10),
+        MakeItem("b", 1000),
+        MakeItem("c", 1000),
+        MakeItem("d", 10),
+    };
+
+    std::mutex mutex;
+    std::vector<std::string> committedFiles;
+    _internal::BulkTransferOperations operations;
+    operations.TransferFile
+        = [&](const _internal::BulkTransferItem& item, const Azure::Core::Context&) {
+            if (item.Path == "a")
+            {
+              throw std::runtime_error("File failed.");
+            }
+          };
+    operations.TransferChunk = [&](const _internal::BulkTransferItem& item,
+                                   int64_t,
+                                   int64_t,
+                                   int64_t chunkId,
+                                   const Azure::Core::Context&) {
+      if (item.Path == "b" && chunkId == 3)
+      {
+        throw Azure::Core::RequestFailedException("Chunk failed.");
+      }
+    };
+    operations.CommitChunks = [&](const _internal::BulkTransferItem& item,
+                                  int64_t,
+                                  const Azure::Core::Context&) {
+      std::lock_guard<std::mutex> guard(mutex);
+      committedFiles.push_back(item.Path);
+    };
+
+    _internal::BulkTransferOptions options;
+    options.Concurrency = 3;
+    options.MaxBytesInFlight = 1000;
+    options.SingleTransferThreshold = 100;
+    options.ChunkSize = 100;
+    options.MaxChunkCount = 1000;
+    auto result = _internal::BulkTransfer(items, options, operations, Azure::Core::Context());
+
+    EXPECT_EQ(result.TransferredFiles, 2);
+    ASSERT_EQ(result.FailedFiles.size(), 2U);
+    EXPECT_EQ(result.FailedFiles.at("a"), "File failed.");
+    EXPECT_EQ(result.FailedFiles.at("b"), "Chunk failed.");
+    EXPECT_EQ(committedFiles, std::vector<std::string>{"c"});
+  }
+
+  TEST(BulkTransferTest, ChunkSizeLimits)
+  {
+    const int64_t maxSize = std::numeric_limits<int64_t>::max();
+    const std::vector<_internal::BulkTransferItem> items{
+        MakeItem("large", 1000),
+        MakeItem("huge", maxSize),
+    };
+
+    std::mutex mutex;
+    std::map<std::string, std::vector<std::pair<int64_t, int64_t>>> chunks;
+    _internal::BulkTransferOperations operations;
+    operations.TransferChunk = [&](const _internal::BulkTransferItem& item,
+                                   int64_t offset,
+                                   int64_t length,
+                                   int64_t,
+                                   const Azure::Core::Context&) {
+      std::lock_guard<std::mutex> guard(mutex);
+      chunks[item.Path].emplace_back(offset, length);
+    };
+
+    _internal::BulkTransferOptions options;
+    options.Concurrency = 2;
+    options.MaxBytesInFlight = 1000;
+    options.SingleTransferThreshold = 100;
+    options.ChunkSize = 100;
+    options.MaxChunkCount = maxSize;
+    auto result
+        = _internal::BulkTransfer({items[0]}, options, operations, Azure::Core::Context());
+    EXPECT_EQ(result.TransferredFiles, 1);
+    EXPECT_EQ(chunks["large"].size(), 10U);
+
+    // A file of the maximum size is split into a single chunk, or two chunks of at most half the
+    // maximum size, without overflowing.
+    for (const int64_t maxChunkCount : {int64_t(1), int64_t(2)})
+    {
+      chunks.clear();
+      options.ChunkSize = 1;
+      options.MaxChunkCount = maxChunkCount;
+      result = _internal::BulkTransfer({items[1]}, options, operations, Azure::Core::Context());
+      EXPECT_EQ(result.TransferredFiles, 1);
+      auto& hugeChunks = chunks["huge"];
+      ASSERT_EQ(hugeChunks.size(), static_cast<size_t>(maxChunkCount));
+      std::sort(hugeChunks.begin(), hugeChunks.end());
+      EXPECT_EQ(hugeChunks.back().first + hugeChunks.back().second, maxSize);
+    }
+
+    options.MaxChunkCount = maxSize;
+    for (const int64_t chunkSize : {int64_t(0), int64_t(-1)})
+    {
+      options.ChunkSize = chunkSize;
+      EXPECT_THROW(
+          _internal::BulkTransfer(items, options, operations, Azure::Core::Context()),
+          std::invalid_argument);
+    }
+  }
+
+  TEST(BulkTransferTest, Cancellation)
+  {
+    std::vector<_internal::BulkTransferItem> items;
+    for (int i = 0; i < 100; ++i)
+    {
+      items.push_back(MakeItem(std::to_string(i), 1));
+    }
+    Azure::Core::Context context;
+
+    int transferred = 0;
+    _internal::BulkTransferOperations operations;
+    operations.TransferFile
+        = [&](const _internal::BulkTransferItem&, const Azure::Core::Context&) {
+            if (++transferred == 10)
+            {
+              context.Cancel();
+            }
+          };
+    _internal::BulkTransferOptions options;
+    options.Concurrency = 1;
+    options.MaxBytesInFlight = 1;
+    options.SingleTransferThreshold = 1;
+    EXPECT_THROW(
+        _internal::BulkTransfer(items, options, operations, context),
+        Azure::Core::OperationCancelledException);
+    EXPECT_EQ(transferred, 10);
+  }
+
+  TEST(BulkTransferTest, IsValidRelativePath)
+  {
+    EXPECT_TRUE(_internal::IsValidRelativePath("file"));
+    EXPECT_TRUE(_internal::IsValidRelativePath("dir/file.txt"));
+    EXPECT_TRUE(_internal::IsValidRelativePath("dir/..file"));
+    EXPECT_FALSE(_internal::IsValidRelativePath(""));
+    EXPECT_FALSE(_internal::IsValidRelativePath("/file"));
+    EXPECT_FALSE(_internal::IsValidRelativePath("dir//file"));
+    EXPECT_FALSE(_internal::IsValidRelativePath("dir/"));
+    EXPECT_FALSE(_internal::IsValidRelativePath("."));
+    EXPECT_FALSE(_internal::IsValidRelativePath("../file"));
+    EXPECT_FALSE(_internal::IsValidRelativePath("dir/../../file"));
+  }
+
+  TEST(BulkTransferTest, ListFilesRecursively)
+  {
+    const std::string directory = "bulk-transfer-test-" + std::to_string(std::random_device()());
+    const std::vector<std::pair<std::string, size_t>> files{
+        {"a", 0},
+        {"b/c", 10},
+        {"b/d/e", 20},
+        {"b/d/f", 30},
+    };
+    _internal::CreateDirectories(directory + "/b/d");
+    _internal::CreateDirectories(directory + "/g");
+    // Creating an existing directory succeeds.
+    _internal::CreateDirectories(directory + "/b");
+    for (const auto& file : files)
+    {
+      _internal::FileWriter writer(directory + '/' + file.first);
+      std::vector<uint8_t> content(file.second, 'x');
+      if (!content.empty())
+      {
+        writer.Write(content.data(), content.size(), 0);
+      }
+    }
+    {
+      // A writer that doesn't truncate keeps the content of the file.
+      _internal::FileWriter writer(directory + "/b/d/f", false);
+      const uint8_t content = 'y';
+      writer.Write(&content, 1, 0);
+    }
+
+    auto listedFiles = _internal::ListFilesRecursively(directory);
+    std::sort(listedFiles.begin(), listedFiles.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.Path < rhs.Path;
+    });
+    ASSERT_EQ(listedFiles.size(), files.size());
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+      EXPECT_EQ(listedFiles[i].Path, files[i].first);
+      EXPECT_EQ(listedFiles[i].Size, static_cast<int64_t>(files[i].second));
+    }
+
+    for (auto i = files.rbegin(); i != files.rend(); ++i)
+    {
+      std::remove((directory + '/' + i->first).data());
+    }
+    for (const auto& subdirectory : {"/b/d", "/b", "/g", ""})
+    {
+      std::remove((directory + subdirectory).data());
+    }
+  }
+
+}}} // namespace Azure::Storage::Test
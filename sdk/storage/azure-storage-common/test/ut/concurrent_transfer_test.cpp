@@ -0,0 +1,136 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <azure/core/exception.hpp>
+#include <azure/storage/common/internal/concurrent_transfer.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace Azure { namespace Storage { namespace Test {
+
+  namespace {
+    // offset, length, chunk ID, number of chunks
+    using Chunk = std::tuple<int64_t, int64_t, int64_t, int64_t>;
+  } // namespace
+
+  TEST(ConcurrentTransferTest, AdaptiveCoversRange)
+  {
+    constexpr int64_t Offset = 100;
+    constexpr int64_t Length = 10000;
+    constexpr int64_t ChunkSize = 10;
+    constexpr int64_t MaxChunkSize = 40;
+    constexpr int Concurrency = 4;
+
+    std::mutex mutex;
+    std::vector<Chunk> chunks;
+    std::atomic<int> inFlight{0};
+    std::atomic<int> maxInFlight{0};
+    _internal::AdaptiveConcurrentTransfer(
+        Offset,
+        Length,
+        ChunkSize,
+        MaxChunkSize,
+        Concurrency,
+        Azure::Core::Context(),
+        [&](int64_t offset,
+            int64_t length,
+            int64_t chunkId,
+            int64_t numChunks,
+            const Azure::Core::Context&) {
+          const int current = ++inFlight;
+          int previous = maxInFlight.load();
+          while (previous < current && !maxInFlight.compare_exchange_weak(previous, current))
+          {
+          }
+          std::this_thread::sleep_for(std::chrono::microseconds(100));
+          --inFlight;
+          std::lock_guard<std::mutex> guard(mutex);
+          chunks.emplace_back(offset, length, chunkId, numChunks);
+        });
+
+    std::sort(chunks.begin(), chunks.end());
+    ASSERT_FALSE(chunks.empty());
+    int64_t nextOffset = Offset;
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+      const auto& chunk = chunks[i];
+      EXPECT_EQ(std::get<0>(chunk), nextOffset);
+      EXPECT_EQ(std::get<2>(chunk), static_cast<int64_t>(i));
+      EXPECT_LE(std::get<1>(chunk), MaxChunkSize);
+      if (i + 1 != chunks.size())
+      {
+        EXPECT_GE(std::get<1>(chunk), ChunkSize);
+        EXPECT_GT(std::get<3>(chunk), std::get<2>(chunk) + 1);
+      }
+      nextOffset += std::get<1>(chunk);
+    }
+    EXPECT_EQ(nextOffset, Offset + Length);
+    EXPECT_EQ(std::get<3>(chunks.back()), static_cast<int64_t>(chunks.size()));
+    EXPECT_LE(maxInFlight.load(), Concurrency);
+  }
+
+  TEST(ConcurrentTransferTest, AdaptiveBacksOffWhenThrottled)
+  {
+    std::atomic<int> inFlight{0};
+    std::atomic<int> maxInFlightAtEnd{0};
+    _internal::AdaptiveConcurrentTransfer(
+        0,
+        2000,
+        1,
+        1,
+        8,
+        Azure::Core::Context(),
+        [&](int64_t, int64_t, int64_t chunkId, int64_t, const Azure::Core::Context& context) {
+          const int current = ++inFlight;
+          if (chunkId >= 1900)
+          {
+            int previous = maxInFlightAtEnd.load();
+            while (previous < current && !maxInFlightAtEnd.compare_exchange_weak(previous, current))
+            {
+            }
+          }
+          std::this_thread::sleep_for(std::chrono::microseconds(100));
+          if (chunkId >= 1000)
+          {
+            std::shared_ptr<std::atomic<int64_t>> throttledResponseCount;
+            ASSERT_TRUE(
+                context.TryGetValue(_internal::ThrottledResponseCountKey, throttledResponseCount));
+            ++*throttledResponseCount;
+          }
+          --inFlight;
+        });
+    // Every round is throttled from the 1000th chunk on, so a single chunk is in flight at the end.
+    EXPECT_EQ(maxInFlightAtEnd.load(), 1);
+  }
+
+  TEST(ConcurrentTransferTest, AdaptivePropagatesFailure)
+  {
+    std::atomic<int> transferred{0};
+    EXPECT_THROW(
+        _internal::AdaptiveConcurrentTransfer(
+            0,
+            1000,
+            1,
+            1,
+            4,
+            Azure::Core::Context(),
+            [&](int64_t, int64_t, int64_t chunkId, int64_t, const Azure::Core::Context&) {
+              if (chunkId == 10)
+              {
+                throw Azure::Core::RequestFailedException("Chunk failed.");
+              }
+              ++transferred;
+            }),
+        Azure::Core::RequestFailedException);
+    EXPECT_LT(transferred.load(), 1000);
+  }
+
+}}} // namespace Azure::Storage::Test
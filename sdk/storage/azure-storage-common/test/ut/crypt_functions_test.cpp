@@ -3,7 +3,9 @@
 
 #include "test_base.hpp"
 
+#include <azure/core/io/body_stream.hpp>
 #include <azure/storage/common/crypt.hpp>
+#include <azure/storage/common/internal/hashing_body_stream.hpp>
 
 #include <cstring>
 
@@ -31,6 +33,22 @@ namespace Azure { namespace Storage { namespace Test {
         "+SBESxQVhI53mSEdZJcCBpdBkaqwzfPaVYZMAf5LP3c=");
   }
 
+  TEST_F(CryptFunctionsTest, HmacSha256Context)
+  {
+    for (const std::string& key :
+         {std::string("8CwtGFF1mGR4bPEP9eZ0x1fxKiQ3Ca5N"), std::string(100, 'k')})
+    {
+      std::vector<uint8_t> binaryKey(key.begin(), key.end());
+      _internal::HmacSha256Context context(binaryKey);
+      for (const char* text : {"", "Hello Azure!"})
+      {
+        std::vector<uint8_t> hash(_internal::HmacSha256Context::HashSize);
+        context.Compute(reinterpret_cast<const uint8_t*>(text), std::strlen(text), hash.data());
+        EXPECT_EQ(hash, _internal::HmacSha256(ToBinaryVector(text), binaryKey));
+      }
+    }
+  }
+
   static std::vector<uint8_t> ComputeHash(const std::string& data)
   {
     const uint8_t* ptr = reinterpret_cast<const uint8_t*>(data.data());
@@ -121,4 +139,41 @@ namespace Azure { namespace Storage { namespace Test {
     }
   }
 
+  TEST_F(CryptFunctionsTest, HashingBodyStream)
+  {
+    std::vector<uint8_t> data(1_MB + 123);
+    RandomBuffer(data.data(), data.size());
+    Crc64Hash crc64;
+    Azure::Core::Cryptography::Md5Hash md5;
+    const std::vector<uint8_t> expectedCrc64 = crc64.Final(data.data(), data.size());
+    const std::vector<uint8_t> expectedMd5 = md5.Final(data.data(), data.size());
+
+    for (const auto algorithm : {HashAlgorithm::Crc64, HashAlgorithm::Md5})
+    {
+      Azure::Core::IO::MemoryBodyStream memoryStream(data);
+      _internal::HashingBodyStream hashingStream(memoryStream, algorithm);
+      EXPECT_EQ(hashingStream.Length(), static_cast<int64_t>(data.size()));
+
+      // A partial read is discarded by the rewind.
+      std::vector<uint8_t> buffer(1000);
+      hashingStream.ReadToCount(buffer.data(), buffer.size());
+      hashingStream.Rewind();
+      EXPECT_EQ(hashingStream.ReadToEnd(), data);
+
+      const ContentHash hash = hashingStream.GetHash();
+      EXPECT_EQ(hash.Algorithm, algorithm);
+      EXPECT_EQ(hash.Value, algorithm == HashAlgorithm::Crc64 ? expectedCrc64 : expectedMd5);
+
+      EXPECT_NO_THROW(_internal::VerifyContentHash(hash, hash, "Test"));
+      EXPECT_THROW(
+          _internal::VerifyContentHash(hash, Azure::Nullable<ContentHash>(), "Test"),
+          Azure::Core::RequestFailedException);
+      ContentHash corrupted = hash;
+      corrupted.Value[0] ^= 1;
+      EXPECT_THROW(
+          _internal::VerifyContentHash(hash, corrupted, "Test"),
+          Azure::Core::RequestFailedException);
+    }
+  }
+
 }}} // namespace Azure::Storage::Test
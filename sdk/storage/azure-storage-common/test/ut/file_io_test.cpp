@@ -0,0 +1,214 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include <azure/core/exception.hpp>
+#include <azure/core/io/body_stream.hpp>
+#include <azure/storage/common/internal/file_io.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace Azure { namespace Storage { namespace Test {
+
+  namespace {
+    std::vector<uint8_t> RandomContent(size_t size)
+    {
+      std::mt19937 generator(static_cast<std::mt19937::result_type>(size));
+      std::vector<uint8_t> content(size);
+      for (auto& byte : content)
+      {
+        byte = static_cast<uint8_t>(generator());
+      }
+      return content;
+    }
+
+    // Ranges at, across and between the 4 KiB blocks of a file, in an arbitrary order.
+    const std::vector<std::pair<int64_t, int64_t>> FileRanges{
+        {4096, 8192},
+        {0, 100},
+        {12288, 5000},
+        {100, 3996},
+        {17288, 12345},
+        {29633, 1},
+    };
+    constexpr int64_t FileRangesSize = 29634;
+  } // namespace
+
+  TEST(FileIoTest, ReadModes)
+  {
+    const std::string filename = "file-io-" + std::to_string(std::random_device()());
+    const auto content = RandomContent(static_cast<size_t>(FileRangesSize));
+    {
+      _internal::FileWriter writer(filename);
+      writer.Write(content.data(), content.size(), 0);
+    }
+
+    for (const auto mode : {FileIoMode::Buffered, FileIoMode::MemoryMapped, FileIoMode::Direct})
+    {
+      _internal::FileReader reader(filename, mode);
+      EXPECT_EQ(reader.GetFileSize(), FileRangesSize);
+      for (const auto& range : FileRanges)
+      {
+        auto stream = reader.GetRangeStream(range.first, range.second);
+        ASSERT_EQ(stream->Length(), range.second);
+        for (int i = 0; i < 2; ++i)
+        {
+          // Read in pieces, then again after rewinding.
+          std::vector<uint8_t> buffer(static_cast<size_t>(range.second) + 1);
+          size_t bytesRead = 0;
+          while (size_t n = stream->Read(
+                     buffer.data() + bytesRead,
+                     (std::min)(buffer.size() - bytesRead, static_cast<size_t>(1000)),
+                     Azure::Core::Context()))
+          {
+            bytesRead += n;
+          }
+          buffer.resize(bytesRead);
+          EXPECT_EQ(
+              buffer,
+              std::vector<uint8_t>(
+                  content.begin() + static_cast<size_t>(range.first),
+                  content.begin() + static_cast<size_t>(range.first + range.second)));
+          stream->Rewind();
+        }
+      }
+      EXPECT_EQ(reader.GetRangeStream(FileRangesSize, 0)->Length(), 0);
+      EXPECT_THROW(reader.GetRangeStream(FileRangesSize - 1, 2), std::runtime_error);
+    }
+    std::remove(filename.data());
+
+    // An empty file can't be mapped.
+    {
+      _internal::FileWriter writer(filename);
+    }
+    {
+      _internal::FileReader reader(filename, FileIoMode::MemoryMapped);
+      EXPECT_EQ(reader.GetRangeStream(0, 0)->Length(), 0);
+    }
+    std::remove(filename.data());
+  }
+
+  TEST(FileIoTest, WriteModes)
+  {
+    const auto content = RandomContent(static_cast<size_t>(FileRangesSize));
+    for (const auto mode : {FileIoMode::Buffered, FileIoMode::MemoryMapped, FileIoMode::Direct})
+    {
+      const std::string filename = "file-io-" + std::to_string(std::random_device()());
+      {
+        _internal::FileWriter writer(filename, true, mode, FileRangesSize);
+        for (const auto& range : FileRanges)
+        {
+          Azure::Core::IO::MemoryBodyStream stream(
+              content.data() + range.first, static_cast<size_t>(range.second));
+          writer.WriteFromStream(stream, range.first, range.second, Azure::Core::Context());
+        }
+        // The stream is shorter than the range.
+        Azure::Core::IO::MemoryBodyStream stream(content.data(), 10);
+        EXPECT_THROW(
+            writer.WriteFromStream(stream, 0, 11, Azure::Core::Context()),
+            Azure::Core::RequestFailedException);
+      }
+
+      _internal::FileReader reader(filename);
+      ASSERT_EQ(reader.GetFileSize(), FileRangesSize);
+      std::vector<uint8_t> written(content.size());
+      EXPECT_EQ(
+          reader.GetRangeStream(0, FileRangesSize)
+              ->ReadToCount(written.data(), written.size(), Azure::Core::Context()),
+          written.size());
+      EXPECT_EQ(written, content);
+      std::remove(filename.data());
+    }
+  }
+
+  TEST(FileIoTest, SparseWrite)
+  {
+    const int64_t fileSize = 8 * 1024 * 1024;
+    const auto content = RandomContent(4096);
+    for (const auto mode : {FileIoMode::Buffered, FileIoMode::MemoryMapped, FileIoMode::Direct})
+    {
+      const std::string filename = "file-io-" + std::to_string(std::random_device()());
+      {
+        _internal::FileWriter writer(filename, true, mode, fileSize, true);
+        Azure::Core::IO::MemoryBodyStream stream(content);
+        writer.WriteFromStream(stream, 1024 * 1024, 4096, Azure::Core::Context());
+      }
+
+      // The ranges not written read as zeros.
+      _internal::FileReader reader(filename);
+      ASSERT_EQ(reader.GetFileSize(), fileSize);
+      std::vector<uint8_t> written(static_cast<size_t>(fileSize));
+      EXPECT_EQ(
+          reader.GetRangeStream(0, fileSize)
+              ->ReadToCount(written.data(), written.size(), Azure::Core::Context()),
+          written.size());
+      std::vector<uint8_t> expected(static_cast<size_t>(fileSize));
+      std::copy(content.begin(), content.end(), expected.begin() + 1024 * 1024);
+      EXPECT_EQ(written, expected);
+      std::remove(filename.data());
+    }
+  }
+
+  TEST(TransferJournalTest, Resume)
+  {
+    const std::string filename = "transfer-journal-" + std::to_string(std::random_device()());
+    const std::string key = "UploadFrom\nsource\ndestination\n4194304";
+    {
+      _internal::TransferJournal journal(filename, key, 20);
+      EXPECT_FALSE(journal.IsResumed());
+      for (int64_t chunkId = 0; chunkId < 20; ++chunkId)
+      {
+        EXPECT_FALSE(journal.IsChunkDone(chunkId));
+      }
+      journal.SetChunkDone(0);
+      journal.SetChunkDone(9);
+      journal.SetChunkDone(19);
+    }
+    {
+      // The same transfer resumes from the chunks done.
+      _internal::TransferJournal journal(filename, key, 20);
+      EXPECT_TRUE(journal.IsResumed());
+      for (int64_t chunkId = 0; chunkId < 20; ++chunkId)
+      {
+        EXPECT_EQ(journal.IsChunkDone(chunkId), chunkId == 0 || chunkId == 9 || chunkId == 19);
+      }
+      EXPECT_FALSE(journal.IsChunkDone(20));
+    }
+    {
+      // Another transfer starts over.
+      _internal::TransferJournal journal(filename, key + "0", 20);
+      EXPECT_FALSE(journal.IsResumed());
+      EXPECT_FALSE(journal.IsChunkDone(0));
+      journal.SetChunkDone(1);
+    }
+    {
+      _internal::TransferJournal journal(filename, key + "0", 21);
+      EXPECT_FALSE(journal.IsResumed());
+      EXPECT_FALSE(journal.IsChunkDone(1));
+      journal.Remove();
+      EXPECT_FALSE(journal.IsChunkDone(1));
+    }
+    // The journal was deleted.
+    EXPECT_NE(std::remove(filename.data()), 0);
+  }
+
+  TEST(TransferJournalTest, NoChunks)
+  {
+    const std::string filename = "transfer-journal-" + std::to_string(std::random_device()());
+    {
+      _internal::TransferJournal journal(filename, "key", 0);
+      EXPECT_FALSE(journal.IsResumed());
+      EXPECT_FALSE(journal.IsChunkDone(0));
+    }
+    _internal::TransferJournal journal(filename, "key", 0);
+    EXPECT_TRUE(journal.IsResumed());
+    journal.Remove();
+  }
+
+}}} // namespace Azure::Storage::Test
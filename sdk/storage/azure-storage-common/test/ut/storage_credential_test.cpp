@@ -3,10 +3,40 @@
 
 #include "test_base.hpp"
 
+#include <azure/core/internal/http/pipeline.hpp>
+#include <azure/storage/common/internal/shared_key_policy.hpp>
 #include <azure/storage/common/storage_credential.hpp>
 
 namespace Azure { namespace Storage { namespace Test {
 
+  namespace {
+    class AuthorizationCapturePolicy final : public Core::Http::Policies::HttpPolicy {
+    public:
+      explicit AuthorizationCapturePolicy(std::shared_ptr<std::string> authorization)
+          : m_authorization(std::move(authorization))
+      {
+      }
+
+      std::unique_ptr<HttpPolicy> Clone() const override
+      {
+        return std::make_unique<AuthorizationCapturePolicy>(*this);
+      }
+
+      std::unique_ptr<Core::Http::RawResponse> Send(
+          Core::Http::Request& request,
+          Core::Http::Policies::NextHttpPolicy,
+          Core::Context const&) const override
+      {
+        *m_authorization = request.GetHeader("Authorization").Value();
+        return std::make_unique<Core::Http::RawResponse>(
+            1, 1, Core::Http::HttpStatusCode::Ok, "OK");
+      }
+
+    private:
+      std::shared_ptr<std::string> m_authorization;
+    };
+  } // namespace
+
   TEST(StorageCredentialTest, DefaultHostCorrect)
   {
     EXPECT_EQ(
@@ -23,4 +53,37 @@ namespace Azure { namespace Storage { namespace Test {
         "testaccount.blob.core.windows.net");
   }
 
+  TEST(StorageCredentialTest, SharedKeySignature)
+  {
+    auto credential = std::make_shared<StorageSharedKeyCredential>(
+        "account", Core::Convert::Base64Encode(std::vector<uint8_t>(64, 'k')));
+    auto authorization = std::make_shared<std::string>();
+    std::vector<std::unique_ptr<Core::Http::Policies::HttpPolicy>> policies;
+    policies.emplace_back(std::make_unique<_internal::SharedKeyPolicy>(credential));
+    policies.emplace_back(std::make_unique<AuthorizationCapturePolicy>(authorization));
+    Core::Http::_internal::HttpPipeline pipeline(policies);
+
+    const auto sign = [&]() {
+      Core::Http::Request request(
+          Core::Http::HttpMethod::Put,
+          Core::Url("https://account.blob.core.windows.net/container/dir%2Fblob?comp=block&"
+                    "blockid=YmxvY2s%3D&Timeout=30&prefix=a+b"));
+      request.SetHeader("Content-Length", "0");
+      request.SetHeader("Content-Type", "application/octet-stream");
+      request.SetHeader("Range", "bytes=0-1023");
+      request.SetHeader("x-ms-version", "2024-08-04");
+      request.SetHeader("x-ms-date", "Thu, 01 Jan 2024 00:00:00 GMT");
+      request.SetHeader("x-ms-meta-Name", "value");
+      request.SetHeader("x-ms-meta-name-2", "value2");
+      request.SetHeader("x-ms-meta_name", "value3");
+      pipeline.Send(request, Core::Context());
+      return *authorization;
+    };
+
+    EXPECT_EQ(sign(), "SharedKey account:gBjp/vfkFCa00J1xscEcyyp3E94kLBIH964fej2Mk0o=");
+    EXPECT_EQ(sign(), "SharedKey account:gBjp/vfkFCa00J1xscEcyyp3E94kLBIH964fej2Mk0o=");
+    credential->Update(Core::Convert::Base64Encode(std::vector<uint8_t>(64, 'r')));
+    EXPECT_EQ(sign(), "SharedKey account:dMs0+ffCp5aQXJSCzNoWtnTGYAi4ghdED2plvW0h9FA=");
+  }
+
 }}} // namespace Azure::Storage::Test
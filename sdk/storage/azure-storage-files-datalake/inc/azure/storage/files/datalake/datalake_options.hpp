@@ -962,6 +962,20 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
        * The maximum number of threads that may be used in a parallel transfer.
        */
       int32_t Concurrency = 5;
+
+      /**
+       * When set to true, the chunk size and the number of chunks transferred in parallel are
+       * tuned during the transfer based on the measured throughput, and reduced when the service
+       * throttles requests. ChunkSize is then the smallest chunk size and Concurrency the maximum
+       * number of chunks transferred in parallel.
+       */
+      bool Adaptive = false;
+
+      /**
+       * How the local file is read. Memory-mapped and direct I/O reduce the copies and the page
+       * cache pressure of very large transfers.
+       */
+      Storage::FileIoMode FileIoMode = Storage::FileIoMode::Buffered;
     } TransferOptions;
   };
 
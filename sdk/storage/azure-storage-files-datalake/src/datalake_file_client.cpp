@@ -260,6 +260,8 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
         = options.TransferOptions.SingleUploadThreshold;
     blobOptions.TransferOptions.ChunkSize = options.TransferOptions.ChunkSize;
     blobOptions.TransferOptions.Concurrency = options.TransferOptions.Concurrency;
+    blobOptions.TransferOptions.Adaptive = options.TransferOptions.Adaptive;
+    blobOptions.TransferOptions.FileIoMode = options.TransferOptions.FileIoMode;
     blobOptions.HttpHeaders = options.HttpHeaders;
     blobOptions.Metadata = options.Metadata;
     return m_blobClient.AsBlockBlobClient().UploadFrom(fileName, blobOptions, context);
@@ -276,6 +278,7 @@ namespace Azure { namespace Storage { namespace Files { namespace DataLake {
         = options.TransferOptions.SingleUploadThreshold;
     blobOptions.TransferOptions.ChunkSize = options.TransferOptions.ChunkSize;
     blobOptions.TransferOptions.Concurrency = options.TransferOptions.Concurrency;
+    blobOptions.TransferOptions.Adaptive = options.TransferOptions.Adaptive;
     blobOptions.HttpHeaders = options.HttpHeaders;
     blobOptions.Metadata = options.Metadata;
     return m_blobClient.AsBlockBlobClient().UploadFrom(buffer, bufferSize, blobOptions, context);
@@ -235,6 +235,36 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
         const ListFilesAndDirectoriesOptions& options = ListFilesAndDirectoriesOptions(),
         const Azure::Core::Context& context = Azure::Core::Context()) const;
 
+    /**
+     * @brief Uploads the files of a local directory and its subdirectories to this directory.
+     * The missing subdirectories are created and existing files are overwritten. The requests for
+     * all the files share the same limits on the number of requests and bytes in flight, small
+     * files are uploaded with a single request and large files in ranges.
+     * @param localDirectoryPath The path of the local directory to upload.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A BulkTransferResult describing the files uploaded and the ones that failed.
+     */
+    BulkTransferResult UploadDirectory(
+        const std::string& localDirectoryPath,
+        const UploadDirectoryOptions& options = UploadDirectoryOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
+    /**
+     * @brief Downloads the files of this directory and its subdirectories to a local directory.
+     * The missing local directories are created and existing files are overwritten. The requests
+     * for all the files share the same limits on the number of requests and bytes in flight, small
+     * files are downloaded with a single request and large files in ranges.
+     * @param localDirectoryPath The path of the local directory to download to.
+     * @param options Optional parameters to execute this function.
+     * @param context Context for cancelling long running operations.
+     * @return A BulkTransferResult describing the files downloaded and the ones that failed.
+     */
+    BulkTransferResult DownloadDirectory(
+        const std::string& localDirectoryPath,
+        const DownloadDirectoryOptions& options = DownloadDirectoryOptions(),
+        const Azure::Core::Context& context = Azure::Core::Context()) const;
+
     /**
      * @brief Returns a sequence of the open handles on a directory or a file. Enumerating the
      * handles may make multiple requests to the service while fetching all the values.
@@ -10,6 +10,7 @@
 #include <azure/core/nullable.hpp>
 #include <azure/storage/common/access_conditions.hpp>
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -599,6 +600,85 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     Nullable<bool> IncludeExtendedInfo;
   };
 
+  /**
+   * @brief Optional parameters for
+   * #Azure::Storage::Files::Shares::ShareDirectoryClient::UploadDirectory.
+   */
+  struct UploadDirectoryOptions final
+  {
+    /**
+     * @brief Options for parallel transfer.
+     */
+    struct
+    {
+      /**
+       * Files smaller than this will be uploaded with a single upload operation, larger ones in
+       * ranges. This value cannot be larger than 4 MiB.
+       */
+      int64_t SingleUploadThreshold = 4 * 1024 * 1024;
+
+      /**
+       * The size of the ranges of the files uploaded in ranges. This value cannot be larger than 4
+       * MiB.
+       */
+      int64_t ChunkSize = 4 * 1024 * 1024;
+
+      /**
+       * The maximum number of requests in flight, shared by all the files.
+       */
+      int32_t Concurrency = 16;
+
+      /**
+       * The maximum number of bytes uploaded by the requests in flight, shared by all the files.
+       */
+      int64_t MaxBytesInFlight = 256 * 1024 * 1024;
+    } TransferOptions;
+
+    /**
+     * Called each time a file or a range has been uploaded or has failed.
+     */
+    std::function<void(const BulkTransferProgress&)> ProgressHandler;
+  };
+
+  /**
+   * @brief Optional parameters for
+   * #Azure::Storage::Files::Shares::ShareDirectoryClient::DownloadDirectory.
+   */
+  struct DownloadDirectoryOptions final
+  {
+    /**
+     * @brief Options for parallel transfer.
+     */
+    struct
+    {
+      /**
+       * Files smaller than this will be downloaded with a single download operation, larger ones
+       * in ranges.
+       */
+      int64_t SingleDownloadThreshold = 4 * 1024 * 1024;
+
+      /**
+       * The size of the ranges of the files downloaded in ranges.
+       */
+      int64_t ChunkSize = 4 * 1024 * 1024;
+
+      /**
+       * The maximum number of requests in flight, shared by all the files.
+       */
+      int32_t Concurrency = 16;
+
+      /**
+       * The maximum number of bytes downloaded by the requests in flight, shared by all the files.
+       */
+      int64_t MaxBytesInFlight = 256 * 1024 * 1024;
+    } TransferOptions;
+
+    /**
+     * Called each time a file or a range has been downloaded or has failed.
+     */
+    std::function<void(const BulkTransferProgress&)> ProgressHandler;
+  };
+
   /**
    * @brief Optional parameters for
    * #Azure::Storage::Files::Shares::ShareDirectoryClient::ListHandles.
@@ -861,6 +941,13 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
      */
     Azure::Nullable<ContentHash> TransactionalContentHash;
 
+    /**
+     * When set to true and TransactionalContentHash isn't specified, the MD5 of the content is
+     * computed while the content is sent and compared with the one returned by the service. This
+     * validates the content without reading it twice.
+     */
+    bool ValidateContentHash = false;
+
     /**
      * The operation will only succeed if the access condition is met.
      */
@@ -1006,6 +1093,22 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
      */
     Azure::Nullable<Core::Http::HttpRange> Range;
 
+    /**
+     * When set to true, the MD5 of every chunk is requested from the service and compared with the
+     * MD5 computed while the chunk is received. The service only returns the hash of a range of up
+     * to 4 MiB, so the chunk sizes are limited to 4 MiB.
+     */
+    bool ValidateContentHash = false;
+
+    /**
+     * The path of a file recording the chunks already written to the destination file. When set,
+     * a download that failed or was interrupted skips the chunks written by previous attempts with
+     * the same file, ETag, destination file and chunk sizes, instead of starting over. The first
+     * chunk is always downloaded again. The file is deleted once the download completes. Adaptive
+     * transfer isn't used with a journal, since resuming needs the same chunks in every attempt.
+     */
+    Azure::Nullable<std::string> JournalPath;
+
     /**
      * @brief Options for parallel transfer.
      */
@@ -1027,6 +1130,20 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
        * The maximum number of threads that may be used in a parallel transfer.
        */
       int32_t Concurrency = 5;
+
+      /**
+       * When set to true, the chunk size and the number of chunks transferred in parallel are
+       * tuned during the transfer based on the measured throughput, and reduced when the service
+       * throttles requests. ChunkSize is then the smallest chunk size and Concurrency the maximum
+       * number of chunks transferred in parallel.
+       */
+      bool Adaptive = false;
+
+      /**
+       * @brief How the local file is written. Memory-mapped and direct I/O reduce the copies
+       * and the page cache pressure of very large transfers.
+       */
+      Storage::FileIoMode FileIoMode = Storage::FileIoMode::Buffered;
     } TransferOptions;
   };
 
@@ -1066,6 +1183,15 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
      */
     Nullable<Models::FilePermissionFormat> FilePermissionFormat;
 
+    /**
+     * The path of a file recording the ranges already uploaded. When set, an upload from a file
+     * that failed or was interrupted skips the ranges uploaded by previous attempts with the same
+     * source file, destination and chunk size, instead of starting over. The file is deleted once
+     * the upload completes. Adaptive transfer isn't used with a journal, since resuming needs the
+     * same ranges in every attempt. Only used when uploading from a file.
+     */
+    Azure::Nullable<std::string> JournalPath;
+
     /**
      * @brief Options for parallel transfer.
      */
@@ -1086,6 +1212,20 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
        * The maximum number of threads that may be used in a parallel transfer.
        */
       int32_t Concurrency = 5;
+
+      /**
+       * When set to true, the chunk size and the number of chunks transferred in parallel are
+       * tuned during the transfer based on the measured throughput, and reduced when the service
+       * throttles requests. ChunkSize is then the smallest chunk size and Concurrency the maximum
+       * number of chunks transferred in parallel.
+       */
+      bool Adaptive = false;
+
+      /**
+       * @brief How the local file is read. Memory-mapped and direct I/O reduce the copies
+       * and the page cache pressure of very large transfers.
+       */
+      Storage::FileIoMode FileIoMode = Storage::FileIoMode::Buffered;
     } TransferOptions;
   };
 
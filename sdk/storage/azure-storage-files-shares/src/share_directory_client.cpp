@@ -9,13 +9,21 @@
 #include <azure/core/credentials/credentials.hpp>
 #include <azure/core/http/policies/policy.hpp>
 #include <azure/storage/common/crypt.hpp>
+#include <azure/storage/common/internal/bulk_transfer.hpp>
 #include <azure/storage/common/internal/constants.hpp>
+#include <azure/storage/common/internal/file_io.hpp>
 #include <azure/storage/common/internal/shared_key_policy.hpp>
 #include <azure/storage/common/internal/storage_per_retry_policy.hpp>
 #include <azure/storage/common/internal/storage_service_version_policy.hpp>
 #include <azure/storage/common/storage_common.hpp>
 #include <azure/storage/common/storage_exception.hpp>
 
+#include <deque>
+#include <limits>
+#include <map>
+#include <set>
+#include <vector>
+
 namespace Azure { namespace Storage { namespace Files { namespace Shares {
 
   ShareDirectoryClient ShareDirectoryClient::CreateFromConnectionString(
@@ -564,6 +572,194 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     return pagedResponse;
   }
 
+  BulkTransferResult ShareDirectoryClient::UploadDirectory(
+      const std::string& localDirectoryPath,
+      const UploadDirectoryOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    constexpr int64_t MaxUploadRangeSize = 4 * 1024 * 1024;
+
+    if (options.TransferOptions.ChunkSize > MaxUploadRangeSize)
+    {
+      throw Azure::Core::RequestFailedException("Range size is too big.");
+    }
+
+    std::vector<_internal::BulkTransferItem> items;
+    // Ordered, so that parent directories are created before their subdirectories.
+    std::set<std::string> directories;
+    for (auto& file : _internal::ListFilesRecursively(localDirectoryPath))
+    {
+      for (size_t pos = file.Path.find('/'); pos != std::string::npos;
+           pos = file.Path.find('/', pos + 1))
+      {
+        directories.insert(file.Path.substr(0, pos));
+      }
+      _internal::BulkTransferItem item;
+      item.Path = std::move(file.Path);
+      item.Size = file.Size;
+      items.push_back(std::move(item));
+    }
+    for (const auto& directory : directories)
+    {
+      GetSubdirectoryClient(directory).CreateIfNotExists(CreateDirectoryOptions(), context);
+    }
+
+    _internal::BulkTransferOperations operations;
+    operations.TransferFile
+        = [&](const _internal::BulkTransferItem& item, const Azure::Core::Context& fileContext) {
+            UploadFileFromOptions uploadOptions;
+            uploadOptions.TransferOptions.SingleUploadThreshold
+                = options.TransferOptions.SingleUploadThreshold;
+            uploadOptions.TransferOptions.Concurrency = 1;
+            GetFileClient(item.Path).UploadFrom(
+                localDirectoryPath + '/' + item.Path, uploadOptions, fileContext);
+          };
+    operations.PrepareChunks
+        = [&](const _internal::BulkTransferItem& item, const Azure::Core::Context& fileContext) {
+            GetFileClient(item.Path).Create(item.Size, CreateFileOptions(), fileContext);
+          };
+    operations.TransferChunk = [&](const _internal::BulkTransferItem& item,
+                                   int64_t offset,
+                                   int64_t length,
+                                   int64_t,
+                                   const Azure::Core::Context& chunkContext) {
+      _internal::FileReader fileReader(localDirectoryPath + '/' + item.Path);
+      Azure::Core::IO::_internal::RandomAccessFileBodyStream contentStream(
+          fileReader.GetHandle(), offset, length);
+      GetFileClient(item.Path).UploadRange(
+          offset, contentStream, UploadFileRangeOptions(), chunkContext);
+    };
+
+    _internal::BulkTransferOptions transferOptions;
+    transferOptions.Concurrency = options.TransferOptions.Concurrency;
+    transferOptions.MaxBytesInFlight = options.TransferOptions.MaxBytesInFlight;
+    transferOptions.SingleTransferThreshold = options.TransferOptions.SingleUploadThreshold;
+    transferOptions.ChunkSize = options.TransferOptions.ChunkSize;
+    transferOptions.MaxChunkCount = std::numeric_limits<int64_t>::max();
+    transferOptions.ProgressHandler = options.ProgressHandler;
+    return _internal::BulkTransfer(items, transferOptions, operations, context);
+  }
+
+  BulkTransferResult ShareDirectoryClient::DownloadDirectory(
+      const std::string& localDirectoryPath,
+      const DownloadDirectoryOptions& options,
+      const Azure::Core::Context& context) const
+  {
+    std::vector<_internal::BulkTransferItem> items;
+    std::map<std::string, std::string> invalidFiles;
+    ListFilesAndDirectoriesOptions listOptions;
+    listOptions.Include = Models::ListFilesIncludeFlags::ETag;
+    // The paths of the directories to list, relative to this directory.
+    std::deque<std::string> directories{std::string()};
+    while (!directories.empty())
+    {
+      const std::string directory = std::move(directories.front());
+      directories.pop_front();
+      const std::string pathPrefix = directory.empty() ? directory : directory + '/';
+      auto directoryClient = directory.empty() ? *this : GetSubdirectoryClient(directory);
+      for (auto page = directoryClient.ListFilesAndDirectories(listOptions, context);
+           page.HasPage();
+           page.MoveToNextPage(context))
+      {
+        for (auto& subdirectory : page.Directories)
+        {
+          if (!_internal::IsValidRelativePath(subdirectory.Name))
+          {
+            invalidFiles[pathPrefix + subdirectory.Name]
+                = "The directory name cannot be mapped to a local directory.";
+            continue;
+          }
+          directories.push_back(pathPrefix + subdirectory.Name);
+        }
+        for (auto& file : page.Files)
+        {
+          _internal::BulkTransferItem item;
+          item.Path = pathPrefix + file.Name;
+          if (!_internal::IsValidRelativePath(file.Name))
+          {
+            invalidFiles[item.Path] = "The file name cannot be mapped to a local file.";
+            continue;
+          }
+          item.Size = file.Details.FileSize;
+          item.ETag = std::move(file.Details.Etag);
+          items.push_back(std::move(item));
+        }
+      }
+    }
+    _internal::CreateDirectories(localDirectoryPath);
+
+    auto createParentDirectories = [&](const _internal::BulkTransferItem& item) {
+      const size_t pos = item.Path.rfind('/');
+      if (pos != std::string::npos)
+      {
+        _internal::CreateDirectories(localDirectoryPath + '/' + item.Path.substr(0, pos));
+      }
+    };
+    auto downloadToFile = [&](const _internal::BulkTransferItem& item,
+                              Azure::Nullable<Core::Http::HttpRange> range,
+                              _internal::FileWriter& fileWriter,
+                              const Azure::Core::Context& downloadContext) {
+      DownloadFileOptions downloadOptions;
+      downloadOptions.Range = std::move(range);
+      auto response = GetFileClient(item.Path).Download(downloadOptions, downloadContext);
+      if (downloadOptions.Range.HasValue() && item.ETag.HasValue()
+          && response.Value.Details.ETag != item.ETag)
+      {
+        throw Azure::Core::RequestFailedException("File was modified in the middle of download.");
+      }
+      int64_t offset = downloadOptions.Range.HasValue() ? downloadOptions.Range.Value().Offset : 0;
+      constexpr int64_t BufferSize = 4 * 1024 * 1024;
+      std::vector<uint8_t> buffer(
+          static_cast<size_t>((std::max<int64_t>)((std::min)(BufferSize, item.Size), 1)));
+      while (true)
+      {
+        const size_t bytesRead
+            = response.Value.BodyStream->Read(buffer.data(), buffer.size(), downloadContext);
+        if (bytesRead == 0)
+        {
+          break;
+        }
+        fileWriter.Write(buffer.data(), bytesRead, offset);
+        offset += bytesRead;
+      }
+    };
+
+    _internal::BulkTransferOperations operations;
+    operations.TransferFile
+        = [&](const _internal::BulkTransferItem& item, const Azure::Core::Context& fileContext) {
+            createParentDirectories(item);
+            _internal::FileWriter fileWriter(localDirectoryPath + '/' + item.Path);
+            downloadToFile(item, Azure::Nullable<Core::Http::HttpRange>(), fileWriter, fileContext);
+          };
+    operations.PrepareChunks
+        = [&](const _internal::BulkTransferItem& item, const Azure::Core::Context&) {
+            createParentDirectories(item);
+            _internal::FileWriter fileWriter(localDirectoryPath + '/' + item.Path);
+          };
+    operations.TransferChunk = [&](const _internal::BulkTransferItem& item,
+                                   int64_t offset,
+                                   int64_t length,
+                                   int64_t,
+                                   const Azure::Core::Context& chunkContext) {
+      _internal::FileWriter fileWriter(localDirectoryPath + '/' + item.Path, false);
+      Core::Http::HttpRange range;
+      range.Offset = offset;
+      range.Length = length;
+      downloadToFile(item, range, fileWriter, chunkContext);
+    };
+
+    _internal::BulkTransferOptions transferOptions;
+    transferOptions.Concurrency = options.TransferOptions.Concurrency;
+    transferOptions.MaxBytesInFlight = options.TransferOptions.MaxBytesInFlight;
+    transferOptions.SingleTransferThreshold = options.TransferOptions.SingleDownloadThreshold;
+    transferOptions.ChunkSize = options.TransferOptions.ChunkSize;
+    transferOptions.MaxChunkCount = std::numeric_limits<int64_t>::max();
+    transferOptions.ProgressHandler = options.ProgressHandler;
+    auto result = _internal::BulkTransfer(items, transferOptions, operations, context);
+    result.FailedFiles.insert(invalidFiles.begin(), invalidFiles.end());
+    return result;
+  }
+
   ListDirectoryHandlesPagedResponse ShareDirectoryClient::ListHandles(
       const ListDirectoryHandlesOptions& options,
       const Azure::Core::Context& context) const
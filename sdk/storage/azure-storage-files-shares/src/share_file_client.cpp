@@ -14,6 +14,7 @@
 #include <azure/storage/common/internal/concurrent_transfer.hpp>
 #include <azure/storage/common/internal/constants.hpp>
 #include <azure/storage/common/internal/file_io.hpp>
+#include <azure/storage/common/internal/hashing_body_stream.hpp>
 #include <azure/storage/common/internal/reliable_stream.hpp>
 #include <azure/storage/common/internal/shared_key_policy.hpp>
 #include <azure/storage/common/internal/storage_per_retry_policy.hpp>
@@ -23,6 +24,11 @@
 
 namespace Azure { namespace Storage { namespace Files { namespace Shares {
 
+  namespace {
+    // The largest range a single Put Range request accepts.
+    constexpr int64_t MaxUploadRangeSize = 4 * 1024 * 1024;
+  } // namespace
+
   ShareFileClient ShareFileClient::CreateFromConnectionString(
       const std::string& connectionString,
       const std::string& shareName,
@@ -585,6 +591,19 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     protocolLayerOptions.FileLastWrittenMode = options.FileLastWrittenMode;
     protocolLayerOptions.AllowTrailingDot = m_allowTrailingDot;
     protocolLayerOptions.FileRequestIntent = m_shareTokenIntent;
+    if (options.ValidateContentHash && !options.TransactionalContentHash.HasValue())
+    {
+      _internal::HashingBodyStream hashingStream(content, HashAlgorithm::Md5);
+      auto response = _detail::FileClient::UploadRange(
+          *m_pipeline, m_shareFileUrl, hashingStream, protocolLayerOptions, context);
+      Azure::Nullable<ContentHash> returnedHash;
+      if (!response.Value.TransactionalContentHash.Value.empty())
+      {
+        returnedHash = response.Value.TransactionalContentHash;
+      }
+      _internal::VerifyContentHash(hashingStream.GetHash(), returnedHash, "UploadRange");
+      return response;
+    }
     return _detail::FileClient::UploadRange(
         *m_pipeline, m_shareFileUrl, content, protocolLayerOptions, context);
   }
@@ -786,7 +805,16 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     // keep downloading it in chunks.
     int64_t firstChunkOffset = options.Range.HasValue() ? options.Range.Value().Offset : 0;
     int64_t firstChunkLength = options.TransferOptions.InitialChunkSize;
-
+    int64_t chunkSize = options.TransferOptions.ChunkSize;
+    int64_t maxChunkSize = (std::numeric_limits<int64_t>::max)();
+    Azure::Nullable<HashAlgorithm> chunkHashAlgorithm;
+    if (options.ValidateContentHash)
+    {
+      firstChunkLength = (std::min)(firstChunkLength, _internal::MaxHashedRangeSize);
+      chunkSize = (std::min)(chunkSize, _internal::MaxHashedRangeSize);
+      maxChunkSize = _internal::MaxHashedRangeSize;
+      chunkHashAlgorithm = HashAlgorithm::Md5;
+    }
     if (options.Range.HasValue() && options.Range.Value().Length.HasValue())
     {
       firstChunkLength = (std::min)(firstChunkLength, options.Range.Value().Length.Value());
@@ -794,12 +822,34 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
 
     DownloadFileOptions firstChunkOptions;
     firstChunkOptions.Range = options.Range;
+    if (options.ValidateContentHash && !firstChunkOptions.Range.HasValue())
+    {
+      // The service only returns the hash of a range.
+      firstChunkOptions.Range = Core::Http::HttpRange();
+    }
     if (firstChunkOptions.Range.HasValue())
     {
       firstChunkOptions.Range.Value().Length = firstChunkLength;
     }
+    firstChunkOptions.RangeHashAlgorithm = chunkHashAlgorithm;
 
-    auto firstChunk = Download(firstChunkOptions, context);
+    auto firstChunk = [&]() {
+      try
+      {
+        return Download(firstChunkOptions, context);
+      }
+      catch (StorageException& e)
+      {
+        if (!options.ValidateContentHash || options.Range.HasValue()
+            || e.StatusCode != Azure::Core::Http::HttpStatusCode::RangeNotSatisfiable)
+        {
+          throw;
+        }
+      }
+      // The file is empty, so there's no range to request the hash of.
+      firstChunkOptions = DownloadFileOptions();
+      return Download(firstChunkOptions, context);
+    }();
     const Azure::ETag etag = firstChunk.Value.Details.ETag;
 
     int64_t fileSize;
@@ -808,7 +858,7 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     {
       fileSize = firstChunk.Value.FileSize;
       fileRangeSize = fileSize - firstChunkOffset;
-      if (options.Range.Value().Length.HasValue())
+      if (options.Range.HasValue() && options.Range.Value().Length.HasValue())
       {
         fileRangeSize = (std::min)(fileRangeSize, options.Range.Value().Length.Value());
       }
@@ -827,12 +877,19 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
           "Buffer is not big enough, file range size is " + std::to_string(fileRangeSize) + ".");
     }
 
-    int64_t bytesRead = firstChunk.Value.BodyStream->ReadToCount(
-        buffer, static_cast<size_t>(firstChunkLength), context);
-    if (bytesRead != firstChunkLength)
-    {
-      throw Azure::Core::RequestFailedException("Error when reading body stream.");
-    }
+    _internal::ReadAndVerifyContentHash(
+        *firstChunk.Value.BodyStream,
+        firstChunkOptions.RangeHashAlgorithm,
+        firstChunk.Value.TransactionalContentHash,
+        "Download",
+        [&](Azure::Core::IO::BodyStream& stream) {
+          int64_t bytesRead
+              = stream.ReadToCount(buffer, static_cast<size_t>(firstChunkLength), context);
+          if (bytesRead != firstChunkLength)
+          {
+            throw Azure::Core::RequestFailedException("Error when reading body stream.");
+          }
+        });
     firstChunk.Value.BodyStream.reset();
 
     auto returnTypeConverter = [](Azure::Response<Models::DownloadFileResult>& response) {
@@ -846,32 +903,41 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     auto ret = returnTypeConverter(firstChunk);
 
     // Keep downloading the remaining in parallel
-    auto downloadChunkFunc
-        = [&](int64_t offset, int64_t length, int64_t chunkId, int64_t numChunks) {
-            DownloadFileOptions chunkOptions;
-            chunkOptions.Range = Core::Http::HttpRange();
-            chunkOptions.Range.Value().Offset = offset;
-            chunkOptions.Range.Value().Length = length;
-            auto chunk = Download(chunkOptions, context);
-            int64_t bytesRead = chunk.Value.BodyStream->ReadToCount(
-                buffer + (offset - firstChunkOffset),
-                static_cast<size_t>(chunkOptions.Range.Value().Length.Value()),
-                context);
-            if (bytesRead != chunkOptions.Range.Value().Length.Value())
+    auto downloadChunkFunc = [&](int64_t offset,
+                                 int64_t length,
+                                 int64_t chunkId,
+                                 int64_t numChunks,
+                                 const Azure::Core::Context& chunkContext) {
+      DownloadFileOptions chunkOptions;
+      chunkOptions.Range = Core::Http::HttpRange();
+      chunkOptions.Range.Value().Offset = offset;
+      chunkOptions.Range.Value().Length = length;
+      chunkOptions.RangeHashAlgorithm = chunkHashAlgorithm;
+      auto chunk = Download(chunkOptions, chunkContext);
+      _internal::ReadAndVerifyContentHash(
+          *chunk.Value.BodyStream,
+          chunkHashAlgorithm,
+          chunk.Value.TransactionalContentHash,
+          "Download",
+          [&](Azure::Core::IO::BodyStream& stream) {
+            int64_t bytesRead = stream.ReadToCount(
+                buffer + (offset - firstChunkOffset), static_cast<size_t>(length), chunkContext);
+            if (bytesRead != length)
             {
               throw Azure::Core::RequestFailedException("Error when reading body stream.");
             }
-            if (chunk.Value.Details.ETag != etag)
-            {
-              throw Azure::Core::RequestFailedException(
-                  "File was modified in the middle of download.");
-            }
+          });
+      if (chunk.Value.Details.ETag != etag)
+      {
+        throw Azure::Core::RequestFailedException(
+            "File was modified in the middle of download.");
+      }
 
-            if (chunkId == numChunks - 1)
-            {
-              ret = returnTypeConverter(chunk);
-            }
-          };
+      if (chunkId == numChunks - 1)
+      {
+        ret = returnTypeConverter(chunk);
+      }
+    };
 
     int64_t remainingOffset = firstChunkOffset + firstChunkLength;
     int64_t remainingSize = fileRangeSize - firstChunkLength;
@@ -879,8 +945,11 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     _internal::ConcurrentTransfer(
         remainingOffset,
         remainingSize,
-        options.TransferOptions.ChunkSize,
+        chunkSize,
+        maxChunkSize,
         options.TransferOptions.Concurrency,
+        options.TransferOptions.Adaptive,
+        context,
         downloadChunkFunc);
     ret.Value.ContentRange.Offset = firstChunkOffset;
     ret.Value.ContentRange.Length = fileRangeSize;
@@ -897,6 +966,16 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     // keep downloading it in chunks.
     int64_t firstChunkOffset = options.Range.HasValue() ? options.Range.Value().Offset : 0;
     int64_t firstChunkLength = options.TransferOptions.InitialChunkSize;
+    int64_t chunkSize = options.TransferOptions.ChunkSize;
+    int64_t maxChunkSize = (std::numeric_limits<int64_t>::max)();
+    Azure::Nullable<HashAlgorithm> chunkHashAlgorithm;
+    if (options.ValidateContentHash)
+    {
+      firstChunkLength = (std::min)(firstChunkLength, _internal::MaxHashedRangeSize);
+      chunkSize = (std::min)(chunkSize, _internal::MaxHashedRangeSize);
+      maxChunkSize = _internal::MaxHashedRangeSize;
+      chunkHashAlgorithm = HashAlgorithm::Md5;
+    }
     if (options.Range.HasValue() && options.Range.Value().Length.HasValue())
     {
       firstChunkLength = (std::min)(firstChunkLength, options.Range.Value().Length.Value());
@@ -904,12 +983,34 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
 
     DownloadFileOptions firstChunkOptions;
     firstChunkOptions.Range = options.Range;
+    if (options.ValidateContentHash && !firstChunkOptions.Range.HasValue())
+    {
+      // The service only returns the hash of a range.
+      firstChunkOptions.Range = Core::Http::HttpRange();
+    }
     if (firstChunkOptions.Range.HasValue())
     {
       firstChunkOptions.Range.Value().Length = firstChunkLength;
     }
+    firstChunkOptions.RangeHashAlgorithm = chunkHashAlgorithm;
 
-    auto firstChunk = Download(firstChunkOptions, context);
+    auto firstChunk = [&]() {
+      try
+      {
+        return Download(firstChunkOptions, context);
+      }
+      catch (StorageException& e)
+      {
+        if (!options.ValidateContentHash || options.Range.HasValue()
+            || e.StatusCode != Azure::Core::Http::HttpStatusCode::RangeNotSatisfiable)
+        {
+          throw;
+        }
+      }
+      // The file is empty, so there's no range to request the hash of.
+      firstChunkOptions = DownloadFileOptions();
+      return Download(firstChunkOptions, context);
+    }();
     const Azure::ETag etag = firstChunk.Value.Details.ETag;
 
     int64_t fileSize;
@@ -918,7 +1019,7 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     {
       fileSize = firstChunk.Value.FileSize;
       fileRangeSize = fileSize - firstChunkOffset;
-      if (options.Range.Value().Length.HasValue())
+      if (options.Range.HasValue() && options.Range.Value().Length.HasValue())
       {
         fileRangeSize = (std::min)(fileRangeSize, options.Range.Value().Length.Value());
       }
@@ -930,29 +1031,55 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     }
     firstChunkLength = (std::min)(firstChunkLength, fileRangeSize);
 
-    auto bodyStreamToFile = [](Azure::Core::IO::BodyStream& stream,
-                               _internal::FileWriter& fileWriter,
-                               int64_t offset,
-                               int64_t length,
-                               const Azure::Core::Context& context) {
-      constexpr size_t bufferSize = 4 * 1024 * 1024;
-      std::vector<uint8_t> buffer(bufferSize);
-      while (length > 0)
+    std::unique_ptr<_internal::TransferJournal> journal;
+    if (options.JournalPath.HasValue())
+    {
+      // The query is left out, so that the SAS token isn't written to the journal.
+      const std::string journalKey = "DownloadTo\n" + m_shareFileUrl.GetScheme() + "://"
+          + m_shareFileUrl.GetHost() + "/" + m_shareFileUrl.GetPath() + "\n" + etag.ToString()
+          + "\n" + fileName + "\n" + std::to_string(firstChunkOffset) + "\n"
+          + std::to_string(fileRangeSize) + "\n" + std::to_string(firstChunkLength) + "\n"
+          + std::to_string(chunkSize);
+      const int64_t numChunks = (fileRangeSize - firstChunkLength + chunkSize - 1) / chunkSize;
+      journal = std::make_unique<_internal::TransferJournal>(
+          options.JournalPath.Value(), journalKey, numChunks);
+      if (journal->IsResumed())
       {
-        size_t readSize = static_cast<size_t>(std::min<int64_t>(bufferSize, length));
-        size_t bytesRead = stream.ReadToCount(buffer.data(), readSize, context);
-        if (bytesRead != readSize)
+        bool isFileIntact = false;
+        try
         {
-          throw Azure::Core::RequestFailedException("Error when reading body stream.");
+          _internal::FileReader existingFile(fileName);
+          isFileIntact = existingFile.GetFileSize() == fileRangeSize;
+        }
+        catch (std::runtime_error&)
+        {
+        }
+        if (!isFileIntact)
+        {
+          // The ranges written by the previous attempt are gone.
+          journal->Remove();
+          journal = std::make_unique<_internal::TransferJournal>(
+              options.JournalPath.Value(), journalKey, numChunks);
         }
-        fileWriter.Write(buffer.data(), bytesRead, offset);
-        length -= bytesRead;
-        offset += bytesRead;
       }
-    };
+    }
 
-    _internal::FileWriter fileWriter(fileName);
-    bodyStreamToFile(*(firstChunk.Value.BodyStream), fileWriter, 0, firstChunkLength, context);
+    // With a journal, the size of the file is set up front, so that a resumed download can tell
+    // whether the file is still the one written by the previous attempt.
+    _internal::FileWriter fileWriter(
+        fileName,
+        !(journal && journal->IsResumed()),
+        options.TransferOptions.FileIoMode,
+        fileRangeSize,
+        journal != nullptr);
+    _internal::ReadAndVerifyContentHash(
+        *firstChunk.Value.BodyStream,
+        firstChunkOptions.RangeHashAlgorithm,
+        firstChunk.Value.TransactionalContentHash,
+        "Download",
+        [&](Azure::Core::IO::BodyStream& stream) {
+          fileWriter.WriteFromStream(stream, 0, firstChunkLength, context);
+        });
     firstChunk.Value.BodyStream.reset();
 
     auto returnTypeConverter = [](Azure::Response<Models::DownloadFileResult>& response) {
@@ -966,30 +1093,44 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     auto ret = returnTypeConverter(firstChunk);
 
     // Keep downloading the remaining in parallel
-    auto downloadChunkFunc
-        = [&](int64_t offset, int64_t length, int64_t chunkId, int64_t numChunks) {
-            DownloadFileOptions chunkOptions;
-            chunkOptions.Range = Core::Http::HttpRange();
-            chunkOptions.Range.Value().Offset = offset;
-            chunkOptions.Range.Value().Length = length;
-            auto chunk = Download(chunkOptions, context);
-            if (chunk.Value.Details.ETag != etag)
-            {
-              throw Azure::Core::RequestFailedException(
-                  "File was modified in the middle of download.");
-            }
-            bodyStreamToFile(
-                *(chunk.Value.BodyStream),
-                fileWriter,
-                offset - firstChunkOffset,
-                chunkOptions.Range.Value().Length.Value(),
-                context);
-
-            if (chunkId == numChunks - 1)
-            {
-              ret = returnTypeConverter(chunk);
-            }
-          };
+    auto downloadChunkFunc = [&](int64_t offset,
+                                 int64_t length,
+                                 int64_t chunkId,
+                                 int64_t numChunks,
+                                 const Azure::Core::Context& chunkContext) {
+      if (journal && journal->IsChunkDone(chunkId))
+      {
+        return;
+      }
+      DownloadFileOptions chunkOptions;
+      chunkOptions.Range = Core::Http::HttpRange();
+      chunkOptions.Range.Value().Offset = offset;
+      chunkOptions.Range.Value().Length = length;
+      chunkOptions.RangeHashAlgorithm = chunkHashAlgorithm;
+      auto chunk = Download(chunkOptions, chunkContext);
+      if (chunk.Value.Details.ETag != etag)
+      {
+        throw Azure::Core::RequestFailedException(
+            "File was modified in the middle of download.");
+      }
+      _internal::ReadAndVerifyContentHash(
+          *chunk.Value.BodyStream,
+          chunkHashAlgorithm,
+          chunk.Value.TransactionalContentHash,
+          "Download",
+          [&](Azure::Core::IO::BodyStream& stream) {
+            fileWriter.WriteFromStream(stream, offset - firstChunkOffset, length, chunkContext);
+          });
+      if (journal)
+      {
+        journal->SetChunkDone(chunkId);
+      }
+
+      if (chunkId == numChunks - 1)
+      {
+        ret = returnTypeConverter(chunk);
+      }
+    };
 
     int64_t remainingOffset = firstChunkOffset + firstChunkLength;
     int64_t remainingSize = fileRangeSize - firstChunkLength;
@@ -997,9 +1138,16 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     _internal::ConcurrentTransfer(
         remainingOffset,
         remainingSize,
-        options.TransferOptions.ChunkSize,
+        chunkSize,
+        maxChunkSize,
         options.TransferOptions.Concurrency,
+        options.TransferOptions.Adaptive && !journal,
+        context,
         downloadChunkFunc);
+    if (journal)
+    {
+      journal->Remove();
+    }
     ret.Value.ContentRange.Offset = firstChunkOffset;
     ret.Value.ContentRange.Length = fileRangeSize;
     return ret;
@@ -1089,7 +1237,11 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     auto createResult
         = _detail::FileClient::Create(*m_pipeline, m_shareFileUrl, protocolLayerOptions, context);
 
-    auto uploadPageFunc = [&](int64_t offset, int64_t length, int64_t chunkId, int64_t numChunks) {
+    auto uploadPageFunc = [&](int64_t offset,
+                              int64_t length,
+                              int64_t chunkId,
+                              int64_t numChunks,
+                              const Azure::Core::Context& chunkContext) {
       (void)chunkId;
       (void)numChunks;
       // TODO: Investigate changing lambda parameters to be size_t, unless they need to be int64_t
@@ -1101,7 +1253,7 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
         uploadRangeOptions.FileLastWrittenMode
             = Azure::Storage::Files::Shares::Models::FileLastWrittenMode::Preserve;
       }
-      UploadRange(offset, contentStream, uploadRangeOptions, context);
+      UploadRange(offset, contentStream, uploadRangeOptions, chunkContext);
     };
 
     int64_t chunkSize = options.TransferOptions.ChunkSize;
@@ -1113,7 +1265,14 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     if (bufferSize > 0)
     {
       _internal::ConcurrentTransfer(
-          0, bufferSize, chunkSize, options.TransferOptions.Concurrency, uploadPageFunc);
+          0,
+          bufferSize,
+          chunkSize,
+          MaxUploadRangeSize,
+          options.TransferOptions.Concurrency,
+          options.TransferOptions.Adaptive,
+          context,
+          uploadPageFunc);
     }
 
     Models::UploadFileFromResult result;
@@ -1127,7 +1286,7 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
       const UploadFileFromOptions& options,
       const Azure::Core::Context& context) const
   {
-    _internal::FileReader fileReader(fileName);
+    _internal::FileReader fileReader(fileName, options.TransferOptions.FileIoMode);
 
     _detail::FileClient::CreateFileOptions protocolLayerOptions;
     protocolLayerOptions.FileContentLength = fileReader.GetFileSize();
@@ -1204,40 +1363,106 @@ namespace Azure { namespace Storage { namespace Files { namespace Shares {
     protocolLayerOptions.AllowTrailingDot = m_allowTrailingDot;
     protocolLayerOptions.FileRequestIntent = m_shareTokenIntent;
     protocolLayerOptions.FilePermissionFormat = options.FilePermissionFormat;
-    auto createResult
-        = _detail::FileClient::Create(*m_pipeline, m_shareFileUrl, protocolLayerOptions, context);
 
-    auto uploadPageFunc = [&](int64_t offset, int64_t length, int64_t chunkId, int64_t numChunks) {
-      (void)chunkId;
-      (void)numChunks;
-      Azure::Core::IO::_internal::RandomAccessFileBodyStream contentStream(
-          fileReader.GetHandle(), offset, length);
+    const int64_t fileSize = fileReader.GetFileSize();
+    int64_t chunkSize = options.TransferOptions.ChunkSize;
+    if (fileSize < options.TransferOptions.SingleUploadThreshold)
+    {
+      chunkSize = fileSize;
+    }
+
+    std::unique_ptr<_internal::TransferJournal> journal;
+    std::string journalKey;
+    const int64_t numChunks = fileSize > 0 ? (fileSize + chunkSize - 1) / chunkSize : 0;
+    if (options.JournalPath.HasValue())
+    {
+      // The query is left out, so that the SAS token isn't written to the journal.
+      journalKey = "UploadFrom\n" + fileName + "\n" + std::to_string(fileSize) + "\n"
+          + std::to_string(fileReader.GetLastWriteTime()) + "\n" + m_shareFileUrl.GetScheme()
+          + "://" + m_shareFileUrl.GetHost() + "/" + m_shareFileUrl.GetPath() + "\n"
+          + std::to_string(chunkSize);
+      journal = std::make_unique<_internal::TransferJournal>(
+          options.JournalPath.Value(), journalKey, numChunks);
+    }
+
+    Models::UploadFileFromResult result;
+    std::unique_ptr<Azure::Core::Http::RawResponse> rawResponse;
+    if (journal && journal->IsResumed())
+    {
+      // The file was created by the previous attempt, unless it was deleted or replaced since.
+      try
+      {
+        auto properties = GetProperties(GetFilePropertiesOptions(), context);
+        if (properties.Value.FileSize == fileSize)
+        {
+          result.IsServerEncrypted = properties.Value.IsServerEncrypted;
+          rawResponse = std::move(properties.RawResponse);
+        }
+      }
+      catch (StorageException& e)
+      {
+        if (e.StatusCode != Azure::Core::Http::HttpStatusCode::NotFound)
+        {
+          throw;
+        }
+      }
+      if (!rawResponse)
+      {
+        journal->Remove();
+        journal = std::make_unique<_internal::TransferJournal>(
+            options.JournalPath.Value(), journalKey, numChunks);
+      }
+    }
+    if (!rawResponse)
+    {
+      auto createResult
+          = _detail::FileClient::Create(*m_pipeline, m_shareFileUrl, protocolLayerOptions, context);
+      result.IsServerEncrypted = createResult.Value.IsServerEncrypted;
+      rawResponse = std::move(createResult.RawResponse);
+    }
+
+    auto uploadPageFunc = [&](int64_t offset,
+                              int64_t length,
+                              int64_t chunkId,
+                              int64_t,
+                              const Azure::Core::Context& chunkContext) {
+      if (journal && journal->IsChunkDone(chunkId))
+      {
+        return;
+      }
+      auto contentStream = fileReader.GetRangeStream(offset, length);
       UploadFileRangeOptions uploadRangeOptions;
       if (options.SmbProperties.LastWrittenOn.HasValue())
       {
         uploadRangeOptions.FileLastWrittenMode
             = Azure::Storage::Files::Shares::Models::FileLastWrittenMode::Preserve;
       }
-      UploadRange(offset, contentStream, uploadRangeOptions, context);
+      UploadRange(offset, *contentStream, uploadRangeOptions, chunkContext);
+      if (journal)
+      {
+        journal->SetChunkDone(chunkId);
+      }
     };
 
-    const int64_t fileSize = fileReader.GetFileSize();
-    int64_t chunkSize = options.TransferOptions.ChunkSize;
-    if (fileSize < options.TransferOptions.SingleUploadThreshold)
-    {
-      chunkSize = fileSize;
-    }
-
     if (fileSize > 0)
     {
       _internal::ConcurrentTransfer(
-          0, fileSize, chunkSize, options.TransferOptions.Concurrency, uploadPageFunc);
+          0,
+          fileSize,
+          chunkSize,
+          MaxUploadRangeSize,
+          options.TransferOptions.Concurrency,
+          options.TransferOptions.Adaptive && !journal,
+          context,
+          uploadPageFunc);
+    }
+    if (journal)
+    {
+      journal->Remove();
     }
 
-    Models::UploadFileFromResult result;
-    result.IsServerEncrypted = createResult.Value.IsServerEncrypted;
     return Azure::Response<Models::UploadFileFromResult>(
-        std::move(result), std::move(createResult.RawResponse));
+        std::move(result), std::move(rawResponse));
   }
 
   Azure::Response<Models::UploadFileRangeFromUriResult> ShareFileClient::UploadRangeFromUri(
@@ -10,6 +10,7 @@
 #include <azure/core/nullable.hpp>
 #include <azure/core/paged_response.hpp>
 
+#include <chrono>
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -628,6 +629,35 @@ namespace Azure { namespace Data { namespace Tables {
       Azure::Nullable<std::string> Filter;
     };
 
+    /**
+     * @brief Optional parameters for TableClient::QueryEntitiesInParallel.
+     *
+     */
+    struct QueryEntitiesInParallelOptions final
+    {
+      /**
+       * @brief Strictly increasing partition keys at which the key space is split into ranges
+       * that are queried concurrently. When empty, split points are sampled from the table.
+       *
+       */
+      std::vector<std::string> PartitionKeyBoundaries;
+      /**
+       * @brief The select query.
+       *
+       */
+      std::string SelectColumns;
+      /**
+       * @brief The filter expression, applied to every range.
+       *
+       */
+      Azure::Nullable<std::string> Filter;
+      /**
+       * @brief The maximum number of ranges queried concurrently.
+       *
+       */
+      int32_t Concurrency = 8;
+    };
+
     /**
      * @brief Query Entities result.
      *
@@ -724,5 +754,72 @@ namespace Azure { namespace Data { namespace Tables {
        */
       Azure::Nullable<TransactionError> Error;
     };
+
+    /**
+     * @brief Optional parameters for TableClient::SubmitTransactionsInBulk.
+     *
+     */
+    struct SubmitTransactionsInBulkOptions final
+    {
+      /**
+       * The maximum number of transactions submitted in parallel.
+       */
+      int32_t Concurrency = 8;
+      /**
+       * The maximum number of times a transaction is resubmitted after a transient failure.
+       */
+      int32_t MaxRetries = 3;
+      /**
+       * The delay before the first resubmission of a failed transaction, doubled for every
+       * following attempt.
+       */
+      std::chrono::milliseconds RetryDelay = std::chrono::milliseconds(800);
+      /**
+       * The maximum number of steps held back while waiting for more steps of the same partition.
+       * Larger values produce fuller transactions when partition keys are interleaved, at the cost
+       * of memory.
+       */
+      int32_t MaxBufferedSteps = 10000;
+    };
+
+    /**
+     * @brief A transaction that could not be committed by TableClient::SubmitTransactionsInBulk.
+     *
+     */
+    struct FailedTransaction final
+    {
+      /**
+       * The steps of the transaction, none of which have been applied.
+       */
+      std::vector<TransactionStep> Steps;
+      /**
+       * Status Code, empty if no response was received.
+       */
+      std::string StatusCode;
+      /**
+       * Error.
+       */
+      Azure::Nullable<TransactionError> Error;
+    };
+
+    /**
+     * @brief Submit transactions in bulk result.
+     *
+     */
+    struct SubmitTransactionsInBulkResult final
+    {
+      /**
+       * The number of transactions that were committed.
+       */
+      int64_t CommittedTransactions = 0;
+      /**
+       * The number of steps that were committed.
+       */
+      int64_t CommittedSteps = 0;
+      /**
+       * The transactions that failed with a non-transient error or ran out of retries.
+       */
+      std::vector<FailedTransaction> FailedTransactions;
+    };
   } // namespace Models
 }}} // namespace Azure::Data::Tables
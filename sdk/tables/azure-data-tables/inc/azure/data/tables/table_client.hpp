@@ -13,6 +13,7 @@
 #include <azure/core/response.hpp>
 
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -162,6 +163,24 @@ namespace Azure { namespace Data { namespace Tables {
         Models::QueryEntitiesOptions const& options = {},
         Core::Context const& context = {}) const;
 
+    /**
+     * @brief Queries entities in a table by splitting the partition key space into ranges that are
+     * queried concurrently.
+     *
+     * @details Each range follows its own continuation tokens. Pages are passed to \p onPage as
+     * they arrive, one at a time, so \p onPage doesn't need to be thread-safe. Entities are
+     * returned in no particular order.
+     *
+     * @param onPage Called with the entities of each page. The entities may be moved from.
+     * @param options Optional parameters to execute this function.
+     * @param context for canceling long running operations.
+     * @throw std::invalid_argument if the partition key boundaries aren't strictly increasing.
+     */
+    void QueryEntitiesInParallel(
+        std::function<void(std::vector<Models::TableEntity>&)> const& onPage,
+        Models::QueryEntitiesInParallelOptions const& options = {},
+        Core::Context const& context = {}) const;
+
     /**
      * @brief Queries a single entity in a table.
      *
@@ -186,6 +205,39 @@ namespace Azure { namespace Data { namespace Tables {
         std::vector<Models::TransactionStep> const& steps,
         Core::Context const& context = {}) const;
 
+    /**
+     * @brief Submits an arbitrary number of steps as concurrent transactions.
+     *
+     * @details Steps are grouped by partition key into transactions of up to 100 steps and 4 MiB
+     * of payload, which are submitted with bounded parallelism. Transactions that fail with a
+     * transient error are resubmitted. The transactions of a partition are submitted one at a
+     * time, so steps for the same entity are applied in the order they are produced, steps for
+     * different entities may be applied in any order.
+     *
+     * @param nextStep Called repeatedly to produce the next step. Returns false once there are no
+     * more steps.
+     * @param options Optional parameters to execute this function.
+     * @param context for canceling long running operations.
+     * @return Submit transactions in bulk result.
+     */
+    Models::SubmitTransactionsInBulkResult SubmitTransactionsInBulk(
+        std::function<bool(Models::TransactionStep&)> const& nextStep,
+        Models::SubmitTransactionsInBulkOptions const& options = {},
+        Core::Context const& context = {}) const;
+
+    /**
+     * @brief Submits an arbitrary number of steps as concurrent transactions.
+     *
+     * @param steps The steps to execute.
+     * @param options Optional parameters to execute this function.
+     * @param context for canceling long running operations.
+     * @return Submit transactions in bulk result.
+     */
+    Models::SubmitTransactionsInBulkResult SubmitTransactionsInBulk(
+        std::vector<Models::TransactionStep> const& steps,
+        Models::SubmitTransactionsInBulkOptions const& options = {},
+        Core::Context const& context = {}) const;
+
   private:
 #ifdef _azure_TABLES_TESTING_BUILD
     friend class Azure::Data::Tables::StressTest::TransactionStressTest;
@@ -211,11 +263,41 @@ namespace Azure { namespace Data { namespace Tables {
         std::string const& batchId,
         std::string const& changesetId,
         std::vector<Models::TransactionStep> const& steps) const;
-    std::string PrepAddEntity(std::string const& changesetId, Models::TableEntity entity) const;
-    std::string PrepDeleteEntity(std::string const& changesetId, Models::TableEntity entity) const;
-    std::string PrepMergeEntity(std::string const& changesetId, Models::TableEntity entity) const;
-    std::string PrepUpdateEntity(std::string const& changesetId, Models::TableEntity entity) const;
-    std::string PrepInsertEntity(std::string const& changesetId, Models::TableEntity entity) const;
+    Azure::Nullable<std::string> FindFirstPartitionKey(
+        std::string const& lowerBound,
+        Core::Context const& context) const;
+    std::vector<std::string> SamplePartitionKeyBoundaries(
+        int32_t concurrency,
+        Core::Context const& context) const;
+    size_t EstimateStepOverhead() const;
+    void PrepAddEntity(
+        std::string& payload,
+        std::string const& changesetId,
+        Models::TableEntity const& entity,
+        std::string const& body) const;
+    void PrepDeleteEntity(
+        std::string& payload,
+        std::string const& changesetId,
+        Models::TableEntity const& entity) const;
+    void PrepMergeEntity(
+        std::string& payload,
+        std::string const& changesetId,
+        Models::TableEntity const& entity,
+        std::string const& body) const;
+    void PrepUpdateEntity(
+        std::string& payload,
+        std::string const& changesetId,
+        Models::TableEntity const& entity,
+        std::string const& body) const;
+    void PrepInsertEntity(
+        std::string& payload,
+        std::string const& changesetId,
+        Models::TableEntity const& entity,
+        std::string const& body) const;
+    Models::SubmitTransactionsInBulkResult SubmitChangeset(
+        std::vector<Models::TransactionStep> steps,
+        Models::SubmitTransactionsInBulkOptions const& options,
+        Core::Context const& context) const;
     std::shared_ptr<Core::Http::_internal::HttpPipeline> m_pipeline;
     Core::Url m_url;
     std::string m_tableName;
@@ -0,0 +1,100 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "private/changeset_batcher.hpp"
+
+#include <algorithm>
+
+using namespace Azure::Data::Tables;
+using namespace Azure::Data::Tables::_detail;
+
+namespace {
+// JSON punctuation and the "@odata.type" annotation written for a single property.
+constexpr size_t PropertyOverhead = 48;
+} // namespace
+
+constexpr size_t ChangesetBatcher::MaxChangesetSteps;
+constexpr size_t ChangesetBatcher::MaxChangesetBytes;
+
+ChangesetBatcher::ChangesetBatcher(size_t maxBufferedSteps, size_t stepOverhead)
+    : m_maxBufferedSteps((std::max)(maxBufferedSteps, size_t(1))), m_stepOverhead(stepOverhead)
+{
+}
+
+size_t ChangesetBatcher::EstimateStepSize(Models::TransactionStep const& step) const
+{
+  // The keys also appear in the request URL, where they may be percent-encoded.
+  size_t size = m_stepOverhead
+      + 3 * (step.Entity.GetPartitionKey().Value.size() + step.Entity.GetRowKey().Value.size());
+  for (auto const& property : step.Entity.Properties)
+  {
+    size += 2 * property.first.size() + property.second.Value.size() + PropertyOverhead;
+  }
+  return size;
+}
+
+void ChangesetBatcher::Add(
+    Models::TransactionStep step,
+    std::vector<std::vector<Models::TransactionStep>>& ready)
+{
+  auto const stepSize = EstimateStepSize(step);
+  auto const partitionKey = step.Entity.GetPartitionKey().Value;
+  auto rowKey = step.Entity.GetRowKey().Value;
+
+  auto changeset = m_openChangesets.find(partitionKey);
+  if (changeset != m_openChangesets.end()
+      && (changeset->second.Steps.size() >= MaxChangesetSteps
+          || changeset->second.Bytes + stepSize > MaxChangesetBytes
+          || changeset->second.RowKeys.count(rowKey) != 0))
+  {
+    // The service rejects a changeset that touches the same entity twice, so a repeated row key
+    // starts a new changeset to preserve the order of the two operations.
+    Close(changeset, ready);
+    changeset = m_openChangesets.end();
+  }
+  if (changeset == m_openChangesets.end())
+  {
+    changeset = m_openChangesets.emplace(partitionKey, OpenChangeset()).first;
+    changeset->second.Steps.reserve(MaxChangesetSteps);
+  }
+
+  changeset->second.Steps.emplace_back(std::move(step));
+  changeset->second.RowKeys.emplace(std::move(rowKey));
+  changeset->second.Bytes += stepSize;
+  ++m_bufferedSteps;
+
+  if (changeset->second.Steps.size() >= MaxChangesetSteps)
+  {
+    Close(changeset, ready);
+  }
+
+  while (m_bufferedSteps > m_maxBufferedSteps)
+  {
+    auto largest = std::max_element(
+        m_openChangesets.begin(),
+        m_openChangesets.end(),
+        [](auto const& lhs, auto const& rhs) {
+          return lhs.second.Steps.size() < rhs.second.Steps.size();
+        });
+    Close(largest, ready);
+  }
+}
+
+void ChangesetBatcher::Flush(std::vector<std::vector<Models::TransactionStep>>& ready)
+{
+  for (auto& changeset : m_openChangesets)
+  {
+    ready.emplace_back(std::move(changeset.second.Steps));
+  }
+  m_openChangesets.clear();
+  m_bufferedSteps = 0;
+}
+
+void ChangesetBatcher::Close(
+    std::unordered_map<std::string, OpenChangeset>::iterator changeset,
+    std::vector<std::vector<Models::TransactionStep>>& ready)
+{
+  m_bufferedSteps -= changeset->second.Steps.size();
+  ready.emplace_back(std::move(changeset->second.Steps));
+  m_openChangesets.erase(changeset);
+}
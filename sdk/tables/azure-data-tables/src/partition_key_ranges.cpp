@@ -0,0 +1,87 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "private/partition_key_ranges.hpp"
+
+using namespace Azure::Data::Tables::_detail;
+
+namespace {
+// Characters that keys commonly start with, in ascending order. Keys starting with other
+// characters are still found, since a probe returns the first key at or after the candidate.
+constexpr const char* SampleAlphabet
+    = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+std::string QuoteLiteral(std::string const& value)
+{
+  std::string quoted = "'";
+  for (auto c : value)
+  {
+    quoted += c;
+    if (c == '\'')
+    {
+      quoted += c;
+    }
+  }
+  quoted += "'";
+  return quoted;
+}
+} // namespace
+
+Azure::Nullable<std::string> PartitionKeyRanges::GetRangeFilter(
+    Azure::Nullable<std::string> const& lowerBound,
+    Azure::Nullable<std::string> const& upperBound,
+    Azure::Nullable<std::string> const& filter)
+{
+  std::string rangeFilter;
+  if (lowerBound.HasValue())
+  {
+    rangeFilter = "PartitionKey ge " + QuoteLiteral(lowerBound.Value());
+  }
+  if (upperBound.HasValue())
+  {
+    if (!rangeFilter.empty())
+    {
+      rangeFilter += " and ";
+    }
+    rangeFilter += "PartitionKey lt " + QuoteLiteral(upperBound.Value());
+  }
+
+  if (rangeFilter.empty())
+  {
+    return filter;
+  }
+  if (!filter.HasValue() || filter.Value().empty())
+  {
+    return rangeFilter;
+  }
+  return "(" + filter.Value() + ") and (" + rangeFilter + ")";
+}
+
+std::vector<std::string> PartitionKeyRanges::GetSampleCandidates(std::string const& prefix)
+{
+  // The prefix itself finds the first key under it, whatever character that key continues with.
+  std::vector<std::string> candidates{prefix};
+  for (auto c = SampleAlphabet; *c != '\0'; ++c)
+  {
+    candidates.emplace_back(prefix + *c);
+  }
+  return candidates;
+}
+
+std::vector<std::string> PartitionKeyRanges::SelectBoundaries(
+    std::vector<std::string> const& keys,
+    size_t maxBoundaries)
+{
+  if (keys.size() <= maxBoundaries)
+  {
+    return keys;
+  }
+
+  std::vector<std::string> boundaries;
+  boundaries.reserve(maxBoundaries);
+  for (size_t i = 1; i <= maxBoundaries; ++i)
+  {
+    boundaries.emplace_back(keys[i * keys.size() / (maxBoundaries + 1)]);
+  }
+  return boundaries;
+}
@@ -16,8 +16,7 @@ namespace Azure { namespace Data { namespace Tables { namespace _detail { namesp
       Core::Http::Policies::NextHttpPolicy nextPolicy,
       Core::Context const& context) const
   {
-    const auto& headers = request.GetHeaders();
-    if (headers.find(HttpHeaderDate) == headers.end())
+    if (!request.HasHeader(HttpHeaderDate))
     {
       // add x-ms-date header in RFC1123 format
       request.SetHeader(
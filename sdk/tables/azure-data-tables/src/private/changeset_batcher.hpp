@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "azure/data/tables/models.hpp"
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Azure { namespace Data { namespace Tables { namespace _detail {
+
+  /**
+   * @brief Groups a stream of transaction steps into changesets that can be submitted as a
+   * single transaction.
+   *
+   * @details A changeset only contains steps for one partition key, at most #MaxChangesetSteps
+   * steps, at most #MaxChangesetBytes of estimated payload, and never two steps for the same
+   * entity.
+   */
+  class ChangesetBatcher final {
+  public:
+    /**
+     * Maximum number of operations the service accepts in a single changeset.
+     */
+    constexpr static size_t MaxChangesetSteps = 100;
+    /**
+     * Maximum size of a batch request payload accepted by the service.
+     */
+    constexpr static size_t MaxChangesetBytes = 4 * 1024 * 1024;
+
+    /**
+     * @brief Constructs a batcher.
+     *
+     * @param maxBufferedSteps Maximum number of steps held in changesets that are not full yet.
+     * Once exceeded, the largest open changeset is closed early.
+     * @param stepOverhead Estimated size of the multipart framing of a single step, excluding
+     * the entity itself.
+     */
+    explicit ChangesetBatcher(size_t maxBufferedSteps, size_t stepOverhead);
+
+    /**
+     * @brief Adds a step, moving any changeset that can no longer grow to \p ready.
+     */
+    void Add(
+        Models::TransactionStep step,
+        std::vector<std::vector<Models::TransactionStep>>& ready);
+
+    /**
+     * @brief Moves every open changeset to \p ready.
+     */
+    void Flush(std::vector<std::vector<Models::TransactionStep>>& ready);
+
+    /**
+     * @brief Returns the estimated payload size of a step.
+     */
+    size_t EstimateStepSize(Models::TransactionStep const& step) const;
+
+  private:
+    struct OpenChangeset final
+    {
+      std::vector<Models::TransactionStep> Steps;
+      std::set<std::string> RowKeys;
+      size_t Bytes = 0;
+    };
+
+    void Close(
+        std::unordered_map<std::string, OpenChangeset>::iterator changeset,
+        std::vector<std::vector<Models::TransactionStep>>& ready);
+
+    std::unordered_map<std::string, OpenChangeset> m_openChangesets;
+    size_t m_bufferedSteps = 0;
+    size_t m_maxBufferedSteps;
+    size_t m_stepOverhead;
+  };
+}}}} // namespace Azure::Data::Tables::_detail
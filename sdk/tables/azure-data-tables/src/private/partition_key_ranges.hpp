@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <azure/core/nullable.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Azure { namespace Data { namespace Tables { namespace _detail {
+
+  /**
+   * @brief Helpers to split the partition key space of a table into ranges.
+   */
+  class PartitionKeyRanges final {
+  public:
+    /**
+     * @brief Builds the filter expression for the range [\p lowerBound, \p upperBound), combined
+     * with \p filter.
+     *
+     * @param lowerBound Inclusive lower bound, or empty for the start of the key space.
+     * @param upperBound Exclusive upper bound, or empty for the end of the key space.
+     * @param filter The filter expression supplied by the caller.
+     */
+    static Azure::Nullable<std::string> GetRangeFilter(
+        Azure::Nullable<std::string> const& lowerBound,
+        Azure::Nullable<std::string> const& upperBound,
+        Azure::Nullable<std::string> const& filter);
+
+    /**
+     * @brief Returns the keys probed to find split points under \p prefix, in ascending order.
+     */
+    static std::vector<std::string> GetSampleCandidates(std::string const& prefix);
+
+    /**
+     * @brief Picks at most \p maxBoundaries evenly spaced keys from the sorted, distinct
+     * \p keys.
+     */
+    static std::vector<std::string> SelectBoundaries(
+        std::vector<std::string> const& keys,
+        size_t maxBoundaries);
+  };
+}}}} // namespace Azure::Data::Tables::_detail
@@ -76,5 +76,13 @@ namespace Azure { namespace Data { namespace Tables { namespace _detail {
      * @brief Deserialize a TableEntity from JSON.
      */
     static Models::TableEntity DeserializeEntity(Azure::Core::Json::_internal::json json);
+
+    /**
+     * @brief Deserialize the TableEntities of a query response directly from its JSON body,
+     * without building a JSON document.
+     *
+     */
+    static std::vector<Models::TableEntity> DeserializeEntities(
+        std::vector<uint8_t> const& responseData);
   };
 }}}} // namespace Azure::Data::Tables::_detail
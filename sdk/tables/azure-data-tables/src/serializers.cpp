@@ -3,11 +3,270 @@
 
 #include "private/serializers.hpp"
 
+#include "private/tables_constants.hpp"
+
 #include <azure/core/internal/json/json.hpp>
 
+#include <stdexcept>
+
 using namespace Azure::Data::Tables::_detail::Xml;
 using namespace Azure::Data::Tables;
 using namespace Azure::Data::Tables::Models;
+
+namespace {
+using Azure::Core::Json::_internal::json;
+
+constexpr static const char* ODataTypeSuffix = "@odata.type";
+
+/**
+ * @brief SAX handler which builds table entities directly from the bytes of a query response,
+ * without creating a JSON document first.
+ *
+ * @remark The response is either a single entity, or an object with the entities in its "value"
+ * array. Properties are collected into a flat vector and moved into the entity once all of them
+ * (including their "@odata.type" annotations) have been read.
+ */
+class TableEntitiesSaxHandler final : public Azure::Core::Json::_internal::json_sax<json> {
+public:
+  explicit TableEntitiesSaxHandler(std::vector<TableEntity>& entities) : m_entities(entities) {}
+
+  bool null() override { return Scalar("null"); }
+
+  bool boolean(bool val) override { return Scalar(val ? "true" : "false"); }
+
+  bool number_integer(number_integer_t val) override { return Scalar(std::to_string(val)); }
+
+  bool number_unsigned(number_unsigned_t val) override { return Scalar(std::to_string(val)); }
+
+  bool number_float(number_float_t val, string_t const&) override
+  {
+    // Format the same way as json::dump() does.
+    return Scalar(json(val).dump());
+  }
+
+  bool string(string_t& val) override
+  {
+    if (IsNested())
+    {
+      return Scalar(json(val).dump());
+    }
+    return Scalar(std::move(val));
+  }
+
+  bool binary(binary_t&) override { return Scalar(std::string()); }
+
+  bool start_object(std::size_t) override
+  {
+    ++m_depth;
+    if (m_depth == 1)
+    {
+      // The root object is an entity unless it turns out to have a "value" array.
+      StartEntity();
+    }
+    else if (m_inValueArray && m_depth == EntityInValueArrayDepth)
+    {
+      StartEntity();
+    }
+    else
+    {
+      StartNested('{');
+    }
+    return true;
+  }
+
+  bool key(string_t& val) override
+  {
+    if (IsNested())
+    {
+      if (m_nestedValue.back() != '{')
+      {
+        m_nestedValue += ',';
+      }
+      m_nestedValue += json(val).dump();
+      m_nestedValue += ':';
+    }
+    else
+    {
+      m_key = std::move(val);
+    }
+    return true;
+  }
+
+  bool end_object() override
+  {
+    if (IsNested())
+    {
+      EndNested('}');
+    }
+    else if (m_depth == m_entityDepth)
+    {
+      EndEntity();
+    }
+    --m_depth;
+    return true;
+  }
+
+  bool start_array(std::size_t) override
+  {
+    ++m_depth;
+    if (m_depth == 2 && !IsNested() && m_key == Azure::Data::Tables::_detail::Value)
+    {
+      m_inValueArray = true;
+      m_entityDepth = 0;
+    }
+    else
+    {
+      StartNested('[');
+    }
+    return true;
+  }
+
+  bool end_array() override
+  {
+    if (IsNested())
+    {
+      EndNested(']');
+    }
+    else if (m_inValueArray && m_depth == 2)
+    {
+      m_inValueArray = false;
+    }
+    --m_depth;
+    return true;
+  }
+
+  bool parse_error(
+      std::size_t,
+      std::string const&,
+      Azure::Core::Json::_internal::detail::exception const& ex) override
+  {
+    // Surface the same exceptions as json::parse().
+    switch ((ex.id / 100) % 100)
+    {
+      case 1:
+        throw *static_cast<json::parse_error const*>(&ex);
+      case 4:
+        throw *static_cast<json::out_of_range const*>(&ex);
+      default:
+        throw std::runtime_error(ex.what());
+    }
+  }
+
+private:
+  // Depth of the entity objects found in {"value":[{...}]}.
+  constexpr static int EntityInValueArrayDepth = 3;
+
+  std::vector<TableEntity>& m_entities;
+  std::vector<std::pair<std::string, std::string>> m_properties;
+  std::string m_key;
+  int m_depth = 0;
+  int m_entityDepth = 0;
+  bool m_inValueArray = false;
+
+  // Objects and arrays nested within a property are kept as JSON text, like json::dump() would.
+  std::string m_nestedValue;
+  int m_nestedDepth = 0;
+
+  bool IsNested() const { return m_nestedDepth != 0; }
+
+  bool Scalar(std::string value)
+  {
+    if (IsNested())
+    {
+      AppendNestedSeparator();
+      m_nestedValue += value;
+    }
+    else if (m_entityDepth != 0 && m_depth == m_entityDepth)
+    {
+      m_properties.emplace_back(std::move(m_key), std::move(value));
+    }
+    return true;
+  }
+
+  void AppendNestedSeparator()
+  {
+    // In objects, the separator is written together with the key.
+    if (m_nestedValue.back() == '[' || m_nestedValue.back() == ',')
+    {
+      return;
+    }
+    if (m_nestedValue.back() != ':')
+    {
+      m_nestedValue += ',';
+    }
+  }
+
+  void StartNested(char open)
+  {
+    if (IsNested())
+    {
+      AppendNestedSeparator();
+    }
+    else
+    {
+      m_nestedValue.clear();
+    }
+    m_nestedValue += open;
+    ++m_nestedDepth;
+  }
+
+  void EndNested(char close)
+  {
+    m_nestedValue += close;
+    --m_nestedDepth;
+    if (!IsNested() && m_entityDepth != 0 && m_depth - 1 == m_entityDepth)
+    {
+      m_properties.emplace_back(std::move(m_key), std::move(m_nestedValue));
+    }
+  }
+
+  void StartEntity()
+  {
+    m_properties.clear();
+    m_entityDepth = m_depth;
+  }
+
+  void EndEntity()
+  {
+    m_entityDepth = 0;
+
+    TableEntity entity;
+    auto const suffixLength = std::char_traits<char>::length(ODataTypeSuffix);
+    auto isTypeAnnotation = [&](std::string const& name) {
+      return name.size() > suffixLength
+          && name.compare(name.size() - suffixLength, suffixLength, ODataTypeSuffix) == 0;
+    };
+
+    for (auto& property : m_properties)
+    {
+      if (!isTypeAnnotation(property.first))
+      {
+        entity.Properties[std::move(property.first)]
+            = TableEntityProperty(std::move(property.second));
+      }
+    }
+    for (auto& property : m_properties)
+    {
+      if (isTypeAnnotation(property.first))
+      {
+        auto found = entity.Properties.find(
+            property.first.substr(0, property.first.size() - suffixLength));
+        if (found != entity.Properties.end())
+        {
+          found->second.Type = TableEntityDataType(std::move(property.second));
+        }
+        else
+        {
+          entity.Properties[std::move(property.first)]
+              = TableEntityProperty(std::move(property.second));
+        }
+      }
+    }
+    m_entities.emplace_back(std::move(entity));
+  }
+};
+} // namespace
+
 namespace Azure { namespace Data { namespace Tables { namespace _detail {
   std::string const Serializers::CreateEntity(Models::TableEntity const& tableEntity)
   {
@@ -566,4 +825,13 @@ namespace Azure { namespace Data { namespace Tables { namespace _detail {
     }
     return tableEntity;
   }
+
+  std::vector<Models::TableEntity> Serializers::DeserializeEntities(
+      std::vector<uint8_t> const& responseData)
+  {
+    std::vector<Models::TableEntity> entities;
+    TableEntitiesSaxHandler handler(entities);
+    Core::Json::_internal::json::sax_parse(responseData.begin(), responseData.end(), &handler);
+    return entities;
+  }
 }}}} // namespace Azure::Data::Tables::_detail
@@ -3,15 +3,26 @@
 
 #include "azure/data/tables/table_client.hpp"
 #include "azure/data/tables/table_service_client.hpp"
+#include "private/changeset_batcher.hpp"
 #include "private/package_version.hpp"
+#include "private/partition_key_ranges.hpp"
 #include "private/policies/service_version_policy.hpp"
 #include "private/policies/tenant_bearer_token_policy.hpp"
 #include "private/policies/timeout_policy.hpp"
 #include "private/serializers.hpp"
 #include "private/tables_constants.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <iterator>
+#include <mutex>
+#include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 
 using namespace Azure::Data::Tables;
 using namespace Azure::Data::Tables::_detail::Policies;
@@ -630,12 +641,15 @@ Models::QueryEntitiesPagedResponse TableClient::QueryEntities(
     Core::Context const& context) const
 {
   auto url = m_url;
-  if (!options.NextPartitionKey.empty() && !options.NextRowKey.empty())
+  if (!options.NextPartitionKey.empty())
   {
     url.AppendPath(Azure::Core::Url::Encode(m_tableName));
     url.AppendQueryParameter(
         "NextPartitionKey", Azure::Core::Url::Encode(options.NextPartitionKey));
-    url.AppendQueryParameter("NextRowKey", Azure::Core::Url::Encode(options.NextRowKey));
+    if (!options.NextRowKey.empty())
+    {
+      url.AppendQueryParameter("NextRowKey", Azure::Core::Url::Encode(options.NextRowKey));
+    }
   }
   else
   {
@@ -673,6 +687,7 @@ Models::QueryEntitiesPagedResponse TableClient::QueryEntities(
   }
 
   Models::QueryEntitiesPagedResponse response(std::make_shared<TableClient>(*this));
+  response.m_operationOptions = options;
   {
     const auto& responseBody = rawResponse->GetBody();
 
@@ -692,23 +707,217 @@ Models::QueryEntitiesPagedResponse TableClient::QueryEntities(
       response.NextPageToken = "true";
     }
 
-    response.TableEntities.clear();
-    auto const jsonRoot
-        = Core::Json::_internal::json::parse(responseBody.begin(), responseBody.end());
+    response.TableEntities = Serializers::DeserializeEntities(responseBody);
+  }
+  return response;
+}
+
+namespace {
+// Runs func(0) ... func(count - 1) on up to concurrency threads, stopping at the first exception.
+void RunConcurrently(size_t count, int32_t concurrency, std::function<void(size_t)> const& func)
+{
+  std::atomic<size_t> nextIndex{0};
+  std::atomic<bool> failed{false};
+  auto threadFunc = [&]() {
+    while (!failed)
+    {
+      auto const index = nextIndex.fetch_add(1);
+      if (index >= count)
+      {
+        break;
+      }
+      try
+      {
+        func(index);
+      }
+      catch (...)
+      {
+        failed = true;
+        throw;
+      }
+    }
+  };
+
+  auto const numThreads
+      = (std::min)(static_cast<size_t>((std::max)(concurrency, int32_t(1))), count);
+  std::vector<std::future<void>> threadHandles;
+  for (size_t i = 1; i < numThreads; ++i)
+  {
+    threadHandles.emplace_back(std::async(std::launch::async, threadFunc));
+  }
+  std::exception_ptr error;
+  try
+  {
+    threadFunc();
+  }
+  catch (...)
+  {
+    error = std::current_exception();
+  }
+  for (auto& handle : threadHandles)
+  {
+    try
+    {
+      handle.get();
+    }
+    catch (...)
+    {
+      if (!error)
+      {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+}
+} // namespace
+
+void TableClient::QueryEntitiesInParallel(
+    std::function<void(std::vector<Models::TableEntity>&)> const& onPage,
+    Models::QueryEntitiesInParallelOptions const& options,
+    Core::Context const& context) const
+{
+  for (size_t i = 1; i < options.PartitionKeyBoundaries.size(); ++i)
+  {
+    if (!(options.PartitionKeyBoundaries[i - 1] < options.PartitionKeyBoundaries[i]))
+    {
+      throw std::invalid_argument("PartitionKeyBoundaries must be strictly increasing.");
+    }
+  }
+  auto const boundaries = options.PartitionKeyBoundaries.empty()
+      ? SamplePartitionKeyBoundaries(options.Concurrency, context)
+      : options.PartitionKeyBoundaries;
+
+  std::mutex onPageMutex;
+  RunConcurrently(boundaries.size() + 1, options.Concurrency, [&](size_t range) {
+    Models::QueryEntitiesOptions queryOptions;
+    queryOptions.SelectColumns = options.SelectColumns;
+    queryOptions.Filter = PartitionKeyRanges::GetRangeFilter(
+        range == 0 ? Azure::Nullable<std::string>() : boundaries[range - 1],
+        range == boundaries.size() ? Azure::Nullable<std::string>() : boundaries[range],
+        options.Filter);
+
+    for (auto page = QueryEntities(queryOptions, context); page.HasPage();
+         page.MoveToNextPage(context))
+    {
+      if (!page.TableEntities.empty())
+      {
+        std::lock_guard<std::mutex> lock(onPageMutex);
+        onPage(page.TableEntities);
+      }
+    }
+  });
+}
 
-    if (!jsonRoot.contains(Value))
+Azure::Nullable<std::string> TableClient::FindFirstPartitionKey(
+    std::string const& lowerBound,
+    Core::Context const& context) const
+{
+  Models::QueryEntitiesOptions options;
+  options.Filter = PartitionKeyRanges::GetRangeFilter(lowerBound, {}, {});
+  options.SelectColumns = "PartitionKey";
+  while (true)
+  {
+    auto url = m_url;
+    if (options.NextPartitionKey.empty())
     {
-      response.TableEntities.emplace_back(Serializers::DeserializeEntity(jsonRoot));
+      url.AppendPath(Azure::Core::Url::Encode(m_tableName) + "()");
     }
     else
     {
-      for (auto value : jsonRoot[Value])
+      url.AppendPath(Azure::Core::Url::Encode(m_tableName));
+      url.AppendQueryParameter(
+          "NextPartitionKey", Azure::Core::Url::Encode(options.NextPartitionKey));
+      if (!options.NextRowKey.empty())
       {
-        response.TableEntities.emplace_back(Serializers::DeserializeEntity(value));
+        url.AppendQueryParameter("NextRowKey", Azure::Core::Url::Encode(options.NextRowKey));
       }
     }
+    url.AppendQueryParameter("$filter", Azure::Core::Url::Encode(options.Filter.Value()));
+    url.AppendQueryParameter("$select", options.SelectColumns);
+    url.AppendQueryParameter("$top", "1");
+
+    Core::Http::Request request(Core::Http::HttpMethod::Get, url);
+    request.SetHeader(AcceptHeader, AcceptFullMeta);
+
+    auto rawResponse = m_pipeline->Send(request, context);
+    if (rawResponse->GetStatusCode() != Core::Http::HttpStatusCode::Ok)
+    {
+      throw Core::RequestFailedException(rawResponse);
+    }
+
+    auto const entities = Serializers::DeserializeEntities(rawResponse->GetBody());
+    if (!entities.empty())
+    {
+      return entities.front().GetPartitionKey().Value;
+    }
+
+    // The service may return an empty page with a continuation token when the query times out.
+    auto const& headers = rawResponse->GetHeaders();
+    auto const nextPartitionKey = headers.find("x-ms-continuation-NextPartitionKey");
+    if (nextPartitionKey == headers.end())
+    {
+      return {};
+    }
+    options.NextPartitionKey = nextPartitionKey->second;
+    auto const nextRowKey = headers.find("x-ms-continuation-NextRowKey");
+    options.NextRowKey = nextRowKey == headers.end() ? std::string() : nextRowKey->second;
   }
-  return response;
+}
+
+std::vector<std::string> TableClient::SamplePartitionKeyBoundaries(
+    int32_t concurrency,
+    Core::Context const& context) const
+{
+  // Probes the first partition key at or after each candidate prefix. When all probes under the
+  // current prefix land on the same key, the prefix is extended by that key's next character, so
+  // that tables whose keys share a long common prefix can be split too, within a bounded number
+  // of probes.
+  constexpr size_t MaxSampleProbes = 512;
+  size_t probes = 0;
+  std::string prefix;
+  std::vector<std::string> keys;
+  while (true)
+  {
+    auto const candidates = PartitionKeyRanges::GetSampleCandidates(prefix);
+    if (probes + candidates.size() > MaxSampleProbes)
+    {
+      break;
+    }
+    probes += candidates.size();
+    std::vector<Azure::Nullable<std::string>> results(candidates.size());
+    RunConcurrently(candidates.size(), concurrency, [&](size_t i) {
+      results[i] = FindFirstPartitionKey(candidates[i], context);
+    });
+
+    std::set<std::string> found;
+    for (auto const& result : results)
+    {
+      if (result.HasValue() && result.Value().compare(0, prefix.size(), prefix) == 0)
+      {
+        found.emplace(result.Value());
+      }
+    }
+    keys.assign(found.begin(), found.end());
+    if (keys.size() != 1 || keys.front().size() <= prefix.size())
+    {
+      break;
+    }
+    prefix += keys.front()[prefix.size()];
+  }
+
+  if (keys.empty())
+  {
+    return keys;
+  }
+  // The first range starts at the beginning of the key space, so the smallest key isn't a split
+  // point.
+  keys.erase(keys.begin());
+  return PartitionKeyRanges::SelectBoundaries(
+      keys, static_cast<size_t>((std::max)(concurrency, int32_t(1))) * 4 - 1);
 }
 
 Azure::Response<Models::SubmitTransactionResult> TableClient::SubmitTransaction(
@@ -779,158 +988,434 @@ Azure::Response<Models::SubmitTransactionResult> TableClient::SubmitTransaction(
   return Response<Models::SubmitTransactionResult>(std::move(response), std::move(rawResponse));
 }
 
+namespace {
+bool IsRetriableTransactionStatus(std::string const& statusCode)
+{
+  return statusCode == "0" || statusCode == "408" || statusCode == "429" || statusCode == "500"
+      || statusCode == "502" || statusCode == "503" || statusCode == "504";
+}
+} // namespace
+
+Models::SubmitTransactionsInBulkResult TableClient::SubmitTransactionsInBulk(
+    std::vector<Models::TransactionStep> const& steps,
+    Models::SubmitTransactionsInBulkOptions const& options,
+    Core::Context const& context) const
+{
+  size_t nextIndex = 0;
+  return SubmitTransactionsInBulk(
+      [&](Models::TransactionStep& step) {
+        if (nextIndex == steps.size())
+        {
+          return false;
+        }
+        step = steps[nextIndex++];
+        return true;
+      },
+      options,
+      context);
+}
+
+Models::SubmitTransactionsInBulkResult TableClient::SubmitTransactionsInBulk(
+    std::function<bool(Models::TransactionStep&)> const& nextStep,
+    Models::SubmitTransactionsInBulkOptions const& options,
+    Core::Context const& context) const
+{
+  auto const concurrency = (std::max)(options.Concurrency, 1);
+  auto const maxQueuedChangesets = static_cast<size_t>(concurrency) * 2;
+  ChangesetBatcher batcher(
+      static_cast<size_t>((std::max)(options.MaxBufferedSteps, 1)), EstimateStepOverhead());
+
+  std::mutex mutex;
+  std::condition_variable queueChanged;
+  std::deque<std::vector<Models::TransactionStep>> queue;
+  // A partition has at most one changeset in flight, so that its changesets, and the steps for
+  // the same entity, are applied in the order they are produced.
+  std::set<std::string> inFlightPartitions;
+  bool producerDone = false;
+  std::exception_ptr error;
+  Models::SubmitTransactionsInBulkResult result;
+
+  auto worker = [&]() {
+    while (true)
+    {
+      std::vector<Models::TransactionStep> steps;
+      std::string partitionKey;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        auto next = queue.end();
+        queueChanged.wait(lock, [&] {
+          next = std::find_if(
+              queue.begin(), queue.end(), [&](std::vector<Models::TransactionStep> const& c) {
+                return inFlightPartitions.count(c.front().Entity.GetPartitionKey().Value) == 0;
+              });
+          return next != queue.end() || (producerDone && queue.empty()) || error;
+        });
+        if (error || next == queue.end())
+        {
+          return;
+        }
+        steps = std::move(*next);
+        queue.erase(next);
+        partitionKey = steps.front().Entity.GetPartitionKey().Value;
+        inFlightPartitions.insert(partitionKey);
+      }
+      queueChanged.notify_all();
+
+      try
+      {
+        auto changesetResult = SubmitChangeset(std::move(steps), options, context);
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          inFlightPartitions.erase(partitionKey);
+          result.CommittedTransactions += changesetResult.CommittedTransactions;
+          result.CommittedSteps += changesetResult.CommittedSteps;
+          std::move(
+              changesetResult.FailedTransactions.begin(),
+              changesetResult.FailedTransactions.end(),
+              std::back_inserter(result.FailedTransactions));
+        }
+        queueChanged.notify_all();
+      }
+      catch (...)
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (!error)
+          {
+            error = std::current_exception();
+          }
+        }
+        queueChanged.notify_all();
+        return;
+      }
+    }
+  };
+
+  std::vector<std::future<void>> workers;
+  for (int32_t i = 0; i < concurrency; ++i)
+  {
+    workers.emplace_back(std::async(std::launch::async, worker));
+  }
+
+  // The calling thread groups the steps while the workers submit the changesets that are full.
+  try
+  {
+    std::vector<std::vector<Models::TransactionStep>> ready;
+    bool hasMoreSteps = true;
+    while (hasMoreSteps)
+    {
+      Models::TransactionStep step;
+      hasMoreSteps = nextStep(step);
+      if (hasMoreSteps)
+      {
+        batcher.Add(std::move(step), ready);
+      }
+      else
+      {
+        batcher.Flush(ready);
+      }
+      if (ready.empty())
+      {
+        continue;
+      }
+
+      context.ThrowIfCancelled();
+      std::unique_lock<std::mutex> lock(mutex);
+      for (auto& changeset : ready)
+      {
+        queueChanged.wait(lock, [&] { return queue.size() < maxQueuedChangesets || error; });
+        if (error)
+        {
+          break;
+        }
+        queue.emplace_back(std::move(changeset));
+        queueChanged.notify_all();
+      }
+      ready.clear();
+      if (error)
+      {
+        break;
+      }
+    }
+  }
+  catch (...)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!error)
+    {
+      error = std::current_exception();
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    producerDone = true;
+  }
+  queueChanged.notify_all();
+  for (auto& handle : workers)
+  {
+    handle.get();
+  }
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+  return result;
+}
+
+Models::SubmitTransactionsInBulkResult TableClient::SubmitChangeset(
+    std::vector<Models::TransactionStep> steps,
+    Models::SubmitTransactionsInBulkOptions const& options,
+    Core::Context const& context) const
+{
+  Models::SubmitTransactionsInBulkResult result;
+  for (int32_t attempt = 0;; ++attempt)
+  {
+    std::string statusCode;
+    Azure::Nullable<Models::TransactionError> transactionError;
+    try
+    {
+      auto response = SubmitTransaction(steps, context);
+      if (!response.Value.Error.HasValue())
+      {
+        result.CommittedTransactions = 1;
+        result.CommittedSteps = static_cast<int64_t>(steps.size());
+        return result;
+      }
+      statusCode = response.Value.StatusCode;
+      transactionError = response.Value.Error;
+    }
+    catch (Core::RequestFailedException const& e)
+    {
+      // The size of a changeset is only estimated, so split it if the service rejects it.
+      if (e.StatusCode == Core::Http::HttpStatusCode::PayloadTooLarge && steps.size() > 1)
+      {
+        auto const middle = steps.begin() + static_cast<std::ptrdiff_t>(steps.size() / 2);
+        std::vector<Models::TransactionStep> second(
+            std::make_move_iterator(middle), std::make_move_iterator(steps.end()));
+        steps.erase(middle, steps.end());
+
+        result = SubmitChangeset(std::move(steps), options, context);
+        auto secondResult = SubmitChangeset(std::move(second), options, context);
+        result.CommittedTransactions += secondResult.CommittedTransactions;
+        result.CommittedSteps += secondResult.CommittedSteps;
+        std::move(
+            secondResult.FailedTransactions.begin(),
+            secondResult.FailedTransactions.end(),
+            std::back_inserter(result.FailedTransactions));
+        return result;
+      }
+      statusCode = std::to_string(static_cast<int>(e.StatusCode));
+      transactionError = Models::TransactionError{e.Message, e.ErrorCode};
+    }
+    catch (Core::OperationCancelledException const&)
+    {
+      throw;
+    }
+    catch (std::exception const& e)
+    {
+      // No response was received, and the pipeline has already retried the request.
+      result.FailedTransactions.emplace_back(
+          Models::FailedTransaction{std::move(steps), {}, Models::TransactionError{e.what(), {}}});
+      return result;
+    }
+
+    if (attempt >= options.MaxRetries || !IsRetriableTransactionStatus(statusCode))
+    {
+      result.FailedTransactions.emplace_back(Models::FailedTransaction{
+          std::move(steps), std::move(statusCode), std::move(transactionError)});
+      return result;
+    }
+
+    context.ThrowIfCancelled();
+    std::this_thread::sleep_for(options.RetryDelay * (int64_t(1) << (std::min)(attempt, 16)));
+  }
+}
+
+size_t TableClient::EstimateStepOverhead() const
+{
+  // Fixed multipart framing and sub-request headers of a single step, plus its request URL.
+  return 320 + m_url.GetAbsoluteUrl().size() + m_tableName.size();
+}
+
 std::string TableClient::PreparePayload(
     std::string const& batchId,
     std::string const& changesetId,
     std::vector<Models::TransactionStep> const& steps) const
 {
-  std::string accumulator
-      = "--" + batchId + "\nContent-Type: multipart/mixed; boundary=" + changesetId + "\n\n";
+  // Serialize the entities up front so the payload can be written into a single buffer.
+  std::vector<std::string> bodies;
+  bodies.reserve(steps.size());
+  auto const stepOverhead = EstimateStepOverhead() + changesetId.size();
+  size_t payloadSize = 2 * batchId.size() + 2 * changesetId.size() + 64;
+  for (auto const& step : steps)
+  {
+    switch (step.Action)
+    {
+      case Models::TransactionActionType::Add:
+        bodies.emplace_back(Serializers::CreateEntity(step.Entity));
+        break;
+      case Models::TransactionActionType::Delete:
+        bodies.emplace_back();
+        break;
+      case Models::TransactionActionType::InsertMerge:
+      case Models::TransactionActionType::UpdateMerge:
+        bodies.emplace_back(Serializers::MergeEntity(step.Entity));
+        break;
+      case Models::TransactionActionType::InsertReplace:
+      case Models::TransactionActionType::UpdateReplace:
+        bodies.emplace_back(Serializers::UpdateEntity(step.Entity));
+        break;
+    }
+    payloadSize += stepOverhead + bodies.back().size()
+        + 3
+            * (step.Entity.GetPartitionKey().Value.size()
+               + step.Entity.GetRowKey().Value.size())
+        + step.Entity.GetETag().Value.size();
+  }
+
+  std::string payload;
+  payload.reserve(payloadSize);
+  payload.append("--")
+      .append(batchId)
+      .append("\nContent-Type: multipart/mixed; boundary=")
+      .append(changesetId)
+      .append("\n\n");
 
-  for (auto step : steps)
+  for (size_t i = 0; i < steps.size(); ++i)
   {
+    auto const& step = steps[i];
     switch (step.Action)
     {
       case Models::TransactionActionType::Add:
-        accumulator += PrepAddEntity(changesetId, step.Entity);
+        PrepAddEntity(payload, changesetId, step.Entity, bodies[i]);
         break;
       case Models::TransactionActionType::Delete:
-        accumulator += PrepDeleteEntity(changesetId, step.Entity);
+        PrepDeleteEntity(payload, changesetId, step.Entity);
         break;
       case Models::TransactionActionType::InsertMerge:
       case Models::TransactionActionType::UpdateMerge:
-        accumulator += PrepMergeEntity(changesetId, step.Entity);
+        PrepMergeEntity(payload, changesetId, step.Entity, bodies[i]);
         break;
       case Models::TransactionActionType::InsertReplace:
-        accumulator += PrepInsertEntity(changesetId, step.Entity);
+        PrepInsertEntity(payload, changesetId, step.Entity, bodies[i]);
         break;
       case Models::TransactionActionType::UpdateReplace:
-        accumulator += PrepUpdateEntity(changesetId, step.Entity);
+        PrepUpdateEntity(payload, changesetId, step.Entity, bodies[i]);
         break;
     }
   }
 
-  accumulator += "\n\n--" + changesetId + "--\n";
-  accumulator += "--" + batchId + "\n";
-  return accumulator;
+  payload.append("\n\n--").append(changesetId).append("--\n");
+  payload.append("--").append(batchId).append("\n");
+  return payload;
 }
-std::string TableClient::PrepAddEntity(std::string const& changesetId, Models::TableEntity entity)
-    const
+
+void TableClient::PrepAddEntity(
+    std::string& payload,
+    std::string const& changesetId,
+    Models::TableEntity const&,
+    std::string const& body) const
 {
-  std::string returnValue = "--" + changesetId + "\n";
-  returnValue += "Content-Type: application/http\n";
-  returnValue += "Content-Transfer-Encoding: binary\n\n";
+  payload.append("--").append(changesetId).append("\n");
+  payload.append("Content-Type: application/http\n");
+  payload.append("Content-Transfer-Encoding: binary\n\n");
   auto url = m_url;
   url.AppendPath(m_tableName);
-  returnValue += "POST " + url.GetAbsoluteUrl() + " HTTP/1.1\n";
-  returnValue += "Content-Type: application/json\n";
-  returnValue += "Accept: application/json;odata=minimalmetadata\n";
-  returnValue += "Prefer: return-no-content\n";
-  returnValue += "DataServiceVersion: 3.0;\n\n";
-  returnValue += Serializers::CreateEntity(entity);
-  return returnValue;
-}
-std::string TableClient::PrepDeleteEntity(
+  payload.append("POST ").append(url.GetAbsoluteUrl()).append(" HTTP/1.1\n");
+  payload.append("Content-Type: application/json\n");
+  payload.append("Accept: application/json;odata=minimalmetadata\n");
+  payload.append("Prefer: return-no-content\n");
+  payload.append("DataServiceVersion: 3.0;\n\n");
+  payload.append(body);
+}
+
+void TableClient::PrepDeleteEntity(
+    std::string& payload,
     std::string const& changesetId,
-    Models::TableEntity entity) const
+    Models::TableEntity const& entity) const
 {
-  std::string returnValue = "--" + changesetId + "\n";
-  returnValue += "Content-Type: application/http\n";
-  returnValue += "Content-Transfer-Encoding: binary\n\n";
+  payload.append("--").append(changesetId).append("\n");
+  payload.append("Content-Type: application/http\n");
+  payload.append("Content-Transfer-Encoding: binary\n\n");
   auto url = m_url;
   url.AppendPath(
       m_tableName + PartitionKeyFragment + entity.GetPartitionKey().Value + RowKeyFragment
       + entity.GetRowKey().Value + ClosingFragment);
-  returnValue += "DELETE " + url.GetAbsoluteUrl() + " HTTP/1.1\n";
-  returnValue += "Accept: application/json;odata=minimalmetadata\n";
-  returnValue += "Prefer: return-no-content\n";
-  returnValue += "DataServiceVersion: 3.0;\n";
-  if (!entity.GetETag().Value.empty())
-  {
-    returnValue += "If-Match: " + entity.GetETag().Value;
-  }
-  else
-  {
-    returnValue += "If-Match: *";
-  }
-  returnValue += "\n";
-  return returnValue;
+  payload.append("DELETE ").append(url.GetAbsoluteUrl()).append(" HTTP/1.1\n");
+  payload.append("Accept: application/json;odata=minimalmetadata\n");
+  payload.append("Prefer: return-no-content\n");
+  payload.append("DataServiceVersion: 3.0;\n");
+  auto const eTag = entity.GetETag().Value;
+  payload.append("If-Match: ").append(eTag.empty() ? "*" : eTag);
+  payload.append("\n");
 }
 
-std::string TableClient::PrepMergeEntity(std::string const& changesetId, Models::TableEntity entity)
-    const
+void TableClient::PrepMergeEntity(
+    std::string& payload,
+    std::string const& changesetId,
+    Models::TableEntity const& entity,
+    std::string const& body) const
 {
-  std::string returnValue = "--" + changesetId + "\n";
-  returnValue += "Content-Type: application/http\n";
-  returnValue += "Content-Transfer-Encoding: binary\n\n";
+  payload.append("--").append(changesetId).append("\n");
+  payload.append("Content-Type: application/http\n");
+  payload.append("Content-Transfer-Encoding: binary\n\n");
   auto url = m_url;
   url.AppendPath(
       m_tableName + PartitionKeyFragment + entity.GetPartitionKey().Value + RowKeyFragment
       + entity.GetRowKey().Value + ClosingFragment);
-  returnValue += "MERGE " + url.GetAbsoluteUrl() + " HTTP/1.1\n";
-  returnValue += "Content-Type: application/json\n";
-  returnValue += "Accept: application/json;odata=minimalmetadata\n";
-  returnValue += "DataServiceVersion: 3.0;\n\n";
-  returnValue += Serializers::MergeEntity(entity);
-
-  return returnValue;
+  payload.append("MERGE ").append(url.GetAbsoluteUrl()).append(" HTTP/1.1\n");
+  payload.append("Content-Type: application/json\n");
+  payload.append("Accept: application/json;odata=minimalmetadata\n");
+  payload.append("DataServiceVersion: 3.0;\n\n");
+  payload.append(body);
 }
 
-std::string TableClient::PrepUpdateEntity(
+void TableClient::PrepUpdateEntity(
+    std::string& payload,
     std::string const& changesetId,
-    Models::TableEntity entity) const
+    Models::TableEntity const& entity,
+    std::string const& body) const
 {
-  std::string returnValue = "--" + changesetId + "\n";
-  returnValue += "Content-Type: application/http\n";
-  returnValue += "Content-Transfer-Encoding: binary\n\n";
+  payload.append("--").append(changesetId).append("\n");
+  payload.append("Content-Type: application/http\n");
+  payload.append("Content-Transfer-Encoding: binary\n\n");
   auto url = m_url;
   url.AppendPath(
       m_tableName + PartitionKeyFragment + entity.GetPartitionKey().Value + RowKeyFragment
       + entity.GetRowKey().Value + ClosingFragment);
-  returnValue += "PUT " + url.GetAbsoluteUrl() + " HTTP/1.1\n";
-  returnValue += "Content-Type: application/json\n";
-  returnValue += "Accept: application/json;odata=minimalmetadata\n";
-  returnValue += "Prefer: return-no-content\n";
-  returnValue += "DataServiceVersion: 3.0;\n";
-  if (!entity.GetETag().Value.empty())
-  {
-    returnValue += "If-Match: " + entity.GetETag().Value;
-  }
-  else
-  {
-    returnValue += "If-Match: *";
-  }
-  returnValue += "\n\n";
-  returnValue += Serializers::UpdateEntity(entity);
-  return returnValue;
+  payload.append("PUT ").append(url.GetAbsoluteUrl()).append(" HTTP/1.1\n");
+  payload.append("Content-Type: application/json\n");
+  payload.append("Accept: application/json;odata=minimalmetadata\n");
+  payload.append("Prefer: return-no-content\n");
+  payload.append("DataServiceVersion: 3.0;\n");
+  auto const eTag = entity.GetETag().Value;
+  payload.append("If-Match: ").append(eTag.empty() ? "*" : eTag);
+  payload.append("\n\n");
+  payload.append(body);
 }
 
-std::string TableClient::PrepInsertEntity(
+void TableClient::PrepInsertEntity(
+    std::string& payload,
     std::string const& changesetId,
-    Models::TableEntity entity) const
+    Models::TableEntity const& entity,
+    std::string const& body) const
 {
-  std::string payload = Serializers::UpdateEntity(entity);
-  std::string returnValue = "--" + changesetId + "\n";
-  returnValue += "Content-Type: application/http\n";
-  returnValue += "Content-Transfer-Encoding: binary\n\n";
+  payload.append("--").append(changesetId).append("\n");
+  payload.append("Content-Type: application/http\n");
+  payload.append("Content-Transfer-Encoding: binary\n\n");
   auto url = m_url;
   url.AppendPath(
       m_tableName + PartitionKeyFragment + entity.GetPartitionKey().Value + RowKeyFragment
       + entity.GetRowKey().Value + ClosingFragment);
-  returnValue += "PATCH " + url.GetAbsoluteUrl() + " HTTP/1.1\n";
-  returnValue += "Content-Type: application/json\n";
-  returnValue += "Content-Length: " + std::to_string(payload.length());
-  returnValue += "Accept: application/json;odata=minimalmetadata\n";
-  returnValue += "Prefer: return-no-content\n";
-  returnValue += "DataServiceVersion: 3.0;\n";
-  if (!entity.GetETag().Value.empty())
-  {
-    returnValue += "If-Match: " + entity.GetETag().Value;
-  }
-  else
-  {
-    returnValue += "If-Match: *";
-  }
-  returnValue += "\n\n";
-  return returnValue;
+  payload.append("PATCH ").append(url.GetAbsoluteUrl()).append(" HTTP/1.1\n");
+  payload.append("Content-Type: application/json\n");
+  payload.append("Content-Length: ").append(std::to_string(body.length())).append("\n");
+  payload.append("Accept: application/json;odata=minimalmetadata\n");
+  payload.append("Prefer: return-no-content\n");
+  payload.append("DataServiceVersion: 3.0;\n");
+  auto const eTag = entity.GetETag().Value;
+  payload.append("If-Match: ").append(eTag.empty() ? "*" : eTag);
+  payload.append("\n\n");
+  payload.append(body);
 }
@@ -0,0 +1,255 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "../src/private/changeset_batcher.hpp"
+#include "azure/data/tables/table_client.hpp"
+
+#include <azure/core/http/transport.hpp>
+#include <azure/core/io/body_stream.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Azure::Data::Tables;
+using namespace Azure::Data::Tables::_detail;
+
+namespace Azure { namespace Data { namespace Test {
+  namespace {
+    Models::TransactionStep CreateStep(
+        std::string const& partitionKey,
+        std::string const& rowKey,
+        std::string const& value = "value")
+    {
+      Models::TransactionStep step;
+      step.Action = Models::TransactionActionType::InsertMerge;
+      step.Entity.SetPartitionKey(partitionKey);
+      step.Entity.SetRowKey(rowKey);
+      step.Entity.Properties["Data"] = Models::TableEntityProperty(value);
+      return step;
+    }
+
+    std::string CreateBatchResponse(std::string const& status, std::string const& errorCode)
+    {
+      std::string error;
+      if (!errorCode.empty())
+      {
+        error = "{\"odata.error\":{\"code\":\"" + errorCode
+            + "\",\"message\":{\"value\":\"Error.\"}}}\r\n";
+      }
+      return "--batchresponse\r\nContent-Type: multipart/mixed\r\n\r\nHTTP/1.1 " + status
+          + "\r\n\r\n" + error + "--batchresponse--\r\n";
+    }
+
+    // Accepts every changeset, unless one of its entities has a row key starting with "fail".
+    class BatchTransport final : public Azure::Core::Http::HttpTransport {
+      std::string const m_success = CreateBatchResponse("204 No Content", "");
+      std::string const m_conflict = CreateBatchResponse("409 Conflict", "EntityAlreadyExists");
+      std::string const m_busy = CreateBatchResponse("503 Service Unavailable", "ServerBusy");
+
+    public:
+      std::atomic<int> Requests{0};
+      std::atomic<int> FailuresLeft{0};
+      std::mutex PayloadsMutex;
+      std::vector<std::string> Payloads;
+
+      std::unique_ptr<Azure::Core::Http::RawResponse> Send(
+          Azure::Core::Http::Request& request,
+          Azure::Core::Context const& context) override
+      {
+        ++Requests;
+        auto const body = request.GetBodyStream()->ReadToEnd(context);
+        std::string const payload(body.begin(), body.end());
+
+        if (payload.find("RowKey='throw") != std::string::npos)
+        {
+          throw std::runtime_error("Unexpected error.");
+        }
+        if (payload.find("slow-value") != std::string::npos)
+        {
+          std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        {
+          std::lock_guard<std::mutex> lock(PayloadsMutex);
+          Payloads.push_back(payload);
+        }
+
+        std::string const* responseBody = &m_success;
+        if (payload.find("RowKey='fail") != std::string::npos)
+        {
+          responseBody = &m_conflict;
+        }
+        else if (FailuresLeft.fetch_sub(1) > 0)
+        {
+          responseBody = &m_busy;
+        }
+
+        auto response = std::make_unique<Azure::Core::Http::RawResponse>(
+            1, 1, Azure::Core::Http::HttpStatusCode::Accepted, "Accepted");
+        response->SetBodyStream(std::make_unique<Azure::Core::IO::MemoryBodyStream>(
+            reinterpret_cast<uint8_t const*>(responseBody->data()), responseBody->size()));
+        return response;
+      }
+    };
+  } // namespace
+
+  TEST(ChangesetBatcher, GroupsByPartitionKey)
+  {
+    ChangesetBatcher batcher(10000, 256);
+    std::vector<std::vector<Models::TransactionStep>> ready;
+    for (int i = 0; i < 250; ++i)
+    {
+      batcher.Add(CreateStep(i % 2 == 0 ? "even" : "odd", std::to_string(i)), ready);
+    }
+    EXPECT_EQ(ready.size(), 2);
+    batcher.Flush(ready);
+    ASSERT_EQ(ready.size(), 4);
+
+    size_t steps = 0;
+    for (auto const& changeset : ready)
+    {
+      EXPECT_LE(changeset.size(), ChangesetBatcher::MaxChangesetSteps);
+      for (auto const& step : changeset)
+      {
+        EXPECT_EQ(
+            step.Entity.GetPartitionKey().Value,
+            changeset.front().Entity.GetPartitionKey().Value);
+      }
+      steps += changeset.size();
+    }
+    EXPECT_EQ(steps, 250);
+  }
+
+  TEST(ChangesetBatcher, RespectsPayloadSize)
+  {
+    ChangesetBatcher batcher(10000, 256);
+    std::vector<std::vector<Models::TransactionStep>> ready;
+    std::string const largeValue(1024 * 1024, 'x');
+    for (int i = 0; i < 8; ++i)
+    {
+      batcher.Add(CreateStep("partition", std::to_string(i), largeValue), ready);
+    }
+    batcher.Flush(ready);
+
+    ASSERT_EQ(ready.size(), 3);
+    for (auto const& changeset : ready)
+    {
+      size_t bytes = 0;
+      for (auto const& step : changeset)
+      {
+        bytes += batcher.EstimateStepSize(step);
+      }
+      EXPECT_LE(bytes, ChangesetBatcher::MaxChangesetBytes);
+    }
+  }
+
+  TEST(ChangesetBatcher, RepeatedEntityStartsNewChangeset)
+  {
+    ChangesetBatcher batcher(10000, 256);
+    std::vector<std::vector<Models::TransactionStep>> ready;
+    batcher.Add(CreateStep("partition", "a"), ready);
+    batcher.Add(CreateStep("partition", "b"), ready);
+    batcher.Add(CreateStep("partition", "a"), ready);
+    ASSERT_EQ(ready.size(), 1);
+    EXPECT_EQ(ready[0].size(), 2);
+    batcher.Flush(ready);
+    ASSERT_EQ(ready.size(), 2);
+    EXPECT_EQ(ready[1].size(), 1);
+  }
+
+  TEST(ChangesetBatcher, BoundsBufferedSteps)
+  {
+    ChangesetBatcher batcher(10, 256);
+    std::vector<std::vector<Models::TransactionStep>> ready;
+    for (int i = 0; i < 100; ++i)
+    {
+      batcher.Add(CreateStep(std::to_string(i % 20), std::to_string(i)), ready);
+    }
+    size_t steps = 0;
+    for (auto const& changeset : ready)
+    {
+      steps += changeset.size();
+    }
+    EXPECT_GE(steps, 90);
+  }
+
+  TEST(BulkIngestion, SubmitsAndRetriesChangesets)
+  {
+    auto transport = std::make_shared<BatchTransport>();
+    transport->FailuresLeft = 2;
+    TableClientOptions clientOptions;
+    clientOptions.Transport.Transport = transport;
+    clientOptions.Retry.MaxRetries = 0;
+    TableClient client("https://account.table.core.windows.net", "table", clientOptions);
+
+    std::vector<Models::TransactionStep> steps;
+    for (int i = 0; i < 1000; ++i)
+    {
+      steps.emplace_back(CreateStep(std::to_string(i % 7), std::to_string(i)));
+    }
+    steps.emplace_back(CreateStep("failing", "fail"));
+
+    Models::SubmitTransactionsInBulkOptions options;
+    options.Concurrency = 4;
+    options.RetryDelay = std::chrono::milliseconds(1);
+    auto const result = client.SubmitTransactionsInBulk(steps, options);
+
+    EXPECT_EQ(result.CommittedSteps, 1000);
+    EXPECT_EQ(result.CommittedTransactions, 14);
+    ASSERT_EQ(result.FailedTransactions.size(), 1);
+    EXPECT_EQ(result.FailedTransactions[0].StatusCode, "409");
+    ASSERT_TRUE(result.FailedTransactions[0].Error.HasValue());
+    EXPECT_EQ(result.FailedTransactions[0].Error.Value().Code, "EntityAlreadyExists");
+    ASSERT_EQ(result.FailedTransactions[0].Steps.size(), 1);
+    // 14 committed changesets, 2 transient failures and 1 permanent failure.
+    EXPECT_EQ(transport->Requests.load(), 17);
+  }
+
+  TEST(BulkIngestion, SubmitsChangesetsOfPartitionInOrder)
+  {
+    auto transport = std::make_shared<BatchTransport>();
+    TableClientOptions clientOptions;
+    clientOptions.Transport.Transport = transport;
+    TableClient client("https://account.table.core.windows.net", "table", clientOptions);
+
+    // The repeated row key splits the partition into three changesets, the first one is slow.
+    std::vector<Models::TransactionStep> steps;
+    steps.emplace_back(CreateStep("partition", "entity", "first-slow-value"));
+    steps.emplace_back(CreateStep("partition", "entity", "second"));
+    steps.emplace_back(CreateStep("partition", "entity", "third"));
+
+    Models::SubmitTransactionsInBulkOptions options;
+    options.Concurrency = 4;
+    auto const result = client.SubmitTransactionsInBulk(steps, options);
+
+    EXPECT_EQ(result.CommittedTransactions, 3);
+    ASSERT_EQ(transport->Payloads.size(), 3);
+    EXPECT_NE(transport->Payloads[0].find("first"), std::string::npos);
+    EXPECT_NE(transport->Payloads[1].find("second"), std::string::npos);
+    EXPECT_NE(transport->Payloads[2].find("third"), std::string::npos);
+  }
+
+  TEST(BulkIngestion, RecordsChangesetWithoutResponseAsFailed)
+  {
+    auto transport = std::make_shared<BatchTransport>();
+    TableClientOptions clientOptions;
+    clientOptions.Transport.Transport = transport;
+    TableClient client("https://account.table.core.windows.net", "table", clientOptions);
+
+    std::vector<Models::TransactionStep> steps;
+    steps.emplace_back(CreateStep("first", "throw"));
+    steps.emplace_back(CreateStep("second", "entity"));
+    auto const result = client.SubmitTransactionsInBulk(steps);
+
+    EXPECT_EQ(result.CommittedTransactions, 1);
+    ASSERT_EQ(result.FailedTransactions.size(), 1);
+    EXPECT_TRUE(result.FailedTransactions[0].StatusCode.empty());
+    ASSERT_TRUE(result.FailedTransactions[0].Error.HasValue());
+    EXPECT_EQ(result.FailedTransactions[0].Error.Value().Message, "Unexpected error.");
+  }
+}}} // namespace Azure::Data::Test
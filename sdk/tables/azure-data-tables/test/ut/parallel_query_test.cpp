@@ -0,0 +1,223 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+#include "../src/private/partition_key_ranges.hpp"
+#include "azure/data/tables/table_client.hpp"
+
+#include <azure/core/http/transport.hpp>
+#include <azure/core/io/body_stream.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Azure::Data::Tables;
+using namespace Azure::Data::Tables::_detail;
+
+namespace Azure { namespace Data { namespace Test {
+  namespace {
+    // Serves a table of entities with the partition keys "key-000" to "key-099", or with another
+    // prefix. Understands the partition key range filters, $top and continuation tokens, and
+    // returns pages of 7 entities.
+    class TableTransport final : public Azure::Core::Http::HttpTransport {
+      std::vector<std::string> m_keys;
+      std::mutex m_mutex;
+      std::deque<std::string> m_responseBodies;
+
+      static std::string GetBound(std::string const& filter, std::string const& op)
+      {
+        auto const start = filter.find("PartitionKey " + op + " '");
+        if (start == std::string::npos)
+        {
+          return {};
+        }
+        auto const valueStart = start + op.size() + 15;
+        return filter.substr(valueStart, filter.find('\'', valueStart) - valueStart);
+      }
+
+    public:
+      std::atomic<int> RangeQueries{0};
+      std::atomic<int> Probes{0};
+
+      TableTransport(std::string const& prefix = "key-")
+      {
+        for (int i = 0; i < 100; ++i)
+        {
+          std::string key = std::to_string(i);
+          m_keys.emplace_back(prefix + std::string(3 - key.size(), '0') + key);
+        }
+      }
+
+      std::unique_ptr<Azure::Core::Http::RawResponse> Send(
+          Azure::Core::Http::Request& request,
+          Azure::Core::Context const&) override
+      {
+        auto const parameters = request.GetUrl().GetQueryParameters();
+        auto const getParameter = [&](std::string const& name) {
+          auto const parameter = parameters.find(name);
+          return parameter == parameters.end()
+              ? std::string()
+              : Azure::Core::Url::Decode(parameter->second);
+        };
+        auto const filter = getParameter("$filter");
+        auto const top = getParameter("$top");
+        auto lowerBound = GetBound(filter, "ge");
+        auto const upperBound = GetBound(filter, "lt");
+        auto const nextPartitionKey = getParameter("NextPartitionKey");
+        if (!nextPartitionKey.empty())
+        {
+          lowerBound = (std::max)(lowerBound, nextPartitionKey);
+        }
+        if (top.empty())
+        {
+          ++RangeQueries;
+        }
+        else
+        {
+          ++Probes;
+        }
+
+        size_t const pageSize = top.empty() ? 7 : std::stoul(top);
+        auto key = std::lower_bound(m_keys.begin(), m_keys.end(), lowerBound);
+        std::string body = "{\"value\":[";
+        auto const inRange = [&](std::vector<std::string>::const_iterator k) {
+          return k != m_keys.end() && (upperBound.empty() || *k < upperBound);
+        };
+        for (size_t i = 0; i < pageSize && inRange(key); ++i, ++key)
+        {
+          body += std::string(i == 0 ? "" : ",") + "{\"PartitionKey\":\"" + *key
+              + "\",\"RowKey\":\"row\"}";
+        }
+        body += "]}";
+
+        auto response = std::make_unique<Azure::Core::Http::RawResponse>(
+            1, 1, Azure::Core::Http::HttpStatusCode::Ok, "OK");
+        if (inRange(key))
+        {
+          response->SetHeader("x-ms-continuation-NextPartitionKey", *key);
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_responseBodies.emplace_back(std::move(body));
+        response->SetBodyStream(std::make_unique<Azure::Core::IO::MemoryBodyStream>(
+            reinterpret_cast<uint8_t const*>(m_responseBodies.back().data()),
+            m_responseBodies.back().size()));
+        return response;
+      }
+    };
+
+    std::vector<std::string> ScanTable(
+        TableClient const& client,
+        Models::QueryEntitiesInParallelOptions const& options)
+    {
+      std::vector<std::string> keys;
+      client.QueryEntitiesInParallel(
+          [&](std::vector<Models::TableEntity>& entities) {
+            for (auto const& entity : entities)
+            {
+              keys.emplace_back(entity.GetPartitionKey().Value);
+            }
+          },
+          options);
+      std::sort(keys.begin(), keys.end());
+      return keys;
+    }
+  } // namespace
+
+  TEST(PartitionKeyRanges, GetRangeFilter)
+  {
+    EXPECT_FALSE(PartitionKeyRanges::GetRangeFilter({}, {}, {}).HasValue());
+    EXPECT_EQ(
+        PartitionKeyRanges::GetRangeFilter({}, {}, std::string("Age gt 5")).Value(), "Age gt 5");
+    EXPECT_EQ(
+        PartitionKeyRanges::GetRangeFilter(std::string("a"), {}, {}).Value(),
+        "PartitionKey ge 'a'");
+    EXPECT_EQ(
+        PartitionKeyRanges::GetRangeFilter({}, std::string("O'Brien"), {}).Value(),
+        "PartitionKey lt 'O''Brien'");
+    EXPECT_EQ(
+        PartitionKeyRanges::GetRangeFilter(
+            std::string("a"), std::string("b"), std::string("Age gt 5"))
+            .Value(),
+        "(Age gt 5) and (PartitionKey ge 'a' and PartitionKey lt 'b')");
+  }
+
+  TEST(PartitionKeyRanges, SelectBoundaries)
+  {
+    std::vector<std::string> keys{"a", "b", "c", "d", "e", "f", "g", "h"};
+    EXPECT_EQ(PartitionKeyRanges::SelectBoundaries(keys, 10), keys);
+    EXPECT_EQ(
+        PartitionKeyRanges::SelectBoundaries(keys, 3), (std::vector<std::string>{"c", "e", "g"}));
+  }
+
+  TEST(ParallelQuery, ExplicitBoundaries)
+  {
+    auto transport = std::make_shared<TableTransport>();
+    TableClientOptions clientOptions;
+    clientOptions.Transport.Transport = transport;
+    TableClient client("https://account.table.core.windows.net", "table", clientOptions);
+
+    Models::QueryEntitiesInParallelOptions options;
+    options.PartitionKeyBoundaries = {"key-025", "key-050", "key-075"};
+    options.Concurrency = 4;
+    auto const keys = ScanTable(client, options);
+
+    ASSERT_EQ(keys.size(), 100);
+    EXPECT_EQ(keys.front(), "key-000");
+    EXPECT_EQ(keys.back(), "key-099");
+    EXPECT_EQ(std::adjacent_find(keys.begin(), keys.end()), keys.end());
+    // 4 ranges of 25 entities, 4 pages each.
+    EXPECT_EQ(transport->RangeQueries.load(), 16);
+  }
+
+  TEST(ParallelQuery, SampledBoundaries)
+  {
+    auto transport = std::make_shared<TableTransport>();
+    TableClientOptions clientOptions;
+    clientOptions.Transport.Transport = transport;
+    TableClient client("https://account.table.core.windows.net", "table", clientOptions);
+
+    Models::QueryEntitiesInParallelOptions options;
+    options.Concurrency = 4;
+    auto const keys = ScanTable(client, options);
+
+    ASSERT_EQ(keys.size(), 100);
+    EXPECT_EQ(std::adjacent_find(keys.begin(), keys.end()), keys.end());
+    // Sampling splits "key-0" into 10 ranges of 10 entities, 2 pages each.
+    EXPECT_EQ(transport->RangeQueries.load(), 20);
+  }
+
+  TEST(ParallelQuery, SamplingProbesAreBounded)
+  {
+    auto transport = std::make_shared<TableTransport>(std::string(64, 'k'));
+    TableClientOptions clientOptions;
+    clientOptions.Transport.Transport = transport;
+    TableClient client("https://account.table.core.windows.net", "table", clientOptions);
+
+    auto const keys = ScanTable(client, {});
+
+    ASSERT_EQ(keys.size(), 100);
+    EXPECT_EQ(std::adjacent_find(keys.begin(), keys.end()), keys.end());
+    EXPECT_LE(transport->Probes.load(), 512);
+  }
+
+  TEST(ParallelQuery, InvalidBoundaries)
+  {
+    auto transport = std::make_shared<TableTransport>();
+    TableClientOptions clientOptions;
+    clientOptions.Transport.Transport = transport;
+    TableClient client("https://account.table.core.windows.net", "table", clientOptions);
+
+    Models::QueryEntitiesInParallelOptions options;
+    options.PartitionKeyBoundaries = {"key-050", "key-025"};
+    EXPECT_THROW(ScanTable(client, options), std::invalid_argument);
+    options.PartitionKeyBoundaries = {"key-025", "key-025"};
+    EXPECT_THROW(ScanTable(client, options), std::invalid_argument);
+    EXPECT_EQ(transport->RangeQueries.load(), 0);
+  }
+}}} // namespace Azure::Data::Test
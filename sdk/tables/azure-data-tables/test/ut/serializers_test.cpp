@@ -534,4 +534,96 @@ namespace Azure { namespace Data { namespace Test {
     EXPECT_TRUE(data.SignedIdentifiers[0].Permissions.empty());
   }
 
+  TEST_F(SerializersTest, DeserializeEntitiesValueArray)
+  {
+    std::string body = R"({
+    "odata.metadata": "https://account.table.core.windows.net/$metadata#table",
+    "value": [
+      {
+        "odata.etag": "W/\"datetime'2023-01-01T00%3A00%3A00Z'\"",
+        "PartitionKey": "p1",
+        "RowKey": "r1",
+        "Age@odata.type": "Edm.Int64",
+        "Age": "30"
+      },
+      {
+        "PartitionKey": "p1",
+        "RowKey": "r2",
+        "Name": "Jane Doe"
+      }
+    ]
+  })";
+
+    auto entities
+        = Serializers::DeserializeEntities(std::vector<uint8_t>(body.begin(), body.end()));
+
+    ASSERT_EQ(entities.size(), 2);
+    EXPECT_EQ(entities[0].GetPartitionKey().Value, "p1");
+    EXPECT_EQ(entities[0].GetRowKey().Value, "r1");
+    EXPECT_EQ(entities[0].GetETag().Value, "W/\"datetime'2023-01-01T00%3A00%3A00Z'\"");
+    EXPECT_EQ(entities[0].Properties["Age"].Value, "30");
+    EXPECT_EQ(entities[0].Properties["Age"].Type.Value().ToString(), "Edm.Int64");
+    EXPECT_EQ(entities[0].Properties.count("Age@odata.type"), 0);
+    EXPECT_EQ(entities[0].Properties.count("odata.metadata"), 0);
+    EXPECT_EQ(entities[1].GetRowKey().Value, "r2");
+    EXPECT_EQ(entities[1].Properties["Name"].Value, "Jane Doe");
+    EXPECT_FALSE(entities[1].Properties["Name"].Type.HasValue());
+  }
+
+  TEST_F(SerializersTest, DeserializeEntitiesEmptyValueArray)
+  {
+    std::string body = R"({"odata.metadata": "metadata", "value": []})";
+
+    auto entities
+        = Serializers::DeserializeEntities(std::vector<uint8_t>(body.begin(), body.end()));
+
+    EXPECT_TRUE(entities.empty());
+  }
+
+  TEST_F(SerializersTest, DeserializeEntitiesMatchesDeserializeEntity)
+  {
+    std::string body = R"({
+    "PartitionKey": "p7",
+    "RowKey": "r7",
+    "Completed": true,
+    "Score": 9.5,
+    "Age": 30,
+    "Large": 18446744073709551615,
+    "Negative": -5,
+    "Description": null,
+    "Description@odata.type": "Edm.String",
+    "Orphan@odata.type": "Edm.Guid",
+    "Nested": {"a": [1, "two", {"b": null}], "c": {}},
+    "List": [[], [true, false]]
+  })";
+
+    auto entities
+        = Serializers::DeserializeEntities(std::vector<uint8_t>(body.begin(), body.end()));
+    auto expected = Serializers::DeserializeEntity(Core::Json::_internal::json::parse(body));
+
+    ASSERT_EQ(entities.size(), 1);
+    ASSERT_EQ(entities[0].Properties.size(), expected.Properties.size());
+    for (auto const& property : expected.Properties)
+    {
+      auto const& actual = entities[0].Properties.at(property.first);
+      EXPECT_EQ(actual.Value, property.second.Value) << property.first;
+      EXPECT_EQ(actual.Type.HasValue(), property.second.Type.HasValue()) << property.first;
+      if (actual.Type.HasValue())
+      {
+        EXPECT_EQ(actual.Type.Value(), property.second.Type.Value()) << property.first;
+      }
+    }
+    EXPECT_EQ(entities[0].Properties["Nested"].Value, R"({"a":[1,"two",{"b":null}],"c":{}})");
+    EXPECT_EQ(entities[0].Properties["List"].Value, "[[],[true,false]]");
+  }
+
+  TEST_F(SerializersTest, DeserializeEntitiesInvalidJson)
+  {
+    std::string body = R"({"value": [{"PartitionKey": "p1",)";
+
+    EXPECT_THROW(
+        Serializers::DeserializeEntities(std::vector<uint8_t>(body.begin(), body.end())),
+        Core::Json::_internal::json::parse_error);
+  }
+
 }}} // namespace Azure::Data::Test
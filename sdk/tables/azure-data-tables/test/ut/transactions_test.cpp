@@ -151,6 +151,11 @@ namespace Azure { namespace Data { namespace Test {
             lines[4],
             "PATCH " + url + "/" + tableName + "(PartitionKey='" + partitionKey + "',RowKey='"
                 + rowKey + "') HTTP/1.1");
+        EXPECT_EQ(lines[6].substr(0, 16), "Content-Length: ");
+        EXPECT_EQ(lines[7], "Accept: application/json;odata=minimalmetadata");
+        EXPECT_EQ(lines[11], "");
+        EXPECT_EQ(lines[12].find("\"PartitionKey\""), 1);
+        EXPECT_EQ(lines[6].substr(16), std::to_string(lines[12].size()));
         break;
     }
     EXPECT_EQ(lines[lines.size() - 1], "--" + changeset + "--");